@@ -0,0 +1,374 @@
+#ifndef INCLUDED_COMM_KERNELS_THROUGHPUT_HARNESS_H
+#define INCLUDED_COMM_KERNELS_THROUGHPUT_HARNESS_H
+
+// sustained throughput of single blocks; every block under test runs in its own top block
+// (repeating vector sources -> head -> block -> null sinks) for each point of the parameter
+// matrix, and the results go to a CSV and a JSON report
+
+#include <gnuradio/top_block.h>
+#include <gnuradio/high_res_timer.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/null_sink.h>
+
+#include <Comm_Kernels/array_kernels.h>
+#include <Comm_Kernels/random_gen.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+#define THRPT_DEF_ITEMS                     (2000000)                                   // items pushed into the block per run
+#define THRPT_DEF_REPEAT                    (3)                                         // runs per point; the fastest one is reported
+#define THRPT_DEF_PACKET                    "100,1000,10000,100000"                     // default packet sizes
+#define THRPT_DEF_SPB                       "1,2,4,8,16"                                // default samples per bit
+#define THRPT_DEF_WIN                       "1000,10000,100000"                         // default window sizes
+#define THRPT_DEF_RATE                      "32e3,1e6,10e6"                             // default sample rates
+#define THRPT_SEED                          (2020)                                      // seed of the generated input data
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // parameters a block depends on; only these are swept for it
+    enum Throughput_Axis {AXIS_PACKET = 1, AXIS_SPB = 2, AXIS_WIN = 4, AXIS_RATE = 8};
+
+
+    // one point of the parameter matrix
+    struct Throughput_Point
+    {
+        int iPacketSize;  // packet size (samples)
+        int iSamplesPerBit;  // samples per bit
+        int iWinSize;  // measurement window size (samples)
+        float fSampRate;  // sample rate (samples/s)
+    };
+
+
+    // measurement of one block at one point
+    struct Throughput_Result
+    {
+        std::string sBlock;  // block name
+        int iAxes;  // swept parameters
+        Throughput_Point Point;  // parameter values
+        uint64_t uItems;  // items through the first input
+        double dSeconds;  // wall time of the fastest run
+        double dWorkSeconds;  // time spent in the block's work of that run; negative if performance counters are off
+    };
+
+
+    class Throughput_Harness
+    {
+        public:
+        // builds the flowgraph of one point and returns the block under test; nullptr skips the point
+        typedef std::function<gr::block_sptr(Throughput_Harness &, gr::top_block_sptr, const Throughput_Point &)> Builder;
+
+        private:
+        struct Entry  // registered block
+        {
+            std::string sBlock;
+            int iAxes;
+            Builder fBuild;
+        };
+
+        std::string sModule;  // module name; used in the report names
+        uint64_t uItems;  // items per run
+        int iRepeat;  // runs per point
+        std::string sFilter;  // only blocks whose name contains this are run
+        std::string sCsvPath;  // CSV report path
+        std::string sJsonPath;  // JSON report path
+        std::vector<int> vPacketSizes;  // swept packet sizes
+        std::vector<int> vSamplesPerBit;  // swept samples per bit
+        std::vector<int> vWinSizes;  // swept window sizes
+        std::vector<float> vSampRates;  // swept sample rates
+        std::vector<Entry> vEntries;  // registered blocks
+        std::vector<Throughput_Result> vResults;  // measurements
+
+        template <class T>
+        static std::vector<T> ParseList(const std::string &sList)  // comma separated list of numbers
+        {
+            std::vector<T> vOut;
+            std::stringstream ssList(sList);
+            std::string sItem;
+            while(std::getline(ssList, sItem, ','))  // go through the items
+            {
+                if(!sItem.empty())
+                {
+                    vOut.push_back(T(std::strtod(sItem.c_str(), nullptr)));
+                }
+            }
+            return vOut;
+        }
+
+        static bool Option(const std::string &sArg, const std::string &sName, std::string &sValue)  // '--name=value' option
+        {
+            std::string sPrefix = "--" + sName + "=";
+            if(sArg.compare(0, sPrefix.size(), sPrefix) != 0)
+            {
+                return false;
+            }
+            sValue = sArg.substr(sPrefix.size());
+            return true;
+        }
+
+        void Usage(const char *ptr_cProgram) const
+        {
+            std::cout << "Usage: " << ptr_cProgram << " [options]" << std::endl
+                      << "  --items=N        items pushed into each block per run (" << THRPT_DEF_ITEMS << ")" << std::endl
+                      << "  --repeat=N       runs per point, the fastest is reported (" << THRPT_DEF_REPEAT << ")" << std::endl
+                      << "  --filter=NAME    only run blocks whose name contains NAME" << std::endl
+                      << "  --packet=LIST    packet sizes (" << THRPT_DEF_PACKET << ")" << std::endl
+                      << "  --spb=LIST       samples per bit (" << THRPT_DEF_SPB << ")" << std::endl
+                      << "  --win=LIST       window sizes (" << THRPT_DEF_WIN << ")" << std::endl
+                      << "  --rate=LIST      sample rates (" << THRPT_DEF_RATE << ")" << std::endl
+                      << "  --csv=PATH       CSV report (" << sModule << "_throughput.csv)" << std::endl
+                      << "  --json=PATH      JSON report (" << sModule << "_throughput.json)" << std::endl
+                      << "Blocks report work time too when GNU Radio performance counters are on." << std::endl;
+        }
+
+        template <class T>
+        static gr::basic_block_sptr MakeSource(const std::vector<T> &vData);  // repeating vector source of the given data
+
+        void Measure(const Entry &entry, const Throughput_Point &point)  // run one point and keep the fastest run
+        {
+            Throughput_Result result;
+            result.sBlock = entry.sBlock;
+            result.iAxes = entry.iAxes;
+            result.Point = point;
+            result.uItems = uItems;
+            result.dSeconds = -1.0;
+            result.dWorkSeconds = -1.0;
+
+            for(int index_r = 0; index_r < iRepeat; ++index_r)  // go through the runs
+            {
+                gr::top_block_sptr tb = gr::make_top_block(sModule + "_throughput");
+                gr::block_sptr block = entry.fBuild(*this, tb, point);
+                if(block == nullptr)  // point is not valid for the block
+                {
+                    return;
+                }
+
+                std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+                tb->run();
+                double dSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+
+                if((result.dSeconds < 0.0) || (dSeconds < result.dSeconds))  // fastest run so far
+                {
+                    result.dSeconds = dSeconds;
+                    double dWorkTicks = block->pc_work_time_total();  // zero when performance counters are off
+                    result.dWorkSeconds = (dWorkTicks > 0.0) ? dWorkTicks/double(gr::high_res_timer_tps()) : -1.0;
+                }
+            }
+
+            vResults.push_back(result);
+
+            std::cout << std::left << std::setw(24) << result.sBlock << std::right
+                      << std::setw(8) << ((entry.iAxes & AXIS_PACKET) ? std::to_string(point.iPacketSize) : "-")
+                      << std::setw(5) << ((entry.iAxes & AXIS_SPB) ? std::to_string(point.iSamplesPerBit) : "-")
+                      << std::setw(8) << ((entry.iAxes & AXIS_WIN) ? std::to_string(point.iWinSize) : "-")
+                      << std::setw(10) << ((entry.iAxes & AXIS_RATE) ? std::to_string(int(point.fSampRate)) : "-")
+                      << std::setw(14) << std::fixed << std::setprecision(0) << uItems/result.dSeconds
+                      << std::setw(10) << std::setprecision(2) << 1e9*result.dSeconds/uItems << std::endl;
+        }
+
+        void WriteCsv(void) const
+        {
+            std::ofstream file(sCsvPath);
+            file << "module,block,packet_size,samples_per_bit,win_size,samp_rate,items,seconds,items_per_s,ns_per_item,work_ns_per_item" << std::endl;
+            for(const Throughput_Result &result : vResults)  // go through the measurements
+            {
+                file << sModule << "," << result.sBlock << ","
+                     << ((result.iAxes & AXIS_PACKET) ? std::to_string(result.Point.iPacketSize) : "") << ","
+                     << ((result.iAxes & AXIS_SPB) ? std::to_string(result.Point.iSamplesPerBit) : "") << ","
+                     << ((result.iAxes & AXIS_WIN) ? std::to_string(result.Point.iWinSize) : "") << ","
+                     << ((result.iAxes & AXIS_RATE) ? std::to_string(result.Point.fSampRate) : "") << ","
+                     << result.uItems << "," << result.dSeconds << ","
+                     << result.uItems/result.dSeconds << "," << 1e9*result.dSeconds/result.uItems << ","
+                     << ((result.dWorkSeconds >= 0.0) ? std::to_string(1e9*result.dWorkSeconds/result.uItems) : "") << std::endl;
+            }
+        }
+
+        void WriteJson(void) const
+        {
+            std::ofstream file(sJsonPath);
+            file << "{" << std::endl
+                 << "  \"module\": \"" << sModule << "\"," << std::endl
+                 << "  \"items\": " << uItems << "," << std::endl
+                 << "  \"repeat\": " << iRepeat << "," << std::endl
+                 << "  \"results\": [";
+            for(size_t index = 0; index < vResults.size(); ++index)  // go through the measurements
+            {
+                const Throughput_Result &result = vResults[index];
+                file << ((index == 0) ? "" : ",") << std::endl
+                     << "    {\"block\": \"" << result.sBlock << "\""
+                     << ", \"packet_size\": " << ((result.iAxes & AXIS_PACKET) ? std::to_string(result.Point.iPacketSize) : "null")
+                     << ", \"samples_per_bit\": " << ((result.iAxes & AXIS_SPB) ? std::to_string(result.Point.iSamplesPerBit) : "null")
+                     << ", \"win_size\": " << ((result.iAxes & AXIS_WIN) ? std::to_string(result.Point.iWinSize) : "null")
+                     << ", \"samp_rate\": " << ((result.iAxes & AXIS_RATE) ? std::to_string(result.Point.fSampRate) : "null")
+                     << ", \"items\": " << result.uItems
+                     << ", \"seconds\": " << result.dSeconds
+                     << ", \"items_per_s\": " << result.uItems/result.dSeconds
+                     << ", \"ns_per_item\": " << 1e9*result.dSeconds/result.uItems
+                     << ", \"work_ns_per_item\": " << ((result.dWorkSeconds >= 0.0) ? std::to_string(1e9*result.dWorkSeconds/result.uItems) : "null")
+                     << "}";
+            }
+            file << std::endl << "  ]" << std::endl << "}" << std::endl;
+        }
+
+        public:
+        Throughput_Harness(const std::string &module, int argc, char **argv)
+            : sModule(module), uItems(THRPT_DEF_ITEMS), iRepeat(THRPT_DEF_REPEAT),
+              sCsvPath(module + "_throughput.csv"), sJsonPath(module + "_throughput.json")
+        {
+            std::string sPacket = THRPT_DEF_PACKET, sSpB = THRPT_DEF_SPB, sWin = THRPT_DEF_WIN, sRate = THRPT_DEF_RATE;
+            std::string sValue;
+
+            for(int index = 1; index < argc; ++index)  // go through the arguments
+            {
+                std::string sArg(argv[index]);
+                if(Option(sArg, "items", sValue)) uItems = std::strtoull(sValue.c_str(), nullptr, 10);
+                else if(Option(sArg, "repeat", sValue)) iRepeat = std::atoi(sValue.c_str());
+                else if(Option(sArg, "filter", sValue)) sFilter = sValue;
+                else if(Option(sArg, "packet", sValue)) sPacket = sValue;
+                else if(Option(sArg, "spb", sValue)) sSpB = sValue;
+                else if(Option(sArg, "win", sValue)) sWin = sValue;
+                else if(Option(sArg, "rate", sValue)) sRate = sValue;
+                else if(Option(sArg, "csv", sValue)) sCsvPath = sValue;
+                else if(Option(sArg, "json", sValue)) sJsonPath = sValue;
+                else
+                {
+                    Usage(argv[0]);
+                    std::exit((sArg == "--help") ? EXIT_SUCCESS : EXIT_FAILURE);
+                }
+            }
+
+            vPacketSizes = ParseList<int>(sPacket);
+            vSamplesPerBit = ParseList<int>(sSpB);
+            vWinSizes = ParseList<int>(sWin);
+            vSampRates = ParseList<float>(sRate);
+            iRepeat = (iRepeat < 1) ? 1 : iRepeat;  // at least one run
+        }
+
+        uint64_t get_Items(void) const  // getter: uItems
+        {
+            return uItems;
+        }
+
+        void add(const std::string &block, const int axes, Builder build)  // register a block and the parameters it depends on
+        {
+            vEntries.push_back(Entry{block, axes, build});
+        }
+
+        // 'iLen' samples of random bits with 'iSpB' samples per bit
+        static std::vector<char> BitSignal(const int iLen, const int iSpB, const uint64_t stream = 0)
+        {
+            Philox_Rand_Eng RandEng(THRPT_SEED, stream);
+            std::vector<char> vBits(iLen/iSpB + 1);
+            RandEng.fill_bits(vBits.data(), vBits.size());
+
+            std::vector<char> vSignal(vBits.size()*iSpB);
+            InterpArray<char>(vBits.data(), vSignal.data(), vBits.size(), iSpB);  // resample the bits
+            vSignal.resize(iLen);
+            return vSignal;
+        }
+
+        // BitSignal as on-off keyed levels plus noise of standard deviation 'fNoiseStd'
+        static std::vector<float> NoisySignal(const int iLen, const int iSpB, const float fNoiseStd = 0.1, const uint64_t stream = 0)
+        {
+            std::vector<char> vBits = BitSignal(iLen, iSpB, stream);
+            std::vector<float> vSignal(iLen);
+            Philox_Rand_Eng RandEng(THRPT_SEED, stream + 1);  // noise on its own stream
+            RandEng.fill_normal(vSignal.data(), iLen, 0.0, fNoiseStd);
+            for(int index = 0; index < iLen; ++index)  // go through all samples
+            {
+                vSignal[index] += vBits[index];  // add the level
+            }
+            return vSignal;
+        }
+
+        // repeating source of 'vData', cut to the run length, into 'port' of 'block'
+        template <class T>
+        void connect_source(gr::top_block_sptr tb, const std::vector<T> &vData, gr::basic_block_sptr block, const int port)
+        {
+            gr::blocks::head::sptr head = gr::blocks::head::make(sizeof(T), uItems);
+            tb->connect(MakeSource<T>(vData), 0, head, 0);
+            tb->connect(head, 0, block, port);
+        }
+
+        // null sinks on the outputs of 'block'; one per item size
+        void connect_sinks(gr::top_block_sptr tb, gr::basic_block_sptr block, const std::vector<size_t> &vItemSizes)
+        {
+            for(size_t index = 0; index < vItemSizes.size(); ++index)  // go through the outputs
+            {
+                tb->connect(block, index, gr::blocks::null_sink::make(vItemSizes[index]), 0);
+            }
+        }
+
+        int run(void)  // sweep all registered blocks and write the reports
+        {
+            std::cout << std::left << std::setw(24) << "block" << std::right << std::setw(8) << "packet" << std::setw(5) << "spb"
+                      << std::setw(8) << "win" << std::setw(10) << "rate" << std::setw(14) << "items/s" << std::setw(10) << "ns/item" << std::endl;
+
+            for(const Entry &entry : vEntries)  // go through the blocks
+            {
+                if(entry.sBlock.find(sFilter) == std::string::npos)  // filtered out
+                {
+                    continue;
+                }
+
+                // unused parameters keep a single default value
+                std::vector<int> vPacket = (entry.iAxes & AXIS_PACKET) ? vPacketSizes : std::vector<int>(1, vPacketSizes.front());
+                std::vector<int> vSpB = (entry.iAxes & AXIS_SPB) ? vSamplesPerBit : std::vector<int>(1, vSamplesPerBit.front());
+                std::vector<int> vWin = (entry.iAxes & AXIS_WIN) ? vWinSizes : std::vector<int>(1, vWinSizes.front());
+                std::vector<float> vRate = (entry.iAxes & AXIS_RATE) ? vSampRates : std::vector<float>(1, vSampRates.front());
+
+                for(int iPacket : vPacket)
+                    for(int iSpB : vSpB)
+                        for(int iWin : vWin)
+                            for(float fRate : vRate)
+                            {
+                                if(((entry.iAxes & AXIS_PACKET) && (entry.iAxes & AXIS_SPB) && (iSpB > iPacket)) ||
+                                   ((entry.iAxes & AXIS_WIN) && (entry.iAxes & AXIS_SPB) && (iSpB > iWin)))  // less than one bit
+                                {
+                                    continue;
+                                }
+                                this->Measure(entry, Throughput_Point{iPacket, iSpB, iWin, fRate});
+                            }
+            }
+
+            this->WriteCsv();
+            this->WriteJson();
+            std::cout << "Reports: " << sCsvPath << ", " << sJsonPath << std::endl;
+            return EXIT_SUCCESS;
+        }
+    };
+
+
+    template <>
+    inline gr::basic_block_sptr Throughput_Harness::MakeSource<char>(const std::vector<char> &vData)
+    {
+        return gr::blocks::vector_source_b::make(std::vector<unsigned char>(vData.begin(), vData.end()), true);
+    }
+
+    template <>
+    inline gr::basic_block_sptr Throughput_Harness::MakeSource<float>(const std::vector<float> &vData)
+    {
+        return gr::blocks::vector_source_f::make(vData, true);
+    }
+
+    template <>
+    inline gr::basic_block_sptr Throughput_Harness::MakeSource<int>(const std::vector<int> &vData)
+    {
+        return gr::blocks::vector_source_i::make(vData, true);
+    }
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_THROUGHPUT_HARNESS_H */
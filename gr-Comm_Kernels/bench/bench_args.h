@@ -0,0 +1,72 @@
+#ifndef INCLUDED_COMM_KERNELS_BENCH_ARGS_H
+#define INCLUDED_COMM_KERNELS_BENCH_ARGS_H
+
+#include <benchmark/benchmark.h>
+#include <Comm_Kernels/macros_functions.h>
+
+
+#define BENCH_MIN_PACKET        (100)     // smallest packet size
+#define BENCH_MAX_PACKET        (100000)  // largest packet size
+#define BENCH_PACKET_MULT       (10)      // packet size step
+#define BENCH_MIN_SPB           (1)       // smallest samples per bit
+#define BENCH_MAX_SPB           (16)      // largest samples per bit
+#define BENCH_PATTERN_BITS      (32)      // header pattern length in bits (preamble + label)
+#define BENCH_SEED              (12345)   // fixed seed so every run sees the same data
+#define BENCH_BANK_DEPTH        (4096)    // depth of the deep bank buffer
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // packet sizes 100 .. 100k
+    inline void PacketArgs(benchmark::internal::Benchmark *ptr_Bench)
+    {
+        ptr_Bench->ArgName("packet");
+        for(int iPacket = BENCH_MIN_PACKET; iPacket <= BENCH_MAX_PACKET; iPacket *= BENCH_PACKET_MULT)  // go through packet sizes
+        {
+            ptr_Bench->Arg(iPacket);
+        }
+    }
+
+    // packet sizes 100 .. 100k by samples per bit 1 .. 16
+    inline void PacketSpBArgs(benchmark::internal::Benchmark *ptr_Bench)
+    {
+        ptr_Bench->ArgNames({"packet", "spb"});
+        for(int iPacket = BENCH_MIN_PACKET; iPacket <= BENCH_MAX_PACKET; iPacket *= BENCH_PACKET_MULT)  // go through packet sizes
+        {
+            for(int iSpB = BENCH_MIN_SPB; iSpB <= BENCH_MAX_SPB; iSpB *= 2)  // go through samples per bit
+            {
+                ptr_Bench->Args({iPacket, iSpB});
+            }
+        }
+    }
+
+    // as PacketSpBArgs, only for packets longer than the resampled header pattern
+    inline void PatternArgs(benchmark::internal::Benchmark *ptr_Bench)
+    {
+        ptr_Bench->ArgNames({"packet", "spb"});
+        for(int iPacket = BENCH_MIN_PACKET; iPacket <= BENCH_MAX_PACKET; iPacket *= BENCH_PACKET_MULT)  // go through packet sizes
+        {
+            for(int iSpB = BENCH_MIN_SPB; iSpB <= BENCH_MAX_SPB; iSpB *= 2)  // go through samples per bit
+            {
+                if(iPacket > 2*BENCH_PATTERN_BITS*iSpB)  // pattern fits in the packet
+                {
+                    ptr_Bench->Args({iPacket, iSpB});
+                }
+            }
+        }
+    }
+
+    // report elements and bytes per second of a benchmark that handles 'iItems' elements of type T per iteration
+    template <class T>
+    inline void SetThroughput(benchmark::State &state, const int64_t iItems)
+    {
+        state.SetItemsProcessed(int64_t(state.iterations())*iItems);
+        state.SetBytesProcessed(int64_t(state.iterations())*iItems*int64_t(sizeof(T)));
+        state.counters["simd_level"] = SIMD_Level();  // dispatch level the numbers belong to
+    }
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_BENCH_ARGS_H */
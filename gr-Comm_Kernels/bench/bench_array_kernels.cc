@@ -0,0 +1,386 @@
+// micro-benchmarks of the array kernels, with the packet sizes and samples per bit the blocks use
+
+#include "bench_args.h"
+
+#include <vector>
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // bits resampled to 'iSpB' samples per bit, the way Add_Header and Source_BV build their signal
+    static std::vector<char> BitSignal(const int iLen, const int iSpB)
+    {
+        Philox_Rand_Eng RandEng(BENCH_SEED);  // same bits every run
+        std::vector<char> vBits(iLen/iSpB + 1);
+        RandEng.fill_bits(vBits.data(), vBits.size());
+
+        std::vector<char> vSignal(vBits.size()*iSpB);
+        InterpArray<char>(vBits.data(), vSignal.data(), vBits.size(), iSpB);  // resample the bits
+        vSignal.resize(iLen);
+        return vSignal;
+    }
+
+    // noisy on-off keyed version of BitSignal, the input of Channel_Analyser and Signal_Quality_Metre
+    static std::vector<float> NoisySignal(const int iLen, const int iSpB)
+    {
+        std::vector<char> vSignal = BitSignal(iLen, iSpB);
+        std::vector<float> vNoise(iLen);
+        Philox_Rand_Eng RandEng(BENCH_SEED, 1);  // noise on its own stream
+        RandEng.fill_normal(vNoise.data(), iLen, 0.0, 0.1);
+
+        std::vector<float> vOut(iLen);
+        for(int index = 0; index < iLen; ++index)  // go through all samples
+        {
+            vOut[index] = vSignal[index] + vNoise[index];  // add noise to the level
+        }
+        return vOut;
+    }
+
+
+    static void BM_MatchBitSeq(benchmark::State &state)  // header search of Remove_Header; the match is at the end of the packet
+    {
+        const int iPacket = state.range(0);
+        const int iSpB = state.range(1);
+        const int iPatternLen = BENCH_PATTERN_BITS*iSpB;  // resampled header pattern
+
+        std::vector<char> vIn = BitSignal(iPacket, iSpB);
+        std::vector<char> vPattern(iPatternLen, VAL_1);  // a run of ones shows up rarely in random bits
+        std::vector<char> vAux(iPatternLen);
+        const int iMatch = iPacket - iPatternLen - 1;  // last index the search reaches
+        CopyArrays<char>(vPattern.data(), vIn.data() + iMatch, iPatternLen);
+
+        for(auto _ : state)
+        {
+            int index_M = MatchBitSeq<char>(vIn.data(), vPattern.data(), vAux.data(), iPacket, iPatternLen);
+            benchmark::DoNotOptimize(index_M);
+        }
+        SetThroughput<char>(state, iPacket);
+    }
+    BENCHMARK(BM_MatchBitSeq)->Apply(PatternArgs);
+
+
+    static void BM_BitCorrelator(benchmark::State &state)  // same search with Bit_Correlator; packing the input is part of the cost
+    {
+        const int iPacket = state.range(0);
+        const int iSpB = state.range(1);
+        const int iPatternLen = BENCH_PATTERN_BITS*iSpB;  // resampled header pattern
+
+        std::vector<char> vIn = BitSignal(iPacket, iSpB);
+        std::vector<char> vPattern(iPatternLen, VAL_1);  // a run of ones shows up rarely in random bits
+        const int iMatch = iPacket - iPatternLen - 1;  // last index the search reaches
+        CopyArrays<char>(vPattern.data(), vIn.data() + iMatch, iPatternLen);
+
+        Bit_Correlator Correlator;
+        Correlator.set_Pattern(vPattern.data(), iPatternLen);
+        for(auto _ : state)
+        {
+            Correlator.load(vIn.data(), iPacket);
+            int index_M = Correlator.find(0);
+            benchmark::DoNotOptimize(index_M);
+        }
+        SetThroughput<char>(state, iPacket);
+    }
+    BENCHMARK(BM_BitCorrelator)->Apply(PatternArgs);
+
+
+    static void BM_WeightAverage(benchmark::State &state)  // Slicer; one weighted mean per sample over a one bit window
+    {
+        const int iPacket = state.range(0);
+        const int iSpB = state.range(1);
+
+        std::vector<float> vIn = NoisySignal(iPacket, iSpB);
+        std::vector<float> vWeights(iSpB, 1.0f);
+
+        for(auto _ : state)
+        {
+            float fMean = 0.0;
+            for(int index = 0; index < iPacket; ++index)  // go through all samples, as Slicer does
+            {
+                fMean += WeightAverage<float>(vIn.data(), vWeights.data(), index, iPacket, iSpB);
+            }
+            benchmark::DoNotOptimize(fMean);
+        }
+        SetThroughput<float>(state, iPacket);
+    }
+    BENCHMARK(BM_WeightAverage)->Apply(PacketSpBArgs);
+
+
+    static void BM_CalcMeanVar(benchmark::State &state)  // level statistics of Channel_Analyser and Signal_Quality_Metre
+    {
+        const int iPacket = state.range(0);
+        const int iSpB = state.range(1);
+
+        std::vector<float> vIn = NoisySignal(iPacket, iSpB);
+        int arr_iLen[2];
+        float arr_fRes[4];
+
+        for(auto _ : state)
+        {
+            CalcMeanVar<float>(vIn.data(), iPacket, 0, 0.5, iSpB, arr_iLen, arr_fRes);
+            benchmark::DoNotOptimize(arr_fRes);
+        }
+        SetThroughput<float>(state, iPacket/iSpB);
+    }
+    BENCHMARK(BM_CalcMeanVar)->Apply(PacketSpBArgs);
+
+
+    static void BM_FindFirstEdge(benchmark::State &state)  // edge search of Channel_Analyser; the only edge is at the end
+    {
+        const int iPacket = state.range(0);
+
+        std::vector<float> vIn(iPacket, 0.0f);
+        vIn[iPacket - 1] = 1.0f;  // single rising edge
+
+        for(auto _ : state)
+        {
+            int firstEdge = FindFirstEdge<float>(vIn.data(), iPacket, 0, 0.5, 2);
+            benchmark::DoNotOptimize(firstEdge);
+        }
+        SetThroughput<float>(state, iPacket);
+    }
+    BENCHMARK(BM_FindFirstEdge)->Apply(PacketArgs);
+
+
+    static void BM_InterpArray(benchmark::State &state)  // bit to sample resampling of Add_Header, Source_BV and Tx_Soft_Switch
+    {
+        const int iPacket = state.range(0);
+        const int iSpB = state.range(1);
+        const int iBits = iPacket/iSpB;
+
+        std::vector<char> vIn(iBits, VAL_1);
+        std::vector<char> vOut(iBits*iSpB);
+
+        for(auto _ : state)
+        {
+            InterpArray<char>(vIn.data(), vOut.data(), iBits, iSpB);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<char>(state, int64_t(iBits)*iSpB);
+    }
+    BENCHMARK(BM_InterpArray)->Apply(PacketSpBArgs);
+
+
+    static void BM_DecimatArray_char(benchmark::State &state)  // sample to bit decimation of Remove_Header and Rx_Soft_Switch
+    {
+        const int iPacket = state.range(0);
+        const int iSpB = state.range(1);
+
+        std::vector<char> vIn = BitSignal(iPacket, iSpB);
+        std::vector<char> vOut(iPacket/iSpB + 1);
+
+        for(auto _ : state)
+        {
+            DecimatArray<char>(vIn.data(), vOut.data(), iPacket, iSpB);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<char>(state, iPacket);
+    }
+    BENCHMARK(BM_DecimatArray_char)->Apply(PacketSpBArgs);
+
+
+    static void BM_DecimatArray_float(benchmark::State &state)  // float decimation; gather kernels on AVX2 and AVX-512
+    {
+        const int iPacket = state.range(0);
+        const int iSpB = state.range(1);
+
+        std::vector<float> vIn = NoisySignal(iPacket, iSpB);
+        std::vector<float> vOut(iPacket/iSpB + 1);
+
+        for(auto _ : state)
+        {
+            DecimatArray<float>(vIn.data(), vOut.data(), iPacket, iSpB);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<float>(state, iPacket);
+    }
+    BENCHMARK(BM_DecimatArray_float)->Apply(PacketSpBArgs);
+
+
+    static void BM_Bits2Num(benchmark::State &state)  // counter and label decoding; 8 bit words over the packet
+    {
+        const int iPacket = state.range(0);
+
+        std::vector<char> vIn = BitSignal(iPacket, 1);
+
+        for(auto _ : state)
+        {
+            int iSum = 0;
+            for(int index = 0; index + 8 <= iPacket; index += 8)  // go through all words
+            {
+                iSum += Bits2Num<int>(vIn.data() + index, 8);
+            }
+            benchmark::DoNotOptimize(iSum);
+        }
+        SetThroughput<char>(state, iPacket);
+    }
+    BENCHMARK(BM_Bits2Num)->Apply(PacketArgs);
+
+
+    static void BM_Num2Bits(benchmark::State &state)  // counter and label encoding; 8 bit words over the packet
+    {
+        const int iPacket = state.range(0);
+
+        std::vector<char> vOut(iPacket);
+
+        for(auto _ : state)
+        {
+            for(int index = 0; index + 8 <= iPacket; index += 8)  // go through all words
+            {
+                Num2Bits<int>(index & 0xFF, vOut.data() + index, 8);
+            }
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<char>(state, iPacket);
+    }
+    BENCHMARK(BM_Num2Bits)->Apply(PacketArgs);
+
+
+    static void BM_LinearMap(benchmark::State &state)  // gain and offset of the channel blocks
+    {
+        const int iPacket = state.range(0);
+
+        std::vector<float> vIn = NoisySignal(iPacket, 1);
+        std::vector<float> vOut(iPacket);
+
+        for(auto _ : state)
+        {
+            LinearMap<float>(vIn.data(), vOut.data(), iPacket, 0.5f, 0.1f);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<float>(state, iPacket);
+    }
+    BENCHMARK(BM_LinearMap)->Apply(PacketArgs);
+
+
+    static void BM_LinearMap_char(benchmark::State &state)  // integer gain and offset over bit streams
+    {
+        const int iPacket = state.range(0);
+
+        std::vector<char> vIn = BitSignal(iPacket, 1);
+        std::vector<char> vOut(iPacket);
+
+        for(auto _ : state)
+        {
+            LinearMap<char>(vIn.data(), vOut.data(), iPacket, 3, 1);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<char>(state, iPacket);
+    }
+    BENCHMARK(BM_LinearMap_char)->Apply(PacketArgs);
+
+
+    static void BM_LinearMap_int(benchmark::State &state)  // integer gain and offset over counters
+    {
+        const int iPacket = state.range(0);
+
+        std::vector<int> vIn(iPacket);
+        for(int index = 0; index < iPacket; index++) vIn[index] = index;  // ramp
+        std::vector<int> vOut(iPacket);
+
+        for(auto _ : state)
+        {
+            LinearMap<int>(vIn.data(), vOut.data(), iPacket, 3, 1);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<int>(state, iPacket);
+    }
+    BENCHMARK(BM_LinearMap_int)->Apply(PacketArgs);
+
+
+    static void BM_PackBits(benchmark::State &state)  // Pack_Bits; 'iPacket' samples in, iPacket/(8*iSpB) bytes out
+    {
+        const int iPacket = state.range(0);
+        const int iSpB = state.range(1);
+        const int iBytes = iPacket/(8*iSpB);
+
+        std::vector<char> vIn = BitSignal(iPacket, iSpB);
+        std::vector<unsigned char> vOut(iBytes + 1);
+
+        for(auto _ : state)
+        {
+            PackBits(vIn.data(), vOut.data(), iBytes, iSpB);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<char>(state, iPacket);
+    }
+    BENCHMARK(BM_PackBits)->Apply(PacketSpBArgs);
+
+
+    static void BM_UnpackBits(benchmark::State &state)  // Unpack_Bits; iPacket/(8*iSpB) bytes in, 'iPacket' samples out
+    {
+        const int iPacket = state.range(0);
+        const int iSpB = state.range(1);
+        const int iBytes = iPacket/(8*iSpB);
+
+        std::vector<unsigned char> vIn(iBytes + 1, 0xA5);
+        std::vector<char> vOut(iPacket);
+
+        for(auto _ : state)
+        {
+            UnpackBits(vIn.data(), vOut.data(), iBytes, iSpB);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<char>(state, iPacket);
+    }
+    BENCHMARK(BM_UnpackBits)->Apply(PacketSpBArgs);
+
+
+    static void BM_Crc32(benchmark::State &state)  // Add_Header/Remove_Header integrity field; CRC-32 of a 'iPacket' sample payload
+    {
+        const int iPacket = state.range(0);
+
+        std::vector<char> vIn = BitSignal(iPacket, 1);
+
+        for(auto _ : state)
+        {
+            uint32_t uCrc = Crc32(vIn.data(), iPacket);
+            benchmark::DoNotOptimize(uCrc);
+        }
+        SetThroughput<char>(state, iPacket);
+    }
+    BENCHMARK(BM_Crc32)->Apply(PacketArgs);
+
+
+    // packet sizes 1k .. 100k by preamble lengths 32 .. 2048 samples; direct, FFT and the automatic choice
+    static void CorrelatorArgs(benchmark::internal::Benchmark *ptr_Bench)
+    {
+        ptr_Bench->ArgNames({"packet", "pattern", "fft"});
+        for(int iPacket = 10*BENCH_MIN_PACKET; iPacket <= BENCH_MAX_PACKET; iPacket *= BENCH_PACKET_MULT)  // go through packet sizes
+        {
+            for(int iPattern = BENCH_PATTERN_BITS; iPattern <= 64*BENCH_PATTERN_BITS; iPattern *= 4)  // go through preamble lengths
+            {
+                ptr_Bench->Args({iPacket, iPattern, 0});
+                ptr_Bench->Args({iPacket, iPattern, 1});
+                ptr_Bench->Args({iPacket, iPattern, 2});
+            }
+        }
+    }
+
+
+    static void BM_FloatCorrelator(benchmark::State &state)  // Preamble_Sync; correlation of a noisy signal with the resampled preamble
+    {
+        const int iPacket = state.range(0);
+        const int iPatternLen = state.range(1);
+
+        std::vector<float> vIn = NoisySignal(iPacket + iPatternLen - 1, 1);
+        std::vector<float> vPattern(vIn.begin(), vIn.begin() + iPatternLen);
+        std::vector<float> vOut(iPacket);
+
+        Float_Correlator Correlator;
+        Correlator.set_Pattern(vPattern.data(), iPatternLen);
+        if(state.range(2) != 2)  // 2 keeps the choice of set_Pattern
+        {
+            Correlator.set_Fft(state.range(2) != 0);
+        }
+        for(auto _ : state)
+        {
+            Correlator.correlate(vIn.data(), vOut.data(), iPacket);
+            benchmark::DoNotOptimize(vOut.data());
+        }
+        SetThroughput<float>(state, iPacket);
+    }
+    BENCHMARK(BM_FloatCorrelator)->Apply(CorrelatorArgs);
+
+  } // namespace Comm_Kernels
+} // namespace gr
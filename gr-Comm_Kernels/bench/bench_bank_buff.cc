@@ -0,0 +1,78 @@
+// micro-benchmarks of the bank buffer; one slot holds one packet
+
+#include "bench_args.h"
+
+#include <vector>
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    static void BM_BankBuff_PushPop(benchmark::State &state)  // steady state of a half full bank; one push and one pop per packet
+    {
+        const int iPacket = state.range(0);
+
+        Bank_Buff<char> BankBuff(iPacket);
+        std::vector<char> vIn(iPacket, VAL_1);
+        std::vector<char> vOut(iPacket);
+        for(int index = 0; index < BankBuff.get_BankSize()/2; ++index)  // fill half of the bank
+        {
+            BankBuff.push(vIn.data());
+        }
+
+        for(auto _ : state)
+        {
+            BankBuff.push(vIn.data());
+            int index_s = BankBuff.pop(vOut.data());
+            benchmark::DoNotOptimize(index_s);
+        }
+        SetThroughput<char>(state, 2*int64_t(iPacket));
+    }
+    BENCHMARK(BM_BankBuff_PushPop)->Apply(PacketArgs);
+
+
+    static void BM_BankBuff_PushFull(benchmark::State &state)  // push into a full bank; the oldest slot is overwritten
+    {
+        const int iPacket = state.range(0);
+
+        Bank_Buff<char> BankBuff(iPacket);
+        std::vector<char> vIn(iPacket, VAL_1);
+        for(int index = 0; index < BankBuff.get_BankSize(); ++index)  // fill the bank
+        {
+            BankBuff.push(vIn.data());
+        }
+
+        for(auto _ : state)
+        {
+            BankBuff.push(vIn.data());
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<char>(state, iPacket);
+    }
+    BENCHMARK(BM_BankBuff_PushFull)->Apply(PacketArgs);
+
+
+    static void BM_BankBuff_PushPopDeep(benchmark::State &state)  // steady state of a half full bank of BENCH_BANK_DEPTH packets; costs as a shallow one
+    {
+        const int iPacket = state.range(0);
+
+        Bank_Buff<char> BankBuff(iPacket, BENCH_BANK_DEPTH);
+        std::vector<char> vIn(iPacket, VAL_1);
+        std::vector<char> vOut(iPacket);
+        for(int index = 0; index < BankBuff.get_BankSize()/2; ++index)  // fill half of the bank
+        {
+            BankBuff.push(vIn.data());
+        }
+
+        for(auto _ : state)
+        {
+            BankBuff.push(vIn.data());
+            int index_s = BankBuff.pop(vOut.data());
+            benchmark::DoNotOptimize(index_s);
+        }
+        SetThroughput<char>(state, 2*int64_t(iPacket));
+    }
+    BENCHMARK(BM_BankBuff_PushPopDeep)->Arg(100)->Arg(1000)->ArgName("packet");
+
+  } // namespace Comm_Kernels
+} // namespace gr
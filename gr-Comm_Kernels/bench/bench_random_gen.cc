@@ -0,0 +1,116 @@
+// micro-benchmarks of the random number generators, in bulk and one number at a time
+
+#include "bench_args.h"
+
+#include <vector>
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    static void BM_Philox_Uniform(benchmark::State &state)  // raw engine output
+    {
+        const int iPacket = state.range(0);
+
+        Philox_Rand_Eng RandEng(BENCH_SEED);
+        std::vector<float> vOut(iPacket);
+
+        for(auto _ : state)
+        {
+            RandEng.fill_uniform(vOut.data(), iPacket);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<float>(state, iPacket);
+    }
+    BENCHMARK(BM_Philox_Uniform)->Apply(PacketArgs);
+
+
+    static void BM_NormDistArray(benchmark::State &state)  // noise of the channel blocks
+    {
+        const int iPacket = state.range(0);
+
+        Norm_Rand_Gen RandGen(BENCH_SEED);
+        std::vector<float> vOut(iPacket);
+
+        for(auto _ : state)
+        {
+            RandGen.NormDistArray(vOut.data(), iPacket);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<float>(state, iPacket);
+    }
+    BENCHMARK(BM_NormDistArray)->Apply(PacketArgs);
+
+
+    static void BM_LogNormalDistArray(benchmark::State &state)  // weak turbulence channel coefficients
+    {
+        const int iPacket = state.range(0);
+
+        Norm_Rand_Gen RandGen(BENCH_SEED);
+        std::vector<float> vOut(iPacket);
+
+        for(auto _ : state)
+        {
+            RandGen.LogNormalDistArray(vOut.data(), 1.0, 0.1, iPacket);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<float>(state, iPacket);
+    }
+    BENCHMARK(BM_LogNormalDistArray)->Apply(PacketArgs);
+
+
+    static void BM_RayleighDistArray(benchmark::State &state)  // strong turbulence channel coefficients
+    {
+        const int iPacket = state.range(0);
+
+        Norm_Rand_Gen RandGen(BENCH_SEED);
+        std::vector<float> vOut(iPacket);
+
+        for(auto _ : state)
+        {
+            RandGen.RayleighDistArray(vOut.data(), 1.0, 1.0, iPacket);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<float>(state, iPacket);
+    }
+    BENCHMARK(BM_RayleighDistArray)->Apply(PacketArgs);
+
+
+    static void BM_UniformBinary(benchmark::State &state)  // random bits of Source_BV
+    {
+        const int iPacket = state.range(0);
+
+        Norm_Rand_Gen RandGen(BENCH_SEED);
+        std::vector<char> vOut(iPacket);
+
+        for(auto _ : state)
+        {
+            RandGen.UniformBinary(vOut.data(), iPacket);
+            benchmark::ClobberMemory();
+        }
+        SetThroughput<char>(state, iPacket);
+    }
+    BENCHMARK(BM_UniformBinary)->Apply(PacketArgs);
+
+
+    static void BM_GaussNormNumGen(benchmark::State &state)  // one number per call, as the older blocks draw them
+    {
+        const int iPacket = state.range(0);
+
+        Norm_Rand_Gen RandGen(BENCH_SEED);
+
+        for(auto _ : state)
+        {
+            float fSum = 0.0;
+            for(int index = 0; index < iPacket; ++index)  // go through the packet
+            {
+                fSum += RandGen.GaussNormNumGen();
+            }
+            benchmark::DoNotOptimize(fSum);
+        }
+        SetThroughput<float>(state, iPacket);
+    }
+    BENCHMARK(BM_GaussNormNumGen)->Apply(PacketArgs);
+
+  } // namespace Comm_Kernels
+} // namespace gr
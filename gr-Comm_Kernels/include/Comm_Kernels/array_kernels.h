@@ -0,0 +1,1200 @@
+#ifndef INCLUDED_COMM_KERNELS_ARRAY_KERNELS_H
+#define INCLUDED_COMM_KERNELS_ARRAY_KERNELS_H
+
+
+#include <cmath>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_DEBUG_MODE_) || defined(_ARRAY_MODE_)
+#include <iostream>
+#endif
+
+#include "defaults.h"
+#include "macros.h"
+#include "simd_dispatch.h"
+
+#ifdef _VOLK_KERNELS_
+#include <volk/volk.h>
+#endif
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+
+    template <class T>
+    void DisplayArray(const T *ptr_inArray, const int iArrayLen = 0, const int iOffset = 0);  // display the array items
+
+    template <class T>
+    float DC_Value(const T *ptr_inArray, const int iArrayLen = 0, const int iOffset = 0);  // find DC value of the signal
+
+    template <class T>
+    int FindFirstEdge(const T *ptr_inArray, const int iArrayLen = 0, const int iOffset = 0, const float fThresh = 0, const int edgeFindingRange = 2);  // find the first edge index
+
+    template <class T>
+    int FindFirstRisingEdge(const T *ptr_inArray, const int iArrayLen = 0, const int iOffset = 0, const float fThresh = 0, const int edgeFindingRange = 2);  // find the first rising edge index
+
+    template <class T>
+    int FindFirstFallingEdge(const T *ptr_inArray, const int iArrayLen = 0, const int iOffset = 0, const float fThresh = 0, const int edgeFindingRange = 2);  // find the first falling edge index
+
+    template <class T>
+    void CalcMeanVar(const T *ptr_inArray, const int iArrayLen = 0, const int iOffset = 0, const float fThresh = 0, const int iSpS = 1, int *ptr_iLen = nullptr, float *prt_fRes = nullptr);  // calculate mean and variance at levels 0 and 1
+
+    template <class T>
+    void FillArray(T *ptr_array, const T value = 0, const int iArrayLen = 0);  // fill the array with given value
+
+    template <class T>
+    void InterpArray(const T *ptr_inArray, T *ptr_outArray, const int iArrayLen = 0, const int iInterRatio = 1);  // interpolate of input array
+
+    template <class T>
+    void CopyArrays(const T *ptr_srcArray, T *ptr_destArray, const int iArrayLen = 0);  // copies 'iArrayLen' contents of 'ptr_srcArray' to 'ptr_destArray'
+
+    template <class T>
+    void Num2Bits(const T inArg, char *ptr_destArray, const int iSeqLen = 8);  // converts input number to equivalent bit sequence
+
+    template <class T>
+    void AddArrays(const T *ptr_array_1, const T *ptr_array_2, T *ptr_fOutArray, const int iArrayLen = 0);  // copies 'iArrayLen' contents of 'ptr_array_1' + 'ptr_array_2' to 'ptr_destArray'
+
+    template <class T>
+    void SubtractArrays(const T *ptr_array_1, const T *ptr_array_2, T *ptr_fOutArray, const int iArrayLen = 0);  // copies 'iArrayLen' contents of 'ptr_array_1' - 'ptr_array_2' to 'ptr_destArray'
+
+    template <class T>
+    void LinearMap(const T *ptr_inArray, T *ptr_outArray, const int iArrayLen = 0, const T fA = 1, const T fB = 0);  // apply linear map to input array
+
+    template <class T>
+    int MatchBitSeq(const T *ptr_inArray, const T *ptr_inPattern, T *ptr_auxPattern = nullptr, const int iArrayLen = 0, const int iPatternLen = 0);  // find index of first matching of pattern and the input array
+
+    template <class T>
+    void DecimatArray(const T *ptr_inArray, T *ptr_outArray, const int iArrayLen = 0, const  int iDecimatRatio = 1);  // decimation of input array
+
+    template <class T>
+    T Bits2Num(const char *ptr_inArray, const int iSeqLen = 8);  // converts input bit sequence to equivalent number
+
+    template <class T, class U, class V>
+    T ApplySum(const U *ptr_inArray, V (*f)(V), const int iArrayLen = 0);  // apply given function to each element in the array and then sum them
+
+    template <class T>
+    T Sum(const T *ptr_inArray, const int iArrayLen = 0);  // returns summation of array elements
+
+    template <class T, class U>
+    void Apply(const T *ptr_inArray, T *ptr_outArray, U (*f)(U), const int iArrayLen = 0);  // returns summation of array elements
+
+    template <class T>
+    float WeightAverage(const T *ptr_inArray, const float *prt_fWeights, const int iCentreIndex = 0, const int iArrayLen = 0, const int iWeightLen = 0);  // returns weighted average of input
+
+
+    template <class T>
+    void DisplayArray(const T *ptr_inArray, const int iArrayLen, const int iOffset)  // display the array items
+    {
+        #ifdef _ARRAY_MODE_
+        std::cout << "[";
+        for(int index = 0; index < iArrayLen; index++)  // go through the samples within the window
+        {
+            if(sizeof(T) == sizeof(char))  // if tempelate is 'character'
+            {
+                std::cout << CPRN(ptr_inArray[index + iOffset]) << ", ";
+            }
+            else  //otherwise
+            {
+                std::cout << ptr_inArray[index + iOffset] << ", ";
+            }            
+        }
+        std::cout << "]";
+        #endif
+    }
+
+
+    template <class T>
+    float DC_Value(const T *ptr_inArray, const int iArrayLen, const int iOffset)  // find DC value of the signal
+    {
+        float DC = 0.0;  // inital DC value
+
+        for(int index = 0; index < iArrayLen; index++)  // go through the samples within the window
+        {
+            DC += ptr_inArray[iOffset + index];  // update summation
+        }
+        return DC / iArrayLen;  // return DC value
+    }
+
+
+    template <class T>
+    int FindFirstEdge(const T *ptr_inArray, const int iArrayLen, const int iOffset, const float fThresh, const int edgeFindingRange)  // find the first edge index
+    {
+        int firstEdge = 0;  // initial edge index
+        for(int index = 0; index < iArrayLen - (edgeFindingRange - 1); index++)  // go through the samples within the window
+        {
+            if(((ptr_inArray[iOffset + index] < fThresh) &&
+                (ptr_inArray[iOffset + index + (edgeFindingRange - 1)] >= fThresh)) ||
+                ((ptr_inArray[iOffset + index] > fThresh) &&
+                (ptr_inArray[iOffset + index + (edgeFindingRange - 1)] <= fThresh)))  // if it is an edge
+            {
+            firstEdge = index++;  // update edge index
+            break;  // leave the loop
+            }
+        }
+
+        return firstEdge;  // return index of first edge
+    }
+
+
+    template <class T>
+    int FindFirstRisingEdge(const T *ptr_inArray, const int iArrayLen, const int iOffset, const float fThresh, const int edgeFindingRange)  // find the first rising edge index
+    {
+        int firstRisingEdge = 0;  // initial rising edge index
+        for(int index = 0; index < iArrayLen - (edgeFindingRange - 1); index++)  // go through the samples within the window
+        {
+            if((ptr_inArray[iOffset + index] < fThresh) &&
+            (ptr_inArray[iOffset + index + (edgeFindingRange - 1)] >= fThresh))  // if it is a rising edge
+            {
+            firstRisingEdge = index++;  // update rising edge index
+            break;  // leave the loop
+            }
+        }
+
+        return firstRisingEdge;  // return index of first rising edge
+    }
+
+
+    template <class T>
+    int FindFirstFallingEdge(const T *ptr_inArray, const int iArrayLen, const int iOffset, const float fThresh, const int edgeFindingRange)  // find the first falling edge index
+    {
+        int firstFallingEdge = 0;  // initial falling edge index
+        for(int index = 0; index < iArrayLen - (edgeFindingRange - 1); index++)  // go through the samples within the window
+        {
+            if((ptr_inArray[iOffset + index] > fThresh) &&
+            (ptr_inArray[iOffset + index + (edgeFindingRange - 1)] <= fThresh))  // if it is a falling edge
+            {
+            firstFallingEdge = index++;  // update falling edge index
+            break;  // leave the loop
+            }
+        }
+
+        return firstFallingEdge;  // return index of first falling edge
+    }
+
+
+    template <class T>
+    void CalcMeanVar(const T *ptr_inArray, const int iArrayLen, const int iOffset, const float fThresh, const int iSpS, int *ptr_iLen, float *prt_fRes)  // calculate mean and variance at levels 0 and 1
+    {
+        float x2_0 = 0.0;  // noise variance for level 0 dummy variable
+        float x2_1 = 0.0;  // noise variance for level 1 dummy variable
+
+        float x_0 = 0.0;  // mean value for level 0 dummy variable
+        float x_1 = 0.0;  // mean value for level 1 dummy variable
+
+        int n_0 = 0;  // number of level 0
+        int n_1 = 0;  // number of level 1
+
+        for(int index = 0; index < iArrayLen; index += iSpS)  // go through the samples at the centre of each bit  within the window
+        {
+            if(ptr_inArray[iOffset + index] < fThresh)  // if it is level 0
+            {
+            ++n_0;  // update total number of level 0
+            x_0 += ptr_inArray[iOffset + index];  // update mean value
+            x2_0 += POW2(ptr_inArray[iOffset + index]);  // update variance
+            } 
+            else  // if it is a level 1
+            {
+            ++n_1;  // update total number of level 0
+            x_1 += ptr_inArray[iOffset + index];  // update mean value
+            x2_1 += POW2(ptr_inArray[iOffset + index]);  // update variance
+            }
+        }
+
+        float mean_0 = x_0/n_0;  // calculate mean value of level 0
+        float mean_1 = x_1/n_1;  // calculate mean value of level 1
+
+        float var_0 = x2_0/(n_0 - 1) - POW2(mean_0)*n_0/(n_0 - 1);  // calculate variance value of level 0
+        float var_1 = x2_1/(n_1 - 1) - POW2(mean_1)*n_1/(n_1 - 1);  // calculate variance value of level 1
+
+        #ifdef _DEBUG_MODE_
+        std::cout << "CalcMeanVar: mean_0 = " << mean_0 << std::endl;
+        std::cout << "CalcMeanVar: mean_1 = " << mean_1 << std::endl;
+        std::cout << "CalcMeanVar: var_0:1 = " << x2_0/(n_0 - 1) << std::endl;
+        std::cout << "CalcMeanVar: var_0:2 = " << POW2(mean_0)*n_0 << std::endl;
+        std::cout << "CalcMeanVar: var_1:1 = " << x2_1/(n_1 - 1) << std::endl;
+        std::cout << "CalcMeanVar: var_1:2 = " << POW2(mean_1)*n_1 << std::endl;
+        #endif
+
+        // update length array
+        ptr_iLen[0] = n_0;
+        ptr_iLen[1] = n_1;
+
+        // update result array
+        prt_fRes[0] = mean_0;
+        prt_fRes[1] = mean_1;
+        prt_fRes[2] = var_0;
+        prt_fRes[3] = var_1;
+
+        return;
+    }
+
+
+    template <class T>
+    void FillArray(T *ptr_array, T value, const int iArrayLen)  // fill the array with given value
+    {
+        for(int index = 0; index < iArrayLen; index++)  // go through the array elements
+        {
+            ptr_array[index] = value;  // update array element
+        }
+    }
+
+
+    template <class T>
+    void InterpArray(const T *ptr_inArray, T *ptr_outArray, const int iArrayLen, const int iInterRatio)  // interpolate input array
+    {
+        for(int index = 0; index < iArrayLen; ++index)  // go through input items
+        {
+            FillArray<T>((ptr_outArray + index*iInterRatio), ptr_inArray[index], iInterRatio);
+        }
+    }
+
+    template <class T>
+    void CopyArrays(const T *ptr_srcArray, T *ptr_destArray, const int iArrayLen)  // copies 'iArrayLen' contents of 'ptr_srcArray' to 'ptr_destArray'
+    {
+        for(int index = 0; index < iArrayLen; index++)  // go through the array elements
+        {
+            ptr_destArray[index] = ptr_srcArray[index];  // update destination array element with source array element
+        }   
+    }
+
+
+    template <class T>
+    void Num2Bits(const T inArg, char *ptr_destArray, const int iSeqLen)  // converts input number to equivalent bit sequence
+    {
+        for(int index_b = 0; index_b < iSeqLen; ++index_b)  // go through the letter bits
+        {
+            ptr_destArray[index_b] = (inArg >> index_b) & 1;  // extract bit from the number; also for types wider than int
+            
+        }
+    }
+
+
+    template <class T>
+    void AddArrays(const T *ptr_array_1, const T *ptr_array_2, T *ptr_outArray, const int iArrayLen)  // copies 'iArrayLen' contents of 'ptr_array_1' + 'ptr_array_2' to 'ptr_destArray'
+    {
+        for(int index = 0; index < iArrayLen; index++)  // go through the array elements
+        {
+            ptr_outArray[index] = ptr_array_1[index] + ptr_array_2[index];  // update array element
+        }
+    }
+
+
+    template <class T>
+    void SubtractArrays(const T *ptr_array_1, const T *ptr_array_2, T *ptr_outArray, const int iArrayLen)  // copies 'iArrayLen' contents of 'ptr_array_1' - 'ptr_array_2' to 'ptr_destArray'
+    {
+        for(int index = 0; index < iArrayLen; index++)  // go through the array elements
+        {
+            ptr_outArray[index] = ptr_array_1[index] - ptr_array_2[index];  // update array element
+        }
+    }
+
+
+    template <class T>
+    void LinearMap(const T *ptr_inArray, T *ptr_outArray, const int iArrayLen, const T fA, const T fB)  // apply linear map to input array
+    {
+        for(int index = 0; index < iArrayLen; index++)  // go through the array elements
+        {
+            ptr_outArray[index] = (T)(ptr_inArray[index]*fA + fB);  // update array element
+        }
+    }
+
+
+    template <class T>
+    int MatchBitSeq(const T *ptr_inArray, const T *ptr_inPattern, T *ptr_auxPattern, const int iArrayLen, const int iPatternLen)  // find index of first matching of pattern and the input array
+    {
+        bool bMemAlloc = false;  // memory flag
+        if (ptr_auxPattern == nullptr)  // if no auxillary memory is provided
+        {
+            ptr_auxPattern = new T [iPatternLen];  // allocate the memory
+            bMemAlloc = true;  // set the memory flag
+        }
+
+        int test;
+        int index_Match = -1;
+        int index_Min = -1;
+        int Min_Val = INT_MAX;  // initial index of minimum value
+        
+        for(int index_T = 0; index_T < (iArrayLen - iPatternLen); ++index_T)  // go through available element in the input array
+        {
+            SubtractArrays(ptr_inPattern, (ptr_inArray + index_T), ptr_auxPattern, iPatternLen);  // calculate the difference
+
+            test = ApplySum<int, char, int>(ptr_auxPattern, abs, iPatternLen);//0;  // initialise the test
+
+            if(test == 0)  // if it is a match
+            {
+                index_Match = index_T;
+                break;
+            }
+
+            if(test < Min_Val)  // if the difference is minimum
+            {
+                index_Min = index_Match;  // update the index of minimum
+                Min_Val = test;  // update minimum value
+            }
+        }
+
+        Min_Val = (Min_Val <= MIN_MATCH_VAL*(iArrayLen - iPatternLen)) ? -1 : Min_Val;  // make sure minimum match is met
+
+        if (bMemAlloc == true)  // if no axillary memory is provided
+        {
+            delete[] ptr_auxPattern;  // release the memory
+            ptr_auxPattern = nullptr;  // label the array as empty
+        }
+
+        return (index_Match == -1) ? index_Min : index_Match;  // return the matching index or index of minimum match
+    }
+
+
+    template <class T>
+    void DecimatArray(const T *ptr_inArray, T *ptr_outArray, const int iArrayLen, const int iDecimatRatio)  // decimation of input array
+    {
+        int index_O = 0;  // ouput array index
+        for(int index = 0; index < iArrayLen; index += iDecimatRatio)  // go through input items
+        {
+            ptr_outArray[index_O++] = ptr_inArray[index];  // update output array
+            
+        }
+    }
+
+
+    template <class T>
+    T Bits2Num(const char *ptr_inArray, const int iSeqLen)  // converts input bit sequence to equivalent number
+    {
+        T res = 0;  // initialise the number
+
+        for(int index_b = 0; index_b < iSeqLen; ++index_b)  // go through the letter bits
+        {
+            res += T(ptr_inArray[index_b]) << index_b;  // convert bit to equivalent decimal number; also for types wider than int
+            
+        }
+        
+        return res;  // return the convertion result
+    }
+
+
+    template <class T, class U, class V>
+    T ApplySum(const U *ptr_inArray, V (*f)(V), const int iArrayLen)  // apply given function to each element in the array and then sum them
+    {
+        T res = 0;  // initialise the number
+
+        for(int index = 0; index < iArrayLen; ++index)  // go through the letter bits
+        {
+            res += (*f)(ptr_inArray[index]);  // apply the function and sum it up
+            
+        }
+        
+        return res;  // return the convertion result       
+    }
+
+
+    template <class T>
+    T Sum(const T *ptr_inArray, const int iArrayLen)  // returns summation of array elements
+    {
+        T res = 0;  // initialise the number
+
+        for(int index = 0; index < iArrayLen; ++index)  // go through the letter bits
+        {
+            res += ptr_inArray[index];  // apply the function and sum it up
+            
+        }
+        
+        return res;  // return the convertion result 
+    }
+
+
+    template <class T, class U>
+    void Apply(const T *ptr_inArray, T *ptr_outArray, U (*f)(U), const int iArrayLen)  // returns summation of array elements
+    {
+        for(int index = 0; index < iArrayLen; ++index)  // go through the letter bits
+        {
+            ptr_outArray[index] = (*f)(ptr_inArray[index]);  // apply the function and sum it up
+            
+        }
+    }
+
+
+    template <class T>
+    float WeightAverage(const T *ptr_inArray, const float *prt_fWeights, const int iCentreIndex, const int iArrayLen, const int iWeightLen)  // returns weighted average of input
+    {
+        int Index_L = 0;  // index of input array; left side
+        int Index_R = 0;  // index of input array; right side
+        float sum = ptr_inArray[iCentreIndex] * prt_fWeights[0];  // calculate central value
+        float weight = prt_fWeights[0];  // update weight value
+        #ifdef _DEBUG_MODE_
+        std::cout << "----------------------------------------------------------" << std::endl;
+        std::cout << "WeightAverage: Index " << 0 << " out of " << iWeightLen - 1 << std::endl;
+        std::cout << "WeightAverage: Central index = " << iCentreIndex << std::endl;
+        std::cout << "WeightAverage: Central weight = " << prt_fWeights[0] << std::endl;
+        #endif
+
+        for(int index = 1; index < iWeightLen; ++index)  // go through left and right sides elements
+        {
+            #ifdef _DEBUG_MODE_
+            std::cout << "WeightAverage: Index " << index << " out of " << iWeightLen - 1 << std::endl;
+            #endif
+                    
+            Index_L = iCentreIndex - index;  // update index of input array; left side
+            if( (Index_L >= 0) )  // if it's a valid index
+            {
+                #ifdef _DEBUG_MODE_
+                std::cout << "WeightAverage: Left index = " << Index_L << std::endl;
+                std::cout << "WeightAverage: Left weight = " << prt_fWeights[index] << std::endl;
+                #endif
+                sum += ptr_inArray[Index_L] * prt_fWeights[index];  // update central value
+                weight += prt_fWeights[index];  // update weight value
+            }
+
+            Index_R = iCentreIndex + index;  // update index of input array; right side
+             if( (Index_R < iArrayLen) )  // if it's a no valid index
+            {
+                #ifdef _DEBUG_MODE_
+                std::cout << "WeightAverage: Right index = " << Index_R << std::endl;
+                std::cout << "WeightAverage: Right weight = " << prt_fWeights[index] << std::endl;
+                #endif
+                sum += ptr_inArray[Index_R] * prt_fWeights[index];  // update central value
+                weight += prt_fWeights[index];  // update weight value
+            }
+        }
+
+        return (weight != 0.0) ? sum/weight : 0.0;
+    }
+
+
+    #ifndef _GENERIC_KERNELS_
+    // vector kernels of the float and char specialisations below; each one runs whole vectors only
+    // and returns the number of elements it has done, the caller finishes the partial vector
+    #ifdef _SIMD_X86_
+    // SSE2 kernels; 4 floats or 16 chars per vector
+    __attribute__((target("sse2"))) inline int FillArray_SSE2(float *ptr_array, const float value, const int iArrayLen)
+    {
+        int index = 0;
+        __m128 vValue = _mm_set1_ps(value);
+        for(; index + 4 <= iArrayLen; index += 4)  // go through all vectors
+        {
+            _mm_storeu_ps(ptr_array + index, vValue);
+        }
+        return index;
+    }
+
+
+    __attribute__((target("sse2"))) inline int AddArrays_SSE2(const float *ptr_array_1, const float *ptr_array_2, float *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 4 <= iArrayLen; index += 4)  // go through all vectors
+        {
+            _mm_storeu_ps(ptr_outArray + index, _mm_add_ps(_mm_loadu_ps(ptr_array_1 + index), _mm_loadu_ps(ptr_array_2 + index)));
+        }
+        return index;
+    }
+
+
+    __attribute__((target("sse2"))) inline int SubtractArrays_SSE2(const float *ptr_array_1, const float *ptr_array_2, float *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 4 <= iArrayLen; index += 4)  // go through all vectors
+        {
+            _mm_storeu_ps(ptr_outArray + index, _mm_sub_ps(_mm_loadu_ps(ptr_array_1 + index), _mm_loadu_ps(ptr_array_2 + index)));
+        }
+        return index;
+    }
+
+
+    __attribute__((target("sse2"))) inline int LinearMap_SSE2(const float *ptr_inArray, float *ptr_outArray, const int iArrayLen, const float fA, const float fB)
+    {
+        int index = 0;
+        __m128 vA = _mm_set1_ps(fA);
+        __m128 vB = _mm_set1_ps(fB);
+        for(; index + 4 <= iArrayLen; index += 4)  // go through all vectors
+        {
+            _mm_storeu_ps(ptr_outArray + index, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(ptr_inArray + index), vA), vB));
+        }
+        return index;
+    }
+
+
+    __attribute__((target("sse2"))) inline int AddArrays_SSE2(const char *ptr_array_1, const char *ptr_array_2, char *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 16 <= iArrayLen; index += 16)  // go through all vectors
+        {
+            __m128i vSum = _mm_add_epi8(_mm_loadu_si128((const __m128i *)(ptr_array_1 + index)), _mm_loadu_si128((const __m128i *)(ptr_array_2 + index)));
+            _mm_storeu_si128((__m128i *)(ptr_outArray + index), vSum);
+        }
+        return index;
+    }
+
+
+    __attribute__((target("sse2"))) inline int SubtractArrays_SSE2(const char *ptr_array_1, const char *ptr_array_2, char *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 16 <= iArrayLen; index += 16)  // go through all vectors
+        {
+            __m128i vDiff = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)(ptr_array_1 + index)), _mm_loadu_si128((const __m128i *)(ptr_array_2 + index)));
+            _mm_storeu_si128((__m128i *)(ptr_outArray + index), vDiff);
+        }
+        return index;
+    }
+
+
+    __attribute__((target("sse2"))) inline int LinearMap_SSE2(const char *ptr_inArray, char *ptr_outArray, const int iArrayLen, const char fA, const char fB)
+    {
+        int index = 0;
+        __m128i vA = _mm_set1_epi16((unsigned char)fA);
+        __m128i vB = _mm_set1_epi8(fB);
+        __m128i vMask = _mm_set1_epi16(0x00FF);
+        for(; index + 16 <= iArrayLen; index += 16)  // go through all vectors; no 8 bit multiply, so even and odd bytes go through 16 bit lanes
+        {
+            __m128i vIn = _mm_loadu_si128((const __m128i *)(ptr_inArray + index));
+            __m128i vEven = _mm_and_si128(_mm_mullo_epi16(vIn, vA), vMask);
+            __m128i vOdd = _mm_slli_epi16(_mm_mullo_epi16(_mm_srli_epi16(vIn, 8), vA), 8);
+            _mm_storeu_si128((__m128i *)(ptr_outArray + index), _mm_add_epi8(_mm_or_si128(vEven, vOdd), vB));
+        }
+        return index;
+    }
+
+
+    __attribute__((target("sse2"))) inline int LinearMap_SSE2(const int *ptr_inArray, int *ptr_outArray, const int iArrayLen, const int fA, const int fB)
+    {
+        int index = 0;
+        __m128i vA = _mm_set1_epi32(fA);
+        __m128i vB = _mm_set1_epi32(fB);
+        for(; index + 4 <= iArrayLen; index += 4)  // go through all vectors; no 32 bit low multiply before SSE4.1, so even and odd lanes go through 64 bit products
+        {
+            __m128i vIn = _mm_loadu_si128((const __m128i *)(ptr_inArray + index));
+            __m128i vEven = _mm_shuffle_epi32(_mm_mul_epu32(vIn, vA), _MM_SHUFFLE(0, 0, 2, 0));
+            __m128i vOdd = _mm_shuffle_epi32(_mm_mul_epu32(_mm_srli_epi64(vIn, 32), vA), _MM_SHUFFLE(0, 0, 2, 0));
+            _mm_storeu_si128((__m128i *)(ptr_outArray + index), _mm_add_epi32(_mm_unpacklo_epi32(vEven, vOdd), vB));
+        }
+        return index;
+    }
+
+
+    // AVX2 kernels; 8 floats or 32 chars per vector
+    __attribute__((target("avx2"))) inline int FillArray_AVX2(float *ptr_array, const float value, const int iArrayLen)
+    {
+        int index = 0;
+        __m256 vValue = _mm256_set1_ps(value);
+        for(; index + 8 <= iArrayLen; index += 8)  // go through all vectors
+        {
+            _mm256_storeu_ps(ptr_array + index, vValue);
+        }
+        return index;
+    }
+
+
+    __attribute__((target("avx2"))) inline int AddArrays_AVX2(const float *ptr_array_1, const float *ptr_array_2, float *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 8 <= iArrayLen; index += 8)  // go through all vectors
+        {
+            _mm256_storeu_ps(ptr_outArray + index, _mm256_add_ps(_mm256_loadu_ps(ptr_array_1 + index), _mm256_loadu_ps(ptr_array_2 + index)));
+        }
+        return index;
+    }
+
+
+    __attribute__((target("avx2"))) inline int SubtractArrays_AVX2(const float *ptr_array_1, const float *ptr_array_2, float *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 8 <= iArrayLen; index += 8)  // go through all vectors
+        {
+            _mm256_storeu_ps(ptr_outArray + index, _mm256_sub_ps(_mm256_loadu_ps(ptr_array_1 + index), _mm256_loadu_ps(ptr_array_2 + index)));
+        }
+        return index;
+    }
+
+
+    __attribute__((target("avx2,fma"))) inline int LinearMap_AVX2(const float *ptr_inArray, float *ptr_outArray, const int iArrayLen, const float fA, const float fB)
+    {
+        int index = 0;
+        __m256 vA = _mm256_set1_ps(fA);
+        __m256 vB = _mm256_set1_ps(fB);
+        for(; index + 8 <= iArrayLen; index += 8)  // go through all vectors
+        {
+            _mm256_storeu_ps(ptr_outArray + index, _mm256_fmadd_ps(_mm256_loadu_ps(ptr_inArray + index), vA, vB));
+        }
+        return index;
+    }
+
+
+    __attribute__((target("avx2"))) inline int DecimatArray_AVX2(const float *ptr_inArray, float *ptr_outArray, const int iOutLen, const int iDecimatRatio)
+    {
+        int index_O = 0;  // ouput array index
+        __m256i vOffset = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(iDecimatRatio));  // input offsets of a vector
+        for(; index_O + 8 <= iOutLen; index_O += 8)  // go through all output vectors
+        {
+            _mm256_storeu_ps(ptr_outArray + index_O, _mm256_i32gather_ps(ptr_inArray + index_O*iDecimatRatio, vOffset, 4));
+        }
+        return index_O;
+    }
+
+
+    __attribute__((target("avx2"))) inline int AddArrays_AVX2(const char *ptr_array_1, const char *ptr_array_2, char *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 32 <= iArrayLen; index += 32)  // go through all vectors
+        {
+            __m256i vSum = _mm256_add_epi8(_mm256_loadu_si256((const __m256i *)(ptr_array_1 + index)), _mm256_loadu_si256((const __m256i *)(ptr_array_2 + index)));
+            _mm256_storeu_si256((__m256i *)(ptr_outArray + index), vSum);
+        }
+        return index;
+    }
+
+
+    __attribute__((target("avx2"))) inline int SubtractArrays_AVX2(const char *ptr_array_1, const char *ptr_array_2, char *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 32 <= iArrayLen; index += 32)  // go through all vectors
+        {
+            __m256i vDiff = _mm256_sub_epi8(_mm256_loadu_si256((const __m256i *)(ptr_array_1 + index)), _mm256_loadu_si256((const __m256i *)(ptr_array_2 + index)));
+            _mm256_storeu_si256((__m256i *)(ptr_outArray + index), vDiff);
+        }
+        return index;
+    }
+
+
+    __attribute__((target("avx2"))) inline int LinearMap_AVX2(const char *ptr_inArray, char *ptr_outArray, const int iArrayLen, const char fA, const char fB)
+    {
+        int index = 0;
+        __m256i vA = _mm256_set1_epi16((unsigned char)fA);
+        __m256i vB = _mm256_set1_epi8(fB);
+        __m256i vMask = _mm256_set1_epi16(0x00FF);
+        for(; index + 32 <= iArrayLen; index += 32)  // go through all vectors; no 8 bit multiply, so even and odd bytes go through 16 bit lanes
+        {
+            __m256i vIn = _mm256_loadu_si256((const __m256i *)(ptr_inArray + index));
+            __m256i vEven = _mm256_and_si256(_mm256_mullo_epi16(vIn, vA), vMask);
+            __m256i vOdd = _mm256_slli_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(vIn, 8), vA), 8);
+            _mm256_storeu_si256((__m256i *)(ptr_outArray + index), _mm256_add_epi8(_mm256_or_si256(vEven, vOdd), vB));
+        }
+        return index;
+    }
+
+
+    __attribute__((target("avx2"))) inline int LinearMap_AVX2(const int *ptr_inArray, int *ptr_outArray, const int iArrayLen, const int fA, const int fB)
+    {
+        int index = 0;
+        __m256i vA = _mm256_set1_epi32(fA);
+        __m256i vB = _mm256_set1_epi32(fB);
+        for(; index + 8 <= iArrayLen; index += 8)  // go through all vectors
+        {
+            __m256i vIn = _mm256_loadu_si256((const __m256i *)(ptr_inArray + index));
+            _mm256_storeu_si256((__m256i *)(ptr_outArray + index), _mm256_add_epi32(_mm256_mullo_epi32(vIn, vA), vB));
+        }
+        return index;
+    }
+
+
+    // AVX-512F kernels; 16 floats per vector; byte arithmetic needs AVX-512BW, so chars use the AVX2 kernels
+    __attribute__((target("avx512f"))) inline int FillArray_AVX512(float *ptr_array, const float value, const int iArrayLen)
+    {
+        int index = 0;
+        __m512 vValue = _mm512_set1_ps(value);
+        for(; index + 16 <= iArrayLen; index += 16)  // go through all vectors
+        {
+            _mm512_storeu_ps(ptr_array + index, vValue);
+        }
+        return index;
+    }
+
+
+    __attribute__((target("avx512f"))) inline int AddArrays_AVX512(const float *ptr_array_1, const float *ptr_array_2, float *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 16 <= iArrayLen; index += 16)  // go through all vectors
+        {
+            _mm512_storeu_ps(ptr_outArray + index, _mm512_add_ps(_mm512_loadu_ps(ptr_array_1 + index), _mm512_loadu_ps(ptr_array_2 + index)));
+        }
+        return index;
+    }
+
+
+    __attribute__((target("avx512f"))) inline int SubtractArrays_AVX512(const float *ptr_array_1, const float *ptr_array_2, float *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 16 <= iArrayLen; index += 16)  // go through all vectors
+        {
+            _mm512_storeu_ps(ptr_outArray + index, _mm512_sub_ps(_mm512_loadu_ps(ptr_array_1 + index), _mm512_loadu_ps(ptr_array_2 + index)));
+        }
+        return index;
+    }
+
+
+    __attribute__((target("avx512f"))) inline int LinearMap_AVX512(const float *ptr_inArray, float *ptr_outArray, const int iArrayLen, const float fA, const float fB)
+    {
+        int index = 0;
+        __m512 vA = _mm512_set1_ps(fA);
+        __m512 vB = _mm512_set1_ps(fB);
+        for(; index + 16 <= iArrayLen; index += 16)  // go through all vectors
+        {
+            _mm512_storeu_ps(ptr_outArray + index, _mm512_fmadd_ps(_mm512_loadu_ps(ptr_inArray + index), vA, vB));
+        }
+        return index;
+    }
+
+
+    __attribute__((target("avx512f"))) inline int DecimatArray_AVX512(const float *ptr_inArray, float *ptr_outArray, const int iOutLen, const int iDecimatRatio)
+    {
+        int index_O = 0;  // ouput array index
+        __m512i vOffset = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                                             _mm512_set1_epi32(iDecimatRatio));  // input offsets of a vector
+        for(; index_O + 16 <= iOutLen; index_O += 16)  // go through all output vectors
+        {
+            _mm512_storeu_ps(ptr_outArray + index_O, _mm512_i32gather_ps(vOffset, ptr_inArray + index_O*iDecimatRatio, 4));
+        }
+        return index_O;
+    }
+    #endif
+
+
+    #ifdef _SIMD_NEON_
+    // AArch64 NEON kernels; 4 floats or 16 chars per vector
+    inline int FillArray_NEON(float *ptr_array, const float value, const int iArrayLen)
+    {
+        int index = 0;
+        float32x4_t vValue = vdupq_n_f32(value);
+        for(; index + 4 <= iArrayLen; index += 4)  // go through all vectors
+        {
+            vst1q_f32(ptr_array + index, vValue);
+        }
+        return index;
+    }
+
+
+    inline int AddArrays_NEON(const float *ptr_array_1, const float *ptr_array_2, float *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 4 <= iArrayLen; index += 4)  // go through all vectors
+        {
+            vst1q_f32(ptr_outArray + index, vaddq_f32(vld1q_f32(ptr_array_1 + index), vld1q_f32(ptr_array_2 + index)));
+        }
+        return index;
+    }
+
+
+    inline int SubtractArrays_NEON(const float *ptr_array_1, const float *ptr_array_2, float *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 4 <= iArrayLen; index += 4)  // go through all vectors
+        {
+            vst1q_f32(ptr_outArray + index, vsubq_f32(vld1q_f32(ptr_array_1 + index), vld1q_f32(ptr_array_2 + index)));
+        }
+        return index;
+    }
+
+
+    inline int LinearMap_NEON(const float *ptr_inArray, float *ptr_outArray, const int iArrayLen, const float fA, const float fB)
+    {
+        int index = 0;
+        float32x4_t vA = vdupq_n_f32(fA);
+        float32x4_t vB = vdupq_n_f32(fB);
+        for(; index + 4 <= iArrayLen; index += 4)  // go through all vectors
+        {
+            vst1q_f32(ptr_outArray + index, vfmaq_f32(vB, vld1q_f32(ptr_inArray + index), vA));
+        }
+        return index;
+    }
+
+
+    inline int AddArrays_NEON(const char *ptr_array_1, const char *ptr_array_2, char *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 16 <= iArrayLen; index += 16)  // go through all vectors; wrap-around arithmetic is the same for signed and unsigned chars
+        {
+            uint8x16_t vSum = vaddq_u8(vld1q_u8((const uint8_t *)(ptr_array_1 + index)), vld1q_u8((const uint8_t *)(ptr_array_2 + index)));
+            vst1q_u8((uint8_t *)(ptr_outArray + index), vSum);
+        }
+        return index;
+    }
+
+
+    inline int SubtractArrays_NEON(const char *ptr_array_1, const char *ptr_array_2, char *ptr_outArray, const int iArrayLen)
+    {
+        int index = 0;
+        for(; index + 16 <= iArrayLen; index += 16)  // go through all vectors; wrap-around arithmetic is the same for signed and unsigned chars
+        {
+            uint8x16_t vDiff = vsubq_u8(vld1q_u8((const uint8_t *)(ptr_array_1 + index)), vld1q_u8((const uint8_t *)(ptr_array_2 + index)));
+            vst1q_u8((uint8_t *)(ptr_outArray + index), vDiff);
+        }
+        return index;
+    }
+
+
+    inline int LinearMap_NEON(const char *ptr_inArray, char *ptr_outArray, const int iArrayLen, const char fA, const char fB)
+    {
+        int index = 0;
+        uint8x16_t vA = vdupq_n_u8((uint8_t)fA);
+        uint8x16_t vB = vdupq_n_u8((uint8_t)fB);
+        for(; index + 16 <= iArrayLen; index += 16)  // go through all vectors; wrap-around arithmetic is the same for signed and unsigned chars
+        {
+            vst1q_u8((uint8_t *)(ptr_outArray + index), vmlaq_u8(vB, vld1q_u8((const uint8_t *)(ptr_inArray + index)), vA));
+        }
+        return index;
+    }
+
+
+    inline int LinearMap_NEON(const int *ptr_inArray, int *ptr_outArray, const int iArrayLen, const int fA, const int fB)
+    {
+        int index = 0;
+        int32x4_t vA = vdupq_n_s32(fA);
+        int32x4_t vB = vdupq_n_s32(fB);
+        for(; index + 4 <= iArrayLen; index += 4)  // go through all vectors
+        {
+            vst1q_s32(ptr_outArray + index, vmlaq_s32(vB, vld1q_s32(ptr_inArray + index), vA));
+        }
+        return index;
+    }
+    #endif
+
+
+    // float, char and int specialisations; the vector kernel set is picked at run time by SIMD_Level(),
+    // VOLK is used where it has the kernel and the library was found at build time (_VOLK_KERNELS_)
+    template <>
+    inline void FillArray<float>(float *ptr_array, const float value, const int iArrayLen)  // fill the array with given value
+    {
+        if((iArrayLen > 0) && (value == 0.0f) && !std::signbit(value))  // all bytes are zero
+        {
+            std::memset(ptr_array, 0, iArrayLen*sizeof(float));
+            return;
+        }
+
+        int index = 0;  // elements done by the vector kernel
+        switch(SIMD_Level())
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512: index = FillArray_AVX512(ptr_array, value, iArrayLen); break;
+            case SIMD_AVX2: index = FillArray_AVX2(ptr_array, value, iArrayLen); break;
+            case SIMD_SSE2: index = FillArray_SSE2(ptr_array, value, iArrayLen); break;
+            #endif
+            #ifdef _SIMD_NEON_
+            case SIMD_NEON: index = FillArray_NEON(ptr_array, value, iArrayLen); break;
+            #endif
+            default: break;
+        }
+
+        for(; index < iArrayLen; index++)  // partial vector
+        {
+            ptr_array[index] = value;  // update array element
+        }
+    }
+
+
+    template <>
+    inline void FillArray<char>(char *ptr_array, const char value, const int iArrayLen)  // fill the array with given value
+    {
+        if(iArrayLen > 0)  // memset does not take null pointers
+        {
+            std::memset(ptr_array, value, iArrayLen);
+        }
+    }
+
+
+    template <>
+    inline void FillArray<int>(int *ptr_array, const int value, const int iArrayLen)  // fill the array with given value
+    {
+        if((iArrayLen > 0) && ((value == 0) || (value == -1)))  // all bytes are the same
+        {
+            std::memset(ptr_array, value & 0xFF, iArrayLen*sizeof(int));
+            return;
+        }
+
+        for(int index = 0; index < iArrayLen; index++)  // go through the array elements
+        {
+            ptr_array[index] = value;  // update array element
+        }
+    }
+
+
+    template <>
+    inline void CopyArrays<float>(const float *ptr_srcArray, float *ptr_destArray, const int iArrayLen)  // copies 'iArrayLen' contents of 'ptr_srcArray' to 'ptr_destArray'
+    {
+        if(iArrayLen > 0)  // memcpy does not take null pointers
+        {
+            std::memcpy(ptr_destArray, ptr_srcArray, iArrayLen*sizeof(float));
+        }
+    }
+
+
+    template <>
+    inline void CopyArrays<char>(const char *ptr_srcArray, char *ptr_destArray, const int iArrayLen)  // copies 'iArrayLen' contents of 'ptr_srcArray' to 'ptr_destArray'
+    {
+        if(iArrayLen > 0)  // memcpy does not take null pointers
+        {
+            std::memcpy(ptr_destArray, ptr_srcArray, iArrayLen);
+        }
+    }
+
+
+    template <>
+    inline void CopyArrays<int>(const int *ptr_srcArray, int *ptr_destArray, const int iArrayLen)  // copies 'iArrayLen' contents of 'ptr_srcArray' to 'ptr_destArray'
+    {
+        if(iArrayLen > 0)  // memcpy does not take null pointers
+        {
+            std::memcpy(ptr_destArray, ptr_srcArray, iArrayLen*sizeof(int));
+        }
+    }
+
+
+    template <>
+    inline void AddArrays<float>(const float *ptr_array_1, const float *ptr_array_2, float *ptr_outArray, const int iArrayLen)  // copies 'iArrayLen' contents of 'ptr_array_1' + 'ptr_array_2' to 'ptr_destArray'
+    {
+        #ifdef _VOLK_KERNELS_
+        if(iArrayLen > 0)  // nothing to do otherwise
+        {
+            volk_32f_x2_add_32f(ptr_outArray, ptr_array_1, ptr_array_2, (unsigned int)iArrayLen);
+        }
+        #else
+        int index = 0;  // elements done by the vector kernel
+        switch(SIMD_Level())
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512: index = AddArrays_AVX512(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            case SIMD_AVX2: index = AddArrays_AVX2(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            case SIMD_SSE2: index = AddArrays_SSE2(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            #endif
+            #ifdef _SIMD_NEON_
+            case SIMD_NEON: index = AddArrays_NEON(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            #endif
+            default: break;
+        }
+
+        for(; index < iArrayLen; index++)  // partial vector
+        {
+            ptr_outArray[index] = ptr_array_1[index] + ptr_array_2[index];  // update array element
+        }
+        #endif
+    }
+
+
+    template <>
+    inline void AddArrays<char>(const char *ptr_array_1, const char *ptr_array_2, char *ptr_outArray, const int iArrayLen)  // copies 'iArrayLen' contents of 'ptr_array_1' + 'ptr_array_2' to 'ptr_destArray'
+    {
+        int index = 0;  // elements done by the vector kernel
+        switch(SIMD_Level())
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512:
+            case SIMD_AVX2: index = AddArrays_AVX2(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            case SIMD_SSE2: index = AddArrays_SSE2(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            #endif
+            #ifdef _SIMD_NEON_
+            case SIMD_NEON: index = AddArrays_NEON(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            #endif
+            default: break;
+        }
+
+        for(; index < iArrayLen; index++)  // partial vector
+        {
+            ptr_outArray[index] = ptr_array_1[index] + ptr_array_2[index];  // update array element
+        }
+    }
+
+
+    template <>
+    inline void SubtractArrays<float>(const float *ptr_array_1, const float *ptr_array_2, float *ptr_outArray, const int iArrayLen)  // copies 'iArrayLen' contents of 'ptr_array_1' - 'ptr_array_2' to 'ptr_destArray'
+    {
+        #ifdef _VOLK_KERNELS_
+        if(iArrayLen > 0)  // nothing to do otherwise
+        {
+            volk_32f_x2_subtract_32f(ptr_outArray, ptr_array_1, ptr_array_2, (unsigned int)iArrayLen);
+        }
+        #else
+        int index = 0;  // elements done by the vector kernel
+        switch(SIMD_Level())
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512: index = SubtractArrays_AVX512(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            case SIMD_AVX2: index = SubtractArrays_AVX2(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            case SIMD_SSE2: index = SubtractArrays_SSE2(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            #endif
+            #ifdef _SIMD_NEON_
+            case SIMD_NEON: index = SubtractArrays_NEON(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            #endif
+            default: break;
+        }
+
+        for(; index < iArrayLen; index++)  // partial vector
+        {
+            ptr_outArray[index] = ptr_array_1[index] - ptr_array_2[index];  // update array element
+        }
+        #endif
+    }
+
+
+    template <>
+    inline void SubtractArrays<char>(const char *ptr_array_1, const char *ptr_array_2, char *ptr_outArray, const int iArrayLen)  // copies 'iArrayLen' contents of 'ptr_array_1' - 'ptr_array_2' to 'ptr_destArray'
+    {
+        int index = 0;  // elements done by the vector kernel
+        switch(SIMD_Level())
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512:
+            case SIMD_AVX2: index = SubtractArrays_AVX2(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            case SIMD_SSE2: index = SubtractArrays_SSE2(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            #endif
+            #ifdef _SIMD_NEON_
+            case SIMD_NEON: index = SubtractArrays_NEON(ptr_array_1, ptr_array_2, ptr_outArray, iArrayLen); break;
+            #endif
+            default: break;
+        }
+
+        for(; index < iArrayLen; index++)  // partial vector
+        {
+            ptr_outArray[index] = ptr_array_1[index] - ptr_array_2[index];  // update array element
+        }
+    }
+
+
+    inline void LinearMap_Level(const int iLevel, const float *ptr_inArray, float *ptr_outArray, const int iArrayLen, const float fA, const float fB)  // run the kernel of the given set; length is a multiple of its width
+    {
+        switch(iLevel)
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512: LinearMap_AVX512(ptr_inArray, ptr_outArray, iArrayLen, fA, fB); break;
+            case SIMD_AVX2: LinearMap_AVX2(ptr_inArray, ptr_outArray, iArrayLen, fA, fB); break;
+            case SIMD_SSE2: LinearMap_SSE2(ptr_inArray, ptr_outArray, iArrayLen, fA, fB); break;
+            #endif
+            #ifdef _SIMD_NEON_
+            case SIMD_NEON: LinearMap_NEON(ptr_inArray, ptr_outArray, iArrayLen, fA, fB); break;
+            #endif
+            default:
+            for(int index = 0; index < iArrayLen; index++)  // go through the array elements
+            {
+                ptr_outArray[index] = ptr_inArray[index]*fA + fB;  // update array element
+            }
+            break;
+        }
+    }
+
+
+    // the vector kernels fuse the multiply and the add, so the partial vector goes through
+    // the same kernel (padded); every element then gets the same rounding however the caller splits the array
+    template <>
+    inline void LinearMap<float>(const float *ptr_inArray, float *ptr_outArray, const int iArrayLen, const float fA, const float fB)  // apply linear map to input array
+    {
+        #ifdef _VOLK_KERNELS_
+        if(fB == 0.0f)  // pure gain (loss blocks); a single rounding, the same as the fused kernels
+        {
+            if(iArrayLen > 0)  // nothing to do otherwise
+            {
+                volk_32f_s32f_multiply_32f(ptr_outArray, ptr_inArray, fA, (unsigned int)iArrayLen);
+            }
+            return;
+        }
+        #endif
+
+        int iLevel = SIMD_Level();
+        int iWidth = SIMD_Width(iLevel);
+        int iBodyLen = iArrayLen - iArrayLen%iWidth;  // elements handled by whole vectors
+
+        LinearMap_Level(iLevel, ptr_inArray, ptr_outArray, iBodyLen, fA, fB);  // whole vectors
+
+        if(iBodyLen < iArrayLen)  // partial vector is left
+        {
+            float ary_fAuxIn[SIMD_MAX_WIDTH], ary_fAuxOut[SIMD_MAX_WIDTH];  // padded vectors
+
+            PadArray(ptr_inArray + iBodyLen, ary_fAuxIn, iArrayLen - iBodyLen, iWidth);
+            LinearMap_Level(iLevel, ary_fAuxIn, ary_fAuxOut, iWidth, fA, fB);
+            CopyArrays<float>(ary_fAuxOut, ptr_outArray + iBodyLen, iArrayLen - iBodyLen);
+        }
+    }
+
+
+    // integer maps wrap around like the generic loop, so the partial vector is finished element by element
+    template <>
+    inline void LinearMap<char>(const char *ptr_inArray, char *ptr_outArray, const int iArrayLen, const char fA, const char fB)  // apply linear map to input array
+    {
+        int index = 0;
+        switch(SIMD_Level())
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512:
+            case SIMD_AVX2: index = LinearMap_AVX2(ptr_inArray, ptr_outArray, iArrayLen, fA, fB); break;
+            case SIMD_SSE2: index = LinearMap_SSE2(ptr_inArray, ptr_outArray, iArrayLen, fA, fB); break;
+            #endif
+            #ifdef _SIMD_NEON_
+            case SIMD_NEON: index = LinearMap_NEON(ptr_inArray, ptr_outArray, iArrayLen, fA, fB); break;
+            #endif
+            default: break;
+        }
+
+        for(; index < iArrayLen; index++)  // partial vector
+        {
+            ptr_outArray[index] = (char)(ptr_inArray[index]*fA + fB);  // update array element
+        }
+    }
+
+
+    template <>
+    inline void LinearMap<int>(const int *ptr_inArray, int *ptr_outArray, const int iArrayLen, const int fA, const int fB)  // apply linear map to input array
+    {
+        int index = 0;
+        switch(SIMD_Level())
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512:
+            case SIMD_AVX2: index = LinearMap_AVX2(ptr_inArray, ptr_outArray, iArrayLen, fA, fB); break;
+            case SIMD_SSE2: index = LinearMap_SSE2(ptr_inArray, ptr_outArray, iArrayLen, fA, fB); break;
+            #endif
+            #ifdef _SIMD_NEON_
+            case SIMD_NEON: index = LinearMap_NEON(ptr_inArray, ptr_outArray, iArrayLen, fA, fB); break;
+            #endif
+            default: break;
+        }
+
+        for(; index < iArrayLen; index++)  // partial vector
+        {
+            ptr_outArray[index] = (int)((unsigned int)ptr_inArray[index]*(unsigned int)fA + (unsigned int)fB);  // update array element; wraps around like the vector lanes
+        }
+    }
+
+
+    template <>
+    inline void InterpArray<float>(const float *ptr_inArray, float *ptr_outArray, const int iArrayLen, const int iInterRatio)  // interpolate input array
+    {
+        if(iInterRatio >= SIMD_Width(SIMD_Level()))  // each run of repeated items fills at least one vector
+        {
+            for(int index = 0; index < iArrayLen; ++index)  // go through input items
+            {
+                FillArray<float>((ptr_outArray + index*iInterRatio), ptr_inArray[index], iInterRatio);
+            }
+            return;
+        }
+
+        for(int index = 0; index < iArrayLen; ++index)  // go through input items
+        {
+            for(int index_r = 0; index_r < iInterRatio; ++index_r)  // repeat the item
+            {
+                ptr_outArray[index*iInterRatio + index_r] = ptr_inArray[index];
+            }
+        }
+    }
+
+
+    template <>
+    inline void DecimatArray<float>(const float *ptr_inArray, float *ptr_outArray, const int iArrayLen, const int iDecimatRatio)  // decimation of input array
+    {
+        int iOutLen = (iArrayLen + iDecimatRatio - 1)/iDecimatRatio;  // number of output items
+        int index_O = 0;  // ouput array index; items done by the vector kernel
+        switch(SIMD_Level())
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512: index_O = DecimatArray_AVX512(ptr_inArray, ptr_outArray, iOutLen, iDecimatRatio); break;
+            case SIMD_AVX2: index_O = DecimatArray_AVX2(ptr_inArray, ptr_outArray, iOutLen, iDecimatRatio); break;
+            #endif
+            default: break;  // strided loads have no vector form in SSE2 and NEON
+        }
+
+        for(; index_O < iOutLen; ++index_O)  // partial vector
+        {
+            ptr_outArray[index_O] = ptr_inArray[index_O*iDecimatRatio];  // update output array
+        }
+    }
+    #endif
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_ARRAY_KERNELS_H */
@@ -0,0 +1,248 @@
+#ifndef INCLUDED_COMM_KERNELS_BANK_BUFF_H
+#define INCLUDED_COMM_KERNELS_BANK_BUFF_H
+
+// Bank buffer of packets: a ring of packet slots with head and tail indices, so push and pop cost one copy
+// whatever the depth. The ring length is the power of two not below the depth, and all slots are in one
+// allocation, each starting on a cache line; the bank holds up to 'depth' packets, the oldest one is
+// overwritten when a packet is pushed into a full bank.
+// The slots can also be taken by a key, the key modulo the ring length, for packets that leave in another
+// order than they came; store and fetch do not move the head and tail.
+
+
+#include <cstdint>
+
+#ifdef _DEBUG_MODE_
+#include <iostream>
+#endif
+
+#include "defaults.h"
+#include "array_kernels.h"
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // bank buffer class
+    template <class T>
+    class Bank_Buff
+    {
+        private:
+        int iSlotSize;  // bank buffer slot size
+        int iSlotStride;  // distance between slot starts; whole cache lines
+        int iBankSize;  // number of slots that can be taken
+        unsigned int uRingMask;  // ring length - 1; the ring length is a power of two
+        T *ptr_Store;  // memory of all slots
+        T *ptr_Slots;  // first slot; on a cache line
+        unsigned int uHead;  // slots pushed so far; the next slot to write, with the mask
+        unsigned int uTail;  // slots popped so far; the oldest slot, with the mask
+
+        void Allocate(void);  // get the slots memory for the slot size and depth
+        void Release(void);  // release the slots memory
+
+        public:
+        Bank_Buff();  // default constructor
+        Bank_Buff(const int size, const int depth = BUFF_SIZE);  // constructor
+        Bank_Buff(const Bank_Buff &) = delete;  // owns its memory; not copied
+        Bank_Buff &operator=(const Bank_Buff &) = delete;
+        ~Bank_Buff();  // destructor
+
+        void set_SlotSize(const int slotSize);  // setter: iSlotSize; empties the bank
+        int get_SlotSize(void)  // getter: iSlotSize
+        {
+            return iSlotSize;
+        }
+
+        void set_BankSize(const int depth);  // setter: iBankSize; empties the bank
+        int get_BankSize(void)  // getter: iBankSize
+        {
+            return iBankSize;
+        }
+
+        int get_TakenSlots(void)  // getter: number of taken slots
+        {
+            return int(uHead - uTail);
+        }
+
+        int get_RingSize(void)  // getter: ring length; number of keyed slots
+        {
+            return int(uRingMask + 1);
+        }
+
+        void push(const T* inArray);  // insert given array after the newest slot; overwrites the oldest one if the bank is full
+        int pop(T* outArray);  // extract the oldest array from the bank; return -1 if failed
+        void clear(void);  // reset the bank to empty state
+        void store(const uint64_t key, const T* inArray);  // write the given array to the slot of the key
+        void fetch(const uint64_t key, T* outArray);  // read the slot of the key into the given array
+    };
+
+
+    template <class T>
+    Bank_Buff<T>::Bank_Buff()  // default constructor
+        : iSlotSize(0), iSlotStride(0), iBankSize(BUFF_SIZE), uRingMask(0), ptr_Store(nullptr), ptr_Slots(nullptr), uHead(0), uTail(0)
+    {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Bank_Buff: Default constructor called." << std::endl;
+        #endif
+    }
+
+
+    template <class T>
+    Bank_Buff<T>::Bank_Buff(const int size, const int depth)  // constructor
+        : iSlotSize(0), iSlotStride(0), iBankSize(1), uRingMask(0), ptr_Store(nullptr), ptr_Slots(nullptr), uHead(0), uTail(0)
+    {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Bank_Buff: Constructor called." << std::endl;
+        #endif
+
+        iSlotSize = CONSTRAIN(size, 0, INT_MAX);  // slot size
+        this->set_BankSize(depth);  // set bank depth and get the slots memory
+    }
+
+
+    template <class T>
+    Bank_Buff<T>::~Bank_Buff()  // destructor
+    {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Bank_Buff: Destructor called." << std::endl;
+        #endif
+
+        this->Release();  // release the slots memory
+    }
+
+
+    template <class T>
+    void Bank_Buff<T>::Release(void)  // release the slots memory
+    {
+        if(ptr_Store != nullptr)  // if the slots memory is taken
+        {
+            delete[] ptr_Store;  // release the slots memory
+            ptr_Store = nullptr;  // mark the memory as empty
+            ptr_Slots = nullptr;  // mark the slots as empty
+        }
+        uHead = 0;  // mark bank as empty
+        uTail = 0;
+    }
+
+
+    template <class T>
+    void Bank_Buff<T>::Allocate(void)  // get the slots memory for the slot size and depth
+    {
+        this->Release();  // release the old slots memory
+
+        unsigned int uRingLen = 1;  // ring length; power of two not below the depth
+        while(uRingLen < (unsigned int)iBankSize)  // go through the powers of two
+        {
+            uRingLen <<= 1;
+        }
+        uRingMask = uRingLen - 1;
+
+        const int iLineItems = ((CACHE_LINE % sizeof(T)) == 0) ? int(CACHE_LINE/sizeof(T)) : 1;  // items of one cache line
+        iSlotStride = (iSlotSize + iLineItems - 1)/iLineItems*iLineItems;  // slots start on cache lines
+
+        ptr_Store = new T [size_t(iSlotStride)*uRingLen + iLineItems];  // one allocation for all slots; room to align the first one
+        uintptr_t uMisalign = uintptr_t(ptr_Store) % CACHE_LINE;  // distance from the previous cache line
+        ptr_Slots = ptr_Store + ((uMisalign == 0) ? 0 : (CACHE_LINE - uMisalign)/sizeof(T));  // first slot on a cache line
+
+        #ifdef _DEBUG_MODE_
+        std::cout << "Bank_Buff: " << iBankSize << " slots of " << iSlotSize << " items in a ring of " << uRingLen << std::endl;
+        #endif
+    }
+
+
+    template <class T>
+    void Bank_Buff<T>::set_SlotSize(const int slotSize)  // setter: iSlotSize
+    {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Bank_Buff: Bank buffer slot size = " << slotSize << std::endl;
+        #endif
+
+        iSlotSize = CONSTRAIN(slotSize, 0, INT_MAX);  // update buffer size
+        this->Allocate();  // get the slots memory; the bank is empty
+    }
+
+
+    template <class T>
+    void Bank_Buff<T>::set_BankSize(const int depth)  // setter: iBankSize
+    {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Bank_Buff: Bank buffer depth = " << depth << std::endl;
+        #endif
+
+        iBankSize = CONSTRAIN(depth, 1, (1 << 30));  // update bank depth; the ring length stays an int power of two
+        this->Allocate();  // get the slots memory; the bank is empty
+    }
+
+
+    template <class T>
+    void Bank_Buff<T>::push(const T* inArray)  // insert given array after the newest slot
+    {
+        if(int(uHead - uTail) == iBankSize)  // if bank is full
+        {
+            #ifdef _DEBUG_MODE_
+            std::cout << "Bank_Buff: Push: Bank is full; the oldest slot is overwritten." << std::endl;
+            #endif
+            ++uTail;  // drop the oldest slot
+        }
+
+        int index_s = int(uHead & uRingMask);  // available slot index
+        ++uHead;  // one more taken slot
+
+        #ifdef _DEBUG_MODE_
+        std::cout << "Bank_Buff: Push: Slot index = " << index_s << std::endl;
+        std::cout << "Bank_Buff: Push: Number of taken slots = " << get_TakenSlots() << std::endl;
+        #endif
+
+        CopyArrays<T>(inArray, (ptr_Slots + size_t(index_s)*iSlotStride), iSlotSize);  // insert the array into the available slot
+    }
+
+
+    template <class T>
+    int Bank_Buff<T>::pop(T* outArray) // extract the oldest array from the bank; return -1 if failed
+    {
+        if(uHead == uTail)  // no slot available
+        {
+            return -1;  // return error code
+        }
+
+        int index_s = int(uTail & uRingMask);  // oldest slot index
+        ++uTail;  // one less taken slot
+
+        #ifdef _DEBUG_MODE_
+        std::cout << "Bank_Buff: Pop: Slot index = " << index_s << std::endl;
+        std::cout << "Bank_Buff: Pop: Number of taken slots = " << get_TakenSlots() << std::endl;
+        #endif
+
+        CopyArrays<T>((ptr_Slots + size_t(index_s)*iSlotStride), outArray, iSlotSize);  // insert the slot into the array
+
+        return index_s;  // return index of exchanged slot
+    }
+
+
+    template <class T>
+    void Bank_Buff<T>::clear(void) // reset the bank to empty state
+    {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Bank_Buff: Clear called." << std::endl;
+        #endif
+
+        uHead = 0;  // mark bank as empty
+        uTail = 0;
+    }
+
+    template <class T>
+    void Bank_Buff<T>::store(const uint64_t key, const T* inArray)  // write the given array to the slot of the key
+    {
+        CopyArrays<T>(inArray, (ptr_Slots + size_t(key & uRingMask)*iSlotStride), iSlotSize);
+    }
+
+
+    template <class T>
+    void Bank_Buff<T>::fetch(const uint64_t key, T* outArray)  // read the slot of the key into the given array
+    {
+        CopyArrays<T>((ptr_Slots + size_t(key & uRingMask)*iSlotStride), outArray, iSlotSize);
+    }
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_BANK_BUFF_H */
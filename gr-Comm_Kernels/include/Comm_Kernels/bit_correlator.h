@@ -0,0 +1,239 @@
+#ifndef INCLUDED_COMM_KERNELS_BIT_CORRELATOR_H
+#define INCLUDED_COMM_KERNELS_BIT_CORRELATOR_H
+
+// bit-parallel pattern search over one bit per char signals. The samples and the pattern are packed
+// 64 to a word once per work call. An exact search tests 64 offsets per word operation and stops as
+// soon as every offset of the group has a differing sample; a search that allows errors scores each
+// offset with XOR and popcount, one word of the pattern at a time. Samples that are neither VAL_0 nor
+// VAL_1 (status codes) never match a pattern sample, so the matches are the ones of MatchBitSeq.
+// A packed stream (bit_pack.h) is loaded by reversing the bits of each byte, without unpacking it.
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "defaults.h"
+#include "simd_dispatch.h"
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    class Bit_Correlator
+    {
+        private:
+        std::vector<uint64_t> vPattern;  // packed pattern; sample k is bit k%64 of word k/64
+        uint64_t uLastMask;  // valid bits of the last pattern word
+        int iPatternLen;  // pattern length (samples)
+        std::vector<uint64_t> vBits;  // packed samples; VAL_1 is 1
+        std::vector<uint64_t> vInvalid;  // packed samples that are neither VAL_0 nor VAL_1
+        bool bAnyInvalid;  // at least one loaded sample is invalid
+        int iArrayLen;  // number of loaded samples
+
+        static void Pack(const char *ptr_inArray, const int iLen, std::vector<uint64_t> &vWords, std::vector<uint64_t> *ptr_vInvalid, bool *ptr_bAnyInvalid)
+        {
+            const int iNumOfWords = (iLen + 63)/64 + 1;  // one zero word after the last, for the shifted loads
+            vWords.assign(iNumOfWords, 0);
+            if(ptr_vInvalid != nullptr)
+            {
+                ptr_vInvalid->assign(iNumOfWords, 0);
+            }
+
+            for(int index_g = 0; index_g < iLen; index_g += 8)  // go through groups of 8 samples
+            {
+                const int iGroupLen = (iLen - index_g < 8) ? (iLen - index_g) : 8;
+                #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                if((iGroupLen == 8) && (VAL_0 == 0) && (VAL_1 == 1))  // 0/1 samples; one multiply for the group
+                {
+                    uint64_t uGroup;
+                    std::memcpy(&uGroup, ptr_inArray + index_g, 8);
+                    if((uGroup & 0xFEFEFEFEFEFEFEFEULL) == 0)  // no status code among them
+                    {
+                        vWords[index_g >> 6] |= ((uGroup*0x0102040810204080ULL) >> 56) << (index_g & 63);  // sample k moves to bit k
+                        continue;
+                    }
+                }
+                #endif
+
+                for(int index = index_g; index < index_g + iGroupLen; ++index)  // go through the samples one by one
+                {
+                    const char cSample = ptr_inArray[index];
+                    if(cSample == VAL_1)  // bit 1
+                    {
+                        vWords[index >> 6] |= uint64_t(1) << (index & 63);
+                    }
+                    else if((cSample != VAL_0) && (ptr_vInvalid != nullptr))  // status code
+                    {
+                        (*ptr_vInvalid)[index >> 6] |= uint64_t(1) << (index & 63);
+                        *ptr_bAnyInvalid = true;
+                    }
+                }
+            }
+        }
+
+        static uint64_t Window(const uint64_t *ptr_uWords, const int index_b)  // 64 samples from sample 'index_b' on
+        {
+            const int iShift = index_b & 63;
+            const uint64_t *ptr_uWord = ptr_uWords + (index_b >> 6);
+            return (iShift == 0) ? ptr_uWord[0] : ((ptr_uWord[0] >> iShift) | (ptr_uWord[1] << (64 - iShift)));
+        }
+
+        int ScanExact(const int iFirst, const int iLast) const  // first exact match in [iFirst, iLast); 64 offsets at a time
+        {
+            const uint64_t *ptr_uBits = vBits.data();
+            const uint64_t *ptr_uInvalid = vInvalid.data();
+            const uint64_t *ptr_uPattern = vPattern.data();
+
+            for(int index_T = iFirst & ~63; index_T < iLast; index_T += 64)  // go through groups of 64 offsets
+            {
+                uint64_t uCand = ~uint64_t(0);  // bit k is offset index_T + k; cleared once a pattern sample differs
+                if(index_T < iFirst)  // offsets before the start
+                {
+                    uCand <<= (iFirst - index_T);
+                }
+                if(iLast - index_T < 64)  // offsets past the end
+                {
+                    uCand &= (uint64_t(1) << (iLast - index_T)) - 1;
+                }
+
+                for(int index_p = 0; (index_p < iPatternLen) && (uCand != 0); ++index_p)  // go through pattern samples until no offset is left
+                {
+                    uint64_t uSame = Window(ptr_uBits, index_T + index_p) ^ (((ptr_uPattern[index_p >> 6] >> (index_p & 63)) & 1) - 1);  // inverted for a 0 sample
+                    if(bAnyInvalid)  // status codes never match
+                    {
+                        uSame &= ~Window(ptr_uInvalid, index_T + index_p);
+                    }
+                    uCand &= uSame;
+                }
+                if(uCand != 0)  // a match
+                {
+                    return index_T + __builtin_ctzll(uCand);
+                }
+            }
+            return -1;
+        }
+
+        __attribute__((always_inline)) inline int Scan(const int iFirst, const int iLast, const int iMaxErr) const  // first offset in [iFirst, iLast) with at most 'iMaxErr' mismatches
+        {
+            const int iNumOfWords = int(vPattern.size());
+            const uint64_t *ptr_uBits = vBits.data();
+            const uint64_t *ptr_uInvalid = vInvalid.data();
+            const uint64_t *ptr_uPattern = vPattern.data();
+
+            for(int index_T = iFirst; index_T < iLast; ++index_T)  // go through candidate offsets
+            {
+                int iErr = 0;  // mismatches at this offset
+                for(int index_w = 0; (index_w < iNumOfWords) && (iErr <= iMaxErr); ++index_w)  // go through pattern words
+                {
+                    uint64_t uDiff = Window(ptr_uBits, index_T + 64*index_w) ^ ptr_uPattern[index_w];
+                    if(bAnyInvalid)  // status codes never match
+                    {
+                        uDiff |= Window(ptr_uInvalid, index_T + 64*index_w);
+                    }
+                    if(index_w == iNumOfWords - 1)  // only part of the last word is pattern
+                    {
+                        uDiff &= uLastMask;
+                    }
+                    iErr += __builtin_popcountll(uDiff);
+                }
+                if(iErr <= iMaxErr)  // a match
+                {
+                    return index_T;
+                }
+            }
+            return -1;
+        }
+
+        #if defined(_SIMD_X86_) && !defined(_GENERIC_KERNELS_)
+        __attribute__((target("popcnt"))) int Scan_POPCNT(const int iFirst, const int iLast, const int iMaxErr) const  // Scan with the popcnt instruction
+        {
+            return Scan(iFirst, iLast, iMaxErr);
+        }
+        #endif
+
+        public:
+        Bit_Correlator() : uLastMask(0), iPatternLen(0), bAnyInvalid(false), iArrayLen(0) {}
+
+        void set_Pattern(const char *ptr_inPattern, const int iLen)  // pattern of VAL_0/VAL_1 samples
+        {
+            iPatternLen = (iLen > 0) ? iLen : 0;
+            Pack(ptr_inPattern, iPatternLen, vPattern, nullptr, nullptr);
+            vPattern.resize((iPatternLen + 63)/64);  // drop the padding word
+            uLastMask = ((iPatternLen & 63) == 0) ? ~uint64_t(0) : ((uint64_t(1) << (iPatternLen & 63)) - 1);
+        }
+
+        int get_PatternLen(void) const
+        {
+            return iPatternLen;
+        }
+
+        int get_ArrayLen(void) const  // samples loaded for the search
+        {
+            return iArrayLen;
+        }
+
+        void load(const char *ptr_inArray, const int iLen)  // pack the samples to be searched
+        {
+            iArrayLen = (iLen > 0) ? iLen : 0;
+            bAnyInvalid = false;
+            Pack(ptr_inArray, iArrayLen, vBits, &vInvalid, &bAnyInvalid);
+        }
+
+        void load_packed(const unsigned char *ptr_inArray, const int iNumOfBytes)  // take a packed stream (first bit in the most significant bit) as the samples to be searched
+        {
+            iArrayLen = (iNumOfBytes > 0) ? 8*iNumOfBytes : 0;
+            bAnyInvalid = false;  // packed bits have no status codes
+            vBits.assign((iArrayLen + 63)/64 + 1, 0);  // one zero word after the last, for the shifted loads
+            for(int index_B = 0; index_B < iNumOfBytes; index_B += 8)  // go through groups of 8 bytes
+            {
+                uint64_t uWord = 0;
+                #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                std::memcpy(&uWord, ptr_inArray + index_B, ((iNumOfBytes - index_B) < 8) ? (iNumOfBytes - index_B) : 8);  // byte k in bits 8k to 8k+7
+                #else
+                for(int index_k = 0; (index_k < 8) && (index_B + index_k < iNumOfBytes); ++index_k)  // go through the bytes of the group
+                {
+                    uWord |= uint64_t(ptr_inArray[index_B + index_k]) << (8*index_k);
+                }
+                #endif
+                uWord = ((uWord >> 1) & 0x5555555555555555ULL) | ((uWord & 0x5555555555555555ULL) << 1);  // reverse the bits of each byte; the first bit of the stream is bit 0
+                uWord = ((uWord >> 2) & 0x3333333333333333ULL) | ((uWord & 0x3333333333333333ULL) << 2);
+                uWord = ((uWord >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((uWord & 0x0F0F0F0F0F0F0F0FULL) << 4);
+                vBits[index_B >> 3] = uWord;
+            }
+        }
+
+        // index of the first match in [iStart, iStop) with at most 'iMaxErr' mismatching samples, -1 if none;
+        // as in MatchBitSeq, offsets run up to, but not including, iArrayLen - iPatternLen
+        int find(const int iStart = 0, const int iMaxErr = 0, const int iStop = INT_MAX) const
+        {
+            int iLast = iArrayLen - iPatternLen;  // first offset not searched
+            iLast = (iStop < iLast) ? iStop : iLast;
+            if((iPatternLen == 0) || (iStart >= iLast))  // nothing to search
+            {
+                return -1;
+            }
+
+            if(iMaxErr <= 0)  // exact match; no counting needed
+            {
+                return ScanExact((iStart > 0) ? iStart : 0, iLast);
+            }
+
+            #if defined(_SIMD_X86_) && !defined(_GENERIC_KERNELS_)
+            static const bool bPopcnt = []() -> bool {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("popcnt");
+            }();
+            if(bPopcnt)
+            {
+                return Scan_POPCNT((iStart > 0) ? iStart : 0, iLast, iMaxErr);
+            }
+            #endif
+            return Scan((iStart > 0) ? iStart : 0, iLast, iMaxErr);
+        }
+    };
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_BIT_CORRELATOR_H */
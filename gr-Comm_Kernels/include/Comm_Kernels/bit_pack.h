@@ -0,0 +1,149 @@
+#ifndef INCLUDED_COMM_KERNELS_BIT_PACK_H
+#define INCLUDED_COMM_KERNELS_BIT_PACK_H
+
+// conversion between the one bit per char signal of the blocks (VAL_0/VAL_1, 'iSpB' samples per
+// bit) and packed bytes of 8 bits. The first bit goes to the most significant bit, as in the
+// GNU Radio pack_k_bits/unpack_k_bits blocks, so packed streams can be handed to them directly.
+// Packed streams carry one sample per bit; samplesPerBit is only applied at the channel, by UnpackBits.
+
+#include <cstdint>
+#include <cstring>
+
+#include "defaults.h"
+#include "array_kernels.h"
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // packs 'iNumOfBytes' bytes from 8*iSpB*iNumOfBytes samples; each bit is taken from the middle sample.
+    // Samples other than VAL_1 (status codes too) give '0' bits
+    inline void PackBits(const char *ptr_inArray, unsigned char *ptr_outArray, const int iNumOfBytes, const int iSpB = 1)
+    {
+        const char *ptr_cSample = ptr_inArray + iSpB/2;  // middle sample of the first bit
+        for(int index_B = 0; index_B < iNumOfBytes; ++index_B)  // go through the output bytes
+        {
+            #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            if((iSpB == 1) && (VAL_0 == 0) && (VAL_1 == 1))  // one sample per 0/1 bit; 8 bits in one multiply
+            {
+                uint64_t uBits;
+                std::memcpy(&uBits, ptr_cSample, 8);  // byte k of the word holds bit k
+                if((uBits & 0xFEFEFEFEFEFEFEFEULL) == 0)  // no status code among them
+                {
+                    ptr_outArray[index_B] = (unsigned char)((uBits*0x8040201008040201ULL) >> 56);  // bit k moves to bit 7 - k of the top byte
+                    ptr_cSample += 8;  // next byte
+                    continue;
+                }
+            }
+            #endif
+
+            unsigned char ucByte = 0;
+            for(int index_b = 0; index_b < 8; ++index_b)  // go through the bits of the byte
+            {
+                ucByte = (unsigned char)((ucByte << 1) | ((*ptr_cSample == VAL_1) ? 1 : 0));
+                ptr_cSample += iSpB;  // next bit
+            }
+            ptr_outArray[index_B] = ucByte;
+        }
+    }
+
+
+    // packs the 'iNumOfBits' bits of iSpB*iNumOfBits samples into (iNumOfBits + 7)/8 bytes, the number returned;
+    // the last byte is filled up with '0' bits. The bits are the decided ones, so samples of one bit may differ
+    inline int PackBitStream(const char *ptr_inArray, unsigned char *ptr_outArray, const int iNumOfBits, const int iSpB = 1)
+    {
+        const int iNumOfBytes = iNumOfBits/8;  // whole bytes
+        PackBits(ptr_inArray, ptr_outArray, iNumOfBytes, iSpB);
+
+        const int iTailLen = iNumOfBits - 8*iNumOfBytes;  // bits of the last byte
+        if(iTailLen > 0)  // partial byte
+        {
+            const char *ptr_cSample = ptr_inArray + 8*iSpB*iNumOfBytes + iSpB/2;  // middle sample of its first bit
+            unsigned char ucByte = 0;
+            for(int index_b = 0; index_b < iTailLen; ++index_b)  // go through the bits of the byte
+            {
+                ucByte |= (unsigned char)(((*ptr_cSample == VAL_1) ? 1 : 0) << (7 - index_b));
+                ptr_cSample += iSpB;  // next bit
+            }
+            ptr_outArray[iNumOfBytes] = ucByte;
+        }
+        return (iNumOfBits + 7)/8;
+    }
+
+
+    // table of the 8 samples (VAL_0/VAL_1) of every byte value
+    inline const char (*UnpackTable(void))[8]
+    {
+        struct Table
+        {
+            char ary_cBits[256][8];
+            Table()
+            {
+                for(int index_v = 0; index_v < 256; ++index_v)  // go through the byte values
+                {
+                    for(int index_b = 0; index_b < 8; ++index_b)  // go through the bits, most significant first
+                    {
+                        ary_cBits[index_v][index_b] = ((index_v >> (7 - index_b)) & 1) ? VAL_1 : VAL_0;
+                    }
+                }
+            }
+        };
+        static const Table LUT;  // built on the first call
+        return LUT.ary_cBits;
+    }
+
+
+    // unpacks 'iNumOfBytes' bytes into 8*iSpB*iNumOfBytes samples
+    inline void UnpackBits(const unsigned char *ptr_inArray, char *ptr_outArray, const int iNumOfBytes, const int iSpB = 1)
+    {
+        const char (*ptr_LUT)[8] = UnpackTable();
+        if(iSpB == 1)  // one sample per bit; 8 samples per table entry
+        {
+            for(int index_B = 0; index_B < iNumOfBytes; ++index_B)  // go through the input bytes
+            {
+                std::memcpy(ptr_outArray + 8*index_B, ptr_LUT[ptr_inArray[index_B]], 8);
+            }
+            return;
+        }
+
+        for(int index_B = 0; index_B < iNumOfBytes; ++index_B)  // go through the input bytes
+        {
+            InterpArray<char>(ptr_LUT[ptr_inArray[index_B]], (ptr_outArray + 8*iSpB*index_B), 8, iSpB);  // repeat each bit 'iSpB' times
+        }
+    }
+
+
+    // bits of a packed stream from any bit on; 'iNumOfBits' bits from bit 'iBitIndex' (0 is the most significant bit
+    // of the first byte) to one VAL_0/VAL_1 sample per bit
+    inline void ReadBits(const unsigned char *ptr_inArray, const int iBitIndex, char *ptr_outArray, const int iNumOfBits)
+    {
+        for(int index_b = 0; index_b < iNumOfBits; ++index_b)  // go through the bits
+        {
+            const int iBit = iBitIndex + index_b;
+            ptr_outArray[index_b] = ((ptr_inArray[iBit >> 3] >> (7 - (iBit & 7))) & 1) ? VAL_1 : VAL_0;
+        }
+    }
+
+
+    // 'iNumOfBytes' bytes of a packed stream from bit 'iBitIndex' on; a packet that does not start on a byte of the
+    // stream is shifted into whole bytes. Only the bytes holding the copied bits are read
+    inline void CopyBits(const unsigned char *ptr_inArray, const int iBitIndex, unsigned char *ptr_outArray, const int iNumOfBytes)
+    {
+        const unsigned char *ptr_ucByte = ptr_inArray + (iBitIndex >> 3);  // byte of the first bit
+        const int iShift = iBitIndex & 7;
+        if(iShift == 0)  // byte aligned
+        {
+            std::memcpy(ptr_outArray, ptr_ucByte, iNumOfBytes);
+            return;
+        }
+
+        for(int index_B = 0; index_B < iNumOfBytes; ++index_B)  // go through the output bytes; each takes the end of one input byte and the start of the next
+        {
+            ptr_outArray[index_B] = (unsigned char)((ptr_ucByte[index_B] << iShift) | (ptr_ucByte[index_B + 1] >> (8 - iShift)));
+        }
+    }
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_BIT_PACK_H */
@@ -0,0 +1,78 @@
+#ifndef INCLUDED_COMM_KERNELS_CRC32_H
+#define INCLUDED_COMM_KERNELS_CRC32_H
+
+// CRC-32 of IEEE 802.3 (reflected polynomial 0xEDB88320, as zlib's crc32), slice-by-8: eight tables
+// of 256 entries let one step take 8 bytes with 8 independent lookups instead of 8 dependent ones.
+// The result of one call can be given as 'uCrc' of the next, so a message can be taken in parts.
+
+#include <cstdint>
+#include <cstring>
+
+#include "defaults.h"
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // slice-by-8 tables; table k gives the CRC of a byte followed by k zero bytes
+    inline const uint32_t (*Crc32Table(void))[256]
+    {
+        struct Table
+        {
+            uint32_t ary_uCrc[8][256];
+            Table()
+            {
+                for(uint32_t index_v = 0; index_v < 256; ++index_v)  // go through the byte values
+                {
+                    uint32_t uCrc = index_v;
+                    for(int index_b = 0; index_b < 8; ++index_b)  // go through the bits, least significant first
+                    {
+                        uCrc = (uCrc >> 1) ^ ((uCrc & 1) ? CRC32_POLY : 0);
+                    }
+                    ary_uCrc[0][index_v] = uCrc;
+                }
+                for(int index_t = 1; index_t < 8; ++index_t)  // go through the other tables
+                {
+                    for(int index_v = 0; index_v < 256; ++index_v)  // go through the byte values
+                    {
+                        uint32_t uPrev = ary_uCrc[index_t - 1][index_v];
+                        ary_uCrc[index_t][index_v] = (uPrev >> 8) ^ ary_uCrc[0][uPrev & 0xFF];  // one more zero byte
+                    }
+                }
+            }
+        };
+        static const Table LUT;  // built on the first call
+        return LUT.ary_uCrc;
+    }
+
+
+    // CRC-32 of 'iLen' bytes; 'uCrc' is the CRC of the bytes before them, 0 for none
+    inline uint32_t Crc32(const void *ptr_inArray, int iLen, uint32_t uCrc = 0)
+    {
+        const uint32_t (*ptr_LUT)[256] = Crc32Table();
+        const unsigned char *ptr_ucByte = (const unsigned char *) ptr_inArray;
+        uCrc = ~uCrc;
+
+        #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        for(; iLen >= 8; iLen -= 8, ptr_ucByte += 8)  // go through groups of 8 bytes
+        {
+            uint32_t uLow, uHigh;
+            std::memcpy(&uLow, ptr_ucByte, 4);
+            std::memcpy(&uHigh, ptr_ucByte + 4, 4);
+            uLow ^= uCrc;
+            uCrc = ptr_LUT[7][uLow & 0xFF] ^ ptr_LUT[6][(uLow >> 8) & 0xFF] ^ ptr_LUT[5][(uLow >> 16) & 0xFF] ^ ptr_LUT[4][uLow >> 24] ^
+                   ptr_LUT[3][uHigh & 0xFF] ^ ptr_LUT[2][(uHigh >> 8) & 0xFF] ^ ptr_LUT[1][(uHigh >> 16) & 0xFF] ^ ptr_LUT[0][uHigh >> 24];
+        }
+        #endif
+
+        for(; iLen > 0; --iLen, ++ptr_ucByte)  // go through the rest byte by byte
+        {
+            uCrc = (uCrc >> 8) ^ ptr_LUT[0][(uCrc ^ *ptr_ucByte) & 0xFF];
+        }
+        return ~uCrc;
+    }
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_CRC32_H */
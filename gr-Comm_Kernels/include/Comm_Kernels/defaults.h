@@ -0,0 +1,39 @@
+#ifndef INCLUDED_COMM_KERNELS_DEFAULTS_H
+#define INCLUDED_COMM_KERNELS_DEFAULTS_H
+
+// values a module may already set in its own defaults.h (included before this file)
+#ifndef VAL_0
+#define VAL_0                               (0)                                         // value representing bit 0
+#endif
+#ifndef VAL_1
+#define VAL_1                               (1)                                         // value representing bit 1
+#endif
+#ifndef MIN_MATCH_VAL
+#define MIN_MATCH_VAL                       (75.0)                                      // minimum acceptable match (%)
+#endif
+#ifndef BUFF_SIZE
+#define BUFF_SIZE                           (5)                                         // bank buffer size
+#endif
+
+#define CACHE_LINE                          (64)                                        // cache line size (bytes)
+#define RNG_BUFF_SIZE                       (256)                                       // random number generator storage size
+#define PHILOX_ROUNDS                       (10)                                        // number of Philox rounds
+#define PHILOX_M0                           (0xD2511F53)                                // Philox multiplier 0
+#define PHILOX_M1                           (0xCD9E8D57)                                // Philox multiplier 1
+#define PHILOX_W0                           (0x9E3779B9)                                // Philox key increment 0 (golden ratio)
+#define PHILOX_W1                           (0xBB67AE85)                                // Philox key increment 1 (sqrt(3) - 1)
+#define SIMD_MAX_WIDTH                      (16)                                        // widest vector in floats; size of padded tail buffers
+#define TRACE_RING_SIZE                     (4096)                                      // trace records per thread ring; power of two
+#define TRACE_DRAIN_PERIOD                  (2)                                         // trace drainer wake up period (ms)
+#define TRACE_FILE_ENV                      "COMM_TRACE_FILE"                           // environment variable holding the trace file path
+#define TRACE_FILE_DEF                      "Comm_Kernels_trace.bin"                    // default trace file path
+#define PERF_HIST_BINS                      (32)                                        // work duration histogram bins; bin k holds [2^k, 2^(k+1)) ns
+#define PERF_MAX_COUNTERS                   (6)                                         // module specific counters per block
+#define STATS_PERIOD_ENV                    "COMM_STATS_PERIOD"                         // environment variable holding the stats message period (ms)
+#define STATS_PERIOD_DEF                    (0)                                         // default stats message period (ms); 0 is off
+#define CRC32_POLY                          (0xEDB88320u)                               // CRC-32 polynomial (IEEE 802.3), reflected
+#define CORR_FFT_MIN_TAPS                   (64)                                        // shortest pattern correlated by FFT, per float of the direct kernel vector; shorter ones are correlated directly
+#define CORR_FFT_MIN_SIZE                   (1024)                                      // shortest correlation FFT
+#define CORR_FFT_RATIO                      (8)                                         // correlation FFT length over pattern length, at least
+
+#endif /* INCLUDED_COMM_KERNELS_DEFAULTS_H */
@@ -0,0 +1,348 @@
+#ifndef INCLUDED_COMM_KERNELS_FLOAT_CORRELATOR_H
+#define INCLUDED_COMM_KERNELS_FLOAT_CORRELATOR_H
+
+// sliding correlation of a float signal with a float pattern, out[k] = sum_i p[i]*in[k + i], where
+// the pattern has its mean removed so a constant offset of the signal does not change the result.
+// Short patterns are correlated directly, one vector of outputs per pattern sample; long ones by
+// FFT overlap-save, when the call has at least one FFT length of outputs. The wider the vectors of
+// the direct kernels, the longer the pattern the FFT needs to be faster. As the pattern is real, two input segments go through one complex FFT, one as
+// the real part and one as the imaginary part.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "defaults.h"
+#include "simd_dispatch.h"
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // direct kernels; 'iOutLen' outputs from 'iOutLen + iPatternLen - 1' inputs, return the number of outputs done
+    inline int Correlate_Scalar(const float *ptr_fInArray, const float *ptr_fPattern, float *ptr_fOutArray, const int iOutLen, const int iPatternLen)
+    {
+        for(int index_k = 0; index_k < iOutLen; ++index_k)  // go through the outputs
+        {
+            float fSum = 0;
+            for(int index_p = 0; index_p < iPatternLen; ++index_p)  // go through the pattern
+            {
+                fSum += ptr_fPattern[index_p]*ptr_fInArray[index_k + index_p];
+            }
+            ptr_fOutArray[index_k] = fSum;
+        }
+        return iOutLen;
+    }
+
+
+    #ifdef _SIMD_X86_
+    __attribute__((target("sse2"))) inline int Correlate_SSE2(const float *ptr_fInArray, const float *ptr_fPattern, float *ptr_fOutArray, const int iOutLen, const int iPatternLen)
+    {
+        int index_k = 0;
+        for(; index_k + 8 <= iOutLen; index_k += 8)  // two vectors of outputs at a time
+        {
+            __m128 vSum0 = _mm_setzero_ps(), vSum1 = _mm_setzero_ps();
+            for(int index_p = 0; index_p < iPatternLen; ++index_p)  // go through the pattern
+            {
+                __m128 vCoef = _mm_set1_ps(ptr_fPattern[index_p]);
+                vSum0 = _mm_add_ps(vSum0, _mm_mul_ps(vCoef, _mm_loadu_ps(ptr_fInArray + index_k + index_p)));
+                vSum1 = _mm_add_ps(vSum1, _mm_mul_ps(vCoef, _mm_loadu_ps(ptr_fInArray + index_k + index_p + 4)));
+            }
+            _mm_storeu_ps(ptr_fOutArray + index_k, vSum0);
+            _mm_storeu_ps(ptr_fOutArray + index_k + 4, vSum1);
+        }
+        return index_k;
+    }
+
+
+    __attribute__((target("avx2,fma"))) inline int Correlate_AVX2(const float *ptr_fInArray, const float *ptr_fPattern, float *ptr_fOutArray, const int iOutLen, const int iPatternLen)
+    {
+        int index_k = 0;
+        for(; index_k + 16 <= iOutLen; index_k += 16)  // two vectors of outputs at a time
+        {
+            __m256 vSum0 = _mm256_setzero_ps(), vSum1 = _mm256_setzero_ps();
+            for(int index_p = 0; index_p < iPatternLen; ++index_p)  // go through the pattern
+            {
+                __m256 vCoef = _mm256_set1_ps(ptr_fPattern[index_p]);
+                vSum0 = _mm256_fmadd_ps(vCoef, _mm256_loadu_ps(ptr_fInArray + index_k + index_p), vSum0);
+                vSum1 = _mm256_fmadd_ps(vCoef, _mm256_loadu_ps(ptr_fInArray + index_k + index_p + 8), vSum1);
+            }
+            _mm256_storeu_ps(ptr_fOutArray + index_k, vSum0);
+            _mm256_storeu_ps(ptr_fOutArray + index_k + 8, vSum1);
+        }
+        return index_k;
+    }
+
+
+    __attribute__((target("avx512f"))) inline int Correlate_AVX512(const float *ptr_fInArray, const float *ptr_fPattern, float *ptr_fOutArray, const int iOutLen, const int iPatternLen)
+    {
+        int index_k = 0;
+        for(; index_k + 32 <= iOutLen; index_k += 32)  // two vectors of outputs at a time
+        {
+            __m512 vSum0 = _mm512_setzero_ps(), vSum1 = _mm512_setzero_ps();
+            for(int index_p = 0; index_p < iPatternLen; ++index_p)  // go through the pattern
+            {
+                __m512 vCoef = _mm512_set1_ps(ptr_fPattern[index_p]);
+                vSum0 = _mm512_fmadd_ps(vCoef, _mm512_loadu_ps(ptr_fInArray + index_k + index_p), vSum0);
+                vSum1 = _mm512_fmadd_ps(vCoef, _mm512_loadu_ps(ptr_fInArray + index_k + index_p + 16), vSum1);
+            }
+            _mm512_storeu_ps(ptr_fOutArray + index_k, vSum0);
+            _mm512_storeu_ps(ptr_fOutArray + index_k + 16, vSum1);
+        }
+        return index_k;
+    }
+    #endif
+
+
+    #ifdef _SIMD_NEON_
+    inline int Correlate_NEON(const float *ptr_fInArray, const float *ptr_fPattern, float *ptr_fOutArray, const int iOutLen, const int iPatternLen)
+    {
+        int index_k = 0;
+        for(; index_k + 8 <= iOutLen; index_k += 8)  // two vectors of outputs at a time
+        {
+            float32x4_t vSum0 = vdupq_n_f32(0), vSum1 = vdupq_n_f32(0);
+            for(int index_p = 0; index_p < iPatternLen; ++index_p)  // go through the pattern
+            {
+                float32x4_t vCoef = vdupq_n_f32(ptr_fPattern[index_p]);
+                vSum0 = vfmaq_f32(vSum0, vCoef, vld1q_f32(ptr_fInArray + index_k + index_p));
+                vSum1 = vfmaq_f32(vSum1, vCoef, vld1q_f32(ptr_fInArray + index_k + index_p + 4));
+            }
+            vst1q_f32(ptr_fOutArray + index_k, vSum0);
+            vst1q_f32(ptr_fOutArray + index_k + 4, vSum1);
+        }
+        return index_k;
+    }
+    #endif
+
+
+    class Float_Correlator
+    {
+        private:
+        std::vector<float> vPattern;  // pattern with its mean removed
+        int iPatternLen;  // pattern length (samples)
+        float fPatternNorm;  // square root of the pattern energy
+        bool bFft;  // FFT overlap-save instead of the direct kernels
+        int iFftLen;  // FFT length; power of two
+        int iStep;  // valid outputs of one segment; iFftLen - iPatternLen + 1
+        int iFftMinOut;  // fewest outputs of a call correlated by FFT; fewer are faster directly
+        std::vector<int> vBitRev;  // bit reversed index of every FFT element
+        std::vector<float> vTwRe, vTwIm;  // twiddles of all stages one after the other; stage of half length h starts at h - 1
+        std::vector<float> vSpecRe, vSpecIm;  // pattern spectrum, scaled by 1/iFftLen
+        std::vector<float> vRe, vIm;  // spectrum of the segments
+        std::vector<float> vProdRe, vProdIm;  // product of the spectra, then the correlation
+
+        void Fft(float *ptr_fRe, float *ptr_fIm) const  // in place forward FFT; input in bit reversed order, output in natural order
+        {
+            for(int index = 0; index < iFftLen; index += 4)  // first two stages together; their twiddles are 1 and -j
+            {
+                const float fA0Re = ptr_fRe[index] + ptr_fRe[index + 1], fA0Im = ptr_fIm[index] + ptr_fIm[index + 1];
+                const float fA1Re = ptr_fRe[index] - ptr_fRe[index + 1], fA1Im = ptr_fIm[index] - ptr_fIm[index + 1];
+                const float fA2Re = ptr_fRe[index + 2] + ptr_fRe[index + 3], fA2Im = ptr_fIm[index + 2] + ptr_fIm[index + 3];
+                const float fA3Re = ptr_fRe[index + 2] - ptr_fRe[index + 3], fA3Im = ptr_fIm[index + 2] - ptr_fIm[index + 3];
+                ptr_fRe[index] = fA0Re + fA2Re;
+                ptr_fIm[index] = fA0Im + fA2Im;
+                ptr_fRe[index + 2] = fA0Re - fA2Re;
+                ptr_fIm[index + 2] = fA0Im - fA2Im;
+                ptr_fRe[index + 1] = fA1Re + fA3Im;  // -j*A3 added
+                ptr_fIm[index + 1] = fA1Im - fA3Re;
+                ptr_fRe[index + 3] = fA1Re - fA3Im;
+                ptr_fIm[index + 3] = fA1Im + fA3Re;
+            }
+
+            for(int iHalf = 4; iHalf < iFftLen; iHalf <<= 1)  // go through the other stages
+            {
+                const float *ptr_fWRe = vTwRe.data() + iHalf - 1;
+                const float *ptr_fWIm = vTwIm.data() + iHalf - 1;
+                for(int index_g = 0; index_g < iFftLen; index_g += 2*iHalf)  // go through the butterfly groups
+                {
+                    float *ptr_fARe = ptr_fRe + index_g, *ptr_fAIm = ptr_fIm + index_g;
+                    float *ptr_fBRe = ptr_fARe + iHalf, *ptr_fBIm = ptr_fAIm + iHalf;
+                    for(int index = 0; index < iHalf; ++index)  // go through the butterflies
+                    {
+                        const float fTRe = ptr_fBRe[index]*ptr_fWRe[index] - ptr_fBIm[index]*ptr_fWIm[index];
+                        const float fTIm = ptr_fBRe[index]*ptr_fWIm[index] + ptr_fBIm[index]*ptr_fWRe[index];
+                        ptr_fBRe[index] = ptr_fARe[index] - fTRe;
+                        ptr_fBIm[index] = ptr_fAIm[index] - fTIm;
+                        ptr_fARe[index] += fTRe;
+                        ptr_fAIm[index] += fTIm;
+                    }
+                }
+            }
+        }
+
+        void SetupFft(void)  // FFT length, tables and pattern spectrum
+        {
+            iFftLen = CORR_FFT_MIN_SIZE;
+            while(iFftLen < CORR_FFT_RATIO*iPatternLen)  // long enough for the segments to be mostly valid outputs
+            {
+                iFftLen <<= 1;
+            }
+            iStep = iFftLen - iPatternLen + 1;
+
+            int iLog = 0;
+            while((1 << iLog) < iFftLen)
+            {
+                ++iLog;
+            }
+            vBitRev.assign(iFftLen, 0);
+            for(int index = 0; index < iFftLen; ++index)  // go through the elements
+            {
+                for(int index_b = 0; index_b < iLog; ++index_b)  // go through the index bits
+                {
+                    vBitRev[index] |= ((index >> index_b) & 1) << (iLog - 1 - index_b);
+                }
+            }
+
+            vTwRe.assign(iFftLen, 0);
+            vTwIm.assign(iFftLen, 0);
+            for(int iHalf = 1; iHalf < iFftLen; iHalf <<= 1)  // go through the stages
+            {
+                for(int index = 0; index < iHalf; ++index)  // go through the butterflies
+                {
+                    const double dAngle = -M_PI*index/iHalf;
+                    vTwRe[iHalf - 1 + index] = float(std::cos(dAngle));
+                    vTwIm[iHalf - 1 + index] = float(std::sin(dAngle));
+                }
+            }
+
+            vSpecRe.assign(iFftLen, 0);
+            vSpecIm.assign(iFftLen, 0);
+            for(int index = 0; index < iPatternLen; ++index)  // zero padded pattern
+            {
+                vSpecRe[vBitRev[index]] = vPattern[index]/iFftLen;  // inverse FFT scaling
+            }
+            this->Fft(vSpecRe.data(), vSpecIm.data());
+            vRe.assign(iFftLen, 0);
+            vIm.assign(iFftLen, 0);
+            vProdRe.assign(iFftLen, 0);
+            vProdIm.assign(iFftLen, 0);
+        }
+
+        // two segments: 'ptr_fIn0' and 'ptr_fIn1' hold 'iLen0' and 'iLen1' samples, zero padded to the FFT length;
+        // with Z = X0 + jX1, IFFT(Z conj(H)) = c0 + jc1 for a real pattern, and IFFT(Y) = conj(FFT(conj(Y)))/N
+        void CorrelateFft(const float *ptr_fIn0, const int iLen0, const float *ptr_fIn1, const int iLen1, float *ptr_fOut0, float *ptr_fOut1, const int iOut0, const int iOut1)
+        {
+            const int *ptr_iBitRev = vBitRev.data();
+            float *ptr_fRe = vRe.data(), *ptr_fIm = vIm.data();
+            for(int index = 0; index < iFftLen; ++index)  // load the segments in bit reversed order
+            {
+                ptr_fRe[ptr_iBitRev[index]] = (index < iLen0) ? ptr_fIn0[index] : 0.0f;
+                ptr_fIm[ptr_iBitRev[index]] = (index < iLen1) ? ptr_fIn1[index] : 0.0f;
+            }
+            this->Fft(ptr_fRe, ptr_fIm);
+
+            const float *ptr_fHRe = vSpecRe.data(), *ptr_fHIm = vSpecIm.data();
+            float *ptr_fPRe = vProdRe.data(), *ptr_fPIm = vProdIm.data();
+            for(int index = 0; index < iFftLen; ++index)  // conj(Z)*H, in bit reversed order for the next FFT
+            {
+                ptr_fPRe[ptr_iBitRev[index]] = ptr_fRe[index]*ptr_fHRe[index] + ptr_fIm[index]*ptr_fHIm[index];
+                ptr_fPIm[ptr_iBitRev[index]] = ptr_fRe[index]*ptr_fHIm[index] - ptr_fIm[index]*ptr_fHRe[index];
+            }
+            this->Fft(ptr_fPRe, ptr_fPIm);
+
+            for(int index = 0; index < iOut0; ++index)  // real part is the first correlation
+            {
+                ptr_fOut0[index] = ptr_fPRe[index];
+            }
+            for(int index = 0; index < iOut1; ++index)  // conjugated imaginary part is the second
+            {
+                ptr_fOut1[index] = -ptr_fPIm[index];
+            }
+        }
+
+        public:
+        Float_Correlator() : iPatternLen(0), fPatternNorm(0), bFft(false), iFftLen(0), iStep(0), iFftMinOut(0) {}
+
+        void set_Pattern(const float *ptr_fPattern, const int iLen)  // pattern samples; FFT for 'iLen' >= CORR_FFT_MIN_TAPS floats per vector
+        {
+            iPatternLen = (iLen > 0) ? iLen : 0;
+            vPattern.assign(ptr_fPattern, ptr_fPattern + iPatternLen);
+
+            double dMean = 0;
+            for(int index = 0; index < iPatternLen; ++index)  // go through the pattern
+            {
+                dMean += vPattern[index];
+            }
+            dMean /= (iPatternLen > 0) ? iPatternLen : 1;
+
+            double dEnergy = 0;
+            for(int index = 0; index < iPatternLen; ++index)  // remove the mean
+            {
+                vPattern[index] -= float(dMean);
+                dEnergy += double(vPattern[index])*vPattern[index];
+            }
+            fPatternNorm = float(std::sqrt(dEnergy));
+
+            this->set_Fft(iPatternLen >= CORR_FFT_MIN_TAPS*SIMD_Width(SIMD_Level()));
+            iFftMinOut = iFftLen;  // a shorter call pays a whole FFT for a part of its outputs
+        }
+
+        void set_Fft(const bool bUseFft)  // force the FFT or the direct method
+        {
+            bFft = bUseFft && (iPatternLen > 0);
+            iFftMinOut = 0;  // whatever the number of outputs
+            if(bFft)
+            {
+                this->SetupFft();
+            }
+        }
+
+        bool get_Fft(void) const  // calls of at least one FFT length of outputs are correlated by FFT
+        {
+            return bFft;
+        }
+
+        int get_PatternLen(void) const
+        {
+            return iPatternLen;
+        }
+
+        float get_PatternNorm(void) const  // square root of the energy of the mean removed pattern
+        {
+            return fPatternNorm;
+        }
+
+        // 'iOutLen' correlation values; 'ptr_fInArray' holds iOutLen + get_PatternLen() - 1 samples
+        void correlate(const float *ptr_fInArray, float *ptr_fOutArray, const int iOutLen)
+        {
+            if((iPatternLen == 0) || (iOutLen <= 0))  // nothing to correlate
+            {
+                return;
+            }
+
+            if(bFft && (iOutLen >= iFftMinOut))
+            {
+                const int iInLen = iOutLen + iPatternLen - 1;  // input samples
+                for(int index_s = 0; index_s < iOutLen; index_s += 2*iStep)  // go through pairs of segments
+                {
+                    const int index_t = index_s + iStep;  // start of the second segment
+                    const int iOut0 = std::min(iStep, iOutLen - index_s);
+                    const int iOut1 = (index_t < iOutLen) ? std::min(iStep, iOutLen - index_t) : 0;
+                    this->CorrelateFft(ptr_fInArray + index_s, std::min(iFftLen, iInLen - index_s),
+                                       ptr_fInArray + std::min(index_t, iInLen), (iOut1 > 0) ? std::min(iFftLen, iInLen - index_t) : 0,
+                                       ptr_fOutArray + index_s, ptr_fOutArray + std::min(index_t, iOutLen), iOut0, iOut1);
+                }
+                return;
+            }
+
+            int index_k = 0;  // outputs done by the vector kernels
+            switch(SIMD_Level())
+            {
+                #ifdef _SIMD_X86_
+                case SIMD_AVX512: index_k = Correlate_AVX512(ptr_fInArray, vPattern.data(), ptr_fOutArray, iOutLen, iPatternLen); break;
+                case SIMD_AVX2: index_k = Correlate_AVX2(ptr_fInArray, vPattern.data(), ptr_fOutArray, iOutLen, iPatternLen); break;
+                case SIMD_SSE2: index_k = Correlate_SSE2(ptr_fInArray, vPattern.data(), ptr_fOutArray, iOutLen, iPatternLen); break;
+                #endif
+                #ifdef _SIMD_NEON_
+                case SIMD_NEON: index_k = Correlate_NEON(ptr_fInArray, vPattern.data(), ptr_fOutArray, iOutLen, iPatternLen); break;
+                #endif
+                default: break;
+            }
+            Correlate_Scalar(ptr_fInArray + index_k, vPattern.data(), ptr_fOutArray + index_k, iOutLen - index_k, iPatternLen);  // rest of the outputs
+        }
+    };
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_FLOAT_CORRELATOR_H */
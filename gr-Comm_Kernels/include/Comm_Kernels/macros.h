@@ -0,0 +1,21 @@
+#ifndef INCLUDED_COMM_KERNELS_MACROS_H
+#define INCLUDED_COMM_KERNELS_MACROS_H
+
+
+#include <cfloat>
+
+
+#ifndef MIN
+#define MIN(x, y)                           (((x) < (y)) ? (x) : (y))                   // minimum value
+#endif
+#ifndef MAX
+#define MAX(x, y)                           (((x) > (y)) ? (x) : (y))                   // maximum value
+#endif
+#define CONSTRAIN(x, lowLim, highLim)       (MIN(MAX((x), (lowLim)), (highLim)))        // return a constraint value of x within [lowlim, highLim] range*/
+#define POW2(x)                             ((x)*(x))                                   // power of 2
+#define EQUAL(x, y)                         (abs((x) - (y)) <= (10.0*FLT_MIN))          // if two float values are the almost same
+#define CPRN(x)                             (int(x))                                    // character print version
+#define CH2ASC(x)                           (char(x + '0'))                             // character number to ascii character
+#define U32_TO_UNIT(x)                      ((float((x) >> 9) + 0.5f)*(1.0f/8388608.0f))  // maps a random word to (0, 1); 23 bits, so the half step stays exact
+
+#endif /* INCLUDED_COMM_KERNELS_MACROS_H */
@@ -0,0 +1,23 @@
+#ifndef INCLUDED_COMM_KERNELS_MACROS_FUNCTIONS_H
+#define INCLUDED_COMM_KERNELS_MACROS_FUNCTIONS_H
+
+// shared macros, array kernels, random number generators, bank buffer, bit packing, bit and float correlators, CRC-32, serial number
+// arithmetic, tracepoints and performance counters of the FSO_Comm, RF_Comm and Hybrid_Comm modules; header only, so nothing to link
+
+
+#include "defaults.h"
+#include "macros.h"
+#include "simd_dispatch.h"
+#include "simd_math.h"
+#include "array_kernels.h"
+#include "random_gen.h"
+#include "bank_buff.h"
+#include "bit_pack.h"
+#include "bit_correlator.h"
+#include "float_correlator.h"
+#include "crc32.h"
+#include "serial_number.h"
+#include "trace.h"
+#include "perf_counters.h"
+
+#endif /* INCLUDED_COMM_KERNELS_MACROS_FUNCTIONS_H */
@@ -0,0 +1,176 @@
+#ifndef INCLUDED_COMM_KERNELS_PERF_BLOCK_H
+#define INCLUDED_COMM_KERNELS_PERF_BLOCK_H
+
+// GNU Radio side of the performance counters; a block inherits Perf_Block next to its public
+// class, calls setup_Stats(this) in its constructor, puts a Work_Timer at the top of work and
+// forwards setup_rpc to setup_Perf_Rpc. The counters are then
+//  - published as a dictionary on the "stats" message port every $COMM_STATS_PERIOD ms
+//    (0, the default, is off; ControlPort can change it while running)
+//  - registered with ControlPort when it is compiled in (cmake -DCTRLPORT=ON)
+// Not part of macros_functions.h, as it needs the GNU Radio runtime.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <gnuradio/basic_block.h>
+#include <pmt/pmt.h>
+#ifdef GR_CTRLPORT
+#include <gnuradio/rpcregisterhelpers.h>
+#endif
+
+#include "perf_counters.h"
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    class Perf_Block : public Perf_Counters
+    {
+        private:
+        gr::basic_block *ptr_Block;  // owner block; publishes the stats
+        std::atomic<int> iStatsPeriod;  // stats message period (ms); 0 is off
+        std::chrono::steady_clock::time_point tLastStats;  // last stats message time
+        #ifdef GR_CTRLPORT
+        std::vector<rpcbasic_sptr> vRpcVars;  // registered ControlPort variables
+        #endif
+
+        static pmt::pmt_t StatsPort(void)  // stats message port id
+        {
+            return pmt::mp("stats");
+        }
+
+        template <int N>
+        double get_CounterRpc(void)  // ControlPort getter of module specific counter N
+        {
+            return double(this->get_Counter(N));
+        }
+
+        public:
+        Perf_Block() : ptr_Block(nullptr), iStatsPeriod(STATS_PERIOD_DEF), tLastStats(std::chrono::steady_clock::now())
+        {
+            const char *ptr_cPeriod = std::getenv(STATS_PERIOD_ENV);
+            if(ptr_cPeriod != nullptr)  // period is given by the environment
+            {
+                this->set_StatsPeriod(std::atoi(ptr_cPeriod));
+            }
+        }
+
+        void setup_Stats(gr::basic_block *block)  // register the stats message port of the block
+        {
+            ptr_Block = block;
+            ptr_Block->message_port_register_out(StatsPort());
+        }
+
+        // Set stats message period (ms)
+        void set_StatsPeriod(int periodMs)
+        {
+            iStatsPeriod.store((periodMs > 0) ? periodMs : 0, std::memory_order_relaxed);
+        }
+
+        // Get stats message period (ms)
+        int get_StatsPeriod(void)
+        {
+            return iStatsPeriod.load(std::memory_order_relaxed);
+        }
+
+        pmt::pmt_t get_Stats(void)  // all counters as a dictionary
+        {
+            uint64_t ary_uHist[PERF_HIST_BINS];
+            for(int index = 0; index < PERF_HIST_BINS; ++index)  // go through the bins
+            {
+                ary_uHist[index] = this->get_Hist(index);
+            }
+
+            pmt::pmt_t pmtStats = pmt::make_dict();
+            pmtStats = pmt::dict_add(pmtStats, pmt::mp("block"), pmt::mp((ptr_Block != nullptr) ? ptr_Block->alias() : std::string()));
+            pmtStats = pmt::dict_add(pmtStats, pmt::mp("work_calls"), pmt::from_uint64(this->get_WorkCalls()));
+            pmtStats = pmt::dict_add(pmtStats, pmt::mp("items_in"), pmt::from_uint64(this->get_ItemsIn()));
+            pmtStats = pmt::dict_add(pmtStats, pmt::mp("items_out"), pmt::from_uint64(this->get_ItemsOut()));
+            pmtStats = pmt::dict_add(pmtStats, pmt::mp("work_time_hist"), pmt::init_u64vector(PERF_HIST_BINS, ary_uHist));
+            for(int index = 0; index < this->get_NumOfCounters(); ++index)  // go through the module specific counters
+            {
+                pmtStats = pmt::dict_add(pmtStats, pmt::mp(this->get_CounterName(index)), pmt::from_uint64(this->get_Counter(index)));
+            }
+            return pmtStats;
+        }
+
+        void work_Done(void) override  // publish the stats when the period is over
+        {
+            int iPeriod = iStatsPeriod.load(std::memory_order_relaxed);
+            if((iPeriod == 0) || (ptr_Block == nullptr))  // stats messages are off
+            {
+                return;
+            }
+
+            std::chrono::steady_clock::time_point tNow = std::chrono::steady_clock::now();
+            if(tNow - tLastStats >= std::chrono::milliseconds(iPeriod))  // period is over
+            {
+                tLastStats = tNow;
+                ptr_Block->message_port_pub(StatsPort(), this->get_Stats());
+            }
+        }
+
+        // ControlPort getters
+        double get_WorkCallsRpc(void)
+        {
+            return double(this->get_WorkCalls());
+        }
+
+        double get_ItemsInRpc(void)
+        {
+            return double(this->get_ItemsIn());
+        }
+
+        double get_ItemsOutRpc(void)
+        {
+            return double(this->get_ItemsOut());
+        }
+
+        std::vector<float> get_WorkHistRpc(void)
+        {
+            std::vector<float> vHist(PERF_HIST_BINS);
+            for(int index = 0; index < PERF_HIST_BINS; ++index)  // go through the bins
+            {
+                vHist[index] = float(this->get_Hist(index));
+            }
+            return vHist;
+        }
+
+        void setup_Perf_Rpc(const std::string &alias)  // register the counters with ControlPort; called from setup_rpc
+        {
+            #ifdef GR_CTRLPORT
+            typedef double (Perf_Block::*Counter_Getter)(void);
+            static const Counter_Getter ary_Getters[PERF_MAX_COUNTERS] = {&Perf_Block::get_CounterRpc<0>, &Perf_Block::get_CounterRpc<1>, &Perf_Block::get_CounterRpc<2>, &Perf_Block::get_CounterRpc<3>,
+                                                                            &Perf_Block::get_CounterRpc<4>, &Perf_Block::get_CounterRpc<5>};
+            static_assert(PERF_MAX_COUNTERS == 6, "update the ControlPort getter table");
+
+            vRpcVars.push_back(rpcbasic_sptr(new rpcbasic_register_get<Perf_Block, double>(alias, "work_calls", &Perf_Block::get_WorkCallsRpc,
+                pmt::mp(0.0), pmt::mp(1e18), pmt::mp(0.0), "calls", "Number of work calls", RPC_PRIVLVL_MIN, DISPTIME | DISPOPTSTRIP)));
+            vRpcVars.push_back(rpcbasic_sptr(new rpcbasic_register_get<Perf_Block, double>(alias, "items_in", &Perf_Block::get_ItemsInRpc,
+                pmt::mp(0.0), pmt::mp(1e18), pmt::mp(0.0), "items", "Consumed items", RPC_PRIVLVL_MIN, DISPTIME | DISPOPTSTRIP)));
+            vRpcVars.push_back(rpcbasic_sptr(new rpcbasic_register_get<Perf_Block, double>(alias, "items_out", &Perf_Block::get_ItemsOutRpc,
+                pmt::mp(0.0), pmt::mp(1e18), pmt::mp(0.0), "items", "Produced items", RPC_PRIVLVL_MIN, DISPTIME | DISPOPTSTRIP)));
+            vRpcVars.push_back(rpcbasic_sptr(new rpcbasic_register_get<Perf_Block, std::vector<float>>(alias, "work_time_hist", &Perf_Block::get_WorkHistRpc,
+                pmt::make_f32vector(1, 0), pmt::make_f32vector(1, 1e18), pmt::make_f32vector(1, 0), "calls", "Work duration histogram; bin k holds [2^k, 2^(k+1)) ns", RPC_PRIVLVL_MIN, DISPTIME)));
+            for(int index = 0; index < this->get_NumOfCounters(); ++index)  // go through the module specific counters
+            {
+                vRpcVars.push_back(rpcbasic_sptr(new rpcbasic_register_get<Perf_Block, double>(alias, this->get_CounterName(index), ary_Getters[index],
+                    pmt::mp(0.0), pmt::mp(1e18), pmt::mp(0.0), "", this->get_CounterName(index), RPC_PRIVLVL_MIN, DISPTIME | DISPOPTSTRIP)));
+            }
+            vRpcVars.push_back(rpcbasic_sptr(new rpcbasic_register_get<Perf_Block, int>(alias, "stats_period", &Perf_Block::get_StatsPeriod,
+                pmt::mp(0), pmt::mp(60000), pmt::mp(STATS_PERIOD_DEF), "ms", "Stats message period; 0 is off", RPC_PRIVLVL_MIN, DISPNULL)));
+            vRpcVars.push_back(rpcbasic_sptr(new rpcbasic_register_set<Perf_Block, int>(alias, "stats_period", &Perf_Block::set_StatsPeriod,
+                pmt::mp(0), pmt::mp(60000), pmt::mp(STATS_PERIOD_DEF), "ms", "Stats message period; 0 is off", RPC_PRIVLVL_MIN, DISPNULL)));
+            #else
+            (void)alias;  // ControlPort is not compiled in
+            #endif
+        }
+    };
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_PERF_BLOCK_H */
@@ -0,0 +1,156 @@
+#ifndef INCLUDED_COMM_KERNELS_PERF_COUNTERS_H
+#define INCLUDED_COMM_KERNELS_PERF_COUNTERS_H
+
+// per-block performance counters: work calls, items in/out, a log2 histogram of the work duration
+// and up to PERF_MAX_COUNTERS module specific counters. The work thread is the only writer, so a
+// counter update is a relaxed load and store (no locked instruction); any thread may read them.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "defaults.h"
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    class Perf_Counters
+    {
+        private:
+        std::atomic<uint64_t> uWorkCalls;  // number of work calls
+        std::atomic<uint64_t> uItemsIn;  // consumed items
+        std::atomic<uint64_t> uItemsOut;  // produced items
+        std::atomic<uint64_t> ary_uHist[PERF_HIST_BINS];  // work duration histogram
+        std::atomic<uint64_t> ary_uCounters[PERF_MAX_COUNTERS];  // module specific counters
+        const char *ary_cNames[PERF_MAX_COUNTERS];  // names of the module specific counters
+        int iNumOfCounters;  // number of module specific counters
+
+        static void Add(std::atomic<uint64_t> &counter, const uint64_t uValue)  // single writer increment
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + uValue, std::memory_order_relaxed);
+        }
+
+        public:
+        Perf_Counters() : uWorkCalls(0), uItemsIn(0), uItemsOut(0), iNumOfCounters(0)
+        {
+            for(int index = 0; index < PERF_HIST_BINS; ++index)  // go through the bins
+            {
+                ary_uHist[index].store(0, std::memory_order_relaxed);
+            }
+            for(int index = 0; index < PERF_MAX_COUNTERS; ++index)  // go through the counters
+            {
+                ary_uCounters[index].store(0, std::memory_order_relaxed);
+                ary_cNames[index] = nullptr;
+            }
+        }
+        virtual ~Perf_Counters() {}
+
+        virtual void work_Done(void) {}  // called after each timed work call; the block side publishes from here
+
+        static int Log2Bin(const uint64_t uTime)  // histogram bin of a duration (ns)
+        {
+            if(uTime < 2)  // below the first power of two
+            {
+                return 0;
+            }
+            int iBin = 63 - __builtin_clzll(uTime);  // floor(log2(uTime))
+            return (iBin < PERF_HIST_BINS) ? iBin : (PERF_HIST_BINS - 1);  // the last bin takes the rest
+        }
+
+        int add_Counter(const char *name)  // register a module specific counter (constructor); returns its index
+        {
+            if(iNumOfCounters == PERF_MAX_COUNTERS)  // no free counter
+            {
+                return -1;
+            }
+            ary_cNames[iNumOfCounters] = name;
+            return iNumOfCounters++;
+        }
+
+        void count(const int index_c, const uint64_t uValue = 1)  // increment a module specific counter
+        {
+            if(index_c >= 0)  // registered counter
+            {
+                Add(ary_uCounters[index_c], uValue);
+            }
+        }
+
+        void add_Work(const uint64_t uTime, const uint64_t uIn, const uint64_t uOut)  // one work call
+        {
+            Add(uWorkCalls, 1);
+            Add(uItemsIn, uIn);
+            Add(uItemsOut, uOut);
+            Add(ary_uHist[Log2Bin(uTime)], 1);
+        }
+
+        uint64_t get_WorkCalls(void) const
+        {
+            return uWorkCalls.load(std::memory_order_relaxed);
+        }
+
+        uint64_t get_ItemsIn(void) const
+        {
+            return uItemsIn.load(std::memory_order_relaxed);
+        }
+
+        uint64_t get_ItemsOut(void) const
+        {
+            return uItemsOut.load(std::memory_order_relaxed);
+        }
+
+        uint64_t get_Hist(const int index_b) const  // count of histogram bin 'index_b'
+        {
+            return ary_uHist[index_b].load(std::memory_order_relaxed);
+        }
+
+        int get_NumOfCounters(void) const
+        {
+            return iNumOfCounters;
+        }
+
+        const char *get_CounterName(const int index_c) const
+        {
+            return ary_cNames[index_c];
+        }
+
+        uint64_t get_Counter(const int index_c) const
+        {
+            return ary_uCounters[index_c].load(std::memory_order_relaxed);
+        }
+    };
+
+
+    // times one work call; the duration and the items are added to the counters when it goes out of scope
+    class Work_Timer
+    {
+        private:
+        Perf_Counters &Counters;  // counters of the block
+        std::chrono::steady_clock::time_point tStart;  // work entry time
+        uint64_t uIn;  // consumed items
+        uint64_t uOut;  // produced items
+
+        public:
+        Work_Timer(Perf_Counters &counters) : Counters(counters), tStart(std::chrono::steady_clock::now()), uIn(0), uOut(0) {}
+
+        ~Work_Timer()
+        {
+            uint64_t uTime = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count());
+            Counters.add_Work(uTime, uIn, uOut);
+            Counters.work_Done();
+        }
+
+        void set_Items(const int iIn, const int iOut)  // items of this call
+        {
+            uIn = uint64_t(iIn);
+            uOut = uint64_t(iOut);
+        }
+
+        Work_Timer(const Work_Timer &) = delete;
+        Work_Timer &operator=(const Work_Timer &) = delete;
+    };
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_PERF_COUNTERS_H */
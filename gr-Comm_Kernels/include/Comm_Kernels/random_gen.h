@@ -0,0 +1,338 @@
+#ifndef INCLUDED_COMM_KERNELS_RANDOM_GEN_H
+#define INCLUDED_COMM_KERNELS_RANDOM_GEN_H
+
+
+#include <cmath>
+#include <ctime>
+#include <cstdint>
+#include <atomic>
+#include <random>
+
+#ifdef _DEBUG_MODE_
+#include <iostream>
+#endif
+
+#include "defaults.h"
+#include "macros.h"
+#include "simd_math.h"
+#include "array_kernels.h"
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // counter-based random number engine (Philox4x32-10)
+    class Philox_Rand_Eng
+    {
+        private:
+        uint32_t uKey[2];  // engine key (seed)
+        uint32_t uCounter[4];  // block counter; words 0-1 count blocks, words 2-3 hold the stream id
+        uint32_t uBlock[4];  // last generated block
+        int iBlockIndex;  // index of next unused word in the last block
+        float fUniformArray[RNG_BUFF_SIZE];  // auxiliary uniform numbers storage
+
+        static std::atomic<uint64_t> &InstanceCounter(void)  // number of engines created with automatic seeding
+        {
+            static std::atomic<uint64_t> uInstanceCounter(0);
+            return uInstanceCounter;
+        }
+
+        void NextBlock(uint32_t *ptr_uOutBlock);  // generate next block of 4 random words and increment the counter
+
+        public:
+        static const int BlockSize = 4;  // number of random words per block
+
+        Philox_Rand_Eng();  // constructor; seeds from time and instance number
+        Philox_Rand_Eng(const uint64_t seed, const uint64_t stream = 0);  // constructor; seeds with given seed and stream id
+        ~Philox_Rand_Eng();
+
+        void set_Seed(const uint64_t seed, const uint64_t stream = 0);  // reset the engine to the start of the given stream
+        uint32_t next(void);  // return next random word
+        void fill_uniform(float *ptr_fOutArray, const int iArrayLen = 0);  // fill array with uniformly distributed numbers in (0, 1)
+        void fill_normal(float *ptr_fOutArray, const int iArrayLen = 0, const float mean = 0.0, const float std = 1.0);  // fill array with normally distributed numbers
+        void fill_bits(char *ptr_cOutArray, const int iArrayLen = 0);  // fill array with uniformly distributed bits (VAL_0, VAL_1)
+    };
+
+    // normal random number/bit generator
+    class Norm_Rand_Gen
+    {
+        private:
+        Philox_Rand_Eng RandEng;  // random number engine
+        float fGaussGenArray[RNG_BUFF_SIZE];  // normal random numbers storage
+        int iGaussGenCounter;  // index of next unused number in the storage
+
+        public:
+        Norm_Rand_Gen();  // constructor; seeds from time and instance number
+        Norm_Rand_Gen(const uint64_t seed, const uint64_t stream = 0);  // constructor; reproducible stream of the given seed
+        ~Norm_Rand_Gen();
+        void set_Seed(const uint64_t seed, const uint64_t stream = 0);  // restart from the given seed and stream; drops stored numbers
+        float GaussNormNumGen(float mean = 0.0, float std = 1.0);  // normally distributed number generator
+        float RayleighNumGen(float mult_cnt = 1.0, float div_cnt = 1.0);  // Rayleigh distributed number generator
+        float LogNormalNumGen(float mu_x = 1.0, float sig_x = 0.1);  // log-normal distributed number generator
+        void NormDistArray(float *ptr_fInArray, const int iArrayLen = 0);  // fill input array with normally distributed numbers
+        void RayleighDistArray(float *ptr_fInArray, float p1 = 1.0, float p2 = 1.0, const int iArrayLen = 0);  // fill input array with Rayleigh distributed numbers
+        void LogNormalDistArray(float *ptr_fInArray, float mu_x = 1.0, float sig_x = 0.1, const int iArrayLen = 0);  // fill input array with log-normal distributed numbers
+        void UniformBinary(char *ptr_cInArray, const int iArrayLen = 0);  // fill input array with normally distributed binary numbers (0, 1)
+    };
+
+
+    inline Philox_Rand_Eng::Philox_Rand_Eng()  // constructor; seeds from time and instance number
+    {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Philox_Rand_Eng: Default constructor called." << std::endl;
+        #endif
+        uint64_t seed = (uint64_t(std::random_device()()) << 32) ^ uint64_t(time(0));  // process unique seed
+        this->set_Seed(seed, InstanceCounter()++);  // each instance takes its own stream
+    }
+
+
+    inline Philox_Rand_Eng::Philox_Rand_Eng(const uint64_t seed, const uint64_t stream)  // constructor; seeds with given seed and stream id
+    {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Philox_Rand_Eng: Constructor called." << std::endl;
+        #endif
+        this->set_Seed(seed, stream);  // set the key and the counter
+    }
+
+
+    inline Philox_Rand_Eng::~Philox_Rand_Eng()
+    {
+    }
+
+
+    inline void Philox_Rand_Eng::set_Seed(const uint64_t seed, const uint64_t stream)  // reset the engine to the start of the given stream
+    {
+        uKey[0] = uint32_t(seed);  // low word of the seed
+        uKey[1] = uint32_t(seed >> 32);  // high word of the seed
+        uCounter[0] = 0;  // block counter starts from 0
+        uCounter[1] = 0;
+        uCounter[2] = uint32_t(stream);  // stream id keeps streams apart
+        uCounter[3] = uint32_t(stream >> 32);
+        iBlockIndex = BlockSize;  // mark the last block as used up
+    }
+
+
+    inline void Philox_Rand_Eng::NextBlock(uint32_t *ptr_uOutBlock)  // generate next block of 4 random words and increment the counter
+    {
+        uint32_t c0 = uCounter[0], c1 = uCounter[1], c2 = uCounter[2], c3 = uCounter[3];  // round state
+        uint32_t k0 = uKey[0], k1 = uKey[1];  // round key
+
+        for(int index = 0; index < PHILOX_ROUNDS; ++index)  // go through the rounds
+        {
+            uint64_t p0 = uint64_t(PHILOX_M0) * c0;  // first product
+            uint64_t p1 = uint64_t(PHILOX_M1) * c2;  // second product
+
+            c0 = uint32_t(p1 >> 32) ^ c1 ^ k0;  // mix high words with the key
+            c1 = uint32_t(p1);
+            c2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+            c3 = uint32_t(p0);
+
+            k0 += PHILOX_W0;  // bump the key for the next round
+            k1 += PHILOX_W1;
+        }
+
+        ptr_uOutBlock[0] = c0;  // store the block
+        ptr_uOutBlock[1] = c1;
+        ptr_uOutBlock[2] = c2;
+        ptr_uOutBlock[3] = c3;
+
+        if(++uCounter[0] == 0)  // 64-bit block counter
+        {
+            ++uCounter[1];
+        }
+    }
+
+
+    inline uint32_t Philox_Rand_Eng::next(void)  // return next random word
+    {
+        if(iBlockIndex >= BlockSize)  // last block is used up
+        {
+            this->NextBlock(uBlock);  // generate a new one
+            iBlockIndex = 0;
+        }
+
+        return uBlock[iBlockIndex++];
+    }
+
+
+    inline void Philox_Rand_Eng::fill_uniform(float *ptr_fOutArray, const int iArrayLen)  // fill array with uniformly distributed numbers in (0, 1)
+    {
+        int index = 0;
+        uint32_t uAuxBlock[4];  // auxiliary block
+
+        while((index < iArrayLen) && (iBlockIndex < BlockSize))  // use what is left from the last block
+        {
+            ptr_fOutArray[index++] = U32_TO_UNIT(uBlock[iBlockIndex++]);
+        }
+
+        for(; index + BlockSize <= iArrayLen; index += BlockSize)  // whole blocks straight into the array
+        {
+            this->NextBlock(uAuxBlock);
+            for(int index_w = 0; index_w < BlockSize; ++index_w)  // go through the words of the block
+            {
+                ptr_fOutArray[index + index_w] = U32_TO_UNIT(uAuxBlock[index_w]);
+            }
+        }
+
+        for(; index < iArrayLen; ++index)  // remaining elements
+        {
+            ptr_fOutArray[index] = U32_TO_UNIT(this->next());
+        }
+    }
+
+
+    inline void Philox_Rand_Eng::fill_normal(float *ptr_fOutArray, const int iArrayLen, const float mean, const float std)  // fill array with normally distributed numbers
+    {
+        // Box-Muller transform over chunks of RNG_BUFF_SIZE numbers
+        // https://en.wikipedia.org/wiki/Box%E2%80%93Muller_transform
+        for(int index = 0; index < iArrayLen; index += RNG_BUFF_SIZE)  // go through the chunks
+        {
+            float *ptr_fChunk = ptr_fOutArray + index;  // current chunk
+            int iChunkLen = MIN(RNG_BUFF_SIZE, iArrayLen - index);  // current chunk length
+            int iPairs = iChunkLen/2;  // number of complete pairs
+
+            this->fill_uniform(fUniformArray, 2*((iChunkLen + 1)/2));  // uniform numbers for the chunk
+
+            BoxMullerArray(fUniformArray, fUniformArray + iPairs, ptr_fChunk, ptr_fChunk + iPairs, iPairs, mean, std);  // whole pairs in bulk
+
+            if(iChunkLen%2 != 0)  // odd chunk length; one number is left
+            {
+                float r = std*std::sqrt(-2.0f*std::log(fUniformArray[2*iPairs]));  // radius
+                float theta = float(2.0*M_PI)*fUniformArray[2*iPairs + 1];  // angle
+
+                ptr_fChunk[2*iPairs] = r*std::cos(theta) + mean;  // last random value
+            }
+        }
+    }
+
+
+    inline void Philox_Rand_Eng::fill_bits(char *ptr_cOutArray, const int iArrayLen)  // fill array with uniformly distributed bits (VAL_0, VAL_1)
+    {
+        int index = 0;
+        const int iWordBits = 32;  // number of bits per random word
+
+        for(; index + iWordBits <= iArrayLen; index += iWordBits)  // whole words
+        {
+            uint32_t uWord = this->next();  // random word
+            for(int index_b = 0; index_b < iWordBits; ++index_b)  // go through the bits of the word
+            {
+                ptr_cOutArray[index + index_b] = ((uWord >> index_b) & 1) ? VAL_1 : VAL_0;
+            }
+        }
+
+        if(index < iArrayLen)  // remaining bits
+        {
+            uint32_t uWord = this->next();  // random word
+            for(int index_b = 0; index < iArrayLen; ++index, ++index_b)  // go through the remaining bits
+            {
+                ptr_cOutArray[index] = ((uWord >> index_b) & 1) ? VAL_1 : VAL_0;
+            }
+        }
+    }
+
+
+    inline Norm_Rand_Gen::Norm_Rand_Gen()
+    {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Norm_Rand_Gen: Constructor called." << std::endl;
+        #endif        
+        iGaussGenCounter = RNG_BUFF_SIZE;  // mark storage as used up; first call fills it
+    }
+
+
+    inline Norm_Rand_Gen::Norm_Rand_Gen(const uint64_t seed, const uint64_t stream) : RandEng(seed, stream)
+    {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Norm_Rand_Gen: Constructor called; seed = " << seed << ", stream = " << stream << std::endl;
+        #endif        
+        iGaussGenCounter = RNG_BUFF_SIZE;  // mark storage as used up; first call fills it
+    }
+
+
+    inline Norm_Rand_Gen::~Norm_Rand_Gen()
+    {
+    }
+
+
+    inline void Norm_Rand_Gen::set_Seed(const uint64_t seed, const uint64_t stream)  // restart from the given seed and stream; drops stored numbers
+    {
+        RandEng.set_Seed(seed, stream);  // reset the engine
+        iGaussGenCounter = RNG_BUFF_SIZE;  // mark storage as used up
+    }
+
+
+    inline float Norm_Rand_Gen::GaussNormNumGen(float mean, float std)  // normally distributed number generator
+    {
+        if(iGaussGenCounter >= RNG_BUFF_SIZE)  // storage is used up
+        {
+            RandEng.fill_normal(fGaussGenArray, RNG_BUFF_SIZE);  // refill the storage in one go
+            iGaussGenCounter = 0;  // set counter to 0
+        }
+
+        return fGaussGenArray[iGaussGenCounter++]*std + mean;
+    }
+
+    inline float Norm_Rand_Gen::RayleighNumGen(float mult_cnt, float div_cnt)  // Rayleigh distributed number generator
+    {
+        float x, y;
+
+        x = GaussNormNumGen(0.0, 1.0)*mult_cnt;
+        y = GaussNormNumGen(0.0, 1.0)*mult_cnt;
+
+        float r = sqrt( POW2(x) + POW2(y) );  // calculate random radius based on the normal distribution
+        
+        return exp( -2.0*POW2(r) / div_cnt );  // calculate Log-Normal random sequence
+    }
+
+    inline float Norm_Rand_Gen::LogNormalNumGen(float mu_x, float sig_x)  // log-normal distributed number generator
+    {
+        return exp( 2.0*GaussNormNumGen(mu_x, sig_x) );  // calculate Log-Normal random sequence
+    }
+
+    inline void Norm_Rand_Gen::NormDistArray(float *ptr_fInArray, const int iArrayLen)  // fill input array with normally distributed numbers
+    {
+        // numbers are taken from the storage so the sequence does not depend on how the calls split it
+        for(int index = 0; index < iArrayLen; )  // go through all elements
+        {
+            if(iGaussGenCounter >= RNG_BUFF_SIZE)  // storage is used up
+            {
+                RandEng.fill_normal(fGaussGenArray, RNG_BUFF_SIZE);  // refill the storage in one go
+                iGaussGenCounter = 0;  // set counter to 0
+            }
+
+            int iCopyLen = MIN(RNG_BUFF_SIZE - iGaussGenCounter, iArrayLen - index);  // numbers available in the storage
+            CopyArrays<float>((fGaussGenArray + iGaussGenCounter), (ptr_fInArray + index), iCopyLen);  // take them in bulk
+
+            iGaussGenCounter += iCopyLen;
+            index += iCopyLen;
+        }
+    }
+
+    inline void Norm_Rand_Gen::RayleighDistArray(float *ptr_fInArray, float p1, float p2, const int iArrayLen)  // fill input array with Rayleigh distributed numbers
+    {
+        // x^2 + y^2 of two standard normal numbers is -2*log(u) with u uniform in (0, 1),
+        // so exp(-2*p1^2*(x^2 + y^2)/p2) = exp(4*p1^2/p2*log(u)); no normal numbers are needed
+        float fScale = 4.0*POW2(p1)/p2;  // exponent scale
+
+        RandEng.fill_uniform(ptr_fInArray, iArrayLen);  // uniform numbers
+        LogArray(ptr_fInArray, ptr_fInArray, iArrayLen);  // log(u)
+        LinearMap<float>(ptr_fInArray, ptr_fInArray, iArrayLen, fScale, 0.0);  // scale the exponent
+        ExpArray(ptr_fInArray, ptr_fInArray, iArrayLen);  // channel coefficients
+    }
+
+    inline void Norm_Rand_Gen::LogNormalDistArray(float *ptr_fInArray, float mu_x, float sig_x, const int iArrayLen)  // fill input array with log-normal distributed numbers
+    {
+        this->NormDistArray(ptr_fInArray, iArrayLen);  // N(0, 1)
+        LinearMap<float>(ptr_fInArray, ptr_fInArray, iArrayLen, 2.0*sig_x, 2.0*mu_x);  // 2*N(mu_x, sig_x)
+        ExpArray(ptr_fInArray, ptr_fInArray, iArrayLen);  // channel coefficients
+    }
+
+    inline void Norm_Rand_Gen::UniformBinary(char *ptr_cInArray, const int iArrayLen)  // fill input array with uniformly distributed binary numbers (VAL_0, VAL_1)
+    {
+        RandEng.fill_bits(ptr_cInArray, iArrayLen);  // bulk generation
+    }
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_RANDOM_GEN_H */
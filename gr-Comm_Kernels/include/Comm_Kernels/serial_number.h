@@ -0,0 +1,36 @@
+#ifndef INCLUDED_COMM_KERNELS_SERIAL_NUMBER_H
+#define INCLUDED_COMM_KERNELS_SERIAL_NUMBER_H
+
+// Serial number arithmetic of RFC 1982 on sequence numbers of 'iBits' bits (1 to 63): a number wraps to 0 after
+// 2^iBits - 1, and of two numbers the one less than 2^(iBits - 1) steps ahead of the other is the later one.
+// Differences stay right across the wrap, so a counter field of any width can be compared with no extra state.
+
+#include <cstdint>
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // mask of the sequence number bits
+    inline uint64_t SeqMask(int iBits)
+    {
+        return (uint64_t(1) << iBits) - 1;
+    }
+
+    // sequence number 'iSteps' after 'uSeq'; negative steps go back
+    inline uint64_t SeqAdd(uint64_t uSeq, int64_t iSteps, int iBits)
+    {
+        return (uSeq + uint64_t(iSteps)) & SeqMask(iBits);
+    }
+
+    // signed number of steps from 'uSeq_2' to 'uSeq_1'; positive if 'uSeq_1' is the later one, in [-2^(iBits - 1), 2^(iBits - 1))
+    inline int64_t SeqDiff(uint64_t uSeq_1, uint64_t uSeq_2, int iBits)
+    {
+        uint64_t uForward = (uSeq_1 - uSeq_2) & SeqMask(iBits);  // steps forward from 'uSeq_2' to 'uSeq_1'
+        return ((uForward >> (iBits - 1)) != 0) ? int64_t(uForward) - int64_t(SeqMask(iBits)) - 1 : int64_t(uForward);
+    }
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_SERIAL_NUMBER_H */
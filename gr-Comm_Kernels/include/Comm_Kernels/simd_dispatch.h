@@ -0,0 +1,94 @@
+#ifndef INCLUDED_COMM_KERNELS_SIMD_DISPATCH_H
+#define INCLUDED_COMM_KERNELS_SIMD_DISPATCH_H
+
+
+#if defined(__x86_64__) || defined(__i386__)
+#define _SIMD_X86_
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define _SIMD_NEON_
+#include <arm_neon.h>
+#endif
+
+#ifdef _DEBUG_MODE_
+#include <iostream>
+#endif
+
+
+#define SIMD_SCALAR                         (0)                                         // plain C++ kernels
+#define SIMD_SSE2                           (1)                                         // SSE2 kernels
+#define SIMD_NEON                           (2)                                         // AArch64 NEON kernels
+#define SIMD_AVX2                           (3)                                         // AVX2 + FMA kernels
+#define SIMD_AVX512                         (4)                                         // AVX-512F kernels
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // every kernel is compiled for all sets of the target architecture; the set is picked at run time,
+    // so one binary runs on any CPU of the architecture and still uses the widest vectors it has
+    inline int SIMD_Level(void)  // SIMD kernel set picked for this CPU; detected once on first call
+    {
+        static const int iLevel = []() -> int {
+            int iDetected = SIMD_SCALAR;  // no vector unit by default
+
+            #ifdef _SIMD_X86_
+            __builtin_cpu_init();  // make sure CPU features are available
+            if(__builtin_cpu_supports("avx512f"))
+            {
+                iDetected = SIMD_AVX512;
+            }
+            else if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            {
+                iDetected = SIMD_AVX2;
+            }
+            else if(__builtin_cpu_supports("sse2"))
+            {
+                iDetected = SIMD_SSE2;
+            }
+            #endif
+
+            #ifdef _SIMD_NEON_
+            iDetected = SIMD_NEON;  // NEON is part of the AArch64 baseline
+            #endif
+
+            #ifdef _GENERIC_KERNELS_
+            iDetected = SIMD_SCALAR;  // plain C++ kernels are forced for comparison
+            #endif
+
+            #ifdef _DEBUG_MODE_
+            std::cout << "SIMD_Level: kernel set = " << iDetected << std::endl;
+            #endif
+
+            return iDetected;
+        }();
+
+        return iLevel;
+    }
+
+
+    inline int SIMD_Width(const int iLevel)  // floats per vector of the given kernel set
+    {
+        switch(iLevel)
+        {
+            case SIMD_AVX512: return 16;
+            case SIMD_AVX2: return 8;
+            case SIMD_SSE2: return 4;
+            case SIMD_NEON: return 4;
+            default: return 1;
+        }
+    }
+
+
+    inline void PadArray(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen, const int iWidth)  // copy a partial vector and pad it with 1.0 (valid input of all kernels)
+    {
+        for(int index = 0; index < iWidth; ++index)  // go through the vector
+        {
+            ptr_fOutArray[index] = (index < iArrayLen) ? ptr_fInArray[index] : 1.0f;
+        }
+    }
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_SIMD_DISPATCH_H */
@@ -0,0 +1,663 @@
+#ifndef INCLUDED_COMM_KERNELS_SIMD_MATH_H
+#define INCLUDED_COMM_KERNELS_SIMD_MATH_H
+
+
+#include <cmath>
+#include <algorithm>
+
+#include "defaults.h"
+#include "simd_dispatch.h"
+
+
+// polynomial approximations are the single precision ones of the Cephes library
+// http://www.netlib.org/cephes/
+#define LOG_SQRTHF                          (0.707106781186547524f)                     // sqrt(1/2); mantissa split point
+#define LOG_P0                              (7.0376836292e-2f)                          // log polynomial coefficients
+#define LOG_P1                              (-1.1514610310e-1f)
+#define LOG_P2                              (1.1676998740e-1f)
+#define LOG_P3                              (-1.2420140846e-1f)
+#define LOG_P4                              (1.4249322787e-1f)
+#define LOG_P5                              (-1.6668057665e-1f)
+#define LOG_P6                              (2.0000714765e-1f)
+#define LOG_P7                              (-2.4999993993e-1f)
+#define LOG_P8                              (3.3333331174e-1f)
+#define LN2_HI                              (0.693359375f)                              // ln(2) split in two parts for exact range reduction
+#define LN2_LO                              (-2.12194440e-4f)
+#define EXP_HI                              (88.3762626647949f)                         // exp input range
+#define EXP_LO                              (-87.3365447504019f)
+#define LOG2EF                              (1.44269504088896341f)                      // log2(e)
+#define EXP_P0                              (1.9875691500e-4f)                          // exp polynomial coefficients
+#define EXP_P1                              (1.3981999507e-3f)
+#define EXP_P2                              (8.3334519073e-3f)
+#define EXP_P3                              (4.1665795894e-2f)
+#define EXP_P4                              (1.6666665459e-1f)
+#define EXP_P5                              (5.0000001201e-1f)
+#define SIN_P0                              (-1.9515295891e-4f)                         // sin polynomial coefficients on [-pi/4, pi/4]
+#define SIN_P1                              (8.3321608736e-3f)
+#define SIN_P2                              (-1.6666654611e-1f)
+#define COS_P0                              (2.443315711809948e-5f)                     // cos polynomial coefficients on [-pi/4, pi/4]
+#define COS_P1                              (-1.388731625493765e-3f)
+#define COS_P2                              (4.166664568298827e-2f)
+#define PI_2F                               (1.57079632679489662f)                      // pi/2
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+
+    // scalar kernels; also used when no vector unit is available
+    inline void LogArray_Scalar(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)
+    {
+        for(int index = 0; index < iArrayLen; ++index)  // go through all elements
+        {
+            ptr_fOutArray[index] = std::log(ptr_fInArray[index]);
+        }
+    }
+
+
+    inline void ExpArray_Scalar(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)
+    {
+        for(int index = 0; index < iArrayLen; ++index)  // go through all elements
+        {
+            ptr_fOutArray[index] = std::exp(ptr_fInArray[index]);
+        }
+    }
+
+
+    inline void BoxMullerArray_Scalar(const float *ptr_fU1, const float *ptr_fU2, float *ptr_fOut1, float *ptr_fOut2,
+                                      const int iArrayLen, const float mean, const float std)
+    {
+        for(int index = 0; index < iArrayLen; ++index)  // go through all pairs
+        {
+            float r = std*std::sqrt(-2.0f*std::log(ptr_fU1[index]));  // radius
+            float theta = 4.0f*PI_2F*ptr_fU2[index];  // angle
+
+            ptr_fOut1[index] = r*std::cos(theta) + mean;  // first random value
+            ptr_fOut2[index] = r*std::sin(theta) + mean;  // second random value
+        }
+    }
+
+
+    #ifdef _SIMD_X86_
+    // SSE2 kernels; 4 floats per vector; the set has no FMA, so products and sums are separate
+    __attribute__((target("sse2"))) inline __m128 MulAdd_SSE2(__m128 a, __m128 b, __m128 c)  // a*b + c
+    {
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    }
+
+
+    __attribute__((target("sse2"))) inline __m128 Log_SSE2(__m128 x)
+    {
+        __m128i iBits = _mm_castps_si128(x);
+        __m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(iBits, 23), _mm_set1_epi32(126)));  // exponent
+        __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(iBits, _mm_set1_epi32(0x007FFFFF)),
+                                                 _mm_set1_epi32(0x3F000000)));  // mantissa in [0.5, 1)
+        __m128 mask = _mm_cmplt_ps(m, _mm_set1_ps(LOG_SQRTHF));  // mantissa below sqrt(1/2)
+
+        e = _mm_sub_ps(e, _mm_and_ps(mask, _mm_set1_ps(1.0f)));  // move mantissa to [sqrt(1/2), sqrt(2))
+        m = _mm_sub_ps(_mm_add_ps(m, _mm_and_ps(mask, m)), _mm_set1_ps(1.0f));
+
+        __m128 z = _mm_mul_ps(m, m);
+        __m128 y = _mm_set1_ps(LOG_P0);
+        y = MulAdd_SSE2(y, m, _mm_set1_ps(LOG_P1));
+        y = MulAdd_SSE2(y, m, _mm_set1_ps(LOG_P2));
+        y = MulAdd_SSE2(y, m, _mm_set1_ps(LOG_P3));
+        y = MulAdd_SSE2(y, m, _mm_set1_ps(LOG_P4));
+        y = MulAdd_SSE2(y, m, _mm_set1_ps(LOG_P5));
+        y = MulAdd_SSE2(y, m, _mm_set1_ps(LOG_P6));
+        y = MulAdd_SSE2(y, m, _mm_set1_ps(LOG_P7));
+        y = MulAdd_SSE2(y, m, _mm_set1_ps(LOG_P8));
+        y = _mm_mul_ps(_mm_mul_ps(y, m), z);
+
+        y = MulAdd_SSE2(e, _mm_set1_ps(LN2_LO), y);
+        y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+        return MulAdd_SSE2(e, _mm_set1_ps(LN2_HI), _mm_add_ps(m, y));
+    }
+
+
+    __attribute__((target("sse2"))) inline __m128 Exp_SSE2(__m128 x)
+    {
+        x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(EXP_LO)), _mm_set1_ps(EXP_HI));  // keep the result finite
+
+        __m128i in = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(LOG2EF)));  // power of 2; conversion rounds to nearest
+        __m128 n = _mm_cvtepi32_ps(in);
+        x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(LN2_HI)));  // remainder
+        x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(LN2_LO)));
+
+        __m128 y = _mm_set1_ps(EXP_P0);
+        y = MulAdd_SSE2(y, x, _mm_set1_ps(EXP_P1));
+        y = MulAdd_SSE2(y, x, _mm_set1_ps(EXP_P2));
+        y = MulAdd_SSE2(y, x, _mm_set1_ps(EXP_P3));
+        y = MulAdd_SSE2(y, x, _mm_set1_ps(EXP_P4));
+        y = MulAdd_SSE2(y, x, _mm_set1_ps(EXP_P5));
+        y = MulAdd_SSE2(y, _mm_mul_ps(x, x), _mm_add_ps(x, _mm_set1_ps(1.0f)));
+
+        __m128i iPow2 = _mm_slli_epi32(_mm_add_epi32(in, _mm_set1_epi32(127)), 23);  // 2^n
+        return _mm_mul_ps(y, _mm_castsi128_ps(iPow2));
+    }
+
+
+    __attribute__((target("sse2"))) inline void SinCos2Pi_SSE2(__m128 u, __m128 *ptr_s, __m128 *ptr_c)  // sin and cos of 2*pi*u
+    {
+        __m128 v = _mm_mul_ps(u, _mm_set1_ps(4.0f));
+        __m128i iq = _mm_cvtps_epi32(v);  // quadrant; conversion rounds to nearest
+        __m128 r = _mm_mul_ps(_mm_sub_ps(v, _mm_cvtepi32_ps(iq)), _mm_set1_ps(PI_2F));  // angle in [-pi/4, pi/4]
+        __m128 z = _mm_mul_ps(r, r);
+
+        __m128 sr = _mm_set1_ps(SIN_P0);
+        sr = MulAdd_SSE2(sr, z, _mm_set1_ps(SIN_P1));
+        sr = MulAdd_SSE2(sr, z, _mm_set1_ps(SIN_P2));
+        sr = MulAdd_SSE2(_mm_mul_ps(sr, z), r, r);
+
+        __m128 cr = _mm_set1_ps(COS_P0);
+        cr = MulAdd_SSE2(cr, z, _mm_set1_ps(COS_P1));
+        cr = MulAdd_SSE2(cr, z, _mm_set1_ps(COS_P2));
+        cr = MulAdd_SSE2(_mm_mul_ps(cr, z), z, _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(z, _mm_set1_ps(0.5f))));
+
+        __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(iq, _mm_set1_epi32(1)), _mm_set1_epi32(1)));  // odd quadrant
+        __m128 sSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(iq, _mm_set1_epi32(2)), 30));
+        __m128 cSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(iq, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+
+        *ptr_s = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, cr), _mm_andnot_ps(swap, sr)), sSign);
+        *ptr_c = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, sr), _mm_andnot_ps(swap, cr)), cSign);
+    }
+
+
+    __attribute__((target("sse2"))) inline void LogArray_SSE2(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)
+    {
+        for(int index = 0; index < iArrayLen; index += 4)  // go through all vectors
+        {
+            _mm_storeu_ps(ptr_fOutArray + index, Log_SSE2(_mm_loadu_ps(ptr_fInArray + index)));
+        }
+    }
+
+
+    __attribute__((target("sse2"))) inline void ExpArray_SSE2(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)
+    {
+        for(int index = 0; index < iArrayLen; index += 4)  // go through all vectors
+        {
+            _mm_storeu_ps(ptr_fOutArray + index, Exp_SSE2(_mm_loadu_ps(ptr_fInArray + index)));
+        }
+    }
+
+
+    __attribute__((target("sse2"))) inline void BoxMullerArray_SSE2(const float *ptr_fU1, const float *ptr_fU2, float *ptr_fOut1, float *ptr_fOut2,
+                                                                    const int iArrayLen, const float mean, const float std)
+    {
+        __m128 vMean = _mm_set1_ps(mean);
+        __m128 vStd = _mm_set1_ps(std);
+
+        for(int index = 0; index < iArrayLen; index += 4)  // go through all vectors
+        {
+            __m128 r = _mm_mul_ps(vStd, _mm_sqrt_ps(_mm_mul_ps(_mm_set1_ps(-2.0f), Log_SSE2(_mm_loadu_ps(ptr_fU1 + index)))));  // radius
+            __m128 s, c;
+            SinCos2Pi_SSE2(_mm_loadu_ps(ptr_fU2 + index), &s, &c);  // angle
+
+            _mm_storeu_ps(ptr_fOut1 + index, MulAdd_SSE2(r, c, vMean));  // first random values
+            _mm_storeu_ps(ptr_fOut2 + index, MulAdd_SSE2(r, s, vMean));  // second random values
+        }
+    }
+
+
+    // AVX2 + FMA kernels; 8 floats per vector
+    __attribute__((target("avx2,fma"))) inline __m256 Log_AVX2(__m256 x)
+    {
+        __m256i iBits = _mm256_castps_si256(x);
+        __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(iBits, 23), _mm256_set1_epi32(126)));  // exponent
+        __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(iBits, _mm256_set1_epi32(0x007FFFFF)),
+                                                       _mm256_set1_epi32(0x3F000000)));  // mantissa in [0.5, 1)
+        __m256 mask = _mm256_cmp_ps(m, _mm256_set1_ps(LOG_SQRTHF), _CMP_LT_OQ);  // mantissa below sqrt(1/2)
+
+        e = _mm256_sub_ps(e, _mm256_and_ps(mask, _mm256_set1_ps(1.0f)));  // move mantissa to [sqrt(1/2), sqrt(2))
+        m = _mm256_sub_ps(_mm256_add_ps(m, _mm256_and_ps(mask, m)), _mm256_set1_ps(1.0f));
+
+        __m256 z = _mm256_mul_ps(m, m);
+        __m256 y = _mm256_set1_ps(LOG_P0);
+        y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(LOG_P1));
+        y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(LOG_P2));
+        y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(LOG_P3));
+        y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(LOG_P4));
+        y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(LOG_P5));
+        y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(LOG_P6));
+        y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(LOG_P7));
+        y = _mm256_fmadd_ps(y, m, _mm256_set1_ps(LOG_P8));
+        y = _mm256_mul_ps(_mm256_mul_ps(y, m), z);
+
+        y = _mm256_fmadd_ps(e, _mm256_set1_ps(LN2_LO), y);
+        y = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), y);
+        return _mm256_fmadd_ps(e, _mm256_set1_ps(LN2_HI), _mm256_add_ps(m, y));
+    }
+
+
+    __attribute__((target("avx2,fma"))) inline __m256 Exp_AVX2(__m256 x)
+    {
+        x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(EXP_LO)), _mm256_set1_ps(EXP_HI));  // keep the result finite
+
+        __m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(LOG2EF)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);  // power of 2
+        x = _mm256_fnmadd_ps(n, _mm256_set1_ps(LN2_HI), x);  // remainder
+        x = _mm256_fnmadd_ps(n, _mm256_set1_ps(LN2_LO), x);
+
+        __m256 y = _mm256_set1_ps(EXP_P0);
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(EXP_P1));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(EXP_P2));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(EXP_P3));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(EXP_P4));
+        y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(EXP_P5));
+        y = _mm256_fmadd_ps(y, _mm256_mul_ps(x, x), _mm256_add_ps(x, _mm256_set1_ps(1.0f)));
+
+        __m256i iPow2 = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);  // 2^n
+        return _mm256_mul_ps(y, _mm256_castsi256_ps(iPow2));
+    }
+
+
+    __attribute__((target("avx2,fma"))) inline void SinCos2Pi_AVX2(__m256 u, __m256 *ptr_s, __m256 *ptr_c)  // sin and cos of 2*pi*u
+    {
+        __m256 v = _mm256_mul_ps(u, _mm256_set1_ps(4.0f));
+        __m256 q = _mm256_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);  // quadrant
+        __m256 r = _mm256_mul_ps(_mm256_sub_ps(v, q), _mm256_set1_ps(PI_2F));  // angle in [-pi/4, pi/4]
+        __m256i iq = _mm256_cvtps_epi32(q);
+        __m256 z = _mm256_mul_ps(r, r);
+
+        __m256 sr = _mm256_set1_ps(SIN_P0);
+        sr = _mm256_fmadd_ps(sr, z, _mm256_set1_ps(SIN_P1));
+        sr = _mm256_fmadd_ps(sr, z, _mm256_set1_ps(SIN_P2));
+        sr = _mm256_fmadd_ps(_mm256_mul_ps(sr, z), r, r);
+
+        __m256 cr = _mm256_set1_ps(COS_P0);
+        cr = _mm256_fmadd_ps(cr, z, _mm256_set1_ps(COS_P1));
+        cr = _mm256_fmadd_ps(cr, z, _mm256_set1_ps(COS_P2));
+        cr = _mm256_fmadd_ps(_mm256_mul_ps(cr, z), z, _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), _mm256_set1_ps(1.0f)));
+
+        __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(iq, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));  // odd quadrant
+        __m256 sSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(iq, _mm256_set1_epi32(2)), 30));
+        __m256 cSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(iq, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+
+        *ptr_s = _mm256_xor_ps(_mm256_blendv_ps(sr, cr, swap), sSign);
+        *ptr_c = _mm256_xor_ps(_mm256_blendv_ps(cr, sr, swap), cSign);
+    }
+
+
+    __attribute__((target("avx2,fma"))) inline void LogArray_AVX2(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)
+    {
+        for(int index = 0; index < iArrayLen; index += 8)  // go through all vectors
+        {
+            _mm256_storeu_ps(ptr_fOutArray + index, Log_AVX2(_mm256_loadu_ps(ptr_fInArray + index)));
+        }
+    }
+
+
+    __attribute__((target("avx2,fma"))) inline void ExpArray_AVX2(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)
+    {
+        for(int index = 0; index < iArrayLen; index += 8)  // go through all vectors
+        {
+            _mm256_storeu_ps(ptr_fOutArray + index, Exp_AVX2(_mm256_loadu_ps(ptr_fInArray + index)));
+        }
+    }
+
+
+    __attribute__((target("avx2,fma"))) inline void BoxMullerArray_AVX2(const float *ptr_fU1, const float *ptr_fU2, float *ptr_fOut1, float *ptr_fOut2,
+                                                                       const int iArrayLen, const float mean, const float std)
+    {
+        __m256 vMean = _mm256_set1_ps(mean);
+        __m256 vStd = _mm256_set1_ps(std);
+
+        for(int index = 0; index < iArrayLen; index += 8)  // go through all vectors
+        {
+            __m256 r = _mm256_mul_ps(vStd, _mm256_sqrt_ps(_mm256_mul_ps(_mm256_set1_ps(-2.0f), Log_AVX2(_mm256_loadu_ps(ptr_fU1 + index)))));  // radius
+            __m256 s, c;
+            SinCos2Pi_AVX2(_mm256_loadu_ps(ptr_fU2 + index), &s, &c);  // angle
+
+            _mm256_storeu_ps(ptr_fOut1 + index, _mm256_fmadd_ps(r, c, vMean));  // first random values
+            _mm256_storeu_ps(ptr_fOut2 + index, _mm256_fmadd_ps(r, s, vMean));  // second random values
+        }
+    }
+
+
+    // AVX-512F kernels; 16 floats per vector
+    __attribute__((target("avx512f"))) inline __m512 Log_AVX512(__m512 x)
+    {
+        __m512i iBits = _mm512_castps_si512(x);
+        __m512 e = _mm512_cvtepi32_ps(_mm512_sub_epi32(_mm512_srli_epi32(iBits, 23), _mm512_set1_epi32(126)));  // exponent
+        __m512 m = _mm512_castsi512_ps(_mm512_or_si512(_mm512_and_si512(iBits, _mm512_set1_epi32(0x007FFFFF)),
+                                                       _mm512_set1_epi32(0x3F000000)));  // mantissa in [0.5, 1)
+        __mmask16 mask = _mm512_cmp_ps_mask(m, _mm512_set1_ps(LOG_SQRTHF), _CMP_LT_OQ);  // mantissa below sqrt(1/2)
+
+        e = _mm512_mask_sub_ps(e, mask, e, _mm512_set1_ps(1.0f));  // move mantissa to [sqrt(1/2), sqrt(2))
+        m = _mm512_sub_ps(_mm512_mask_add_ps(m, mask, m, m), _mm512_set1_ps(1.0f));
+
+        __m512 z = _mm512_mul_ps(m, m);
+        __m512 y = _mm512_set1_ps(LOG_P0);
+        y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(LOG_P1));
+        y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(LOG_P2));
+        y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(LOG_P3));
+        y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(LOG_P4));
+        y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(LOG_P5));
+        y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(LOG_P6));
+        y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(LOG_P7));
+        y = _mm512_fmadd_ps(y, m, _mm512_set1_ps(LOG_P8));
+        y = _mm512_mul_ps(_mm512_mul_ps(y, m), z);
+
+        y = _mm512_fmadd_ps(e, _mm512_set1_ps(LN2_LO), y);
+        y = _mm512_fnmadd_ps(z, _mm512_set1_ps(0.5f), y);
+        return _mm512_fmadd_ps(e, _mm512_set1_ps(LN2_HI), _mm512_add_ps(m, y));
+    }
+
+
+    __attribute__((target("avx512f"))) inline __m512 Exp_AVX512(__m512 x)
+    {
+        x = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(EXP_LO)), _mm512_set1_ps(EXP_HI));  // keep the result finite
+
+        __m512 n = _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps(LOG2EF)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);  // power of 2
+        x = _mm512_fnmadd_ps(n, _mm512_set1_ps(LN2_HI), x);  // remainder
+        x = _mm512_fnmadd_ps(n, _mm512_set1_ps(LN2_LO), x);
+
+        __m512 y = _mm512_set1_ps(EXP_P0);
+        y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(EXP_P1));
+        y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(EXP_P2));
+        y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(EXP_P3));
+        y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(EXP_P4));
+        y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(EXP_P5));
+        y = _mm512_fmadd_ps(y, _mm512_mul_ps(x, x), _mm512_add_ps(x, _mm512_set1_ps(1.0f)));
+
+        __m512i iPow2 = _mm512_slli_epi32(_mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127)), 23);  // 2^n
+        return _mm512_mul_ps(y, _mm512_castsi512_ps(iPow2));
+    }
+
+
+    __attribute__((target("avx512f"))) inline void SinCos2Pi_AVX512(__m512 u, __m512 *ptr_s, __m512 *ptr_c)  // sin and cos of 2*pi*u
+    {
+        __m512 v = _mm512_mul_ps(u, _mm512_set1_ps(4.0f));
+        __m512 q = _mm512_roundscale_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);  // quadrant
+        __m512 r = _mm512_mul_ps(_mm512_sub_ps(v, q), _mm512_set1_ps(PI_2F));  // angle in [-pi/4, pi/4]
+        __m512i iq = _mm512_cvtps_epi32(q);
+        __m512 z = _mm512_mul_ps(r, r);
+
+        __m512 sr = _mm512_set1_ps(SIN_P0);
+        sr = _mm512_fmadd_ps(sr, z, _mm512_set1_ps(SIN_P1));
+        sr = _mm512_fmadd_ps(sr, z, _mm512_set1_ps(SIN_P2));
+        sr = _mm512_fmadd_ps(_mm512_mul_ps(sr, z), r, r);
+
+        __m512 cr = _mm512_set1_ps(COS_P0);
+        cr = _mm512_fmadd_ps(cr, z, _mm512_set1_ps(COS_P1));
+        cr = _mm512_fmadd_ps(cr, z, _mm512_set1_ps(COS_P2));
+        cr = _mm512_fmadd_ps(_mm512_mul_ps(cr, z), z, _mm512_fnmadd_ps(z, _mm512_set1_ps(0.5f), _mm512_set1_ps(1.0f)));
+
+        __mmask16 swap = _mm512_test_epi32_mask(iq, _mm512_set1_epi32(1));  // odd quadrant
+        __m512i sSign = _mm512_slli_epi32(_mm512_and_si512(iq, _mm512_set1_epi32(2)), 30);
+        __m512i cSign = _mm512_slli_epi32(_mm512_and_si512(_mm512_add_epi32(iq, _mm512_set1_epi32(1)), _mm512_set1_epi32(2)), 30);
+
+        *ptr_s = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(_mm512_mask_blend_ps(swap, sr, cr)), sSign));
+        *ptr_c = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(_mm512_mask_blend_ps(swap, cr, sr)), cSign));
+    }
+
+
+    __attribute__((target("avx512f"))) inline void LogArray_AVX512(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)
+    {
+        for(int index = 0; index < iArrayLen; index += 16)  // go through all vectors
+        {
+            _mm512_storeu_ps(ptr_fOutArray + index, Log_AVX512(_mm512_loadu_ps(ptr_fInArray + index)));
+        }
+    }
+
+
+    __attribute__((target("avx512f"))) inline void ExpArray_AVX512(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)
+    {
+        for(int index = 0; index < iArrayLen; index += 16)  // go through all vectors
+        {
+            _mm512_storeu_ps(ptr_fOutArray + index, Exp_AVX512(_mm512_loadu_ps(ptr_fInArray + index)));
+        }
+    }
+
+
+    __attribute__((target("avx512f"))) inline void BoxMullerArray_AVX512(const float *ptr_fU1, const float *ptr_fU2, float *ptr_fOut1, float *ptr_fOut2,
+                                                                        const int iArrayLen, const float mean, const float std)
+    {
+        __m512 vMean = _mm512_set1_ps(mean);
+        __m512 vStd = _mm512_set1_ps(std);
+
+        for(int index = 0; index < iArrayLen; index += 16)  // go through all vectors
+        {
+            __m512 r = _mm512_mul_ps(vStd, _mm512_sqrt_ps(_mm512_mul_ps(_mm512_set1_ps(-2.0f), Log_AVX512(_mm512_loadu_ps(ptr_fU1 + index)))));  // radius
+            __m512 s, c;
+            SinCos2Pi_AVX512(_mm512_loadu_ps(ptr_fU2 + index), &s, &c);  // angle
+
+            _mm512_storeu_ps(ptr_fOut1 + index, _mm512_fmadd_ps(r, c, vMean));  // first random values
+            _mm512_storeu_ps(ptr_fOut2 + index, _mm512_fmadd_ps(r, s, vMean));  // second random values
+        }
+    }
+    #endif
+
+
+    #ifdef _SIMD_NEON_
+    // AArch64 NEON kernels; 4 floats per vector
+    inline float32x4_t Log_NEON(float32x4_t x)
+    {
+        uint32x4_t uBits = vreinterpretq_u32_f32(x);
+        float32x4_t e = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(uBits, 23)), vdupq_n_s32(126)));  // exponent
+        float32x4_t m = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(uBits, vdupq_n_u32(0x007FFFFF)), vdupq_n_u32(0x3F000000)));  // mantissa in [0.5, 1)
+        uint32x4_t mask = vcltq_f32(m, vdupq_n_f32(LOG_SQRTHF));  // mantissa below sqrt(1/2)
+
+        e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));  // move mantissa to [sqrt(1/2), sqrt(2))
+        m = vsubq_f32(vaddq_f32(m, vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(m)))), vdupq_n_f32(1.0f));
+
+        float32x4_t z = vmulq_f32(m, m);
+        float32x4_t y = vdupq_n_f32(LOG_P0);
+        y = vfmaq_f32(vdupq_n_f32(LOG_P1), y, m);
+        y = vfmaq_f32(vdupq_n_f32(LOG_P2), y, m);
+        y = vfmaq_f32(vdupq_n_f32(LOG_P3), y, m);
+        y = vfmaq_f32(vdupq_n_f32(LOG_P4), y, m);
+        y = vfmaq_f32(vdupq_n_f32(LOG_P5), y, m);
+        y = vfmaq_f32(vdupq_n_f32(LOG_P6), y, m);
+        y = vfmaq_f32(vdupq_n_f32(LOG_P7), y, m);
+        y = vfmaq_f32(vdupq_n_f32(LOG_P8), y, m);
+        y = vmulq_f32(vmulq_f32(y, m), z);
+
+        y = vfmaq_f32(y, e, vdupq_n_f32(LN2_LO));
+        y = vfmsq_f32(y, z, vdupq_n_f32(0.5f));
+        return vfmaq_f32(vaddq_f32(m, y), e, vdupq_n_f32(LN2_HI));
+    }
+
+
+    inline float32x4_t Exp_NEON(float32x4_t x)
+    {
+        x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(EXP_LO)), vdupq_n_f32(EXP_HI));  // keep the result finite
+
+        float32x4_t n = vrndnq_f32(vmulq_f32(x, vdupq_n_f32(LOG2EF)));  // power of 2
+        x = vfmsq_f32(x, n, vdupq_n_f32(LN2_HI));  // remainder
+        x = vfmsq_f32(x, n, vdupq_n_f32(LN2_LO));
+
+        float32x4_t y = vdupq_n_f32(EXP_P0);
+        y = vfmaq_f32(vdupq_n_f32(EXP_P1), y, x);
+        y = vfmaq_f32(vdupq_n_f32(EXP_P2), y, x);
+        y = vfmaq_f32(vdupq_n_f32(EXP_P3), y, x);
+        y = vfmaq_f32(vdupq_n_f32(EXP_P4), y, x);
+        y = vfmaq_f32(vdupq_n_f32(EXP_P5), y, x);
+        y = vfmaq_f32(vaddq_f32(x, vdupq_n_f32(1.0f)), y, vmulq_f32(x, x));
+
+        int32x4_t iPow2 = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23);  // 2^n
+        return vmulq_f32(y, vreinterpretq_f32_s32(iPow2));
+    }
+
+
+    inline void SinCos2Pi_NEON(float32x4_t u, float32x4_t *ptr_s, float32x4_t *ptr_c)  // sin and cos of 2*pi*u
+    {
+        float32x4_t v = vmulq_f32(u, vdupq_n_f32(4.0f));
+        float32x4_t q = vrndnq_f32(v);  // quadrant
+        float32x4_t r = vmulq_f32(vsubq_f32(v, q), vdupq_n_f32(PI_2F));  // angle in [-pi/4, pi/4]
+        int32x4_t iq = vcvtq_s32_f32(q);
+        float32x4_t z = vmulq_f32(r, r);
+
+        float32x4_t sr = vdupq_n_f32(SIN_P0);
+        sr = vfmaq_f32(vdupq_n_f32(SIN_P1), sr, z);
+        sr = vfmaq_f32(vdupq_n_f32(SIN_P2), sr, z);
+        sr = vfmaq_f32(r, vmulq_f32(sr, z), r);
+
+        float32x4_t cr = vdupq_n_f32(COS_P0);
+        cr = vfmaq_f32(vdupq_n_f32(COS_P1), cr, z);
+        cr = vfmaq_f32(vdupq_n_f32(COS_P2), cr, z);
+        cr = vfmaq_f32(vfmsq_f32(vdupq_n_f32(1.0f), z, vdupq_n_f32(0.5f)), vmulq_f32(cr, z), z);
+
+        uint32x4_t swap = vtstq_s32(iq, vdupq_n_s32(1));  // odd quadrant
+        uint32x4_t sSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(iq, vdupq_n_s32(2))), 30);
+        uint32x4_t cSign = vshlq_n_u32(vreinterpretq_u32_s32(vandq_s32(vaddq_s32(iq, vdupq_n_s32(1)), vdupq_n_s32(2))), 30);
+
+        *ptr_s = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, cr, sr)), sSign));
+        *ptr_c = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, sr, cr)), cSign));
+    }
+
+
+    inline void LogArray_NEON(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)
+    {
+        for(int index = 0; index < iArrayLen; index += 4)  // go through all vectors
+        {
+            vst1q_f32(ptr_fOutArray + index, Log_NEON(vld1q_f32(ptr_fInArray + index)));
+        }
+    }
+
+
+    inline void ExpArray_NEON(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)
+    {
+        for(int index = 0; index < iArrayLen; index += 4)  // go through all vectors
+        {
+            vst1q_f32(ptr_fOutArray + index, Exp_NEON(vld1q_f32(ptr_fInArray + index)));
+        }
+    }
+
+
+    inline void BoxMullerArray_NEON(const float *ptr_fU1, const float *ptr_fU2, float *ptr_fOut1, float *ptr_fOut2,
+                                    const int iArrayLen, const float mean, const float std)
+    {
+        float32x4_t vMean = vdupq_n_f32(mean);
+        float32x4_t vStd = vdupq_n_f32(std);
+
+        for(int index = 0; index < iArrayLen; index += 4)  // go through all vectors
+        {
+            float32x4_t r = vmulq_f32(vStd, vsqrtq_f32(vmulq_f32(vdupq_n_f32(-2.0f), Log_NEON(vld1q_f32(ptr_fU1 + index)))));  // radius
+            float32x4_t s, c;
+            SinCos2Pi_NEON(vld1q_f32(ptr_fU2 + index), &s, &c);  // angle
+
+            vst1q_f32(ptr_fOut1 + index, vfmaq_f32(vMean, r, c));  // first random values
+            vst1q_f32(ptr_fOut2 + index, vfmaq_f32(vMean, r, s));  // second random values
+        }
+    }
+    #endif
+
+
+    inline void LogArray_Level(const int iLevel, const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)  // run the kernel of the given set; length is a multiple of its width
+    {
+        switch(iLevel)
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512: LogArray_AVX512(ptr_fInArray, ptr_fOutArray, iArrayLen); break;
+            case SIMD_AVX2: LogArray_AVX2(ptr_fInArray, ptr_fOutArray, iArrayLen); break;
+            case SIMD_SSE2: LogArray_SSE2(ptr_fInArray, ptr_fOutArray, iArrayLen); break;
+            #endif
+            #ifdef _SIMD_NEON_
+            case SIMD_NEON: LogArray_NEON(ptr_fInArray, ptr_fOutArray, iArrayLen); break;
+            #endif
+            default: LogArray_Scalar(ptr_fInArray, ptr_fOutArray, iArrayLen); break;
+        }
+    }
+
+
+    inline void ExpArray_Level(const int iLevel, const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen)  // run the kernel of the given set; length is a multiple of its width
+    {
+        switch(iLevel)
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512: ExpArray_AVX512(ptr_fInArray, ptr_fOutArray, iArrayLen); break;
+            case SIMD_AVX2: ExpArray_AVX2(ptr_fInArray, ptr_fOutArray, iArrayLen); break;
+            case SIMD_SSE2: ExpArray_SSE2(ptr_fInArray, ptr_fOutArray, iArrayLen); break;
+            #endif
+            #ifdef _SIMD_NEON_
+            case SIMD_NEON: ExpArray_NEON(ptr_fInArray, ptr_fOutArray, iArrayLen); break;
+            #endif
+            default: ExpArray_Scalar(ptr_fInArray, ptr_fOutArray, iArrayLen); break;
+        }
+    }
+
+
+    inline void BoxMullerArray_Level(const int iLevel, const float *ptr_fU1, const float *ptr_fU2, float *ptr_fOut1, float *ptr_fOut2,
+                                     const int iArrayLen, const float mean, const float std)  // run the kernel of the given set; length is a multiple of its width
+    {
+        switch(iLevel)
+        {
+            #ifdef _SIMD_X86_
+            case SIMD_AVX512: BoxMullerArray_AVX512(ptr_fU1, ptr_fU2, ptr_fOut1, ptr_fOut2, iArrayLen, mean, std); break;
+            case SIMD_AVX2: BoxMullerArray_AVX2(ptr_fU1, ptr_fU2, ptr_fOut1, ptr_fOut2, iArrayLen, mean, std); break;
+            case SIMD_SSE2: BoxMullerArray_SSE2(ptr_fU1, ptr_fU2, ptr_fOut1, ptr_fOut2, iArrayLen, mean, std); break;
+            #endif
+            #ifdef _SIMD_NEON_
+            case SIMD_NEON: BoxMullerArray_NEON(ptr_fU1, ptr_fU2, ptr_fOut1, ptr_fOut2, iArrayLen, mean, std); break;
+            #endif
+            default: BoxMullerArray_Scalar(ptr_fU1, ptr_fU2, ptr_fOut1, ptr_fOut2, iArrayLen, mean, std); break;
+        }
+    }
+
+
+    // the partial vector at the end goes through the same kernel (padded) as the rest,
+    // so every element gets the same arithmetic however the caller splits the array
+    inline void LogArray(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen = 0)  // natural logarithm of each element (elements > 0)
+    {
+        int iLevel = SIMD_Level();
+        int iWidth = SIMD_Width(iLevel);
+        int iBodyLen = iArrayLen - iArrayLen%iWidth;  // elements handled by whole vectors
+
+        LogArray_Level(iLevel, ptr_fInArray, ptr_fOutArray, iBodyLen);  // whole vectors
+
+        if(iBodyLen < iArrayLen)  // partial vector is left
+        {
+            float ary_fAuxIn[SIMD_MAX_WIDTH], ary_fAuxOut[SIMD_MAX_WIDTH];  // padded vectors
+
+            PadArray(ptr_fInArray + iBodyLen, ary_fAuxIn, iArrayLen - iBodyLen, iWidth);
+            LogArray_Level(iLevel, ary_fAuxIn, ary_fAuxOut, iWidth);
+            std::copy(ary_fAuxOut, ary_fAuxOut + iArrayLen - iBodyLen, ptr_fOutArray + iBodyLen);
+        }
+    }
+
+
+    inline void ExpArray(const float *ptr_fInArray, float *ptr_fOutArray, const int iArrayLen = 0)  // exponential of each element
+    {
+        int iLevel = SIMD_Level();
+        int iWidth = SIMD_Width(iLevel);
+        int iBodyLen = iArrayLen - iArrayLen%iWidth;  // elements handled by whole vectors
+
+        ExpArray_Level(iLevel, ptr_fInArray, ptr_fOutArray, iBodyLen);  // whole vectors
+
+        if(iBodyLen < iArrayLen)  // partial vector is left
+        {
+            float ary_fAuxIn[SIMD_MAX_WIDTH], ary_fAuxOut[SIMD_MAX_WIDTH];  // padded vectors
+
+            PadArray(ptr_fInArray + iBodyLen, ary_fAuxIn, iArrayLen - iBodyLen, iWidth);
+            ExpArray_Level(iLevel, ary_fAuxIn, ary_fAuxOut, iWidth);
+            std::copy(ary_fAuxOut, ary_fAuxOut + iArrayLen - iBodyLen, ptr_fOutArray + iBodyLen);
+        }
+    }
+
+
+    inline void BoxMullerArray(const float *ptr_fU1, const float *ptr_fU2, float *ptr_fOut1, float *ptr_fOut2,
+                               const int iArrayLen = 0, const float mean = 0.0, const float std = 1.0)  // two normal arrays from two uniform (0, 1) arrays
+    {
+        int iLevel = SIMD_Level();
+        int iWidth = SIMD_Width(iLevel);
+        int iBodyLen = iArrayLen - iArrayLen%iWidth;  // elements handled by whole vectors
+
+        BoxMullerArray_Level(iLevel, ptr_fU1, ptr_fU2, ptr_fOut1, ptr_fOut2, iBodyLen, mean, std);  // whole vectors
+
+        if(iBodyLen < iArrayLen)  // partial vector is left
+        {
+            float ary_fAuxU1[SIMD_MAX_WIDTH], ary_fAuxU2[SIMD_MAX_WIDTH];  // padded vectors
+            float ary_fAuxOut1[SIMD_MAX_WIDTH], ary_fAuxOut2[SIMD_MAX_WIDTH];
+
+            PadArray(ptr_fU1 + iBodyLen, ary_fAuxU1, iArrayLen - iBodyLen, iWidth);
+            PadArray(ptr_fU2 + iBodyLen, ary_fAuxU2, iArrayLen - iBodyLen, iWidth);
+            BoxMullerArray_Level(iLevel, ary_fAuxU1, ary_fAuxU2, ary_fAuxOut1, ary_fAuxOut2, iWidth, mean, std);
+            std::copy(ary_fAuxOut1, ary_fAuxOut1 + iArrayLen - iBodyLen, ptr_fOut1 + iBodyLen);
+            std::copy(ary_fAuxOut2, ary_fAuxOut2 + iArrayLen - iBodyLen, ptr_fOut2 + iBodyLen);
+        }
+    }
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#endif /* INCLUDED_COMM_KERNELS_SIMD_MATH_H */
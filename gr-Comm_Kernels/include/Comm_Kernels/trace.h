@@ -0,0 +1,229 @@
+#ifndef INCLUDED_COMM_KERNELS_TRACE_H
+#define INCLUDED_COMM_KERNELS_TRACE_H
+
+// binary tracepoints for the work functions; each thread writes fixed size records into its own
+// lock-free ring and a background thread drains the rings into the trace file. Without
+// _TRACE_MODE_ (cmake -DTRACE=ON) TRACE() expands to nothing and its arguments are not evaluated.
+// File layout: "CKTRACE1", uint32 record size, uint32 ring size, then Trace_Record after
+// Trace_Record; tools/trace_dump.py turns it into CSV.
+
+#include <cstdint>
+
+#include "defaults.h"
+
+#ifdef _TRACE_MODE_
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // trace events; the meaning of the arguments is given next to each one
+    enum Trace_Event : uint16_t
+    {
+        TRC_WORK_ENTRY = 1,  // work called: noutput_items, available input items, packet size
+        TRC_WORK_EXIT = 2,  // work returns: produced items, consumed items
+        TRC_SYNC = 3,  // sync pulse found: stream id, sync index, counter value, valid packets
+        TRC_DELAY = 4,  // delay between streams: delay (packets), lead stream id, delay within input (1/0), buffer stored (1/0)
+        TRC_STATE = 5,  // state reached: status code (error value of the outputs, 0 when in sync), delay or offset, item count
+        TRC_MATCH = 6,  // header search: first match index (-1 none), packets found
+        TRC_PACKET = 7,  // packet parsed: packet index, input index, counter value
+        TRC_BUFFER = 8,  // bank buffer access: 1 push / 0 pop / 2 drop, stream id, item index, taken slots before the access (counter value on drops and on keyed slots)
+        TRC_SYNC_STATE = 9,  // header sync state change: new state, old state, header index, consecutive misses
+        TRC_PREAMBLE = 10,  // preamble found: sample index (lowest 32 bits), correlation peak (1/1000), SNR (1/100 dB)
+        TRC_TAG_MATCH = 11,  // header at a preamble tag: tag index, header index, wrong samples
+        TRC_REJECT = 12,  // packet rejected: reason (1 CRC error, 2 unknown label, 3 bad length), input index, received field (CRC, first 32 label bits or data length), calculated CRC or packet size
+        TRC_DROPPED = 0xFFFF  // written by the drainer: records lost on a full ring
+    };
+
+
+    // one trace record; 32 bytes
+    struct Trace_Record
+    {
+        uint64_t uTime;  // steady clock time (ns)
+        uint32_t uBlockId;  // unique id of the block
+        uint16_t uEvent;  // Trace_Event
+        uint16_t uThread;  // ring (thread) number
+        int32_t iArg[4];  // event arguments
+    };
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+
+#ifdef _TRACE_MODE_
+
+namespace gr {
+    namespace Comm_Kernels {
+
+    // single producer (owner thread), single consumer (drainer) ring of trace records
+    class Trace_Ring
+    {
+        private:
+        Trace_Record ary_Records[TRACE_RING_SIZE];  // record slots
+        std::atomic<uint32_t> uHead;  // next slot to write; written by the owner only
+        char ary_cPad[64];  // keeps head and tail on separate cache lines (no over-aligned new in C++11)
+        std::atomic<uint32_t> uTail;  // next slot to read; written by the drainer only
+        std::atomic<uint32_t> uDropped;  // records lost since the last drain
+
+        public:
+        const uint16_t uThread;  // ring number
+
+        Trace_Ring(const uint16_t thread) : uHead(0), uTail(0), uDropped(0), uThread(thread) {}
+
+        void push(const Trace_Record &record)  // owner thread; drops the record if the ring is full
+        {
+            uint32_t uH = uHead.load(std::memory_order_relaxed);
+            if(uH - uTail.load(std::memory_order_acquire) >= TRACE_RING_SIZE)  // ring is full
+            {
+                uDropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            ary_Records[uH & (TRACE_RING_SIZE - 1)] = record;
+            uHead.store(uH + 1, std::memory_order_release);  // publish the record
+        }
+
+        int drain(Trace_Record *ptr_Out, const int iMaxLen)  // drainer thread; copy out up to 'iMaxLen' records
+        {
+            uint32_t uT = uTail.load(std::memory_order_relaxed);
+            uint32_t uH = uHead.load(std::memory_order_acquire);
+            int iLen = 0;
+            for(; (uT != uH) && (iLen < iMaxLen); ++uT, ++iLen)  // go through the published records
+            {
+                ptr_Out[iLen] = ary_Records[uT & (TRACE_RING_SIZE - 1)];
+            }
+            uTail.store(uT, std::memory_order_release);  // free the slots
+            return iLen;
+        }
+
+        uint32_t take_Dropped(void)  // number of dropped records; resets the count
+        {
+            return uDropped.exchange(0, std::memory_order_relaxed);
+        }
+    };
+
+
+    // owner of the rings and of the thread that writes them to the trace file
+    class Trace_Drainer
+    {
+        private:
+        std::mutex mtxRings;  // guards vRings; taken once per thread and by the drainer
+        std::vector<std::unique_ptr<Trace_Ring>> vRings;  // one ring per tracing thread
+        std::atomic<bool> bRunning;  // drainer thread state
+        std::thread thrDrainer;  // drainer thread
+        std::FILE *ptr_File;  // trace file
+
+        void DrainAll(void)  // write every pending record to the file
+        {
+            Trace_Record ary_Buff[256];
+            std::lock_guard<std::mutex> lock(mtxRings);
+            for(std::unique_ptr<Trace_Ring> &ring : vRings)  // go through the rings
+            {
+                int iLen;
+                while((iLen = ring->drain(ary_Buff, 256)) > 0)  // until the ring is empty
+                {
+                    std::fwrite(ary_Buff, sizeof(Trace_Record), iLen, ptr_File);
+                }
+
+                uint32_t uDropped = ring->take_Dropped();
+                if(uDropped != 0)  // records were lost; leave a note in the stream
+                {
+                    Trace_Record record = {Trace_Now(), 0, TRC_DROPPED, ring->uThread, {int32_t(uDropped), 0, 0, 0}};
+                    std::fwrite(&record, sizeof(Trace_Record), 1, ptr_File);
+                }
+            }
+        }
+
+        public:
+        static uint64_t Trace_Now(void)  // steady clock (ns)
+        {
+            return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        Trace_Drainer() : bRunning(true), ptr_File(nullptr)
+        {
+            const char *ptr_cPath = std::getenv(TRACE_FILE_ENV);
+            ptr_File = std::fopen((ptr_cPath != nullptr) ? ptr_cPath : TRACE_FILE_DEF, "wb");
+            if(ptr_File == nullptr)  // tracing is off if the file can not be opened
+            {
+                bRunning = false;
+                return;
+            }
+
+            const uint32_t ary_uHeader[2] = {uint32_t(sizeof(Trace_Record)), uint32_t(TRACE_RING_SIZE)};
+            std::fwrite("CKTRACE1", 1, 8, ptr_File);
+            std::fwrite(ary_uHeader, sizeof(uint32_t), 2, ptr_File);
+
+            thrDrainer = std::thread([this]() {
+                while(bRunning.load(std::memory_order_acquire))  // until shut down
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(TRACE_DRAIN_PERIOD));
+                    this->DrainAll();
+                }
+            });
+        }
+
+        ~Trace_Drainer()
+        {
+            if(ptr_File == nullptr)
+            {
+                return;
+            }
+            bRunning.store(false, std::memory_order_release);
+            if(thrDrainer.joinable())
+            {
+                thrDrainer.join();
+            }
+            this->DrainAll();  // last records
+            std::fclose(ptr_File);
+        }
+
+        bool is_Open(void) const
+        {
+            return ptr_File != nullptr;
+        }
+
+        Trace_Ring *new_Ring(void)  // ring of the calling thread; the drainer keeps it until shut down
+        {
+            std::lock_guard<std::mutex> lock(mtxRings);
+            vRings.emplace_back(new Trace_Ring(uint16_t(vRings.size())));
+            return vRings.back().get();
+        }
+
+        static Trace_Drainer &Instance(void)  // process wide drainer; started on the first tracepoint
+        {
+            static Trace_Drainer Drainer;
+            return Drainer;
+        }
+    };
+
+
+    inline void Trace_Emit(const uint32_t uBlockId, const uint16_t uEvent, const int32_t iArg0 = 0, const int32_t iArg1 = 0, const int32_t iArg2 = 0, const int32_t iArg3 = 0)
+    {
+        static thread_local Trace_Ring *ptr_Ring = Trace_Drainer::Instance().is_Open() ? Trace_Drainer::Instance().new_Ring() : nullptr;
+        if(ptr_Ring != nullptr)
+        {
+            ptr_Ring->push(Trace_Record{Trace_Drainer::Trace_Now(), uBlockId, uEvent, ptr_Ring->uThread, {iArg0, iArg1, iArg2, iArg3}});
+        }
+    }
+
+  } // namespace Comm_Kernels
+} // namespace gr
+
+#define TRACE(...)                          gr::Comm_Kernels::Trace_Emit(__VA_ARGS__)  // block id, event, up to 4 int arguments
+
+#else
+
+#define TRACE(...)                          do {} while(0)                              // tracing is compiled out
+
+#endif /* _TRACE_MODE_ */
+
+#endif /* INCLUDED_COMM_KERNELS_TRACE_H */
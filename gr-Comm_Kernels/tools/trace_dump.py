@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+#
+# Convert a binary trace file of the Comm_Kernels tracepoints (Comm_Kernels/trace.h) to CSV.
+#
+# usage: trace_dump.py [trace file] [csv file]
+#   defaults: $COMM_TRACE_FILE or Comm_Kernels_trace.bin, standard output
+#
+
+import os
+import struct
+import sys
+
+EVENTS = {  # must follow Trace_Event in trace.h
+    1: 'WORK_ENTRY',
+    2: 'WORK_EXIT',
+    3: 'SYNC',
+    4: 'DELAY',
+    5: 'STATE',
+    6: 'MATCH',
+    7: 'PACKET',
+    8: 'BUFFER',
+    9: 'SYNC_STATE',
+    10: 'PREAMBLE',
+    11: 'TAG_MATCH',
+    12: 'REJECT',
+    0xFFFF: 'DROPPED',
+}
+
+RECORD = struct.Struct('<QIHH4i')  # Trace_Record
+
+
+def main():
+    path_in = sys.argv[1] if len(sys.argv) > 1 else os.environ.get('COMM_TRACE_FILE', 'Comm_Kernels_trace.bin')
+    file_out = open(sys.argv[2], 'w') if len(sys.argv) > 2 else sys.stdout
+
+    with open(path_in, 'rb') as file_in:
+        magic = file_in.read(8)
+        if magic != b'CKTRACE1':
+            sys.exit('%s is not a trace file' % path_in)
+        record_size, ring_size = struct.unpack('<II', file_in.read(8))
+        if record_size != RECORD.size:
+            sys.exit('record size %d is not supported' % record_size)
+
+        records = []
+        while True:
+            data = file_in.read(RECORD.size)
+            if len(data) < RECORD.size:
+                break
+            records.append(RECORD.unpack(data))
+
+    records.sort(key=lambda r: r[0])  # rings are drained one after the other; put them back in time order
+    t0 = records[0][0] if records else 0
+
+    file_out.write('time_ns,thread,block_id,event,arg0,arg1,arg2,arg3\n')
+    for time, block_id, event, thread, a0, a1, a2, a3 in records:
+        file_out.write('%d,%d,%d,%s,%d,%d,%d,%d\n' % (time - t0, thread, block_id, EVENTS.get(event, event), a0, a1, a2, a3))
+
+
+if __name__ == '__main__':
+    main()
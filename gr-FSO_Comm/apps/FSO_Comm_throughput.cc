@@ -0,0 +1,82 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2020 gr-FSO_Comm author.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+// sustained throughput of the FSO_Comm blocks; see Throughput_Harness for the options
+
+#include <FSO_Comm/FogSmoke_Loss.h>
+#include <FSO_Comm/Geometric_Loss.h>
+#include <FSO_Comm/Pointing_Errors.h>
+#include <FSO_Comm/Turbulence.h>
+#include <FSO_Comm/Channel_Analyser.h>
+
+#include <throughput_harness.h>
+
+using namespace gr::Comm_Kernels;
+
+
+int main(int argc, char **argv)
+{
+  Throughput_Harness Harness("FSO_Comm", argc, argv);
+
+  const std::vector<float> vUnit(1024, 1.0f);  // unit signal; the channel blocks only scale it
+  const std::vector<size_t> vFloatOut = {sizeof(float)};
+
+  Harness.add("FogSmoke_Loss", 0, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::FSO_Comm::FogSmoke_Loss::sptr block = gr::FSO_Comm::FogSmoke_Loss::make(100, 10, 850);
+    H.connect_source<float>(tb, vUnit, block, 0);
+    H.connect_sinks(tb, block, vFloatOut);
+    return block;
+  });
+
+  Harness.add("Geometric_Loss", 0, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::FSO_Comm::Geometric_Loss::sptr block = gr::FSO_Comm::Geometric_Loss::make(3.0, 0.1, 50.0, 100.0);
+    H.connect_source<float>(tb, vUnit, block, 0);
+    H.connect_sinks(tb, block, vFloatOut);
+    return block;
+  });
+
+  Harness.add("Pointing_Errors", AXIS_RATE, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::FSO_Comm::Pointing_Errors::sptr block = gr::FSO_Comm::Pointing_Errors::make(200, 5, 0.1, 50, 20, 20, P.fSampRate, THRPT_SEED);
+    H.connect_source<float>(tb, vUnit, block, 0);
+    H.connect_sinks(tb, block, vFloatOut);
+    return block;
+  });
+
+  Harness.add("Turbulence", AXIS_RATE, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::FSO_Comm::Turbulence::sptr block = gr::FSO_Comm::Turbulence::make(1e-12, 850, 50, 200, 25, P.fSampRate, THRPT_SEED);
+    H.connect_source<float>(tb, vUnit, block, 0);
+    H.connect_sinks(tb, block, vFloatOut);
+    return block;
+  });
+
+  Harness.add("Channel_Analyser", AXIS_SPB | AXIS_WIN, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::FSO_Comm::Channel_Analyser::sptr block = gr::FSO_Comm::Channel_Analyser::make(P.iSamplesPerBit, P.iWinSize, "Signal Power", 2);
+    H.connect_source<float>(tb, Throughput_Harness::NoisySignal(P.iWinSize, P.iSamplesPerBit), block, 0);
+    H.connect_sinks(tb, block, vFloatOut);
+    return block;
+  });
+
+  return Harness.run();
+}
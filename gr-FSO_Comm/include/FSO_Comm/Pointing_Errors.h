@@ -44,8 +44,11 @@ namespace gr {
        * constructor is in a private implementation
        * class. FSO_Comm::Pointing_Errors::make is the public interface for
        * creating new instances.
+       *
+       * \param seed random number seed; negative value seeds from time
+       * \param streamId random number stream id; each (seed, streamId) pair gives an independent substream
        */
-      static sptr make(float jitter, float diaTx, float thetaTx, float diaRx, float linkLen, float tempCorr, float sampRate);
+      static sptr make(float jitter, float diaTx, float thetaTx, float diaRx, float linkLen, float tempCorr, float sampRate, int seed = -1, int streamId = 0);
 
       /*!
        * \brief Set pointing errors jitter
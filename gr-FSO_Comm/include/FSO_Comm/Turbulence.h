@@ -44,8 +44,11 @@ namespace gr {
        * constructor is in a private implementation
        * class. FSO_Comm::Turbulence::make is the public interface for
        * creating new instances.
+       *
+       * \param seed random number seed; negative value seeds from time
+       * \param streamId random number stream id; each (seed, streamId) pair gives an independent substream
        */
-      static sptr make(float Cn2, float wavelength, float diaRx, float LinkLen, float tempCorr, float sampRate);
+      static sptr make(float Cn2, float wavelength, float diaRx, float LinkLen, float tempCorr, float sampRate, int seed = -1, int streamId = 0);
 
       /*!
        * \brief Set turbulence Cn2
@@ -33,5 +33,7 @@
 #define SI0_STR                             ("Level 0 SI")                              // Level 0 SI flag string
 #define SI1_STR                             ("Level 1 SI")                              // Level 1 SI flag string
 #define SIm_STR                             ("Average SI")                              // Average SI flag string
+#define DEF_SEED                            (-1)                                        // random number seed; negative value seeds from time
+#define DEF_STREAM_ID                       (0)                                         // random number stream id
 
 #endif /* INCLUDED_DEFAULTS_H */
@@ -46,6 +46,8 @@ namespace gr {
               gr::io_signature::make(1, 1, sizeof(float)),
               gr::io_signature::make(1, 1, sizeof(float))), ptr_fSigMerit(nullptr), fSigPower(0), fNoisePower(1), fSNR(2), fQ_fac(3),  fDC(4), fSI0(5), fSI1(6), fSIm(7)
     {
+      this->setup_Stats(this);  // register the stats message port
+
       #ifdef _DEBUG_MODE_
       std::cout << "Channel_Analyser_impl: Constructor called." << std::endl;
       #endif
@@ -77,6 +79,8 @@ namespace gr {
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       const float *in = (const float *) input_items[0];
       float *out = (float *) output_items[0];
 
@@ -186,6 +190,8 @@ namespace gr {
 
       std::cout << "Measured value = " << *ptr_fSigMerit << std::endl;        
 
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
@@ -22,13 +22,14 @@
 #define INCLUDED_FSO_COMM_CHANNEL_ANALYSER_IMPL_H
 
 #include <FSO_Comm/Channel_Analyser.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace FSO_Comm {
 
     enum MeasType {Ps = 0, Pn = 1, SNR = 2, QF = 3, DC = 4, SI0 = 5, SI1 = 6, SIm = 7};    
 
-    class Channel_Analyser_impl : public Channel_Analyser
+    class Channel_Analyser_impl : public Channel_Analyser, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -62,6 +63,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set samples per symbol
       void set_SampsPerSymb(int sampPerSymb)
       {
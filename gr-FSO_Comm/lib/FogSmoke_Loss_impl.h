@@ -22,11 +22,12 @@
 #define INCLUDED_FSO_COMM_FOGSMOKE_LOSS_IMPL_H
 
 #include <FSO_Comm/FogSmoke_Loss.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace FSO_Comm {
 
-    class FogSmoke_Loss_impl : public FogSmoke_Loss
+    class FogSmoke_Loss_impl : public FogSmoke_Loss, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -48,6 +49,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set link length
       void set_LinkLen(float linkLen)
       {
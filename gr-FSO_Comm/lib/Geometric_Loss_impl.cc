@@ -44,6 +44,8 @@ namespace gr {
               gr::io_signature::make(1, 1, sizeof(float)),
               gr::io_signature::make(1, 2, sizeof(float))), fLoss(0)
     {
+      this->setup_Stats(this);  // register the stats message port
+
       #ifdef _DEBUG_MODE_
       std::cout << "Geometric_Loss_impl: Constructor called." << std::endl;
       #endif
@@ -79,6 +81,8 @@ namespace gr {
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       const float *in = (const float *) input_items[0];
       float *out = (float *) output_items[0];
       float *out_loss = nullptr;
@@ -123,6 +127,8 @@ namespace gr {
       }
       #endif
 
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
@@ -22,11 +22,12 @@
 #define INCLUDED_FSO_COMM_GEOMETRIC_LOSS_IMPL_H
 
 #include <FSO_Comm/Geometric_Loss.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace FSO_Comm {
 
-    class Geometric_Loss_impl : public Geometric_Loss
+    class Geometric_Loss_impl : public Geometric_Loss, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -49,6 +50,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set Tx aperture diameter (mm)
       void set_DiaTx(float diaTx)
       {
@@ -29,21 +29,23 @@ namespace gr {
   namespace FSO_Comm {
 
     Pointing_Errors::sptr
-    Pointing_Errors::make(float jitter, float diaTx, float thetaTx, float diaRx, float linkLen, float tempCorr, float sampRate)
+    Pointing_Errors::make(float jitter, float diaTx, float thetaTx, float diaRx, float linkLen, float tempCorr, float sampRate, int seed, int streamId)
     {
       return gnuradio::get_initial_sptr
-        (new Pointing_Errors_impl(jitter, diaTx, thetaTx, diaRx, linkLen, tempCorr, sampRate));
+        (new Pointing_Errors_impl(jitter, diaTx, thetaTx, diaRx, linkLen, tempCorr, sampRate, seed, streamId));
     }
 
 
     /*
      * The private constructor
      */
-    Pointing_Errors_impl::Pointing_Errors_impl(float jitter, float diaTx, float thetaTx, float diaRx, float linkLen, float tempCorr, float sampRate)
+    Pointing_Errors_impl::Pointing_Errors_impl(float jitter, float diaTx, float thetaTx, float diaRx, float linkLen, float tempCorr, float sampRate, int seed, int streamId)
       : gr::sync_block("Pointing_Errors",
               gr::io_signature::make(1, 1, sizeof(float)),
               gr::io_signature::make(1, 2, sizeof(float))), RandGen()
     {
+      this->setup_Stats(this);  // register the stats message port
+
       #ifdef _DEBUG_MODE_
       std::cout << "Pointing_Errors_impl: Constructor called." << std::endl;
       #endif
@@ -54,6 +56,11 @@ namespace gr {
       this->set_DiaRx(diaRx);  // set Rx diameter (mm)
       this->set_TempCorr(tempCorr);  // set temporal correlation of pointing errors channel
       this->set_SampRate(sampRate);  // set sample rate
+
+      if(seed >= 0)  // reproducible mode
+      {
+        RandGen.set_Seed(seed, streamId);  // start from the given substream
+      }
     }
 
     void
@@ -89,6 +96,8 @@ namespace gr {
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       const float *in = (const float *) input_items[0];
       float *out = (float *) output_items[0];
       float *out_h = nullptr;
@@ -120,19 +129,25 @@ namespace gr {
       float ChannCoeff;  // channel coefficient
 
       // Do <+signal processing+>
-      for (int index_s = 0; index_s < NumOfSeg; ++index_s)  // go through available segments
+      for (int index_c = 0; index_c < NumOfSeg; index_c += RNG_BUFF_SIZE)  // go through chunks of segments
       {
-        ChannCoeff = RandGen.RayleighNumGen(fJitter*1e-3, fW2_eq_PE);  // generate a pointing errors channel coefficient based on Rayleigh distribution
-        #ifdef _DEBUG_MODE_
-        std::cout << "Index = " << index_s << " out of " << NumOfSeg - 1 << std::endl;
-        std::cout << "Current channel coefficient = " << ChannCoeff << std::endl;
-        #endif
-
-        LinearMap<float>((in + index_s*iSig2CCRatio), (out + index_s*iSig2CCRatio), iSig2CCRatio, ChannCoeff, 0.0);  // apply channel coefficient
+        int iChunkSeg = MIN(RNG_BUFF_SIZE, NumOfSeg - index_c);  // number of segments in the chunk
+        RandGen.RayleighDistArray(ary_fChannCoeff, fJitter*1e-3, fW2_eq_PE, iChunkSeg);  // generate pointing errors channel coefficients of the chunk in bulk
 
-        if(bhConnected == true)  // if h is to transferred
+        for (int index_s = index_c; index_s < index_c + iChunkSeg; ++index_s)  // go through segments of the chunk
         {
-          FillArray<float>((out_h + index_s*iSig2CCRatio), ChannCoeff, iSig2CCRatio);  // fill channel coefficient array
+          ChannCoeff = ary_fChannCoeff[index_s - index_c];  // channel coefficient of the segment
+          #ifdef _DEBUG_MODE_
+          std::cout << "Index = " << index_s << " out of " << NumOfSeg - 1 << std::endl;
+          std::cout << "Current channel coefficient = " << ChannCoeff << std::endl;
+          #endif
+
+          LinearMap<float>((in + index_s*iSig2CCRatio), (out + index_s*iSig2CCRatio), iSig2CCRatio, ChannCoeff, 0.0);  // apply channel coefficient
+
+          if(bhConnected == true)  // if h is to transferred
+          {
+            FillArray<float>((out_h + index_s*iSig2CCRatio), ChannCoeff, iSig2CCRatio);  // fill channel coefficient array
+          }
         }
       }
 
@@ -151,6 +166,8 @@ namespace gr {
       }
       #endif
 
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
@@ -22,11 +22,12 @@
 #define INCLUDED_FSO_COMM_POINTING_ERRORS_IMPL_H
 
 #include <FSO_Comm/Pointing_Errors.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace FSO_Comm {
 
-    class Pointing_Errors_impl : public Pointing_Errors
+    class Pointing_Errors_impl : public Pointing_Errors, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -40,12 +41,14 @@ namespace gr {
       float fW2_eq_PE;  // pointing error equivalent beam size squared (m)
       int iSig2CCRatio;  // number of signal samples to number of channel coefficients ratio
       Norm_Rand_Gen RandGen;
+      float ary_fChannCoeff[RNG_BUFF_SIZE];  // channel coefficients of the current chunk
 
       void CalcParam(void);  // calculate channel coefficient parameters
 
      public:
       Pointing_Errors_impl(float jitter = DEF_JITTER, float diaTx = DEF_DIA_TX, float thetaTx = DEF_THETA_TX,
-                          float diaRx = DEF_DIA_RX, float linkLen = DEF_LINK_LEN, float tempCorr = PE_TEMP_CORR, float sampRate = SAMP_RATE);
+                          float diaRx = DEF_DIA_RX, float linkLen = DEF_LINK_LEN, float tempCorr = PE_TEMP_CORR, float sampRate = SAMP_RATE,
+                          int seed = DEF_SEED, int streamId = DEF_STREAM_ID);
       ~Pointing_Errors_impl();
 
       // Where all the action really happens
@@ -55,6 +58,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set jitter (mm)
       void set_Jitter(float jitter)
       {
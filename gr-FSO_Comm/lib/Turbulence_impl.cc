@@ -29,20 +29,22 @@ namespace gr {
   namespace FSO_Comm {
 
     Turbulence::sptr
-    Turbulence::make(float Cn2, float wavelength, float diaRx, float LinkLen, float tempCorr, float sampRate)
+    Turbulence::make(float Cn2, float wavelength, float diaRx, float LinkLen, float tempCorr, float sampRate, int seed, int streamId)
     {
       return gnuradio::get_initial_sptr
-        (new Turbulence_impl(Cn2, wavelength, diaRx, LinkLen, tempCorr, sampRate));
+        (new Turbulence_impl(Cn2, wavelength, diaRx, LinkLen, tempCorr, sampRate, seed, streamId));
     }
 
     /*
      * The private constructor
      */
-    Turbulence_impl::Turbulence_impl(float Cn2, float wavelength, float diaRx, float linkLen, float tempCorr, float sampRate)
+    Turbulence_impl::Turbulence_impl(float Cn2, float wavelength, float diaRx, float linkLen, float tempCorr, float sampRate, int seed, int streamId)
       : gr::sync_block("Turbulence",
               gr::io_signature::make(1, 1, sizeof(float)),
               gr::io_signature::make(1, 2, sizeof(float))), RandGen()
     {
+      this->setup_Stats(this);  // register the stats message port
+
       #ifdef _DEBUG_MODE_
       std::cout << "Turbulence_impl: Constructor called." << std::endl;
       #endif
@@ -52,6 +54,11 @@ namespace gr {
       this->set_LinkLen(linkLen);  // set link length (m)
       this->set_TempCorr(tempCorr);  // set temporal correlation of turbulence```` channel
       this->set_SampRate(sampRate);  // set sample rate
+
+      if(seed >= 0)  // reproducible mode
+      {
+        RandGen.set_Seed(seed, streamId);  // start from the given substream
+      }
     }
 
 
@@ -95,6 +102,8 @@ namespace gr {
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       const float *in = (const float *) input_items[0];
       float *out = (float *) output_items[0];
       float *out_h = nullptr;
@@ -125,19 +134,25 @@ namespace gr {
       float ChannCoeff;  // channel coefficient
 
       // Do <+signal processing+>
-      for (int index_s = 0; index_s < NumOfSeg; ++index_s)  // go through available segments
+      for (int index_c = 0; index_c < NumOfSeg; index_c += RNG_BUFF_SIZE)  // go through chunks of segments
       {
-        ChannCoeff = RandGen.LogNormalNumGen(fmu_x, fsig_x);  // generate a pointing errors channel coefficient based on Rayleigh distribution
-        #ifdef _DEBUG_MODE_
-        std::cout << "Index = " << index_s << " out of " << NumOfSeg - 1 << std::endl;
-        std::cout << "Current channel coefficient = " << ChannCoeff << std::endl;
-        #endif
-
-        LinearMap<float>((in + index_s*iSig2CCRatio), (out + index_s*iSig2CCRatio), iSig2CCRatio, ChannCoeff, 0.0);  // apply channel coefficient
+        int iChunkSeg = MIN(RNG_BUFF_SIZE, NumOfSeg - index_c);  // number of segments in the chunk
+        RandGen.LogNormalDistArray(ary_fChannCoeff, fmu_x, fsig_x, iChunkSeg);  // generate turbulence channel coefficients of the chunk in bulk
 
-        if(bhConnected == true)  // if h is to transferred
+        for (int index_s = index_c; index_s < index_c + iChunkSeg; ++index_s)  // go through segments of the chunk
         {
-          FillArray<float>((out_h + index_s*iSig2CCRatio), ChannCoeff, iSig2CCRatio);  // fill channel coefficient array
+          ChannCoeff = ary_fChannCoeff[index_s - index_c];  // channel coefficient of the segment
+          #ifdef _DEBUG_MODE_
+          std::cout << "Index = " << index_s << " out of " << NumOfSeg - 1 << std::endl;
+          std::cout << "Current channel coefficient = " << ChannCoeff << std::endl;
+          #endif
+
+          LinearMap<float>((in + index_s*iSig2CCRatio), (out + index_s*iSig2CCRatio), iSig2CCRatio, ChannCoeff, 0.0);  // apply channel coefficient
+
+          if(bhConnected == true)  // if h is to transferred
+          {
+            FillArray<float>((out_h + index_s*iSig2CCRatio), ChannCoeff, iSig2CCRatio);  // fill channel coefficient array
+          }
         }
       }
 
@@ -156,6 +171,8 @@ namespace gr {
       }
       #endif
 
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
@@ -22,11 +22,12 @@
 #define INCLUDED_FSO_COMM_TURBULENCE_IMPL_H
 
 #include <FSO_Comm/Turbulence.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace FSO_Comm {
 
-    class Turbulence_impl : public Turbulence
+    class Turbulence_impl : public Turbulence, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -41,12 +42,14 @@ namespace gr {
     	float fmu_x;  // mu parameter weak turbulence
       int iSig2CCRatio;  // number of signal samples to number of channel coefficients ratio
       Norm_Rand_Gen RandGen;
+      float ary_fChannCoeff[RNG_BUFF_SIZE];  // channel coefficients of the current chunk
 
       void CalcParam(void);  // calculate channel coefficient parameters
 
      public:
       Turbulence_impl(float Cn2 = DEF_CN2, float wavelength = DEF_WL, float diaRx = DEF_DIA_RX,
-                      float LinkLen = DEF_LINK_LEN, float tempCorr = T_TEMP_CORR, float sampRate = SAMP_RATE);
+                      float LinkLen = DEF_LINK_LEN, float tempCorr = T_TEMP_CORR, float sampRate = SAMP_RATE,
+                      int seed = DEF_SEED, int streamId = DEF_STREAM_ID);
       ~Turbulence_impl();
 
       // Where all the action really happens
@@ -56,6 +59,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set the Refractive Index Structure Coefficient (m^-2/3)
       void set_Cn2(float Cn2)
       {
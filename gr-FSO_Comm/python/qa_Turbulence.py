@@ -86,5 +86,40 @@ class qa_Turbulence(gr_unittest.TestCase):
 
 
 
+    def test_002_t(self):  # reproducible seeded mode
+        # test parameters
+        Cn2 = 1e-12
+        wavelen = 850
+        linklen = 200
+        Rx_Dia = 50
+        Time_Correlation = 1
+        SampleRate = 32e3
+        Seed = 1234
+
+        # create blocks and connect flowgraph; blocks 0 and 1 share the substream, block 2 uses the next one
+        src_data = (1, )*100000
+
+        src = blocks.vector_source_f(src_data)
+        sqr = [FSO_Comm.Turbulence(Cn2, wavelen, Rx_Dia, linklen, Time_Correlation, SampleRate, Seed, streamId) for streamId in (0, 0, 1)]
+        dst = [blocks.vector_sink_f() for index in range(3)]
+        for index in range(3):
+            self.tb.connect(src, sqr[index], dst[index])
+
+        # set up fg
+        self.tb.run ()
+        # check data
+        result_data = [d.data() for d in dst]
+
+        print("***************************")
+        print("Seed = ", Seed)
+        print("Test:")
+        print("Same substream outputs are equal: ", result_data[0] == result_data[1])
+        print("Different substream outputs are equal: ", result_data[0] == result_data[2])
+
+        # same (seed, stream id) must repeat; different stream id must not
+        self.assertFloatTuplesAlmostEqual(result_data[0], result_data[1], 6)
+        self.assertNotEqual(result_data[0], result_data[2])
+
+
 if __name__ == '__main__':
     gr_unittest.run(qa_Turbulence)
@@ -0,0 +1,346 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2020 gr-Hybrid_Comm author.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+// sustained throughput of the Hybrid_Comm blocks; see Throughput_Harness for the options
+
+#include <Hybrid_Comm/Add_Header.h>
+#include <Hybrid_Comm/Hysteresis_Gate.h>
+#include <Hybrid_Comm/Link_Tester.h>
+#include <Hybrid_Comm/Pack_Bits.h>
+#include <Hybrid_Comm/Preamble_Sync.h>
+#include <Hybrid_Comm/Remove_Header.h>
+#include <Hybrid_Comm/Rx_Hard_Switch.h>
+#include <Hybrid_Comm/Rx_Parallel_Switch.h>
+#include <Hybrid_Comm/Rx_Soft_Switch.h>
+#include <Hybrid_Comm/Signal_Quality_Metre.h>
+#include <Hybrid_Comm/Slicer.h>
+#include <Hybrid_Comm/Source_BV.h>
+#include <Hybrid_Comm/Step_Gate.h>
+#include <Hybrid_Comm/Stream_Aligner.h>
+#include <Hybrid_Comm/Tx_Hard_Switch.h>
+#include <Hybrid_Comm/Tx_Parallel_Switch.h>
+#include <Hybrid_Comm/Tx_Soft_Switch.h>
+#include <Hybrid_Comm/Unpack_Bits.h>
+
+#include <gnuradio/blocks/vector_sink.h>
+#include <algorithm>
+
+#include <throughput_harness.h>
+
+using namespace gr::Comm_Kernels;
+
+
+#define THRPT_PACKETS                       (16)                                        // packets in the generated input of one repetition
+#define THRPT_SEL_LEVELS                    (10)                                        // distinct selector values per repetition
+#define THRPT_LINKS                         (3)                                         // links of the multi link stream aligner
+
+
+// selector input stepping through 0 .. THRPT_SEL_LEVELS - 1, one value per packet, so the switches take all their paths
+static std::vector<float> SelectorSignal(const int iPacketSize)
+{
+  std::vector<float> vSel(THRPT_SEL_LEVELS*iPacketSize);
+  for(size_t index = 0; index < vSel.size(); ++index)  // go through all samples
+  {
+    vSel[index] = float(index/iPacketSize);  // level of the packet
+  }
+  return vSel;
+}
+
+// packets with headers, as Add_Header produces them; the input of Remove_Header
+static std::vector<char> HeaderedSignal(const int iPacketSize, const std::vector<char> &vPreamble, const std::string &sLabel, const int iHeaderSpB, const bool bPacked = false)
+{
+  std::vector<char> vPayload = Throughput_Harness::BitSignal(THRPT_PACKETS*iPacketSize, 1);
+
+  gr::top_block_sptr tb = gr::make_top_block("HeaderedSignal");
+  gr::blocks::vector_source_b::sptr src = gr::blocks::vector_source_b::make(std::vector<unsigned char>(vPayload.begin(), vPayload.end()));
+  gr::Hybrid_Comm::Add_Header::sptr header = gr::Hybrid_Comm::Add_Header::make(iPacketSize, vPreamble, sLabel, iHeaderSpB, false, false, false, 16, bPacked);
+  gr::blocks::vector_sink_b::sptr dst = gr::blocks::vector_sink_b::make();
+  tb->connect(src, 0, header, 0);
+  tb->connect(header, 0, dst, 0);
+  tb->run();
+
+  std::vector<unsigned char> vOut = dst->data();  // copy of the sink contents
+  return std::vector<char>(vOut.begin(), vOut.end());
+}
+
+
+int main(int argc, char **argv)
+{
+  Throughput_Harness Harness("Hybrid_Comm", argc, argv);
+
+  const std::vector<char> vPreamble = {0, 0, 1, 1, 0, 1, 0, 1};  // header preamble
+  const std::string sLabel = "L1";  // header label
+  const std::vector<size_t> vCharOut = {sizeof(char)};
+  const std::vector<size_t> vCharOut2 = {sizeof(char), sizeof(char)};
+  const std::vector<size_t> vFloatOut = {sizeof(float)};
+
+  Harness.add("Add_Header", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Add_Header::sptr block = gr::Hybrid_Comm::Add_Header::make(P.iPacketSize, vPreamble, sLabel, P.iSamplesPerBit);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1), block, 0);
+    H.connect_sinks(tb, block, vCharOut);
+    return block;
+  });
+
+  Harness.add("Remove_Header", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Remove_Header::sptr block = gr::Hybrid_Comm::Remove_Header::make(P.iPacketSize, vPreamble, sLabel, P.iSamplesPerBit);
+    H.connect_source<char>(tb, HeaderedSignal(P.iPacketSize, vPreamble, sLabel, P.iSamplesPerBit), block, 0);
+    H.connect_sinks(tb, block, {sizeof(char), sizeof(char), sizeof(int)});
+    return block;
+  });
+
+  // packed bytes; the packets of the same channel samples, 8*SpB per byte
+  Harness.add("Add_Header_Packed", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    int iPacketBytes = std::max(P.iPacketSize/(8*P.iSamplesPerBit), 1);  // packet bytes
+    gr::Hybrid_Comm::Add_Header::sptr block = gr::Hybrid_Comm::Add_Header::make(iPacketBytes, vPreamble, sLabel, P.iSamplesPerBit, false, false, false, 16, true);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*iPacketBytes, 1), block, 0);
+    H.connect_sinks(tb, block, vCharOut);
+    return block;
+  });
+
+  Harness.add("Remove_Header_Packed", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    int iPacketBytes = std::max(P.iPacketSize/(8*P.iSamplesPerBit), 1);  // packet bytes
+    gr::Hybrid_Comm::Remove_Header::sptr block = gr::Hybrid_Comm::Remove_Header::make(iPacketBytes, vPreamble, sLabel, P.iSamplesPerBit, false, false, false, false, 16, true);
+    H.connect_source<char>(tb, HeaderedSignal(iPacketBytes, vPreamble, sLabel, P.iSamplesPerBit, true), block, 0);
+    H.connect_sinks(tb, block, {sizeof(char), sizeof(char), sizeof(int)});
+    return block;
+  });
+
+  Harness.add("Remove_Header_Demux", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Remove_Header::sptr block = gr::Hybrid_Comm::Remove_Header::make(P.iPacketSize, vPreamble, "L0," + sLabel + ",L2,L3,L4,L5,L6,L7", P.iSamplesPerBit);  // 8 flows
+    H.connect_source<char>(tb, HeaderedSignal(P.iPacketSize, vPreamble, sLabel, P.iSamplesPerBit), block, 0);
+    H.connect_sinks(tb, block, std::vector<size_t>(block->get_NumOfFlows(), sizeof(char)));
+    return block;
+  });
+
+  Harness.add("Hysteresis_Gate", AXIS_PACKET, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Hysteresis_Gate::sptr block = gr::Hybrid_Comm::Hysteresis_Gate::make(P.iPacketSize, -1.0, +1.0, +1.0, +1.0, -1.0, -1.0, "Forward");
+    H.connect_source<float>(tb, Throughput_Harness::NoisySignal(THRPT_PACKETS*P.iPacketSize, 1, 1.0, 0), block, 0);
+    H.connect_source<float>(tb, Throughput_Harness::NoisySignal(THRPT_PACKETS*P.iPacketSize, 1, 1.0, 2), block, 1);
+    H.connect_sinks(tb, block, vFloatOut);
+    return block;
+  });
+
+  Harness.add("Step_Gate", AXIS_PACKET, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Step_Gate::sptr block = gr::Hybrid_Comm::Step_Gate::make(P.iPacketSize, {-2, -1, 0, +1, +2}, {-2, -1, +1, +2});
+    H.connect_source<float>(tb, Throughput_Harness::NoisySignal(THRPT_PACKETS*P.iPacketSize, 1, 1.0, 0), block, 0);
+    H.connect_source<float>(tb, Throughput_Harness::NoisySignal(THRPT_PACKETS*P.iPacketSize, 1, 1.0, 2), block, 1);
+    H.connect_sinks(tb, block, vFloatOut);
+    return block;
+  });
+
+  Harness.add("Link_Tester", AXIS_PACKET | AXIS_SPB | AXIS_RATE, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    if(P.iPacketSize%P.iSamplesPerBit != 0)  // packets hold whole bits only
+    {
+      return nullptr;
+    }
+    gr::Hybrid_Comm::Link_Tester::sptr block = gr::Hybrid_Comm::Link_Tester::make(P.iPacketSize, P.fSampRate);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, P.iSamplesPerBit, 0), block, 0);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, P.iSamplesPerBit, 2), block, 1);
+    H.connect_source<char>(tb, std::vector<char>(P.iPacketSize, VAL_1), block, 2);
+    H.connect_source<char>(tb, std::vector<char>(P.iPacketSize, char(P.iSamplesPerBit)), block, 3);
+    H.connect_sinks(tb, block, {sizeof(float), sizeof(float), sizeof(float)});
+    return block;
+  });
+
+  Harness.add("Signal_Quality_Metre", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Signal_Quality_Metre::sptr block = gr::Hybrid_Comm::Signal_Quality_Metre::make(P.iPacketSize, P.iSamplesPerBit, "Signal Power", 2);
+    H.connect_source<float>(tb, Throughput_Harness::NoisySignal(THRPT_PACKETS*P.iPacketSize, P.iSamplesPerBit), block, 0);
+    H.connect_sinks(tb, block, vFloatOut);
+    return block;
+  });
+
+  Harness.add("Slicer", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Slicer::sptr block = gr::Hybrid_Comm::Slicer::make(P.iPacketSize, P.iSamplesPerBit, 0.5);  // one bit averaging window
+    H.connect_source<float>(tb, Throughput_Harness::NoisySignal(THRPT_PACKETS*P.iPacketSize, P.iSamplesPerBit), block, 0);
+    H.connect_sinks(tb, block, vCharOut);
+    return block;
+  });
+
+  Harness.add("Preamble_Sync", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Preamble_Sync::sptr block = gr::Hybrid_Comm::Preamble_Sync::make(vPreamble, P.iSamplesPerBit, 0.7);
+    H.connect_source<float>(tb, Throughput_Harness::NoisySignal(THRPT_PACKETS*P.iPacketSize, P.iSamplesPerBit), block, 0);
+    H.connect_sinks(tb, block, vFloatOut);
+    return block;
+  });
+
+  Harness.add("Source_BV", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Source_BV::sptr block = gr::Hybrid_Comm::Source_BV::make(P.iPacketSize, "Random", THRPT_SEED);
+    H.connect_source<char>(tb, std::vector<char>(P.iPacketSize, char(P.iSamplesPerBit)), block, 0);
+    H.connect_sinks(tb, block, vCharOut);
+    return block;
+  });
+
+  Harness.add("Stream_Aligner", AXIS_PACKET, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    std::vector<char> vSync(THRPT_PACKETS*P.iPacketSize, 0);  // packet start flags
+    std::vector<int> vCount(THRPT_PACKETS*P.iPacketSize, 0);  // packet counters
+    for(int index_p = 0; index_p < THRPT_PACKETS; ++index_p)  // go through the packets
+    {
+      vSync[index_p*P.iPacketSize] = 1;
+      vCount[index_p*P.iPacketSize] = index_p;
+    }
+
+    gr::Hybrid_Comm::Stream_Aligner::sptr block = gr::Hybrid_Comm::Stream_Aligner::make(P.iPacketSize);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1, 0), block, 0);
+    H.connect_source<char>(tb, vSync, block, 1);
+    H.connect_source<int>(tb, vCount, block, 2);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1, 2), block, 3);
+    H.connect_source<char>(tb, vSync, block, 4);
+    H.connect_source<int>(tb, vCount, block, 5);
+    H.connect_sinks(tb, block, vCharOut2);
+    return block;
+  });
+
+  Harness.add("Stream_Aligner_Zero_Copy", AXIS_PACKET, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    std::vector<char> vSync(THRPT_PACKETS*P.iPacketSize, 0);  // packet start flags
+    std::vector<int> vCount(THRPT_PACKETS*P.iPacketSize, 0);  // packet counters
+    for(int index_p = 0; index_p < THRPT_PACKETS; ++index_p)  // go through the packets
+    {
+      vSync[index_p*P.iPacketSize] = 1;
+      vCount[index_p*P.iPacketSize] = index_p;
+    }
+
+    gr::Hybrid_Comm::Stream_Aligner::sptr block = gr::Hybrid_Comm::Stream_Aligner::make(P.iPacketSize, false, 16, 1, true);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1, 0), block, 0);
+    H.connect_source<char>(tb, vSync, block, 1);
+    H.connect_source<int>(tb, vCount, block, 2);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1, 2), block, 3);
+    H.connect_source<char>(tb, vSync, block, 4);
+    H.connect_source<int>(tb, vCount, block, 5);
+    H.connect_sinks(tb, block, vCharOut2);
+    return block;
+  });
+
+  Harness.add("Stream_Aligner_Multi_Link", AXIS_PACKET, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    std::vector<char> vSync(THRPT_PACKETS*P.iPacketSize, 0);  // packet start flags
+    std::vector<int> vCount(THRPT_PACKETS*P.iPacketSize, 0);  // packet counters
+    for(int index_p = 0; index_p < THRPT_PACKETS; ++index_p)  // go through the packets
+    {
+      vSync[index_p*P.iPacketSize] = 1;
+      vCount[index_p*P.iPacketSize] = index_p;
+    }
+
+    gr::Hybrid_Comm::Stream_Aligner::sptr block = gr::Hybrid_Comm::Stream_Aligner::make(P.iPacketSize, false, 16, 1, true, THRPT_LINKS);
+    for(int index_l = 0; index_l < THRPT_LINKS; ++index_l)  // go through the links
+    {
+      H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1, 2*index_l), block, 3*index_l);
+      H.connect_source<char>(tb, vSync, block, 3*index_l + 1);
+      H.connect_source<int>(tb, vCount, block, 3*index_l + 2);
+    }
+    H.connect_sinks(tb, block, std::vector<size_t>(THRPT_LINKS, sizeof(char)));
+    return block;
+  });
+
+  Harness.add("Tx_Hard_Switch", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Tx_Hard_Switch::sptr block = gr::Hybrid_Comm::Tx_Hard_Switch::make(P.iPacketSize, THRPT_SEL_LEVELS/2, {char(P.iSamplesPerBit), 1});
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1), block, 0);
+    H.connect_source<float>(tb, SelectorSignal(P.iPacketSize), block, 1);
+    H.connect_sinks(tb, block, vCharOut2);
+    return block;
+  });
+
+  Harness.add("Rx_Hard_Switch", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Rx_Hard_Switch::sptr block = gr::Hybrid_Comm::Rx_Hard_Switch::make(P.iPacketSize, THRPT_SEL_LEVELS/2, {char(P.iSamplesPerBit), 1});
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, P.iSamplesPerBit, 0), block, 0);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1, 2), block, 1);
+    H.connect_source<float>(tb, SelectorSignal(P.iPacketSize), block, 2);
+    H.connect_sinks(tb, block, vCharOut);
+    return block;
+  });
+
+  Harness.add("Tx_Parallel_Switch", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    if(P.iPacketSize%P.iSamplesPerBit != 0)  // packets hold whole bits only
+    {
+      return nullptr;
+    }
+    gr::Hybrid_Comm::Tx_Parallel_Switch::sptr block = gr::Hybrid_Comm::Tx_Parallel_Switch::make(P.iPacketSize, P.iSamplesPerBit);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1), block, 0);
+    H.connect_sinks(tb, block, vCharOut2);
+    return block;
+  });
+
+  Harness.add("Rx_Parallel_Switch", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    if(P.iPacketSize%P.iSamplesPerBit != 0)  // packets hold whole bits only
+    {
+      return nullptr;
+    }
+    gr::Hybrid_Comm::Rx_Parallel_Switch::sptr block = gr::Hybrid_Comm::Rx_Parallel_Switch::make(P.iPacketSize, THRPT_SEL_LEVELS/2, P.iSamplesPerBit);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1, 0), block, 0);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, P.iSamplesPerBit, 2), block, 1);
+    H.connect_source<float>(tb, SelectorSignal(P.iPacketSize), block, 2);
+    H.connect_sinks(tb, block, vCharOut);
+    return block;
+  });
+
+  Harness.add("Tx_Soft_Switch", AXIS_PACKET, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Tx_Soft_Switch::sptr block = gr::Hybrid_Comm::Tx_Soft_Switch::make(P.iPacketSize, {5, 8}, {1, 1, 2}, {2, 1, 1});
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1), block, 0);
+    H.connect_source<float>(tb, SelectorSignal(P.iPacketSize), block, 1);
+    H.connect_sinks(tb, block, vCharOut2);
+    return block;
+  });
+
+  Harness.add("Rx_Soft_Switch", AXIS_PACKET, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Rx_Soft_Switch::sptr block = gr::Hybrid_Comm::Rx_Soft_Switch::make(P.iPacketSize, {5, 8}, {1, 1, 2}, {2, 1, 1});
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1, 0), block, 0);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 2, 2), block, 1);
+    H.connect_source<float>(tb, SelectorSignal(P.iPacketSize), block, 2);
+    H.connect_sinks(tb, block, vCharOut);
+    return block;
+  });
+
+  Harness.add("Pack_Bits", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Pack_Bits::sptr block = gr::Hybrid_Comm::Pack_Bits::make(P.iSamplesPerBit);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, P.iSamplesPerBit), block, 0);
+    H.connect_sinks(tb, block, vCharOut);
+    return block;
+  });
+
+  Harness.add("Unpack_Bits", AXIS_PACKET | AXIS_SPB, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::Hybrid_Comm::Unpack_Bits::sptr block = gr::Hybrid_Comm::Unpack_Bits::make(P.iSamplesPerBit);
+    H.connect_source<char>(tb, Throughput_Harness::BitSignal(THRPT_PACKETS*P.iPacketSize, 1), block, 0);  // any byte values
+    H.connect_sinks(tb, block, vCharOut);
+    return block;
+  });
+
+  return Harness.run();
+}
@@ -32,7 +32,25 @@ namespace gr {
      * \ingroup Hybrid_Comm
      * The blocks adds a header to the incoming data array. It adds a preamble as well as a label and a counter to the packet section.
      * The pattern will be like:  [Preamble, Label, Counter, Data]
-     * Counter field has 8 bits length.
+     * Counter field has seqBits (16, 32 or 48) bits length, least significant bit first, and wraps to 0 after its
+     * largest value; the receiving blocks compare counters with serial number arithmetic, so the wrap is seamless.
+     * In PDU mode the block has no input stream; every PDU (u8vector payload) of the 'pdu' message port is unpacked,
+     * samplesPerBit samples per bit, and sent out as one packet. PDU headers always have the length field, so the
+     * receiver gives back exactly the PDU bytes; packetSize is rounded down to whole bytes, 8*samplesPerBit samples.
+     * With the CRC field on, the packet ends with the CRC-32 of the counter field and the data:
+     * [Preamble, Label, Counter, Data, CRC]; CRC field has 32 bits length, least significant bit first. The CRC runs over
+     * the counter bytes (least significant first) and the data bits packed into bytes (first bit in the most significant
+     * bit, the last byte filled up with '0's), so it does not depend on samplesPerBit or on which sample of a bit is read.
+     * With the length field on, a 16 bit field after the counter holds the number of data samples, up to packetSize:
+     * [Preamble, Label, Counter, Length, Data, CRC], and the CRC covers the length field as well. PDU headers hold the
+     * payload bits instead, so a PDU may have up to 8191 bytes at any samplesPerBit. A packetSize longer than the field
+     * holds is rejected. PDUs are then framed
+     * without padding; on the input stream a 'packet_len' tag starts a packet of that length, and untagged input is
+     * cut into packetSize packets. A tagged packet longer than packetSize is dropped up to its length or the next tag.
+     * In packed mode the input and output items are bytes of 8 bits, first bit in the most significant bit, and the header
+     * has one bit per header bit; packetSize is in bytes and the packets go to the channel through Unpack_Bits(samplesPerBit),
+     * which gives the packets of the unpacked block. The length field still holds the data samples on the channel, 8 per
+     * byte times samplesPerBit. Packed headers are whole bytes, so a preamble of other lengths is led by '0's up to one.
      */
     class HYBRID_COMM_API Add_Header : virtual public gr::block
     {
@@ -46,8 +64,13 @@ namespace gr {
        * \param preamble preamble array of '0's and '1's
        * \param label label array of characters
        * \param samplesPerBit header samples per bit
+       * \param pduMode take the packets from the 'pdu' message port instead of the input stream
+       * \param crc add the CRC field after the data
+       * \param lengthField add the payload length field after the counter; packets up to packetSize samples; always on in PDU mode, with the payload bits
+       * \param seqBits counter field length; 16, 32 or 48 bits
+       * \param packed input and output bytes of 8 bits instead of one bit per sample
        */
-      static sptr make(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit);
+      static sptr make(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit, bool pduMode = false, bool crc = false, bool lengthField = false, int seqBits = 16, bool packed = false);
 
       /*!
        * \brief Set preamble
@@ -101,6 +124,39 @@ namespace gr {
        */
       virtual int get_PacketSize() = 0;
 
+      /*!
+       * \brief Return PDU mode
+       */
+      virtual bool get_PduMode(void) = 0;
+
+      /*!
+       * \brief Set CRC field
+       *
+       * \param crc
+       * add the CRC field after the data
+       */
+      virtual void set_Crc(bool crc) = 0;
+
+      /*!
+       * \brief Return CRC field state
+       */
+      virtual bool get_Crc(void) = 0;
+
+      /*!
+       * \brief Return length field state
+       */
+      virtual bool get_LengthField(void) = 0;
+
+      /*!
+       * \brief Return counter field length (bits)
+       */
+      virtual int get_SeqBits(void) = 0;
+
+      /*!
+       * \brief Return packed mode
+       */
+      virtual bool get_Packed(void) = 0;
+
     };
 
   } // namespace Hybrid_Comm
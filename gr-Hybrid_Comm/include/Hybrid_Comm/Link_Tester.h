@@ -34,6 +34,8 @@ namespace gr {
      * The block does the calculattion based on availability of bit streams according to the control 'ctl' pin and the number samples per bit from 'SpB' pin.
      * The outputs are bit-error-rate (BER), link availability (LA), and link throughout (LT).
      * if 'ctl' value is less than 250, it is assumed to be links delay. Values greater than 250 represent error.
+     * In packed mode the bit streams have 8 bits per byte (Source_BV and Remove_Header in packed mode); packetSize is then
+     * in bytes, 'ctl' and 'SpB' have one value per byte, and the sample rate is still the one of the channel.
      */
     class HYBRID_COMM_API Link_Tester : virtual public gr::sync_block
     {
@@ -45,8 +47,9 @@ namespace gr {
        *
        * \param packetSize incoming packet size
        * \param samp_rate sample rate (samples per seconds)
+       * \param packed bit streams of bytes of 8 bits instead of one bit per sample
        */
-      static sptr make(int packetSize, float samp_rate);
+      static sptr make(int packetSize, float samp_rate, bool packed = false);
 
       /*!
        * \brief Set packet data samples length
@@ -74,6 +77,11 @@ namespace gr {
        */
       virtual float get_SampRate(void) = 0;
 
+      /*!
+       * \brief Return packed mode
+       */
+      virtual bool get_Packed(void) = 0;
+
     };
 
   } // namespace Hybrid_Comm
@@ -0,0 +1,95 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2020 gr-Hybrid_Comm author.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HYBRID_COMM_PREAMBLE_SYNC_H
+#define INCLUDED_HYBRID_COMM_PREAMBLE_SYNC_H
+
+#include <Hybrid_Comm/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace Hybrid_Comm {
+
+    /*!
+     * \brief Preamble Sync
+     * \ingroup Hybrid_Comm
+     * The block finds the preamble in the analogue (float) signal before it is sliced into bits. The signal is
+     * correlated with the preamble, resampled to 'samplesPerBit' samples per bit; both have their mean removed
+     * and the result is normalised by their energies, so it lies in [-1, 1] whatever the signal level and offset.
+     * Where it peaks above the threshold the output sample gets a 'preamble_start' tag whose value is a
+     * dictionary of the peak ('corr_peak') and the SNR over the preamble estimated from it ('snr', dB).
+     * Peaks are at least one preamble apart. The signal is passed through delayed by 2*preamble samples - 1;
+     * tags from upstream move with their samples. The optional second output is the normalised correlation.
+     * Long preambles are correlated by FFT in calls of at least one FFT length of samples, short ones directly;
+     * long is 64 samples per float of the CPU vector (1024 with AVX-512, 512 with AVX2, 256 with SSE2 or NEON).
+     */
+    class HYBRID_COMM_API Preamble_Sync : virtual public gr::sync_block
+    {
+     public:
+      typedef boost::shared_ptr<Preamble_Sync> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of Hybrid_Comm::Preamble_Sync.
+       *
+       * \param preamble preamble array of '0's and '1's
+       * \param samplesPerBit header samples per bit
+       * \param thresh normalised correlation threshold
+       */
+      static sptr make(const std::vector<char>& preamble, int samplesPerBit = 1, float thresh = 0.7);
+
+      /*!
+       * \brief Return preamble
+       */
+      virtual void get_Preamble(std::vector<char>* preamble) = 0;
+
+      /*!
+       * \brief Return samples per bit
+       */
+      virtual int get_SamplesPerBit(void) = 0;
+
+      /*!
+       * \brief Set normalised correlation threshold
+       * 
+       * \param thresh
+       * normalised correlation threshold
+       */
+      virtual void set_Thresh(float thresh) = 0;
+
+      /*!
+       * \brief Return normalised correlation threshold
+       */
+      virtual float get_Thresh(void) = 0;
+
+      /*!
+       * \brief Return true if the preamble is long enough for the FFT correlation
+       */
+      virtual bool get_Fft(void) = 0;
+
+      /*!
+       * \brief Return the delay of the output (samples)
+       */
+      virtual int get_Delay(void) = 0;
+
+    };
+
+  } // namespace Hybrid_Comm
+} // namespace gr
+
+#endif /* INCLUDED_HYBRID_COMM_PREAMBLE_SYNC_H */
@@ -35,7 +35,38 @@ namespace gr {
      * A synchronisation pulse at 'sync' pin is used to show the beginning of the data section.
      * if 'Counter' pin value is -1, then the output data is not valid.
      * The pattern will be like:  [Preamble, Label, Counter, Data]
-     * Counter field has 8 bits length.
+     * Counter field has seqBits (16, 32 or 48) bits length; the 'seq' tags and PDU metadata hold all of it and the
+     * 'Counter' pin its lowest 31 bits, so -1 is never a counter value.
+     * Once a header is found, the next ones are expected one packet later; after two of them are found
+     * the block locks and only checks the expected positions, within one header bit. A full search is
+     * run again after 'MaxMisses' consecutive headers are missed.
+     * The fields of the header are decided by the majority of the samples of each bit. With Preamble_Sync upstream
+     * (through Slicer), a header within half a bit of a 'preamble_start' tag is taken even with up to a quarter of its
+     * pattern samples wrong, so a weak signal still syncs; elsewhere the pattern has to match exactly. The tags are
+     * not used in packed mode.
+     * In tag mode there are no 'sync' and 'Counter' outputs (the second output is SpB); every output packet
+     * gets a 'seq' tag holding its counter (-1 if not valid) and valid ones a 'packet_start' tag as well.
+     * In PDU mode there are no output streams; the data of every valid packet is packed into bytes, samplesPerBit
+     * samples per bit, and sent from the 'pdu' message port with its counter, label and sync state as metadata.
+     * PDU headers always have the length field, as Add_Header sends them, with the payload bits (up to 8191 bytes); a
+     * length of no whole bytes marks a corrupted header, so a PDU is never cut short or padded.
+     * With the CRC field on, the packet ends with the CRC-32 of the counter field and the data bits, as Add_Header
+     * computes it; the data bits are the decided ones, the middle sample of each bit. Every packet whose header is
+     * found gets a 'crc_ok' tag (or PDU metadata entry) with the result. In stream mode a bad packet is dropped: its output packet
+     * has the counter -1, like a packet whose header is missed, and the 'crc_ok' tag of false tells the two apart.
+     * With the length field on, the header has a 16 bit field after the counter with the number of data samples, up to
+     * packetSize, and every packet gives exactly its data; packets that are not valid give no output at all. A
+     * packetSize longer than the field holds is rejected. When a locked header is missed, the next one is searched
+     * for within the longest packet after it, and lock is kept until 'MaxMisses' consecutive misses.
+     * A list of labels separated by ',' splits the link into flows, one per label, all of the length of the first
+     * label. The header search then looks for the preamble only and the label field picks the flow with one hash
+     * lookup, so the cost does not grow with the number of labels. Every flow has its own tagged data output (no
+     * SpB output) or, in PDU mode, its own message port 'pdu0', 'pdu1', ...; packets of other labels are skipped.
+     * In packed mode the input and output items are bytes of 8 bits, first bit in the most significant bit, as Pack_Bits
+     * gives them from the channel; packetSize is in bytes. The input is packed for the search once, the headers are found
+     * at any bit offset and their fields read bit by bit, and the data is copied out a byte at a time. The length field
+     * holds the data samples on the channel, so packed and unpacked blocks interwork; preambles whose length is not a
+     * multiple of 8 are led by '0's, as Add_Header does in packed mode.
      */
     class HYBRID_COMM_API Remove_Header : virtual public gr::block
     {
@@ -47,10 +78,16 @@ namespace gr {
        *
        * \param packetSize output packet size
        * \param preamble preamble array of '0's and '1's
-       * \param label label array of characters
+       * \param label label array of characters; labels separated by ',' for one flow per label
        * \param samplesPerBit header samples per bit
+       * \param tagMode mark the packets with 'packet_start' and 'seq' stream tags instead of the sync and counter outputs
+       * \param pduMode send the packets from the 'pdu' message port instead of the output streams
+       * \param crc packets end with the CRC field
+       * \param lengthField headers have the payload length field after the counter; packets up to packetSize samples; always on in PDU mode, with the payload bits
+       * \param seqBits counter field length; 16, 32 or 48 bits
+       * \param packed input and output bytes of 8 bits instead of one bit per sample
        */
-      static sptr make(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit);
+      static sptr make(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit, bool tagMode = false, bool pduMode = false, bool crc = false, bool lengthField = false, int seqBits = 16, bool packed = false);
 
       /*!
        * \brief Set preamble
@@ -104,6 +141,67 @@ namespace gr {
        */
       virtual int get_SamplesPerBit(void) = 0;
 
+      /*!
+       * \brief Set number of consecutive missed headers before lock is lost
+       * 
+       * \param maxMisses
+       * number of consecutive missed headers
+       */
+      virtual void set_MaxMisses(int maxMisses) = 0;
+
+      /*!
+       * \brief Return number of consecutive missed headers before lock is lost
+       */
+      virtual int get_MaxMisses(void) = 0;
+
+      /*!
+       * \brief Return tag mode
+       */
+      virtual bool get_TagMode(void) = 0;
+
+      /*!
+       * \brief Return PDU mode
+       */
+      virtual bool get_PduMode(void) = 0;
+
+      /*!
+       * \brief Set CRC field
+       *
+       * \param crc
+       * packets end with the CRC field
+       */
+      virtual void set_Crc(bool crc) = 0;
+
+      /*!
+       * \brief Return CRC field state
+       */
+      virtual bool get_Crc(void) = 0;
+
+      /*!
+       * \brief Return length field state
+       */
+      virtual bool get_LengthField(void) = 0;
+
+      /*!
+       * \brief Return number of labelled flows
+       */
+      virtual int get_NumOfFlows(void) = 0;
+
+      /*!
+       * \brief Return counter field length (bits)
+       */
+      virtual int get_SeqBits(void) = 0;
+
+      /*!
+       * \brief Return header sync state; 0: hunt, 1: verify, 2: lock
+       */
+      virtual int get_SyncState(void) = 0;
+
+      /*!
+       * \brief Return packed mode
+       */
+      virtual bool get_Packed(void) = 0;
+
     };
 
   } // namespace Hybrid_Comm
@@ -31,7 +31,10 @@ namespace gr {
      * \brief Bit-variant Source
      * \ingroup Hybrid_Comm
      * \brief The block generates fixed length output containing given number of bits.
-     *
+     * In packed mode every output byte holds 8 bits, first bit in the most significant bit, and every bit is sent once;
+     * packetSize is then in bytes and samplesPerBit is applied at the channel by Unpack_Bits. The 'spb' input and output
+     * still have one value per output item. With the same seed, packed packets of P bytes give the bits of unpacked
+     * packets of 8*P*samplesPerBit samples.
      */
     class HYBRID_COMM_API Source_BV : virtual public gr::sync_block
     {
@@ -43,8 +46,11 @@ namespace gr {
        *
        * \param packetSize output packet size
        * \param signalType output signal type; 'Constant' or 'Random'
+       * \param seed random number seed; negative value seeds from time
+       * \param streamId random number stream id; each (seed, streamId) pair gives an independent substream
+       * \param packed output bytes of 8 bits instead of one bit per sample
        */
-      static sptr make(int packetSize, std::string signalType);
+      static sptr make(int packetSize, std::string signalType, int seed = -1, int streamId = 0, bool packed = false);
 
       /*!
        * \brief Set measurement packet size
@@ -73,6 +79,11 @@ namespace gr {
        */
       virtual std::string get_SignalType(void) = 0;
 
+      /*!
+       * \brief Return packed mode
+       */
+      virtual bool get_Packed(void) = 0;
+
     };
 
   } // namespace Hybrid_Comm
@@ -22,7 +22,7 @@
 #define INCLUDED_HYBRID_COMM_STREAM_ALIGNER_H
 
 #include <Hybrid_Comm/api.h>
-#include <gnuradio/sync_block.h>
+#include <gnuradio/block.h>
 
 namespace gr {
   namespace Hybrid_Comm {
@@ -38,8 +38,30 @@ namespace gr {
      * If the block is filling the buffer, 'delay' will be equal to counter difference value and both outputs are set to -4.
      * If the sync pulses are aligned, zero-offset with counter difference within buffer bank capacity,
      * the output 'delay' is the difference between counter values of input stream and the outputs are aligned signals.
+     * In tag mode the only inputs are the two data streams of Remove_Header blocks in tag mode; their stream tags
+     * take the place of the sync and counter inputs.
+     * A packet start without a 'seq' tag, or a counter input of -1, has no counter: the packet can not be paired, so it
+     * is dropped and counted; the buffered and jitter modes send it out as INV_SIG_VAL at both outputs.
+     * The buffer bank holds up to bufferDepth packets of the lead stream, so delays up to bufferDepth packets are
+     * compensated; it is a ring of packet slots, so the depth costs memory only.
+     * Counters are compared with serial number arithmetic on seqBits (16, 32 or 48) bits, 31 bits at most from the
+     * counter inputs, so the delay stays right when the counters wrap.
+     * In zero-copy mode there is no buffer bank: the block reads the inputs at different rates, so the delay is held
+     * by the input buffers of the flow graph, and of the two packets at the input heads the older one is dropped until
+     * their counters match. Only aligned packets are sent out, with no error values; the 'ctl' output gives the
+     * complete packets waiting at input 1 less those at input 2 when the work call starts. The longest delay is set
+     * by the input buffer sizes. In tag mode the output packets get the 'packet_start' and 'seq' tags of the inputs.
+     * More than two links are aligned in zero-copy mode only: each link has its data input (and its sync and counter
+     * inputs in stream mode) and its output, all links are aligned to the slowest one, and 'ctl' gives the packets
+     * waiting at link 1 less the fewest waiting at another link. The delay of each link is given by get_LinkDelay.
+     * In jitter mode the buffered alignment follows a running median of the counter differences of the packets, not the
+     * first packet of each call: a late or early packet does not move it, a small change is followed a packet at a time
+     * and only a jump resets the buffer bank. A held packet sits in the bank slot of its counter and is sent out only
+     * with the lag packet of the same counter, so reordered packets are still paired; one not paired before its slot is
+     * taken again is dropped, so misaligned sync pulses give the error values and keep the buffer bank without pairing
+     * stale packets. Late, early and dropped packets and the resets are counted.
      */
-    class HYBRID_COMM_API Stream_Aligner : virtual public gr::sync_block
+    class HYBRID_COMM_API Stream_Aligner : virtual public gr::block
     {
      public:
       typedef boost::shared_ptr<Stream_Aligner> sptr;
@@ -48,8 +70,14 @@ namespace gr {
        * \brief Return a shared_ptr to a new instance of Hybrid_Comm::Stream_Aligner.
        *
        * \param packetSize output packet size
+       * \param tagMode read the packet starts and counters from the 'packet_start' and 'seq' stream tags of the two data inputs
+       * \param seqBits counter field length of the Remove_Header blocks; 16, 32 or 48 bits
+       * \param bufferDepth buffer bank depth; longest delay compensated (packets)
+       * \param zeroCopy hold the delay in the input buffers, not in the buffer bank; only aligned packets are sent out
+       * \param numOfLinks number of aligned links; more than 2 links set zero-copy mode, which is logged
+       * \param jitterMode buffered alignment follows a running median of the delay; std::invalid_argument with zeroCopy or more than 2 links
        */
-      static sptr make(int packetSize);
+      static sptr make(int packetSize, bool tagMode = false, int seqBits = 16, int bufferDepth = 5, bool zeroCopy = false, int numOfLinks = 2, bool jitterMode = false);
 
       /*!
        * \brief Set packet size
@@ -64,6 +92,54 @@ namespace gr {
        */
       virtual int get_PacketSize(void) = 0;
 
+      /*!
+       * \brief Set buffer bank depth
+       *
+       * \param bufferDepth
+       * longest delay compensated (packets)
+       */
+      virtual void set_BufferDepth(int bufferDepth) = 0;
+
+      /*!
+       * \brief Return buffer bank depth
+       */
+      virtual int get_BufferDepth(void) = 0;
+
+      /*!
+       * \brief Return tag mode
+       */
+      virtual bool get_TagMode(void) = 0;
+
+      /*!
+       * \brief Return zero-copy mode
+       */
+      virtual bool get_ZeroCopy(void) = 0;
+
+      /*!
+       * \brief Return jitter mode
+       */
+      virtual bool get_JitterMode(void) = 0;
+
+      /*!
+       * \brief Return delay (packets) compensated by the jitter buffer
+       */
+      virtual int get_JitterDelay(void) = 0;
+
+      /*!
+       * \brief Return number of aligned links
+       */
+      virtual int get_NumOfLinks(void) = 0;
+
+      /*!
+       * \brief Return packets waiting at a link beyond those at the slowest link, at the last zero-copy work call
+       */
+      virtual int get_LinkDelay(int link) = 0;
+
+      /*!
+       * \brief Return counter bits compared
+       */
+      virtual int get_SeqBits(void) = 0;
+
     };
 
   } // namespace Hybrid_Comm
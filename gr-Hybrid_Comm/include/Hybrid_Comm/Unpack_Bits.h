@@ -0,0 +1,67 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2020 gr-Hybrid_Comm author.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HYBRID_COMM_UNPACK_BITS_H
+#define INCLUDED_HYBRID_COMM_UNPACK_BITS_H
+
+#include <Hybrid_Comm/api.h>
+#include <gnuradio/sync_interpolator.h>
+
+namespace gr {
+  namespace Hybrid_Comm {
+
+    /*!
+     * \brief Unpacks bytes of 8 bits into the one bit per byte signal
+     * \ingroup Hybrid_Comm
+     * \brief The first bit is the most significant bit of a byte, as in the pack_k_bits/unpack_k_bits blocks.
+     *
+     */
+    class HYBRID_COMM_API Unpack_Bits : virtual public gr::sync_interpolator
+    {
+     public:
+      typedef boost::shared_ptr<Unpack_Bits> sptr;
+
+      /*!
+       * \brief Return a shared_ptr to a new instance of Hybrid_Comm::Unpack_Bits.
+       *
+       * \param samplesPerBit samples per bit of the output signal
+       */
+      static sptr make(int samplesPerBit = 1);
+
+      /*!
+       * \brief Set samples per bit
+       * 
+       * \param samplesPerBit
+       * samples per bit
+       */
+      virtual void set_SamplesPerBit(int samplesPerBit) = 0;
+
+      /*!
+       * \brief Return samples per bit
+       */
+      virtual int get_SamplesPerBit(void) = 0;
+
+    };
+
+  } // namespace Hybrid_Comm
+} // namespace gr
+
+#endif /* INCLUDED_HYBRID_COMM_UNPACK_BITS_H */
+
@@ -14,6 +14,8 @@
 #define LONG_DELAY_ERR                      (253)                                       // delay is too long for buffer
 #define FILLING_BUF_ERR                     (255)                                       // filling buffer error
 #define COUNTER_BITS                        (16)                                        // number of bits allocated for counter 
+#define COUNTER_MAX_BITS                    (48)                                        // widest counter field; 16, 32 or 48 bits can be set
+#define COUNTER_STREAM_BITS                 (31)                                        // counter bits carried by an integer counter stream; -1 stays free
 #define BITS_PER_LETT                       (8)                                         // number of bits per letter; for label allocation within the packet header
 #define OUT_NUM_MP                          (5)                                         // number of output items multiple
 #define PACKET_SAMP_SIZE                    (1000)                                      // number of samples in a packet
@@ -37,6 +39,39 @@
 #define CNT_STR                             ("Constant")                                // constant flag string
 #define RND_STR                             ("Random")                                  // random flag string
 #define BUFF_SIZE			                (5)                 						// stream aligner buffer size
+#define ALIGNER_LINKS                       (2)                                         // stream aligner links
+#define ALIGNER_MAX_LINKS                   (32)                                        // stream aligner links at most
+#define JITTER_WINDOW                       (9)                                         // jitter buffer: delay observations in the running median; odd
+#define JITTER_JUMP                         (3)                                         // jitter buffer: delay change (packets) taken as a jump; smaller changes are followed a packet at a time
+#define NO_SEQ_VAL                          (-1)                                        // packet counter: no counter; the packet is not paired
+#define DEF_SEED                            (-1)                                        // random number seed; negative value seeds from time
+#define DEF_STREAM_ID                       (0)                                         // random number stream id
+#define SYNC_HUNT                           (0)                                         // header sync state: full search for a header
+#define SYNC_VERIFY                         (1)                                         // header sync state: header found, confirming the packet period
+#define SYNC_LOCK                           (2)                                         // header sync state: only the expected header positions are checked
+#define SYNC_VERIFY_HITS                    (2)                                         // headers found at the expected position before lock
+#define SYNC_MAX_MISSES                     (3)                                         // consecutive missed headers before lock is lost
+#define SYNC_TOL_BITS                       (1)                                         // header position tolerance around the expected position (bits)
+#define SYNC_WAIT                           (-2)                                        // header search result: the header may be past the end of the input; wait for more input
+#define SYNC_TAG_MAX_ERR                    (0.25)                                      // fraction of the header pattern samples that may mismatch at an upstream 'preamble_start' tag
+#define PACKET_START_TAG                    ("packet_start")                            // stream tag key of a packet start
+#define SEQ_TAG                             ("seq")                                     // stream tag key of a packet counter
+#define PDU_PORT                            ("pdu")                                     // packet (PDU) message port id
+#define PDU_WAIT_MS                         (100)                                       // longest wait for a PDU in one work call (ms)
+#define LABEL_KEY                           ("label")                                   // PDU metadata key of the packet label
+#define LABEL_SEP                           (',')                                       // separator of the labels of a multi-label deframer
+#define SYNC_STATE_KEY                      ("sync_state")                              // PDU metadata key of the header sync state
+#define SYNC_OFFSET_KEY                     ("sync_offset")                             // PDU metadata key of the header offset from its expected position (samples)
+#define CRC_BITS                            (32)                                        // number of bits of the CRC field after the data
+#define CRC_OK_KEY                          ("crc_ok")                                  // stream tag and PDU metadata key of the CRC check result
+#define LENGTH_BITS                         (16)                                        // number of bits of the payload length field after the counter
+#define LENGTH_TAG                          ("packet_len")                              // stream tag key of a packet length (samples)
+#define PREAMBLE_TAG                        ("preamble_start")                          // stream tag key of a preamble found by correlation
+#define CORR_PEAK_KEY                       ("corr_peak")                               // preamble tag key of the normalised correlation peak
+#define SNR_KEY                             ("snr")                                     // preamble tag key of the SNR estimate (dB)
+#define CORR_THRESH                         (0.7)                                       // default normalised correlation threshold of a preamble
+#define CORR_MAX_PEAK                       (0.99999)                                   // largest correlation peak taken for the SNR estimate
+#define CORR_MIN_VAR                        (1e-6)                                      // smallest signal variance under the preamble, relative to its mean square, that is correlated
 
 
 #endif /* INCLUDED_DEFAULTS_H */
@@ -23,35 +23,50 @@
 #endif
 
 #include <gnuradio/io_signature.h>
+#include <stdexcept>
 #include "Add_Header_impl.h"
 
 namespace gr {
   namespace Hybrid_Comm {
 
     Add_Header::sptr
-    Add_Header::make(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit)
+    Add_Header::make(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit, bool pduMode, bool crc, bool lengthField, int seqBits, bool packed)
     {
       return gnuradio::get_initial_sptr
-        (new Add_Header_impl(packetSize, preamble, label, samplesPerBit));
+        (new Add_Header_impl(packetSize, preamble, label, samplesPerBit, pduMode, crc, lengthField, seqBits, packed));
     }
 
     const std::vector<char> Add_Header_impl::defPreamb = {0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0};  // default preamble
     const std::string Add_Header_impl::defLabel = "L1";  // default packet label
-    const int Add_Header_impl::iCounterLen = sizeof(char)*COUNTER_BITS;  // counter field length
     const int Add_Header_impl::iLabelBitsPerLet = sizeof(char)*BITS_PER_LETT;  // label bits per letters
     const int Add_Header_impl::iNumOfOutputMultiple = OUT_NUM_MP;  // number of output items multiple
 
     /*
      * The private constructor
      */
-    Add_Header_impl::Add_Header_impl(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit)
+    Add_Header_impl::Add_Header_impl(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit, bool pduMode, bool crc, bool lengthField, int seqBits, bool packed)
       : gr::block("Add Header",
-              gr::io_signature::make(1, 2, sizeof(char)),
-              gr::io_signature::make(1, 2, sizeof(char))),
-              iPreambleLen(1), iLabelLen(1), iSamplesPerBit(1), iPacketSize(1), iCounter(0),
+              (pduMode ? gr::io_signature::make(0, 0, 0) : gr::io_signature::make(1, 2, sizeof(char))),
+              (pduMode ? gr::io_signature::make(1, 1, sizeof(char)) : gr::io_signature::make(1, 2, sizeof(char)))),
+              iPreambleLen(1), iLabelLen(1), iSamplesPerBit(packed ? 1 : CONSTRAIN(samplesPerBit, 1, INT_MAX)), iChannelSpB(CONSTRAIN(samplesPerBit, 1, INT_MAX)), bPacked(packed), iPacketSize(1), iCounter(0),
               ptr_cPreamble(nullptr), ptr_cLabel(nullptr), ptr_cLabelBits(nullptr),
-              ptr_cPreambleSeq(nullptr), ptr_cLabelBitsSeq(nullptr), ptr_cCounterSeq(nullptr), ary_cCounterBits(nullptr)
+              ptr_cPreambleSeq(nullptr), ptr_cLabelBitsSeq(nullptr), ptr_cHeaderSeq(nullptr), ptr_cCounterLUT(nullptr), iHeaderCounter(0), iHeaderLength(0), iDropItems(0),
+              bPduMode(pduMode), pmtPduPort(pmt::mp(PDU_PORT)), iCounterLen(COUNTER_WIDTH(seqBits)), iCrcLen(crc ? CRC_BITS : 0), iLengthLen((lengthField || pduMode) ? LENGTH_BITS : 0), pmtLengthTag(pmt::mp(LENGTH_TAG))
     {
+      if ((iLengthLen != 0) && (packetSize > this->LengthMaxItems()))  // the length field can not hold the packet size; checked before any memory is taken
+      {
+        throw std::invalid_argument("Add_Header: packet size " + std::to_string(packetSize) + " is longer than the length field holds (" + std::to_string(this->LengthMaxItems()) + ")");
+      }
+      this->setup_Stats(this);  // register the stats message port
+      iPerfPackets = this->add_Counter("packets_framed");
+      iPerfDropped = this->add_Counter("pdus_dropped");
+      iPerfLong = this->add_Counter("long_packets_dropped");
+
+      if(bPduMode == true)  // packets come as messages; work takes them from the queue
+      {
+        this->message_port_register_in(pmtPduPort);
+      }
+
       #ifdef _FLOW_MODE_
       iFlowCounter = 0;
       #endif
@@ -65,12 +80,11 @@ namespace gr {
       this->set_PacketSize(packetSize);  // set packet size
 
       this->set_history(1);
+      this->set_tag_propagation_policy(TPP_DONT);  // a header is inserted before each packet; the input offsets do not hold at the output
 
       #ifdef _FLOW_MODE_
       std::cout << "Add_Header_impl: Packet size = " << iPacketSize << std::endl;
       #endif
-
-      ary_cCounterBits = new char [iCounterLen];  // allocate memory
     }
 
     /*
@@ -108,16 +122,16 @@ namespace gr {
         ptr_cLabelBitsSeq = nullptr;  // label the array as empty
       }
 
-      if (ptr_cCounterSeq != nullptr)  // if the array is free
+      if (ptr_cHeaderSeq != nullptr)  // if the array is free
       {
-        delete[] ptr_cCounterSeq;  // release the array
-        ptr_cCounterSeq = nullptr;  // label the array as empty
+        delete[] ptr_cHeaderSeq;  // release the array
+        ptr_cHeaderSeq = nullptr;  // label the array as empty
       }
 
-      if (ary_cCounterBits != nullptr)  // if the array is free
+      if (ptr_cCounterLUT != nullptr)  // if the array is free
       {
-        delete[] ary_cCounterBits;  // release the array
-        ary_cCounterBits = nullptr;  // label the array as empty
+        delete[] ptr_cCounterLUT;  // release the array
+        ptr_cCounterLUT = nullptr;  // label the array as empty
       }
 
     }
@@ -130,10 +144,19 @@ namespace gr {
       #ifdef _DEBUG_MODE_
       std::cout << "Add_Header_impl: Configure header size called." << std::endl;
       #endif
-      int N_out = (iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen) * iSamplesPerBit + iPacketSize;  // calculate number of output samples for each sample burst
+      int N_out = this->HeaderItems((iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen + iLengthLen) * iSamplesPerBit) + iPacketSize + this->HeaderItems(iCrcLen*iSamplesPerBit);  // calculate number of output samples for each sample burst
       N_out = CONSTRAIN(N_out, 1 ,INT_MAX);  // check the range
 
-      block::set_output_multiple(N_out);
+      if (iLengthLen != 0)  // packets have their own length; room for the longest one is enough
+      {
+        block::set_output_multiple(1);
+        block::set_min_noutput_items(N_out);
+        block::set_min_output_buffer(2*N_out);  // the default buffer may not hold the longest packet; the output multiple does not size it here
+      }
+      else
+      {
+        block::set_output_multiple(N_out);
+      }
       block::set_max_noutput_items(N_out*iNumOfOutputMultiple);
 
       #ifdef _DEBUG_MODE_
@@ -163,14 +186,197 @@ namespace gr {
         InterpArray<char>(ptr_cLabelBits, ptr_cLabelBitsSeq, iLabelLen*iLabelBitsPerLet, iSamplesPerBit);  // resample the array
       }
 
-      if (ptr_cCounterSeq != nullptr)  // if the array is free
+      if (ptr_cCounterLUT != nullptr)  // if the array is free
+      {
+        delete[] ptr_cCounterLUT;  // release the array
+        ptr_cCounterLUT = nullptr;  // label the array as empty
+      }
+      ptr_cCounterLUT = new char [256*8*iSamplesPerBit];  // get the array memory
+      char ary_cByteBits[8];  // bit sequence of one counter byte
+      for(int index_v = 0; index_v < 256; ++index_v)  // go through the byte values
+      {
+        Num2Bits<int>(index_v, ary_cByteBits, 8);  // convert the byte to bit sequence, as the counter field
+        InterpArray<char>(ary_cByteBits, (ptr_cCounterLUT + index_v*8*iSamplesPerBit), 8, iSamplesPerBit);  // resample the array
+      }
+
+      if (ptr_cHeaderSeq != nullptr)  // if the array is free
+      {
+        delete[] ptr_cHeaderSeq;  // release the array
+        ptr_cHeaderSeq = nullptr;  // label the array as empty
+      }
+      if ((ptr_cPreambleSeq != nullptr) && (ptr_cLabelBitsSeq != nullptr))  // both parts are configured
+      {
+        int iPreambleSeqLen = iPreambleLen*iSamplesPerBit;  // preamble samples
+        int iLabelSeqLen = iLabelLen*iLabelBitsPerLet*iSamplesPerBit;  // label samples
+        ptr_cHeaderSeq = new char [iPreambleSeqLen + iLabelSeqLen + (iCounterLen + iLengthLen)*iSamplesPerBit];  // get the array memory
+        CopyArrays<char>(ptr_cPreambleSeq, ptr_cHeaderSeq, iPreambleSeqLen);  // insert preamble into the header
+        CopyArrays<char>(ptr_cLabelBitsSeq, (ptr_cHeaderSeq + iPreambleSeqLen), iLabelSeqLen);  // insert label into the header
+        FillArray<char>((ptr_cHeaderSeq + iPreambleSeqLen + iLabelSeqLen), 0, (iCounterLen + iLengthLen)*iSamplesPerBit);  // counter and length of zero
+        iHeaderCounter = 0;  // counter value in the header
+        iHeaderLength = 0;  // length value in the header
+      }
+
+    }
+
+
+    /*
+     * Rewrite the counter bytes of the header sequence that differ from the new counter value
+     */
+    void Add_Header_impl::PatchCounter(uint64_t iCounterValue)
+    {
+      char *ptr_cCounterField = ptr_cHeaderSeq + (iPreambleLen + iLabelLen*iLabelBitsPerLet)*iSamplesPerBit;  // counter field of the header
+      uint64_t uChanged = iCounterValue ^ iHeaderCounter;  // bits that differ
+
+      for(int index_b = 0; (index_b < iCounterLen) && (uChanged >> index_b); index_b += 8)  // go through the counter bytes, up to the last one that differs
+      {
+        if(((uChanged >> index_b) & 0xFF) != 0)  // byte differs
+        {
+          int iByteLen = ((iCounterLen - index_b) < 8) ? (iCounterLen - index_b) : 8;  // bits of this byte in the field
+          int iByteValue = int((iCounterValue >> index_b) & 0xFF);
+          CopyArrays<char>((ptr_cCounterLUT + iByteValue*8*iSamplesPerBit), (ptr_cCounterField + index_b*iSamplesPerBit), iByteLen*iSamplesPerBit);  // resampled byte bits
+        }
+      }
+      iHeaderCounter = iCounterValue;  // counter value in the header
+    }
+
+    /*
+     * Rewrite the length field of the header sequence, if the length differs from the last packet
+     */
+    void Add_Header_impl::PatchLength(int iLength)
+    {
+      if(iLength == iHeaderLength)  // same length as the last packet
+      {
+        return;
+      }
+      char *ptr_cLengthField = ptr_cHeaderSeq + (iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen)*iSamplesPerBit;  // length field of the header
+      for(int index_b = 0; index_b < iLengthLen; index_b += 8)  // go through the length bytes, least significant first
+      {
+        CopyArrays<char>((ptr_cCounterLUT + ((iLength >> index_b) & 0xFF)*8*iSamplesPerBit), (ptr_cLengthField + index_b*iSamplesPerBit), 8*iSamplesPerBit);  // resampled byte bits
+      }
+      iHeaderLength = iLength;  // length value in the header
+    }
+
+    /*
+     * Write the CRC field of a packet; CRC-32 of the counter and length field bytes and the data bits, packed into bytes
+     */
+    void Add_Header_impl::AppendCrc(char *ptr_cCrcField, const char *ptr_cData, uint64_t iCounterValue, int iDataLen)
+    {
+      uint64_t uCounter = iCounterValue & SeqMask(iCounterLen);  // value of the counter field
+      unsigned char ary_ucFields[(COUNTER_MAX_BITS + LENGTH_BITS + 7)/8];  // counter and length field bytes, least significant first
+      int iNumOfFieldBytes = (iCounterLen + 7)/8;  // counter field bytes
+      for(int index_b = 0; index_b < iNumOfFieldBytes; ++index_b)  // go through the counter bytes
+      {
+        ary_ucFields[index_b] = (unsigned char)((uCounter >> 8*index_b) & 0xFF);
+      }
+      for(int index_b = 0; index_b < iLengthLen/8; ++index_b)  // go through the length bytes; none without the field
+      {
+        ary_ucFields[iNumOfFieldBytes++] = (unsigned char)((this->LengthValue(iDataLen) >> 8*index_b) & 0xFF);
+      }
+      uint32_t uCrc = Crc32(ary_ucFields, iNumOfFieldBytes);  // CRC of the header fields
+      if(bPacked == true)  // the data is packed already
+      {
+        uCrc = Crc32(ptr_cData, iDataLen, uCrc);
+      }
+      else
+      {
+        vCrcBytes.resize((iDataLen/iSamplesPerBit + 7)/8);
+        int iNumOfDataBytes = PackBitStream(ptr_cData, vCrcBytes.data(), iDataLen/iSamplesPerBit, iSamplesPerBit);  // data bits, as the receiver decides them
+        uCrc = Crc32(vCrcBytes.data(), iNumOfDataBytes, uCrc);  // CRC of the header fields and the data
+      }
+
+      char ary_cCrcBits[CRC_BITS];  // CRC field bits of a packed packet
+      char *ptr_cCrcSeq = (bPacked == true) ? ary_cCrcBits : ptr_cCrcField;  // resampled CRC field
+      for(int index_b = 0; index_b < iCrcLen; index_b += 8)  // go through the CRC bytes, least significant first
+      {
+        CopyArrays<char>((ptr_cCounterLUT + ((uCrc >> index_b) & 0xFF)*8*iSamplesPerBit), (ptr_cCrcSeq + index_b*iSamplesPerBit), 8*iSamplesPerBit);  // resampled byte bits
+      }
+      if(bPacked == true)  // 8 bits per output byte
+      {
+        PackBits(ary_cCrcBits, (unsigned char *) ptr_cCrcField, iCrcLen/8);
+      }
+    }
+
+
+    /*
+     * Write the header sequence; its bits are packed into bytes in packed mode
+     */
+    void Add_Header_impl::CopyHeader(char *ptr_cOut, int iNumOfItems)
+    {
+      if(bPacked == true)  // 8 header bits per byte
+      {
+        PackBits(ptr_cHeaderSeq, (unsigned char *) ptr_cOut, iNumOfItems);
+      }
+      else
+      {
+        CopyArrays<char>(ptr_cHeaderSeq, ptr_cOut, iNumOfItems);
+      }
+    }
+
+
+    /*
+     * Frame the PDUs waiting at the message port; waits for the first one, so an idle link costs no CPU
+     */
+    int Add_Header_impl::FramePdus(int noutput_items, char *out)
+    {
+      int N_header = this->HeaderItems((iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen + iLengthLen) * iSamplesPerBit);
+      int N_crc = this->HeaderItems(iCrcLen*iSamplesPerBit);  // CRC field items
+      int N_out = N_header + iPacketSize + N_crc;  // calculate number of output samples for the longest packet
+      int iMaxBytes = (bPacked == true) ? iPacketSize : iPacketSize/(8*iSamplesPerBit);  // longest payload (bytes)
+      int index_B = 0;  // output packet index
+      int iNumOfProduced = 0;  // output samples
+
+      pmt::pmt_t pmtMsg = this->delete_head_blocking(pmtPduPort, PDU_WAIT_MS);  // wait for a packet
+      while ((pmtMsg.get() != nullptr) && ((iNumOfProduced + N_out) <= noutput_items))  // go through the queued packets while there is room for them
       {
-        delete[] ptr_cCounterSeq;  // release the array
-        ptr_cCounterSeq = nullptr;  // label the array as empty
+        if ((pmt::is_pair(pmtMsg) == false) || (pmt::is_u8vector(pmt::cdr(pmtMsg)) == false))  // not a PDU of bytes
+        {
+          #ifdef _DEBUG_MODE_
+          std::cout << "Add_Header_impl: Message is not a PDU of bytes; dropped." << std::endl;
+          #endif
+          this->count(iPerfDropped);  // dropped PDU
+        }
+        else
+        {
+          size_t uNumOfBytes = 0;  // payload length (bytes)
+          const uint8_t *ptr_uPayload = pmt::u8vector_elements(pmt::cdr(pmtMsg), uNumOfBytes);
+          if ((int)uNumOfBytes > iMaxBytes)  // payload does not fit in the packet
+          {
+            #ifdef _DEBUG_MODE_
+            std::cout << "Add_Header_impl: PDU of " << uNumOfBytes << " bytes is longer than " << iMaxBytes << " bytes; dropped." << std::endl;
+            #endif
+            this->count(iPerfDropped);  // dropped PDU
+          }
+          else
+          {
+            char *ptr_cPacket = out + iNumOfProduced;  // output packet
+            int iPayloadLen = (bPacked == true) ? (int)uNumOfBytes : (int)uNumOfBytes*8*iSamplesPerBit;  // payload samples
+            int iDataLen = iPayloadLen;  // packet data samples; PDUs always have the length field, so they are not padded
+            this->PatchCounter(iCounter);  // only the counter changes between headers
+            iCounter = SeqAdd(iCounter, 1, iCounterLen);  // next packet counter
+            this->PatchLength(this->LengthValue(iDataLen));
+            this->CopyHeader(ptr_cPacket, N_header);  // insert the header into the array
+            if(bPacked == true)  // the payload is packed already
+            {
+              CopyArrays<char>((const char *) ptr_uPayload, (ptr_cPacket + N_header), iPayloadLen);
+            }
+            else
+            {
+              UnpackBits(ptr_uPayload, (ptr_cPacket + N_header), (int)uNumOfBytes, iSamplesPerBit);  // insert the payload bits into the array
+            }
+            if(iCrcLen != 0)  // integrity field
+            {
+              this->AppendCrc((ptr_cPacket + N_header + iDataLen), (ptr_cPacket + N_header), iHeaderCounter, iDataLen);  // CRC of the packet
+            }
+            iNumOfProduced += N_header + iDataLen + N_crc;  // end of the packet
+            ++index_B;  // next output packet
+          }
+        }
+
+        pmtMsg = ((iNumOfProduced + N_out) <= noutput_items) ? this->delete_head_nowait(pmtPduPort) : pmt::pmt_t();  // next queued packet, if there is room for it
       }
-      ptr_cCounterSeq = new char [iCounterLen*iSamplesPerBit];  // get the array memory
-      FillArray<char>(ptr_cCounterSeq, 0, iCounterLen*iSamplesPerBit);  // initialise the array with 0
 
+      this->count(iPerfPackets, index_B);  // framed packets
+      return iNumOfProduced;
     }
 
     void
@@ -182,8 +388,8 @@ namespace gr {
       std::cout << "Add_Header_impl: Number of output samples = " << noutput_items << std::endl;
       #endif
 
-      int N_header = (iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen) * iSamplesPerBit;
-      int N_out = N_header + iPacketSize;  // calculate number of output samples for each sample burst
+      int N_header = this->HeaderItems((iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen + iLengthLen) * iSamplesPerBit);
+      int N_out = N_header + iPacketSize + this->HeaderItems(iCrcLen*iSamplesPerBit);  // calculate number of output samples for each sample burst
       N_out = CONSTRAIN(N_out, 1 ,INT_MAX);  // check the range
       int Multiple_out = noutput_items/N_out;  // calculate output to packet size multiple
       #ifdef _DEBUG_MODE_
@@ -197,7 +403,7 @@ namespace gr {
 
       for (int index = 0; index < ninput_items_required.size(); index++)  // go through all inputs
       {
-        ninput_items_required[index] = N_in*Multiple_out;  // set the number of required inputs equal to number of required sample
+        ninput_items_required[index] = (iLengthLen != 0) ? 1 : N_in*Multiple_out;  // set the number of required inputs equal to number of required sample; a tagged packet may be short
         #ifdef _DEBUG_MODE_
         std::cout << "Add_Header_impl: Index = " << index <<" Required number of input = " << ninput_items_required[index] << std::endl;
         #endif
@@ -210,13 +416,22 @@ namespace gr {
                       gr_vector_const_void_star &input_items,
                       gr_vector_void_star &output_items)
   {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       #ifdef _FLOW_MODE_
       std::cout << "Add_Header_impl: Entry: Counter = " << iFlowCounter << std::endl;
       #endif
 
+      char *out = (char *) output_items[0];
+      if(bPduMode == true)  // packets come from the message port
+      {
+        int iNumOfProdOutput = this->FramePdus(noutput_items, out);  // number of produced outputs
+        PerfTimer.set_Items(0, iNumOfProdOutput);  // items of this call
+        return iNumOfProdOutput;
+      }
+
       const char *in = (const char *) input_items[0];
       const char *in_SpB =  nullptr;
-      char *out = (char *) output_items[0];
       char *out_SpB =  nullptr;      
 
       if(input_items.size() == 2)  // SpB input is connected
@@ -231,13 +446,22 @@ namespace gr {
 
       bool bSpBConnected = ( (in_SpB != nullptr) && (out_SpB != nullptr) ) ? true : false;  // if SpB is to be transferred
 
-      int N_header = (iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen) * iSamplesPerBit;
-      int N_out = N_header + iPacketSize;  // calculate number of output samples for each sample burst
+      int N_header = this->HeaderItems((iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen + iLengthLen) * iSamplesPerBit);
+      int N_crc = this->HeaderItems(iCrcLen*iSamplesPerBit);  // CRC field items
+      int N_out = N_header + iPacketSize + N_crc;  // calculate number of output samples for each sample burst; the longest packet with the length field
       N_out = CONSTRAIN(N_out, 1 ,INT_MAX);  // check the range
       int Multiple_out = noutput_items/N_out;  // calculate output to packet size multiple
       int numInput = ninput_items[0];  // number of available input samples
 
       int Index_PacketStart = 0;  // packet start element index
+      int iNumOfConsumed = 0;  // input samples of the framed packets
+      int index_B = 0;  // output packet index
+      size_t index_T = 0;  // next packet length tag
+
+      if(iLengthLen != 0)  // packet lengths come with the input
+      {
+        this->get_tags_in_range(vLengthTags, 0, this->nitems_read(0), this->nitems_read(0) + numInput, pmtLengthTag);  // packet length tags of the input
+      }
 
       #ifdef _DEBUG_MODE_
       std::cout << "Add_Header_impl: Add_Header_impl: Work called." << std::endl;
@@ -256,103 +480,93 @@ namespace gr {
       std::cout << "------------------------------------------" << std::endl;
       #endif
 
-      FillArray<char>(out, 0, noutput_items);  // initialise the array
-      if(output_items.size() == 2)  // SpB output is connected
+      if((out_SpB != nullptr) && (bSpBConnected == false))  // SpB output has no input to copy
       {
         FillArray<char>(out_SpB, 0, noutput_items);  // initialise the array
       }
 
       // Do <+signal processing+>
-      for(int index = 0; index < Multiple_out; ++index, ++iCounter)  // go through availabler input packets
+      while((Index_PacketStart + N_out) <= noutput_items)  // go through availabler input packets while there is room for them
       {
-        #ifdef _DEBUG_MODE_
-        std::cout << "Add_Header_impl: Input packet index = " << index << " out of " << Multiple_out - 1 << std::endl;
-        #endif
-
-        if(bSpBConnected == true)  // if SpB is to transferred
+        if(iDropItems > 0)  // rest of a dropped over-long packet
         {
-          FillArray<char>((out_SpB + index*N_out), iSamplesPerBit, N_header);  // fill SpB with input value
-        }
-
-        CopyArrays<char>(ptr_cPreambleSeq, (out + Index_PacketStart), iPreambleLen*iSamplesPerBit);  // insert preamble into the array
-        Index_PacketStart += iPreambleLen*iSamplesPerBit;  // update packet index
-
-        #ifdef _DEBUG_MODE_
-        std::cout << "Add_Header_impl: Preamble inserted!" << std::endl;
-        #endif
-
-        #ifdef _DEBUG_MODE_
-        std::cout << "Add_Header_impl: Preamble bit sequence = [";
-        for(int index = 0; index < iPreambleLen; )  // go through the array
-        {
-          std::cout << CPRN(ptr_cPreamble[index]);  // show the elements
-          ++index;  // increment the coutner
-          if((index % 4) == 0)  // if 4 bit has been printed out
+          uint64_t uStart = this->nitems_read(0) + iNumOfConsumed;  // first sample left of the packet
+          for(; (index_T < vLengthTags.size()) && (vLengthTags[index_T].offset < uStart); ++index_T);  // skip the tags of the framed packets
+          int iSkip = MIN(iDropItems, numInput - iNumOfConsumed);  // dropped samples of this call
+          if((index_T < vLengthTags.size()) && (vLengthTags[index_T].offset < (uStart + iSkip)))  // the next packet starts inside; the tag ends the dropped one
           {
-            std::cout << ", ";  // show the elements
+            iSkip = (int)(vLengthTags[index_T].offset - uStart);
+            iDropItems = 0;
+          }
+          else
+          {
+            iDropItems -= iSkip;
+          }
+          iNumOfConsumed += iSkip;  // dropped samples are consumed without output
+          if(iDropItems > 0)  // input is used up
+          {
+            break;
           }
         }
-        std::cout << "]" << std::endl;
-        #endif
 
-        #ifdef _DEBUG_MODE_
-        std::cout << "Add_Header_impl: Packet index = " << Index_PacketStart << std::endl;
-        #endif
-
-        #ifdef _ARRAY_MODE_
-        std::cout << "Add_Header_impl: Output = ";
-        DisplayArray(out, noutput_items, 0);  // display input array
-        std::cout << std::endl;
-        #endif
-
-        CopyArrays<char>(ptr_cLabelBitsSeq, (out + Index_PacketStart), iLabelLen*iLabelBitsPerLet*iSamplesPerBit);  // insert label into the array
-        Index_PacketStart += iLabelLen*iLabelBitsPerLet*iSamplesPerBit;  // update packet index
-
-        #ifdef _DEBUG_MODE_
-        std::cout << "Add_Header_impl: Label inserted!" << std::endl;
-        #endif
-
-        #ifdef _DEBUG_MODE_
-        std::cout << "Add_Header_impl: Label = [";
-        for(int index = 0; index < iLabelLen*iLabelBitsPerLet; )  // go through the array
+        int iDataLen = iPacketSize;  // packet data samples
+        if(iLengthLen != 0)  // a tagged packet has its own length; the next tag ends a packet
         {
-          std::cout << CPRN(ptr_cLabelBits[index]);  // show the elements
-          ++index;  // increment the coutner
-          if((index % 4) == 0)  // if 4 bit has been printed out
+          uint64_t uStart = this->nitems_read(0) + iNumOfConsumed;  // first sample of the packet
+          for(; (index_T < vLengthTags.size()) && (vLengthTags[index_T].offset < uStart); ++index_T);  // skip the tags of the framed packets
+          if((index_T < vLengthTags.size()) && (vLengthTags[index_T].offset == uStart))  // tagged packet
           {
-            std::cout << ", ";  // show the elements
+            long lTagLen = pmt::to_long(vLengthTags[index_T].value);  // tagged packet length
+            if(lTagLen > iPacketSize)  // the length field can not hold the packet; dropped instead of cut
+            {
+              #ifdef _DEBUG_MODE_
+              std::cout << "Add_Header_impl: Tagged packet of " << lTagLen << " samples is longer than " << iPacketSize << " samples; dropped." << std::endl;
+              #endif
+              this->count(iPerfLong);  // dropped packet
+              iDropItems = (int)MIN(lTagLen, (long)INT_MAX);
+              ++index_T;  // its own tag does not end it
+              continue;
+            }
+            iDataLen = CONSTRAIN((int)lTagLen, 1, iPacketSize);
+          }
+          else if(index_T < vLengthTags.size())  // untagged samples up to the next tagged packet
+          {
+            iDataLen = CONSTRAIN((int)(vLengthTags[index_T].offset - uStart), 1, iPacketSize);
           }
         }
-        std::cout << "]" << std::endl;
-        #endif
+        if((iNumOfConsumed + iDataLen) > numInput)  // packet is not complete
+        {
+          break;
+        }
 
         #ifdef _DEBUG_MODE_
-        std::cout << "Add_Header_impl: Packet index = " << Index_PacketStart << std::endl;
+        std::cout << "Add_Header_impl: Input packet index = " << index_B << " out of " << Multiple_out - 1 << std::endl;
         #endif
 
-        #ifdef _ARRAY_MODE_
-        std::cout << "Add_Header_impl: Output = ";
-        DisplayArray(out, noutput_items, 0);  // display input array
-        std::cout << std::endl;
-        #endif
+        if(bSpBConnected == true)  // if SpB is to transferred
+        {
+          FillArray<char>((out_SpB + Index_PacketStart), iChannelSpB, N_header);  // fill SpB with input value
+        }
 
-        Num2Bits<char>(iCounter, ary_cCounterBits, iCounterLen);  // convert the letter to bit sequence
-        InterpArray<char>(ary_cCounterBits, ptr_cCounterSeq, iCounterLen, iSamplesPerBit);  // resample the array
-        CopyArrays<char>(ptr_cCounterSeq, (out + Index_PacketStart), iCounterLen*iSamplesPerBit);  // insert counter into the array
-        Index_PacketStart += iCounterLen*iSamplesPerBit;  // update packet index
+        this->PatchCounter(iCounter);  // only the counter changes between headers
+        if(iLengthLen != 0)  // length field
+        {
+          this->PatchLength(this->LengthValue(iDataLen));
+        }
+        this->CopyHeader((out + Index_PacketStart), N_header);  // insert the header into the array
+        Index_PacketStart += N_header;  // update packet index
 
         #ifdef _DEBUG_MODE_
-        std::cout << "Add_Header_impl: Counter inserted!" << std::endl;
+        std::cout << "Add_Header_impl: Header inserted!" << std::endl;
         #endif
 
         #ifdef _DEBUG_MODE_
         std::cout << "Add_Header_impl: Current counter = " << iCounter << std::endl;
-        std::cout << "Add_Header_impl: Counter bit sequence = [";
-        for(int index = 0; index < iCounterLen; )  // go through the array
+        std::cout << "Add_Header_impl: Header bit sequence = [";
+        for(int index = 0; index < N_header; index += iSamplesPerBit)  // go through the header bits
         {
-          std::cout << CPRN(ary_cCounterBits[index]);  // show the elements
-          ++index;  // increment the coutner
-          if((index % 4) == 0)  // if 4 bit has been printed out
+          std::cout << CPRN(ptr_cHeaderSeq[index]);  // show the elements
+          if(((index/iSamplesPerBit + 1) % 4) == 0)  // if 4 bit has been printed out
           {
             std::cout << ", ";  // show the elements
           }
@@ -370,13 +584,23 @@ namespace gr {
         std::cout << std::endl;
         #endif
 
-        CopyArrays<char>((in + index*iPacketSize), (out + Index_PacketStart), iPacketSize);  // insert counter into the array
-        Index_PacketStart += iPacketSize;  // update packet index
+        CopyArrays<char>((in + iNumOfConsumed), (out + Index_PacketStart), iDataLen);  // insert data into the array
+        Index_PacketStart += iDataLen;  // update packet index
+
+        if(iCrcLen != 0)  // integrity field
+        {
+          this->AppendCrc((out + Index_PacketStart), (in + iNumOfConsumed), iCounter, iDataLen);  // CRC of the packet
+        }
 
         if(bSpBConnected == true)  // if SpB is to transferred
         {
-          CopyArrays<char>((in_SpB + index*iPacketSize), (out_SpB + index*N_out + N_header), iPacketSize);  // insert SpB into the output array
+          CopyArrays<char>((in_SpB + iNumOfConsumed), (out_SpB + Index_PacketStart - iDataLen), iDataLen);  // insert SpB into the output array
+          FillArray<char>((out_SpB + Index_PacketStart), iChannelSpB, N_crc);  // CRC field has the header SpB
         }
+        Index_PacketStart += N_crc;  // update packet index
+        iNumOfConsumed += iDataLen;  // next input packet
+        iCounter = SeqAdd(iCounter, 1, iCounterLen);  // next packet counter; wraps with the field
+        ++index_B;  // next output packet
 
         #ifdef _DEBUG_MODE_
         std::cout << "Add_Header_impl: Data inserted!" << std::endl;
@@ -423,14 +647,17 @@ namespace gr {
 
       // Tell runtime system how many input items we consumed on
       // each input stream.
-      consume_each (iPacketSize*Multiple_out);
+      consume_each (iNumOfConsumed);
 
       #ifdef _FLOW_MODE_
       std::cout << "Add_Header_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
       #endif
 
+      this->count(iPerfPackets, index_B);  // framed packets
+      PerfTimer.set_Items(iNumOfConsumed, Index_PacketStart);  // items of this call
+
       // Tell runtime system how many output items we produced.
-      return noutput_items;
+      return Index_PacketStart;
     }
 
   } /* namespace Hybrid_Comm */
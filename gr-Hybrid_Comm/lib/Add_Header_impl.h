@@ -22,11 +22,13 @@
 #define INCLUDED_HYBRID_COMM_ADD_HEADER_IMPL_H
 
 #include <Hybrid_Comm/Add_Header.h>
+#include <Comm_Kernels/perf_block.h>
+#include <algorithm>
 
 namespace gr {
   namespace Hybrid_Comm {
 
-    class Add_Header_impl : public Add_Header
+    class Add_Header_impl : public Add_Header, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -35,28 +37,75 @@ namespace gr {
       char *ptr_cLabel;  // packet label array
       char *ptr_cLabelBits;  // packet label bit sequence
       int iLabelLen;  // packet label array length
-      int iSamplesPerBit;  // samples per bit of the header
+      int iSamplesPerBit;  // samples per bit of the header; 1 in packed mode
+      int iChannelSpB;  // samples per bit on the channel
+      bool bPacked;  // input and output bytes of 8 bits
       int iPacketSize;  // packet size
-      int iCounter;  // packet counter
+      uint64_t iCounter;  // packet counter; wraps with the counter field
       char *ptr_cPreambleSeq;  // preamble resampled bit sequence
       char *ptr_cLabelBitsSeq;  // label bits resampled bit sequence
-      char *ptr_cCounterSeq;  // counter resampled bit sequence
+      char *ptr_cHeaderSeq;  // resampled header; preamble, label and the counter of 'iHeaderCounter'
+      char *ptr_cCounterLUT;  // resampled bit sequences of the 256 counter byte values
+      uint64_t iHeaderCounter;  // counter value in the header sequence
+      int iHeaderLength;  // length value in the header sequence
       #ifdef _FLOW_MODE_
       int iFlowCounter;  // flow debugging counter
       #endif
 
-      char *ary_cCounterBits;  // counter bit sequence
+      int iPerfPackets;  // performance counter: framed packets
+      int iPerfDropped;  // performance counter: dropped PDUs
+      int iPerfLong;  // performance counter: dropped over-long tagged packets
+      int iDropItems;  // input items left of a dropped over-long packet
+      bool bPduMode;  // packets come from the PDU message port instead of the input stream
+      pmt::pmt_t pmtPduPort;  // PDU message port id
+      int iCounterLen;  // counter field length
+      int iCrcLen;  // CRC field length; 0 without the field
+      int iLengthLen;  // length field length; 0 without the field
+      pmt::pmt_t pmtLengthTag;  // packet length tag key
+      std::vector<gr::tag_t> vLengthTags;  // packet length tags of the input
+      std::vector<unsigned char> vCrcBytes;  // packed data bits of a packet for the CRC
 
       static const std::vector<char> defPreamb;  // default preamble
       static const std::string defLabel;  // default packet label
-      static const int iCounterLen;  // counter field length
       static const int iLabelBitsPerLet;  // label bits per letters
       static const int iNumOfOutputMultiple;  // number of output items multiple
 
      public:
-      Add_Header_impl(int packetSize = PACKET_SAMP_SIZE, const std::vector<char>& preamble = defPreamb, const std::string& label = defLabel, int samplesPerBit = DEF_SPB);
+      Add_Header_impl(int packetSize = PACKET_SAMP_SIZE, const std::vector<char>& preamble = defPreamb, const std::string& label = defLabel, int samplesPerBit = DEF_SPB, bool pduMode = false, bool crc = false, bool lengthField = false, int seqBits = COUNTER_BITS, bool packed = false);
       ~Add_Header_impl();
       void ConfigureHeaderSize(void);  // configure header size based on the new pattern
+      void PatchCounter(uint64_t iCounterValue);  // rewrite the counter bytes of the header sequence that differ
+      void PatchLength(int iLength);  // rewrite the length field of the header sequence
+      int FramePdus(int noutput_items, char *out);  // frame the queued PDUs; returns the number of output samples
+      void AppendCrc(char *ptr_cCrcField, const char *ptr_cData, uint64_t iCounterValue, int iDataLen);  // write the CRC field of a packet
+      void CopyHeader(char *ptr_cOut, int iNumOfItems);  // write the header sequence; packed into bytes in packed mode
+
+      // Output items of 'iNumOfSamples' header samples; 8 per byte in packed mode
+      int HeaderItems(int iNumOfSamples) const
+      {
+        return (bPacked == true) ? iNumOfSamples/8 : iNumOfSamples;
+      }
+
+      // Length field value of a packet of 'iDataLen' data items; payload bits in PDU mode, its samples on the channel otherwise
+      int LengthValue(int iDataLen) const
+      {
+        if (bPduMode == true)  // whole bytes; the bits do not depend on the samples per bit
+        {
+          return (bPacked == true) ? 8*iDataLen : iDataLen/iSamplesPerBit;
+        }
+        return (bPacked == true) ? iDataLen*8*iChannelSpB : iDataLen;
+      }
+
+      // Longest packet the length field holds, in data items; whole bytes in PDU mode
+      int LengthMaxItems(void) const
+      {
+        const int iMaxValue = (1 << iLengthLen) - 1;  // largest field value
+        if (bPduMode == true)  // payload bits
+        {
+          return (bPacked == true) ? iMaxValue/8 : (iMaxValue/8)*8*iSamplesPerBit;
+        }
+        return (bPacked == true) ? iMaxValue/(8*iChannelSpB) : iMaxValue;
+      }
 
 
       // Where all the action really happens
@@ -67,6 +116,12 @@ namespace gr {
             gr_vector_const_void_star &input_items,
             gr_vector_void_star &output_items);
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set preamble
       void set_Preamble(const std::vector<char>& preamble)
       {
@@ -76,13 +131,15 @@ namespace gr {
           ptr_cPreamble = nullptr;  // label the array as empty
         }
 
-        iPreambleLen = preamble.size();  // update new number of preamble samples
+        int iPadLen = (bPacked == true) ? (8 - int(preamble.size())%8)%8 : 0;  // packed headers are whole bytes; '0's before the preamble
+        iPreambleLen = preamble.size() + iPadLen;  // update new number of preamble samples
 
         ptr_cPreamble = new char [iPreambleLen];  // get the array memory
 
-        for(int index = 0; index < iPreambleLen; ++index)  // go through the array
+        FillArray<char>(ptr_cPreamble, VAL_0, iPadLen);  // leading '0's
+        for(int index = iPadLen; index < iPreambleLen; ++index)  // go through the array
         {
-          ptr_cPreamble[index] = preamble[index];  // update the element
+          ptr_cPreamble[index] = preamble[index - iPadLen];  // update the element
         }
         
         #ifdef _DEBUG_MODE_
@@ -213,9 +270,10 @@ namespace gr {
         #ifdef _THREAD_MUTEX_
         gr::thread::scoped_lock dummy(d_mutex_delay);  //  create a mutex lock for the current scope#
         #endif
-        iSamplesPerBit = CONSTRAIN(samplesPerBit, 1, INT_MAX);
+        iChannelSpB = CONSTRAIN(samplesPerBit, 1, INT_MAX);
+        iSamplesPerBit = (bPacked == true) ? 1 : iChannelSpB;  // packed headers have one sample per bit
         #ifdef _DEBUG_MODE_
-        std::cout << "Add_Header_impl: Samples per bit = " << iSamplesPerBit << std::endl;
+        std::cout << "Add_Header_impl: Samples per bit = " << iChannelSpB << std::endl;
         #endif
 
         this->ConfigureHeaderSize();  // configure header size based on the new pattern
@@ -225,9 +283,9 @@ namespace gr {
       int get_SamplesPerBit(void)
       {
         #ifdef _DEBUG_MODE_
-        std::cout << "Add_Header_impl: Samples per bit = " << iSamplesPerBit << std::endl;
+        std::cout << "Add_Header_impl: Samples per bit = " << iChannelSpB << std::endl;
         #endif
-        return iSamplesPerBit;
+        return iChannelSpB;
       }
 
       // Set packet size
@@ -236,7 +294,11 @@ namespace gr {
         #ifdef _THREAD_MUTEX_
         gr::thread::scoped_lock dummy(d_mutex_delay);  //  create a mutex lock for the current scope#
         #endif
-        iPacketSize = CONSTRAIN(packetsize, 1, INT_MAX);
+        iPacketSize = CONSTRAIN(packetsize, 1, (iLengthLen != 0) ? this->LengthMaxItems() : INT_MAX);  // the length field holds the longest packet; a larger size is rejected by the constructor
+        if ((bPduMode == true) && (bPacked == false))  // PDUs are whole bytes; so is the longest packet
+        {
+          iPacketSize = std::max(iPacketSize - iPacketSize % (8*iSamplesPerBit), 8*iSamplesPerBit);
+        }
         this->set_output_multiple(iPacketSize);
         #ifdef _DEBUG_MODE_
         std::cout << "Add_Header_impl: Packet size = " << iPacketSize << std::endl;
@@ -254,6 +316,50 @@ namespace gr {
         return iPacketSize;
       }
 
+      // Get PDU mode
+      bool get_PduMode(void)
+      {
+        return bPduMode;
+      }
+
+      // Set CRC field
+      void set_Crc(bool crc)
+      {
+        #ifdef _THREAD_MUTEX_
+        gr::thread::scoped_lock dummy(d_mutex_delay);  //  create a mutex lock for the current scope#
+        #endif
+        iCrcLen = crc ? CRC_BITS : 0;
+        #ifdef _DEBUG_MODE_
+        std::cout << "Add_Header_impl: CRC field is " << ((iCrcLen != 0) ? "on" : "off") << std::endl;
+        #endif
+
+        this->ConfigureHeaderSize();  // configure header size based on the new pattern
+      }
+
+      // Get CRC field
+      bool get_Crc(void)
+      {
+        return (iCrcLen != 0);
+      }
+
+      // Get length field
+      bool get_LengthField(void)
+      {
+        return (iLengthLen != 0);
+      }
+
+      // Get counter field length
+      int get_SeqBits(void)
+      {
+        return iCounterLen;
+      }
+
+      // Get packed mode
+      bool get_Packed(void)
+      {
+        return bPacked;
+      }
+
     };
 
   } // namespace Hybrid_Comm
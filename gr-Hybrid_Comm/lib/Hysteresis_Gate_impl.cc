@@ -47,6 +47,8 @@ namespace gr {
               gr::io_signature::make(1, 1, sizeof(float))), fForwardPoint(forwardPoint), fForwardSlope(forwardSlope), fForwardState(forwardState), 
               fBackwardPoint(backwardPoint), fBackwardSlope(backwardSlope), fBackwardState(backwardState)
     {
+      this->setup_Stats(this);  // register the stats message port
+
       #ifdef _FLOW_MODE_
       iFlowCounter = 0;
       #endif
@@ -80,6 +82,8 @@ namespace gr {
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       #ifdef _FLOW_MODE_
       std::cout << "Hysteresis_Gate_impl: Entry: Counter = " << iFlowCounter << std::endl;
       #endif
@@ -138,6 +142,8 @@ namespace gr {
       std::cout << "Remove_Header_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
       #endif
 
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
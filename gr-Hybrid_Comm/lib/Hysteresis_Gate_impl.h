@@ -22,13 +22,14 @@
 #define INCLUDED_HYBRID_COMM_HYSTERESIS_GATE_IMPL_H
 
 #include <Hybrid_Comm/Hysteresis_Gate.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace Hybrid_Comm {
 
     enum HystType {Forward = 0, Backward = 1};
 
-    class Hysteresis_Gate_impl : public Hysteresis_Gate
+    class Hysteresis_Gate_impl : public Hysteresis_Gate, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -62,6 +63,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set packet size
       void set_PacketSize(int packetsize)
       {
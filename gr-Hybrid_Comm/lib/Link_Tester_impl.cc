@@ -29,20 +29,22 @@ namespace gr {
   namespace Hybrid_Comm {
 
     Link_Tester::sptr
-    Link_Tester::make(int packetSize, float samp_rate)
+    Link_Tester::make(int packetSize, float samp_rate, bool packed)
     {
       return gnuradio::get_initial_sptr
-        (new Link_Tester_impl(packetSize, samp_rate));
+        (new Link_Tester_impl(packetSize, samp_rate, packed));
     }
 
     /*
      * The private constructor
      */
-    Link_Tester_impl::Link_Tester_impl(int packetSize, float samp_rate)
+    Link_Tester_impl::Link_Tester_impl(int packetSize, float samp_rate, bool packed)
       : gr::sync_block("Link Tester",
               gr::io_signature::make(4, 5, sizeof(char)),
-              gr::io_signature::make(3, 3, sizeof(float)))
+              gr::io_signature::make(3, 3, sizeof(float))), bPacked(packed)
     {
+      this->setup_Stats(this);  // register the stats message port
+
       #ifdef _FLOW_MODE_
       iFlowCounter = 0;
       #endif
@@ -72,6 +74,8 @@ namespace gr {
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       #ifdef _FLOW_MODE_
       std::cout << "Link_Tester_impl: Entry: Counter = " << iFlowCounter << std::endl;
       #endif
@@ -115,7 +119,7 @@ namespace gr {
       for(int index_p = 0; index_p < NumOfPackets; ++index_p)  // go through available packets
       {
         int SampPerBit = SpB[index_p * iPacketSize];  // samples per bit
-        NoB = iPacketSize/SampPerBit;  // number of bits in the current packet
+        NoB = (bPacked == true) ? 8*iPacketSize : iPacketSize/SampPerBit;  // number of bits in the current packet
         Bit_Rate = fSampRate/SampPerBit;  // packet data rate
         fLT = (iNumBits_LT*fLT + NoB*Bit_Rate)/(iNumBits_LT + NoB);  // link throughput value
         iNumBits_LT += NoB;  // update number of received bits
@@ -130,6 +134,25 @@ namespace gr {
         std::cout << "Link_Tester_impl: Link Troughput (average data rate) = " << fLT << " bits per second"<< std::endl;
         #endif
 
+        if(bPacked == true)  // 8 bits per item; a byte at a time
+        {
+          for(int index_s = index_p*iPacketSize; index_s < (index_p + 1)*iPacketSize; ++index_s)  // go through the bytes of the packet
+          {
+            iTotRecBits_LA += 8;  // increment numner of total received bits
+            if (IS_VALID(ctl[index_s]))  // if the byte is valid
+            {
+              iTotErrBits_BER += __builtin_popcount((unsigned char)(link_1[index_s] ^ link_2[index_s]));  // update erroneous bits counter
+              iTotValBits += 8;  // update total number of valid bits
+            }
+            fBER = (iTotValBits != 0) ? (iTotErrBits_BER*1.0)/iTotValBits : 0.0;  // BER value
+            fLA = (iTotRecBits_LA != 0) ? (iTotValBits*100.0)/iTotRecBits_LA : 0.0;  // link availability value
+            BER[index_s] = float(fBER);  // update output BER array
+            LA[index_s] = float(fLA);  // update output LA array
+          }
+          FillArray<float>((LT + index_p*iPacketSize), float(fLT), iPacketSize);  // update output LT array
+          continue;
+        }
+
         for(int index_s = 0; index_s < iPacketSize; index_s += SampPerBit)  // go through items with step of SpB, starting from first item in the packet
         {
           iTotRecBits_LA += 1;  // increment numner of total received bits
@@ -172,6 +195,8 @@ namespace gr {
       std::cout << "Link_Tester_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
       #endif
 
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
@@ -22,16 +22,18 @@
 #define INCLUDED_HYBRID_COMM_LINK_TESTER_IMPL_H
 
 #include <Hybrid_Comm/Link_Tester.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace Hybrid_Comm {
 
-    class Link_Tester_impl : public Link_Tester
+    class Link_Tester_impl : public Link_Tester, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
       int iPacketSize;  // packet data samples length
       double fSampRate;  // sample rate
+      bool bPacked;  // bit streams of bytes of 8 bits
       #ifdef _FLOW_MODE_
       int iFlowCounter;  // flow debugging counter
       #endif
@@ -64,7 +66,7 @@ namespace gr {
       }
 
      public:
-      Link_Tester_impl(int packetSize = PACKET_SAMP_SIZE, float samp_rate = SAMPLE_RATE);
+      Link_Tester_impl(int packetSize = PACKET_SAMP_SIZE, float samp_rate = SAMPLE_RATE, bool packed = false);
       ~Link_Tester_impl();
 
       // Where all the action really happens
@@ -74,6 +76,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set packet data samples length
       void set_PacketSize(int packetSize)
       {
@@ -114,6 +122,12 @@ namespace gr {
         return fSampRate;
       }
 
+      // Get packed mode
+      bool get_Packed(void)
+      {
+        return bPacked;
+      }
+
     };
 
   } // namespace Hybrid_Comm
@@ -0,0 +1,98 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2020 gr-Hybrid_Comm author.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "Pack_Bits_impl.h"
+
+namespace gr {
+  namespace Hybrid_Comm {
+
+    Pack_Bits::sptr
+    Pack_Bits::make(int samplesPerBit)
+    {
+      return gnuradio::get_initial_sptr
+        (new Pack_Bits_impl(samplesPerBit));
+    }
+
+
+    /*
+     * The private constructor
+     */
+    Pack_Bits_impl::Pack_Bits_impl(int samplesPerBit)
+      : gr::sync_decimator("Pack Bits",
+              gr::io_signature::make(1, 1, sizeof(char)),
+              gr::io_signature::make(1, 1, sizeof(char)), 8*CONSTRAIN(samplesPerBit, 1, INT_MAX/8))
+    {
+      this->setup_Stats(this);  // register the stats message port
+
+      #ifdef _FLOW_MODE_
+      iFlowCounter = 0;
+      #endif
+
+      #ifdef _DEBUG_MODE_
+      std::cout << "Pack_Bits_impl: Constructor called." << std::endl;
+      #endif
+      this->set_SamplesPerBit(samplesPerBit);  // set samples per bit
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    Pack_Bits_impl::~Pack_Bits_impl()
+    {
+    }
+
+    int
+    Pack_Bits_impl::work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+    {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
+      #ifdef _FLOW_MODE_
+      std::cout << "Pack_Bits_impl: Entry: Counter = " << iFlowCounter << std::endl;
+      #endif
+
+      #ifdef _DEBUG_MODE_
+      std::cout << "Pack_Bits_impl: Work called." << std::endl;
+      std::cout << "Pack_Bits_impl: Number of output items = " << noutput_items << std::endl;
+      std::cout << "Pack_Bits_impl: Samples per bit = " << iSamplesPerBit << std::endl;
+      #endif
+
+      // Do <+signal processing+>
+      PackBits((const char *) input_items[0], (unsigned char *) output_items[0], noutput_items, iSamplesPerBit);  // 8*SpB input samples per output byte
+
+      #ifdef _FLOW_MODE_
+      std::cout << "Pack_Bits_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
+      #endif
+
+      PerfTimer.set_Items(noutput_items*8*iSamplesPerBit, noutput_items);  // items of this call
+
+      // Tell runtime system how many output items we produced.
+      return noutput_items;
+    }
+
+  } /* namespace Hybrid_Comm */
+} /* namespace gr */
+
@@ -0,0 +1,230 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2020 gr-Hybrid_Comm author.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "Preamble_Sync_impl.h"
+
+namespace gr {
+  namespace Hybrid_Comm {
+
+    Preamble_Sync::sptr
+    Preamble_Sync::make(const std::vector<char>& preamble, int samplesPerBit, float thresh)
+    {
+      return gnuradio::get_initial_sptr
+        (new Preamble_Sync_impl(preamble, samplesPerBit, thresh));
+    }
+
+    const std::vector<char> Preamble_Sync_impl::defPreamb = {0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0};  // default preamble
+
+    /*
+     * The private constructor
+     */
+    Preamble_Sync_impl::Preamble_Sync_impl(const std::vector<char>& preamble, int samplesPerBit, float thresh)
+      : gr::sync_block("Preamble Sync",
+              gr::io_signature::make(1, 1, sizeof(float)),
+              gr::io_signature::make(1, 2, sizeof(float))),
+              vPreamble(preamble), iSamplesPerBit(CONSTRAIN(samplesPerBit, 1, INT_MAX)), uNextPeak(0),
+              pmtPreamble(pmt::mp(PREAMBLE_TAG)), pmtCorrPeak(pmt::mp(CORR_PEAK_KEY)), pmtSnr(pmt::mp(SNR_KEY))
+    {
+      this->setup_Stats(this);  // register the stats message port
+      iPerfPreambles = this->add_Counter("preambles_found");
+
+      #ifdef _FLOW_MODE_
+      iFlowCounter = 0;
+      #endif
+
+      #ifdef _DEBUG_MODE_
+      std::cout << "Preamble_Sync_impl: Constructor called." << std::endl;
+      #endif
+
+      if(vPreamble.empty() == true)  // nothing to look for
+      {
+        vPreamble = defPreamb;
+      }
+      iPatternLen = vPreamble.size()*iSamplesPerBit;  // resampled preamble length
+
+      std::vector<float> vPattern(iPatternLen);  // resampled preamble levels
+      for(int index = 0; index < iPatternLen; ++index)  // go through the samples
+      {
+        vPattern[index] = (vPreamble[index/iSamplesPerBit] == VAL_1) ? 1.0 : 0.0;
+      }
+      Correlator.set_Pattern(vPattern.data(), iPatternLen);
+      this->set_Thresh(thresh);  // set correlation threshold
+
+      this->set_history(2*iPatternLen);  // one preamble to correlate and one to look ahead for a higher peak
+      this->set_tag_propagation_policy(TPP_DONT);  // tags are moved by the output delay in work
+
+      #ifdef _DEBUG_MODE_
+      std::cout << "Preamble_Sync_impl: Pattern length = " << iPatternLen << ", FFT = " << Correlator.get_Fft() << std::endl;
+      #endif
+    }
+
+    /*
+     * Our virtual destructor.
+     */
+    Preamble_Sync_impl::~Preamble_Sync_impl()
+    {
+    }
+
+
+    /*
+     * Divide the correlation by the preamble norm and the norm of the mean removed signal under it
+     */
+    void Preamble_Sync_impl::Normalise(const float *ptr_fIn, int iCorrLen)
+    {
+      const float fPatternNorm = Correlator.get_PatternNorm();
+      double dSum = 0, dSumSq = 0;  // sums of the signal and its square under the preamble
+      for(int index = 0; index < iPatternLen; ++index)  // first window
+      {
+        dSum += ptr_fIn[index];
+        dSumSq += double(ptr_fIn[index])*ptr_fIn[index];
+      }
+
+      for(int index_k = 0; index_k < iCorrLen; ++index_k)  // go through the correlation
+      {
+        const double dVar = dSumSq - dSum*dSum/iPatternLen;  // energy of the mean removed signal
+        if((dVar > CORR_MIN_VAR*dSumSq) && (fPatternNorm > 0))  // the signal changes under the preamble
+        {
+          vCorr[index_k] = CONSTRAIN(float(vCorr[index_k]/(fPatternNorm*std::sqrt(dVar))), -1.0f, 1.0f);
+        }
+        else
+        {
+          vCorr[index_k] = 0;
+        }
+
+        if(index_k + 1 < iCorrLen)  // slide the window
+        {
+          const float fNew = ptr_fIn[index_k + iPatternLen], fOld = ptr_fIn[index_k];
+          dSum += fNew - fOld;
+          dSumSq += double(fNew)*fNew - double(fOld)*fOld;
+        }
+      }
+    }
+
+
+    /*
+     * Tag the correlation peaks above the threshold; a peak is the highest value up to one preamble after it
+     */
+    int Preamble_Sync_impl::FindPeaks(int noutput_items)
+    {
+      const uint64_t uStart = this->nitems_written(0);  // output sample of the first correlation value
+      int iFound = 0;
+      for(int index_k = 0; index_k < noutput_items; ++index_k)  // go through the correlation
+      {
+        if((vCorr[index_k] < fThresh) || (uStart + index_k < uNextPeak))  // no preamble starts here
+        {
+          continue;
+        }
+
+        int index_m = index_k + 1;
+        while((index_m <= index_k + iPatternLen) && (vCorr[index_m] <= vCorr[index_k]))  // look for a higher value
+        {
+          ++index_m;
+        }
+        if(index_m <= index_k + iPatternLen)  // not the peak; nothing between is higher than the value found
+        {
+          index_k = index_m - 1;
+          continue;
+        }
+
+        const float fPeak = vCorr[index_k];
+        const float fRho = MIN(fPeak, CORR_MAX_PEAK);
+        const float fSnr = 10*std::log10(fRho*fRho/(1 - fRho*fRho));  // signal to noise power over the preamble
+
+        pmt::pmt_t pmtValue = pmt::make_dict();
+        pmtValue = pmt::dict_add(pmtValue, pmtCorrPeak, pmt::from_double(fPeak));
+        pmtValue = pmt::dict_add(pmtValue, pmtSnr, pmt::from_double(fSnr));
+        this->add_item_tag(0, uStart + index_k, pmtPreamble, pmtValue);  // preamble starts here
+
+        TRACE(unique_id(), TRC_PREAMBLE, int(uStart + index_k), int(1000*fPeak), int(100*fSnr));  // preamble tagged
+
+        this->count(iPerfPreambles);  // one more preamble
+        uNextPeak = uStart + index_k + iPatternLen;  // next one is at least one preamble later
+        index_k += iPatternLen - 1;
+        ++iFound;
+      }
+      return iFound;
+    }
+
+
+    int
+    Preamble_Sync_impl::work(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+    {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
+      #ifdef _FLOW_MODE_
+      std::cout << "Preamble_Sync_impl: Entry: Counter = " << iFlowCounter << std::endl;
+      #endif
+
+      const float *in = (const float *) input_items[0];  // history of 2*iPatternLen - 1 samples first
+
+      float *out = (float *) output_items[0];
+      float *out_corr = nullptr;
+
+      if(output_items.size() == 2)  // correlation output is connected
+      {
+        out_corr = (float *) output_items[1];
+      }
+
+      TRACE(unique_id(), TRC_WORK_ENTRY, noutput_items, noutput_items, iPatternLen);  // work called
+
+      // Do <+signal processing+>
+      this->get_tags_in_range(vTags, 0, this->nitems_read(0), this->nitems_read(0) + noutput_items);  // tags of the new samples
+      for(size_t index_t = 0; index_t < vTags.size(); ++index_t)  // go through the tags
+      {
+        vTags[index_t].offset += this->get_Delay();  // the samples come out later
+        for(size_t index_o = 0; index_o < output_items.size(); ++index_o)  // go through the outputs
+        {
+          this->add_item_tag(index_o, vTags[index_t]);
+        }
+      }
+
+      const int iCorrLen = noutput_items + iPatternLen;  // one preamble more to look ahead for a higher peak
+      vCorr.resize(iCorrLen);
+      Correlator.correlate(in, vCorr.data(), iCorrLen);  // correlation with the preamble
+      this->Normalise(in, iCorrLen);  // normalised correlation
+      this->FindPeaks(noutput_items);  // tag the preambles
+
+      CopyArrays<float>(in, out, noutput_items);  // delayed signal
+      if(out_corr != nullptr)  // correlation output is connected
+      {
+        CopyArrays<float>(vCorr.data(), out_corr, noutput_items);
+      }
+
+      TRACE(unique_id(), TRC_WORK_EXIT, noutput_items, noutput_items);  // work returns
+
+      #ifdef _FLOW_MODE_
+      std::cout << "Preamble_Sync_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
+      #endif
+
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
+      // Tell runtime system how many output items we produced.
+      return noutput_items;
+    }
+
+  } /* namespace Hybrid_Comm */
+} /* namespace gr */
@@ -0,0 +1,121 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2020 gr-Hybrid_Comm author.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HYBRID_COMM_PREAMBLE_SYNC_IMPL_H
+#define INCLUDED_HYBRID_COMM_PREAMBLE_SYNC_IMPL_H
+
+#include <Hybrid_Comm/Preamble_Sync.h>
+#include <Comm_Kernels/perf_block.h>
+#include <Comm_Kernels/float_correlator.h>
+
+namespace gr {
+  namespace Hybrid_Comm {
+
+    class Preamble_Sync_impl : public Preamble_Sync, public Comm_Kernels::Perf_Block
+    {
+     private:
+      std::vector<char> vPreamble;  // preamble bits
+      int iSamplesPerBit;  // samples per bit of the preamble
+      int iPatternLen;  // resampled preamble length
+      float fThresh;  // normalised correlation threshold
+      Comm_Kernels::Float_Correlator Correlator;  // correlation with the resampled preamble
+      std::vector<float> vCorr;  // correlation of one work call
+      uint64_t uNextPeak;  // first output sample that can hold the next preamble
+      pmt::pmt_t pmtPreamble;  // preamble tag key
+      pmt::pmt_t pmtCorrPeak;  // correlation peak key
+      pmt::pmt_t pmtSnr;  // SNR estimate key
+      std::vector<gr::tag_t> vTags;  // upstream tags of one work call
+      int iPerfPreambles;  // performance counter: preambles found
+      #ifdef _FLOW_MODE_
+      int iFlowCounter;  // flow debugging counter
+      #endif
+
+      static const std::vector<char> defPreamb;  // default preamble
+
+     public:
+      Preamble_Sync_impl(const std::vector<char>& preamble = defPreamb, int samplesPerBit = DEF_SPB, float thresh = CORR_THRESH);
+      ~Preamble_Sync_impl();
+      void Normalise(const float *ptr_fIn, int iCorrLen);  // correlation divided by the signal and preamble norms
+      int FindPeaks(int noutput_items);  // tag the correlation peaks; returns the number found
+
+      // Where all the action really happens
+      int work(
+              int noutput_items,
+              gr_vector_const_void_star &input_items,
+              gr_vector_void_star &output_items
+      );
+
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
+      // Get preamble
+      void get_Preamble(std::vector<char>* preamble)
+      {
+        *preamble = vPreamble;
+      }
+
+      // Get samples per bit
+      int get_SamplesPerBit(void)
+      {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Preamble_Sync_impl: Samples per bit = " << iSamplesPerBit << std::endl;
+        #endif
+        return iSamplesPerBit;
+      }
+
+      // Set normalised correlation threshold
+      void set_Thresh(float thresh)
+      {
+        fThresh = CONSTRAIN(thresh, 0.0f, 1.0f);
+        #ifdef _DEBUG_MODE_
+        std::cout << "Preamble_Sync_impl: Correlation threshold = " << fThresh << std::endl;
+        #endif
+      }
+
+      // Get normalised correlation threshold
+      float get_Thresh(void)
+      {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Preamble_Sync_impl: Correlation threshold = " << fThresh << std::endl;
+        #endif
+        return fThresh;
+      }
+
+      // Get correlation method
+      bool get_Fft(void)
+      {
+        return Correlator.get_Fft();
+      }
+
+      // Get output delay
+      int get_Delay(void)
+      {
+        return 2*iPatternLen - 1;
+      }
+
+    };
+
+  } // namespace Hybrid_Comm
+} // namespace gr
+
+#endif /* INCLUDED_HYBRID_COMM_PREAMBLE_SYNC_IMPL_H */
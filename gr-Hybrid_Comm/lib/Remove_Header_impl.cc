@@ -23,38 +23,68 @@
 #endif
 
 #include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <stdexcept>
 #include "Remove_Header_impl.h"
 
 namespace gr {
   namespace Hybrid_Comm {
 
     Remove_Header::sptr
-    Remove_Header::make(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit)
+    Remove_Header::make(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit, bool tagMode, bool pduMode, bool crc, bool lengthField, int seqBits, bool packed)
     {
       return gnuradio::get_initial_sptr
-        (new Remove_Header_impl(packetSize, preamble, label, samplesPerBit));
+        (new Remove_Header_impl(packetSize, preamble, label, samplesPerBit, tagMode, pduMode, crc, lengthField, seqBits, packed));
     }
 
     const std::vector<int> Remove_Header_impl::iov = {sizeof(char), sizeof(char), sizeof(int), sizeof(char)};  // io signature
+    const std::vector<int> Remove_Header_impl::iovTag = {sizeof(char), sizeof(char)};  // io signature in tag mode; no sync and counter streams
 
     const std::vector<char> Remove_Header_impl::defPreamb = {0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0};  // default preamble
     const std::string Remove_Header_impl::defLabel = "L1";  // default packet label
-    const int Remove_Header_impl::iCounterLen = sizeof(char)*COUNTER_BITS;  // counter field length
     const int Remove_Header_impl::iLabelBitsPerLet = sizeof(char)*BITS_PER_LETT;  // label bits per letters
     const int Remove_Header_impl::iNumOfOutputMultiple = OUT_NUM_MP;  // number of output items multiple
 
     /*
      * The private constructor
      */
-    Remove_Header_impl::Remove_Header_impl(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit)
+    Remove_Header_impl::Remove_Header_impl(int packetSize, const std::vector<char>& preamble, const std::string& label, int samplesPerBit, bool tagMode, bool pduMode, bool crc, bool lengthField, int seqBits, bool packed)
       : gr::block("Remove Header",
-              gr::io_signature::make(1, 2, sizeof(char)),
-              gr::io_signature::makev(3, 4, iov)),
-              iPreambleLen(1), iLabelLen(1), iSamplesPerBit(1), iPacketSize(1), iCounter(0), iStoredSampLen(0), bStorageLoaded(false),
+              (pduMode ? gr::io_signature::make(1, 1, sizeof(char)) : gr::io_signature::make(1, 2, sizeof(char))),
+              (pduMode ? gr::io_signature::make(0, 0, 0) : ((CountLabels(label) > 1) ? gr::io_signature::make(CountLabels(label), CountLabels(label), sizeof(char)) :
+                                                           (tagMode ? gr::io_signature::makev(1, 2, iovTag) : gr::io_signature::makev(3, 4, iov))))),
+              iPreambleLen(1), iLabelLen(1), iSamplesPerBit(packed ? 1 : CONSTRAIN(samplesPerBit, 1, INT_MAX)), iChannelSpB(CONSTRAIN(samplesPerBit, 1, INT_MAX)), bPacked(packed), iDataScale(packed ? 8 : 1), iPacketSize(1), iCounter(0),
               ptr_cPreamble(nullptr), ptr_cLabel(nullptr), ptr_cLabelBits(nullptr), ary_cCounterBits(nullptr),
               ptr_cPreambleSeq(nullptr), ptr_cLabelBitsSeq(nullptr), ptr_cCounterSeq(nullptr),
-              ptr_cAuxStorage(nullptr), ptr_cHeaderPattern(nullptr), ptr_cAuxPattern(nullptr)
+              ptr_cHeaderPattern(nullptr), ptr_cAuxPattern(nullptr),
+              iSyncState(SYNC_HUNT), iSyncHits(0), iSyncMisses(0), iMaxMisses(SYNC_MAX_MISSES), iNextHeader(0), iLastHeader(0), pmtPreambleStart(pmt::mp(PREAMBLE_TAG)),
+              bTagMode(tagMode || (CountLabels(label) > 1)), pmtPacketStart(pmt::mp(PACKET_START_TAG)), pmtSeq(pmt::mp(SEQ_TAG)),
+              bPduMode(pduMode), iCounterLen(COUNTER_WIDTH(seqBits)), iCrcLen(crc ? CRC_BITS : 0), pmtCrcOk(pmt::mp(CRC_OK_KEY)),
+              iLengthLen((lengthField || pduMode) ? LENGTH_BITS : 0), pmtLength(pmt::mp(LENGTH_TAG)), iNumOfFlows(CountLabels(label))
     {
+      if ((iLengthLen != 0) && (packetSize > this->LengthMaxItems()))  // the length field can not hold the packet size; checked before any memory is taken
+      {
+        throw std::invalid_argument("Remove_Header: packet size " + std::to_string(packetSize) + " is longer than the length field holds (" + std::to_string(this->LengthMaxItems()) + ")");
+      }
+      this->setup_Stats(this);  // register the stats message port
+      for(int index_f = 0; index_f < iNumOfFlows; ++index_f)  // one PDU port per flow; "pdu" for a single flow, "pdu0", "pdu1", ... otherwise
+      {
+        vpmtPduPorts.push_back(pmt::mp((iNumOfFlows == 1) ? std::string(PDU_PORT) : (PDU_PORT + std::to_string(index_f))));
+      }
+      if(bPduMode == true)  // packets go out as messages
+      {
+        for(int index_f = 0; index_f < iNumOfFlows; ++index_f)  // go through the flows
+        {
+          this->message_port_register_out(vpmtPduPorts[index_f]);
+        }
+      }
+      iPerfPackets = this->add_Counter("packets_deframed");
+      iPerfSyncLosses = this->add_Counter("sync_losses");
+      iPerfMisses = this->add_Counter("header_misses");
+      iPerfSearches = this->add_Counter("full_searches");
+      iPerfCrcErrors = this->add_Counter("crc_errors");
+      iPerfUnknown = this->add_Counter("unknown_labels");
+
       #ifdef _FLOW_MODE_
       iFlowCounter = 0;
       #endif
@@ -68,6 +98,7 @@ namespace gr {
       this->set_PacketSize(packetSize);  // set packet size
 
       this->set_history(1);
+      this->set_tag_propagation_policy(TPP_DONT);  // the header is removed; the output packets get their own tags
 
       ary_cCounterBits = new char [iCounterLen];  // allocate memory
 
@@ -117,12 +148,6 @@ namespace gr {
         ptr_cCounterSeq = nullptr;  // label the array as empty
       }
 
-      if (ptr_cAuxStorage != nullptr)  // if the array is free
-      {
-        delete[] ptr_cAuxStorage;  // release the array
-        ptr_cAuxStorage = nullptr;  // label the array as empty
-      }
-
       if (ptr_cHeaderPattern != nullptr)  // if the array is free
       {
         delete[] ptr_cHeaderPattern;  // release the array
@@ -153,10 +178,15 @@ namespace gr {
       #endif
       int N_out = iPacketSize;  // calculate number of output samples for each sample burst
       N_out = CONSTRAIN(N_out, 1 ,INT_MAX);  // check the range
-      int N_header = (iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen) * iSamplesPerBit;
-      int N_in = N_header + iPacketSize;  // calculate number of input samples for each sample
-      
-      block::set_output_multiple(N_out);
+      if (iLengthLen != 0)  // packets have their own length; room for the longest one is enough
+      {
+        block::set_output_multiple(1);
+        block::set_min_noutput_items(N_out);
+      }
+      else
+      {
+        block::set_output_multiple(N_out);
+      }
 //      block::set_max_noutput_items(N_out*iNumOfOutputMultiple);
 
       #ifdef _DEBUG_MODE_
@@ -194,15 +224,8 @@ namespace gr {
       ptr_cCounterSeq = new char [iCounterLen*iSamplesPerBit];  // get the array memory
       FillArray<char>(ptr_cCounterSeq, 0, iCounterLen*iSamplesPerBit);  // initialise the array with 0
 
-      if (ptr_cAuxStorage != nullptr)  // if the array is free
-      {
-        delete[] ptr_cAuxStorage;  // release the array
-        ptr_cAuxStorage = nullptr;  // label the array as empty
-      }
-      ptr_cAuxStorage = new char [N_in];  // get the array memory
-      FillArray<char>(ptr_cAuxStorage, 0, N_in);  // initialise the array with 0
-
-      int N_headerPattern = (iPreambleLen + iLabelLen*iLabelBitsPerLet) * iSamplesPerBit;  // number of samples in header pattern (preamble + label)
+      int iPatternLabelLen = (iNumOfFlows == 1) ? iLabelLen*iLabelBitsPerLet : 0;  // label bits in the pattern; with several flows the label is read after the preamble is found
+      int N_headerPattern = (iPreambleLen + iPatternLabelLen) * iSamplesPerBit;  // number of samples in header pattern (preamble + label)
       #ifdef _DEBUG_MODE_
       std::cout << "Remove_Header_impl: Number of header pattern sample = " << N_headerPattern << std::endl;
       #endif
@@ -219,8 +242,16 @@ namespace gr {
         ptr_cHeaderPattern = new char [N_headerPattern];  // get the array memory
         ptr_cAuxPattern = new char [N_headerPattern];  // get the array memory
         CopyArrays<char>(ptr_cPreambleSeq, ptr_cHeaderPattern, iPreambleLen*iSamplesPerBit);  // insert preamble sequence
-        CopyArrays<char>(ptr_cLabelBitsSeq, (ptr_cHeaderPattern + iPreambleLen*iSamplesPerBit), iLabelLen*iLabelBitsPerLet*iSamplesPerBit);  // insert label sequence
+        CopyArrays<char>(ptr_cLabelBitsSeq, (ptr_cHeaderPattern + iPreambleLen*iSamplesPerBit), iPatternLabelLen*iSamplesPerBit);  // insert label sequence
       }
+      Correlator.set_Pattern(ptr_cHeaderPattern, (ptr_cHeaderPattern != nullptr) ? N_headerPattern : 0);  // pack the pattern for the search
+      iTagMaxErr = int(SYNC_TAG_MAX_ERR*Correlator.get_PatternLen());  // sliced samples of a weak header that may be wrong where a preamble is marked
+
+      iSyncState = SYNC_HUNT;  // the packet layout changed; search for the header again
+      iSyncHits = 0;
+      iSyncMisses = 0;
+      iNextHeader = 0;
+      iLastHeader = 0;
 
       #ifdef _DEBUG_MODE_
       if (ptr_cHeaderPattern != nullptr)
@@ -241,6 +272,312 @@ namespace gr {
     }
 
 
+    /*
+     * Find the header of the next packet; a full search is only run while hunting
+     */
+    int Remove_Header_impl::FindHeader(int iExpected)
+    {
+      uint64_t iInputStart = this->nitems_read(0)*iDataScale;  // absolute position of the first input sample
+      if (iSyncState == SYNC_HUNT)  // no lock; search the rest of the input
+      {
+        this->count(iPerfSearches);  // one more full search
+        int index_M = Correlator.find(iExpected);  // find first matching index
+        int index_T = this->FindTagged(iExpected, (index_M != -1) ? index_M : INT_MAX);  // a weaker header marked upstream before it
+        index_M = (index_T != -1) ? index_T : index_M;
+        if (index_M != -1)  // a header is found
+        {
+          this->SetSyncState(SYNC_VERIFY, index_M);  // confirm it with the next headers
+          iLastHeader = iInputStart + index_M;
+        }
+        return index_M;
+      }
+
+      int iTolerance = SYNC_TOL_BITS*iSamplesPerBit;  // header position tolerance (samples)
+      int index_M = Correlator.find(iExpected - iTolerance, 0, iExpected + iTolerance + 1);  // check around the expected position only
+      index_M = (index_M != -1) ? index_M : this->FindTagged(iExpected - iTolerance, iExpected + iTolerance + 1);  // or a weaker one marked upstream
+      if ((index_M != -1) && ((iInputStart + index_M - iLastHeader) <= (uint64_t) iTolerance))  // the header counted last, left in the input by the previous call; not one more hit
+      {
+        return index_M;
+      }
+      if (index_M != -1)  // header is where it is expected
+      {
+        iLastHeader = iInputStart + index_M;
+        iSyncMisses = 0;  // reset the consecutive misses
+        if ((iSyncState == SYNC_VERIFY) && (++iSyncHits >= SYNC_VERIFY_HITS))  // packet period is confirmed
+        {
+          this->SetSyncState(SYNC_LOCK, index_M);
+        }
+        return index_M;
+      }
+
+      int index_F = -1;  // header found after the expected position
+      if ((iSyncState == SYNC_LOCK) && (iLengthLen != 0))  // the next packet start is not known; the header is searched for within the longest packet after the expected position
+      {
+        int iMaxLen = (iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen + iLengthLen + iCrcLen)*iSamplesPerBit + iPacketSize*iDataScale;  // longest packet (samples)
+        int iFirst = iExpected + iTolerance + 1;  // first position after the tolerance
+        int iStop = iExpected + iMaxLen + iTolerance + 1;  // last header position of the packet after the missed one
+        index_F = Correlator.find(iFirst, 0, iStop);
+        int index_T = this->FindTagged(iFirst, (index_F != -1) ? index_F : iStop);  // a weaker header marked upstream before it
+        index_F = (index_T != -1) ? index_T : index_F;
+        if ((index_F == -1) && (iStop > (Correlator.get_ArrayLen() - Correlator.get_PatternLen())))  // the search runs past the input; the header may come in the next call
+        {
+          return SYNC_WAIT;
+        }
+      }
+
+      this->count(iPerfMisses);  // header is missed
+      ++iSyncMisses;
+      if ((iSyncState == SYNC_VERIFY) || (iSyncMisses >= iMaxMisses))  // not confirmed, or too many misses; back to the full search
+      {
+        this->LoseSync(iExpected);
+        return this->FindHeader(iExpected - iTolerance);  // search from the expected position on
+      }
+      if (index_F != -1)  // lock is kept; the packet at the expected position is lost
+      {
+        iLastHeader = iInputStart + index_F;
+        return index_F;
+      }
+      return -1;  // lock is kept; this packet is skipped
+    }
+
+
+    /*
+     * Find a header at an upstream preamble tag; the tag is within half a bit of the preamble start, and
+     * the pattern may have up to iTagMaxErr wrong samples there; the fewest mismatches win
+     */
+    int Remove_Header_impl::FindTagged(int iStart, int iStop)
+    {
+      int iTolerance = iSamplesPerBit/2;  // tag position tolerance (samples)
+      for (int index_t = 0; index_t < (int) vPreambleStarts.size(); ++index_t)  // go through the tags
+      {
+        int iFirst = MAX(vPreambleStarts[index_t] - iTolerance, iStart);  // search window of the tag
+        int iLast = MIN(vPreambleStarts[index_t] + iTolerance + 1, iStop);
+        if (iFirst >= iLast)  // tag is out of the range
+        {
+          if (vPreambleStarts[index_t] - iTolerance >= iStop)  // so are the next ones
+          {
+            break;
+          }
+          continue;
+        }
+        for (int iMaxErr = 0; iMaxErr <= iTagMaxErr; ++iMaxErr)  // closest match first
+        {
+          int index_M = Correlator.find(iFirst, iMaxErr, iLast);
+          if (index_M != -1)  // header is at the tag
+          {
+            TRACE(unique_id(), TRC_TAG_MATCH, vPreambleStarts[index_t], index_M, iMaxErr);  // header at the tag
+            return index_M;
+          }
+        }
+      }
+      return -1;
+    }
+
+
+    /*
+     * Mark the start of the output packet at 'iOffset' of flow 'iFlow'; a counter value of -1 marks a packet that is not valid
+     */
+    void Remove_Header_impl::MarkPacket(char *sync, int *counter, int iOffset, int64_t counterValue, int iFlow)
+    {
+      if ((bPduMode == true) || ((iNumOfFlows > 1) && (counterValue == -1)))  // no output streams; or a packet of no flow
+      {
+        return;
+      }
+      else if (bTagMode == true)  // tags instead of the sync and counter streams
+      {
+        if (counterValue != -1)  // valid packet
+        {
+          this->add_item_tag(iFlow, this->nitems_written(iFlow) + iOffset, pmtPacketStart, pmt::PMT_T);  // packet starts here
+        }
+        this->add_item_tag(iFlow, this->nitems_written(iFlow) + iOffset, pmtSeq, pmt::from_long(counterValue));  // packet counter
+      }
+      else if (counterValue != -1)  // valid packet
+      {
+        sync[iOffset] = 1;  // set sync pulse
+        counter[iOffset] = int(SeqAdd(counterValue, 0, COUNTER_STREAM_BITS));  // set counter output; its lowest bits
+      }
+      else
+      {
+        FillArray<int>((counter + iOffset), -1, iPacketSize);  // indicate loss of sync
+      }
+    }
+
+
+    /*
+     * Decided bits of the header field at input sample 'iIndex'; the majority of the samples of each bit, or the bits of a packed input
+     */
+    void Remove_Header_impl::ReadField(const char *in, int iIndex, char *ptr_cBits, int iNumOfBits)
+    {
+      if (bPacked == true)  // 8 bits per input byte
+      {
+        ReadBits((const unsigned char *) in, iIndex, ptr_cBits, iNumOfBits);
+      }
+      else if (iSamplesPerBit == 1)  // one sample per bit
+      {
+        CopyArrays<char>((in + iIndex), ptr_cBits, iNumOfBits);
+      }
+      else
+      {
+        for (int index_b = 0; index_b < iNumOfBits; ++index_b)  // go through the bits; a weak signal flips single samples, mostly at the bit edges
+        {
+          const char *ptr_cBit = in + iIndex + index_b*iSamplesPerBit;  // first sample of the bit
+          int iOnes = 0;  // samples of the bit at VAL_1
+          for (int index_s = 0; index_s < iSamplesPerBit; ++index_s)
+          {
+            iOnes += (ptr_cBit[index_s] == VAL_1) ? 1 : 0;
+          }
+          ptr_cBits[index_b] = (2*iOnes > iSamplesPerBit) ? VAL_1 : ((2*iOnes < iSamplesPerBit) ? VAL_0 : ptr_cBit[iSamplesPerBit/2]);  // a tie takes the middle sample
+        }
+      }
+    }
+
+
+    /*
+     * Copy the 'iDataLen' data items of a packet from input sample 'iIndex'; a packed input is copied a byte at a time from any bit offset
+     */
+    void Remove_Header_impl::CopyData(const char *in, int iIndex, char *ptr_cOut, int iDataLen)
+    {
+      if (bPacked == true)  // 8 bits per input byte
+      {
+        CopyBits((const unsigned char *) in, iIndex, (unsigned char *) ptr_cOut, iDataLen);
+      }
+      else
+      {
+        CopyArrays<char>((in + iIndex), ptr_cOut, iDataLen);
+      }
+    }
+
+
+    /*
+     * Check the CRC field after the data; CRC-32 of the counter and length field bytes and the data bits, packed into bytes
+     */
+    bool Remove_Header_impl::CheckCrc(const char *in, int iIndex, int iDataLen, int64_t counterValue)
+    {
+      unsigned char ary_ucFields[(COUNTER_MAX_BITS + LENGTH_BITS + 7)/8];  // counter and length field bytes, least significant first
+      int iNumOfFieldBytes = (iCounterLen + 7)/8;  // counter field bytes
+      for(int index_b = 0; index_b < iNumOfFieldBytes; ++index_b)  // go through the counter bytes
+      {
+        ary_ucFields[index_b] = (unsigned char)((counterValue >> 8*index_b) & 0xFF);
+      }
+      for(int index_b = 0; index_b < iLengthLen/8; ++index_b)  // go through the length bytes; none without the field
+      {
+        ary_ucFields[iNumOfFieldBytes++] = (unsigned char)((this->LengthValue(iDataLen) >> 8*index_b) & 0xFF);
+      }
+      int iNumOfDataBytes = (bPacked == true) ? iDataLen : (iDataLen/iSamplesPerBit + 7)/8;  // packed data bytes
+      vCrcBytes.resize(iNumOfDataBytes);
+      if (bPacked == true)  // the data bits are packed already
+      {
+        CopyBits((const unsigned char *) in, iIndex, vCrcBytes.data(), iDataLen);
+      }
+      else
+      {
+        PackBitStream((in + iIndex), vCrcBytes.data(), iDataLen/iSamplesPerBit, iSamplesPerBit);  // decided data bits; the middle sample of each bit
+      }
+      uint32_t uCrc = Crc32(vCrcBytes.data(), iNumOfDataBytes, Crc32(ary_ucFields, iNumOfFieldBytes));  // CRC of the header fields and the data
+
+      char ary_cCrcBits[CRC_BITS];  // CRC field bits
+      this->ReadField(in, iIndex + iDataLen*iDataScale, ary_cCrcBits, iCrcLen);  // decide the CRC field
+      uint32_t uCrcField = 0;  // CRC field value
+      for(int index_b = 0; index_b < iCrcLen; ++index_b)  // go through the CRC bits, least significant first
+      {
+        uCrcField |= uint32_t(ary_cCrcBits[index_b] == VAL_1) << index_b;
+      }
+
+      if (uCrcField != uCrc)  // packet is corrupted
+      {
+        TRACE(unique_id(), TRC_REJECT, 1, iIndex, int32_t(uCrcField), int32_t(uCrc));  // CRC error
+        this->count(iPerfCrcErrors);  // one more bad packet
+        return false;
+      }
+      return true;
+    }
+
+
+    /*
+     * Send the data of a packet from the PDU port of its flow, packed into bytes, with its counter, label and sync state
+     */
+    void Remove_Header_impl::PublishPacket(const char *in, int iIndex, int iDataLen, int64_t counterValue, int iOffset, bool bCrcOk, int iFlow)
+    {
+      int iNumOfBytes = (bPacked == true) ? iDataLen : iDataLen/(8*iSamplesPerBit);  // packet data bytes; the length field gives whole bytes in PDU mode
+      vPduBytes.resize(iNumOfBytes);
+      if (bPacked == true)  // the data bits are packed already
+      {
+        CopyBits((const unsigned char *) in, iIndex, vPduBytes.data(), iNumOfBytes);
+      }
+      else
+      {
+        PackBits((in + iIndex), vPduBytes.data(), iNumOfBytes, iSamplesPerBit);  // pack the data bits
+      }
+
+      pmt::pmt_t pmtMeta = pmt::make_dict();
+      pmtMeta = pmt::dict_add(pmtMeta, pmtSeq, pmt::from_long(counterValue));
+      pmtMeta = pmt::dict_add(pmtMeta, pmt::mp(LABEL_KEY), vpmtLabels[iFlow]);
+      pmtMeta = pmt::dict_add(pmtMeta, pmt::mp(SYNC_STATE_KEY), pmt::from_long(iSyncState));
+      pmtMeta = pmt::dict_add(pmtMeta, pmt::mp(SYNC_OFFSET_KEY), pmt::from_long(iOffset));
+      if (iCrcLen != 0)  // packets have the CRC field
+      {
+        pmtMeta = pmt::dict_add(pmtMeta, pmtCrcOk, pmt::from_bool(bCrcOk));
+      }
+      this->message_port_pub(vpmtPduPorts[iFlow], pmt::cons(pmtMeta, pmt::init_u8vector(iNumOfBytes, vPduBytes.data())));
+    }
+
+
+    /*
+     * Find the flow of a packet from its label field; one hash lookup, whatever the number of flows
+     */
+    int Remove_Header_impl::FindFlow(const char *in, int iIndex)
+    {
+      this->ReadField(in, iIndex, vLabelFieldBits.data(), iLabelLen*iLabelBitsPerLet);  // decide the label field
+      for(int index_l = 0; index_l < iLabelLen; ++index_l)  // go through the letters
+      {
+        sLabelField[index_l] = Bits2Num<char>((vLabelFieldBits.data() + index_l*iLabelBitsPerLet), iLabelBitsPerLet);  // convert the letter bits to the letter
+      }
+
+      std::unordered_map<std::string, int>::const_iterator it = mapFlows.find(sLabelField);  // flow of the label
+      if (it == mapFlows.end())  // label of no flow
+      {
+        TRACE(unique_id(), TRC_REJECT, 2, iIndex, int32_t(Bits2Num<uint32_t>(vLabelFieldBits.data(), MIN(iLabelLen*iLabelBitsPerLet, 32))), 0);  // unknown label
+        this->count(iPerfUnknown);  // one more packet of no flow
+        return -1;
+      }
+      return it->second;
+    }
+
+
+    /*
+     * Number of labels in a list of labels separated by LABEL_SEP
+     */
+    int Remove_Header_impl::CountLabels(const std::string& label)
+    {
+      return 1 + std::count(label.begin(), label.end(), LABEL_SEP);
+    }
+
+
+    /*
+     * Move the sync state machine to a new state
+     */
+    void Remove_Header_impl::SetSyncState(int iState, int iIndex)
+    {
+      TRACE(unique_id(), TRC_SYNC_STATE, iState, iSyncState, iIndex, iSyncMisses);  // sync state changes
+      iSyncState = iState;  // update the state
+      iSyncHits = 0;  // reset the state counts
+      iSyncMisses = 0;
+    }
+
+
+    /*
+     * Go back to the full search; leaving the lock counts as a sync loss
+     */
+    void Remove_Header_impl::LoseSync(int iIndex)
+    {
+      if (iSyncState == SYNC_LOCK)  // lock is lost
+      {
+        this->count(iPerfSyncLosses);
+      }
+      this->SetSyncState(SYNC_HUNT, iIndex);
+    }
+
+
     void
     Remove_Header_impl::forecast (int noutput_items, gr_vector_int &ninput_items_required)
     {
@@ -259,12 +596,13 @@ namespace gr {
       std::cout << "Remove_Header_impl: Available number of blocks = " << Multiple_out << std::endl;
       #endif
 
-      int N_header = (iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen) * iSamplesPerBit;
-      int N_in = N_header + iPacketSize;  // calculate number of input samples for each sample 
+      int N_header = (iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen + iLengthLen) * iSamplesPerBit;
+      int N_in = N_header + iPacketSize*iDataScale + iCrcLen*iSamplesPerBit;  // calculate number of input samples for each sample 
+      int N_min = (iLengthLen != 0) ? (N_header + iCrcLen*iSamplesPerBit) : N_in*Multiple_out;  // a packet with the length field may be short
 
       for (int index = 0; index < ninput_items_required.size(); index++)  // go through all inputs
       {
-        ninput_items_required[index] = N_in*Multiple_out;  // set the number of required inputs equal to number of required sample
+        ninput_items_required[index] = (N_min + iNextHeader + iDataScale - 1)/iDataScale;  // set the number of required inputs equal to number of required sample; the packets start at the expected header; whole bytes in packed mode
         #ifdef _DEBUG_MODE_
         std::cout << "Remove_Header_impl: Index = " << index <<" Required number of input = " << ninput_items_required[index] << std::endl;
         #endif
@@ -278,15 +616,17 @@ namespace gr {
                       gr_vector_const_void_star &input_items,
                       gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       #ifdef _FLOW_MODE_
       std::cout << "Remove_Header_impl: Entry: Counter = " << iFlowCounter << std::endl;
       #endif
 
       const char *in = (const char *) input_items[0];
       const char *in_SpB =  nullptr;
-      char *out = (char *) output_items[0];
-      char *sync = (char *) output_items[1];
-      int *counter = (int *) output_items[2];
+      char *out = nullptr;
+      char *sync = nullptr;
+      int *counter = nullptr;
       char *out_SpB =  nullptr;      
 
       if(input_items.size() == 2)  // SpB input is connected
@@ -294,177 +634,240 @@ namespace gr {
         in_SpB = (const char *) input_items[1];
       }
 
-      if(output_items.size() == 4)  // SpB output is connected
+      if(bPduMode == true)  // packets go out as messages; no output streams
       {
-        out_SpB = (char *) output_items[3];
+      }
+      else if(bTagMode == true)  // packet starts are tagged
+      {
+        out = (char *) output_items[0];
+        if((output_items.size() == 2) && (iNumOfFlows == 1))  // SpB output is connected; there is none with several flows
+        {
+          out_SpB = (char *) output_items[1];
+        }
+      }
+      else
+      {
+        out = (char *) output_items[0];
+        sync = (char *) output_items[1];
+        counter = (int *) output_items[2];
+        if(output_items.size() == 4)  // SpB output is connected
+        {
+          out_SpB = (char *) output_items[3];
+        }
       }
 
       bool bSpBConnected = ( (in_SpB != nullptr) && (out_SpB != nullptr) ) ? true : false;  // if SpB is to be transferred
 
-      int N_header = (iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen) * iSamplesPerBit;
-      int N_in = N_header + iPacketSize;  // calculate number of input samples for each sample 
+      int N_header = (iPreambleLen + iLabelLen*iLabelBitsPerLet + iCounterLen + iLengthLen) * iSamplesPerBit;
+      int N_in = N_header + iPacketSize*iDataScale + iCrcLen*iSamplesPerBit;  // calculate number of input samples for each sample; the longest packet with the length field
+      int N_min = (iLengthLen != 0) ? (N_header + iCrcLen*iSamplesPerBit) : N_in;  // input samples of the shortest packet
 
       int N_out = iPacketSize;  // calculate number of output samples for each sample burst
       N_out = CONSTRAIN(N_out, 1 ,INT_MAX);  // check the range
-      int Multiple_out = noutput_items/N_out;  // calculate number of ouput blocks
-      int numInput = ninput_items[0];  // number of available input samples
-
-      int N_headerPattern = (iPreambleLen + iLabelLen*iLabelBitsPerLet) * iSamplesPerBit;  // number of samples in header pattern (preamble + label)
-      int index_M = MatchBitSeq<char>(in, ptr_cHeaderPattern, ptr_cAuxPattern, numInput, N_headerPattern); // find first matching index
-      int Index_PacketStart;  // index of processed element in the current packet; by default all the elements are analysed.
-      int totNumInput = N_in*Multiple_out;  // total number of inputs
-
-      #ifdef _DEBUG_MODE_
-      std::cout << "Remove_Header_impl: Work called." << std::endl;
-      std::cout << "Remove_Header_impl: Available total number of output samples = " << noutput_items << std::endl;
-      std::cout << "Remove_Header_impl: Number of output samples per block = " << N_out << std::endl;
-      std::cout << "Remove_Header_impl: Number of header samples = " << N_header << std::endl;
-      std::cout << "Remove_Header_impl: Expected number of blocks = " << iNumOfOutputMultiple << std::endl;
-      std::cout << "Remove_Header_impl: Available number of blocks = " << Multiple_out << std::endl;
-      std::cout << "Remove_Header_impl: Expected number of input samples = " << totNumInput << std::endl;
-      std::cout << "Remove_Header_impl: Available number of input samples = " << numInput << std::endl;
-      std::cout << "Remove_Header_impl: Samples per bit pin is " << ((bSpBConnected == true) ? "" : "not ") << "connected." << std::endl;
-      #endif
+      int numInput = ninput_items[0]*iDataScale;  // number of available input samples; bits in packed mode
 
-      FillArray<char>(out, INV_SIG_VAL, noutput_items);  // initialise out array
-      FillArray<char>(sync, DEF_SIG_VAL, noutput_items);  // initialise sync array
-      FillArray<int>(counter, DEF_SIG_VAL, noutput_items);  // initialise short array
+      int Index_PacketStart = iNextHeader;  // index of processed element in the current packet; starts at the expected header position
+      int index_First = -1;  // index of the first header found
+      int index_B = 0;  // output packet index
+      int iNumOfProduced = 0;  // output samples of all the flows
+      vFlowOffsets.assign(iNumOfFlows, 0);  // output samples of each flow
+      bool bSkipInvalid = (iNumOfFlows > 1) || (iLengthLen != 0);  // packets that are not valid have no output; they belong to no flow, or have no known length
 
-      // Do <+signal processing+>
-      if (index_M != -1)  // if a match is found
+      if (bPacked == true)  // the input is packed already; its bits are only reversed
       {
-        #ifdef _DEBUG_MODE_
-        std::cout << "Remove_Header_impl: Match found" << std::endl;
-        #endif
-
-        #ifdef _DEBUG_MODE_
-        std::cout << "Remove_Header_impl: First pattern and array matching index = " << index_M << std::endl;
-        #endif
-
-        #ifdef _DEBUG_MODE_
-        std::cout << std::endl << "Remove_Header_impl: DSP main loop: Start" << std::endl;
-        std::cout << "------------------------------------------" << std::endl;
-        #endif
-
-        int NumOfAvPack = Multiple_out - int(index_M/N_in);  // number of available blocks ready for DSP
-        #ifdef _DEBUG_MODE_
-        std::cout << "Remove_Header_impl: Number of available input blocks for DSP = " << NumOfAvPack << std::endl;
-        #endif
-
-        Index_PacketStart = index_M;  // index of first element in the current packet
+        Correlator.load_packed((const unsigned char *) in, ninput_items[0]);
+      }
+      else
+      {
+        Correlator.load(in, numInput);  // pack the input once for all the searches
+      }
 
-        for (int index_B = 0; index_B < NumOfAvPack; ++index_B)  // go through available blocks
+      vPreambleStarts.clear();
+      if (bPacked == false)  // tags of a packed input mark bytes, not preamble starts
+      {
+        this->get_tags_in_range(vTags, 0, this->nitems_read(0), this->nitems_read(0) + ninput_items[0], pmtPreambleStart);  // preambles found upstream, by Preamble_Sync
+        for (int index_t = 0; index_t < (int) vTags.size(); ++index_t)  // go through the tags
         {
+          vPreambleStarts.push_back(int(vTags[index_t].offset - this->nitems_read(0)));  // input position of the preamble
+        }
+      }
 
-          #ifdef _DEBUG_MODE_
-          std::cout << "Remove_Header_impl: Input packet index = " << index_B << " out of " << NumOfAvPack - 1 << std::endl;
-          #endif
-
-          sync[index_B*N_out] = 1;  // set sync pulse
-
-          Index_PacketStart += (iPreambleLen + iLabelLen*iLabelBitsPerLet)*iSamplesPerBit;  // update packet index to point to counter section
-
-          #ifdef _DEBUG_MODE_
-          std::cout << "Remove_Header_impl: Preamble and label parsed!" << std::endl;
-          #endif
-
-          #ifdef _DEBUG_MODE_
-          std::cout << "Remove_Header_impl: Packet index = " << Index_PacketStart << std::endl;
-          #endif
+      TRACE(unique_id(), TRC_WORK_ENTRY, noutput_items, numInput, iPacketSize);  // work called
 
-          CopyArrays<char>((in + Index_PacketStart), ptr_cCounterSeq, iCounterLen*iSamplesPerBit);  // insert counter into the array
-          DecimatArray<char>(ptr_cCounterSeq, ary_cCounterBits, iCounterLen*iSamplesPerBit, iSamplesPerBit);  // decimate the counter array
-          int counterValue = Bits2Num<int>(ary_cCounterBits, iCounterLen);  // convert the counter bits to equivalent number
-          counter[index_B*N_out] = counterValue;  // set counter output
-          Index_PacketStart += iCounterLen*iSamplesPerBit;  // update packet index to point to data section
+      if((bPduMode == false) && (iNumOfFlows == 1))  // output stream; with several flows only the packets are produced
+      {
+        FillArray<char>(out, INV_SIG_VAL, noutput_items);  // initialise out array
+      }
+      if((bTagMode == false) && (bPduMode == false))  // sync and counter streams
+      {
+        FillArray<char>(sync, DEF_SIG_VAL, noutput_items);  // initialise sync array
+        FillArray<int>(counter, DEF_SIG_VAL, noutput_items);  // initialise short array
+      }
 
-          #ifdef _DEBUG_MODE_
-          std::cout << "Remove_Header_impl: Counter parsed!" << std::endl;
-          #endif
-          
-          #ifdef _DEBUG_MODE_
-          std::cout << "Remove_Header_impl: Packet index = " << Index_PacketStart << std::endl;
-          std::cout << "Remove_Header_impl: Counter bit sequence = [";
-          for(int index = 0; index < iCounterLen; )  // go through the array
+      // Do <+signal processing+>
+      while (((iNumOfProduced + N_out) <= noutput_items) && ((Index_PacketStart + N_min) <= numInput))  // go through the packets while there is room for them
+      {
+        int iExpected = Index_PacketStart;  // expected header position
+        int index_M = this->FindHeader(Index_PacketStart);  // find the header of the next packet
+        if (index_M == SYNC_WAIT)  // the header may be past the end of the input
+        {
+          break;  // look for it again in the next call
+        }
+        if (index_M == -1)  // no header is found
+        {
+          if (iSyncState == SYNC_HUNT)  // no header in the rest of the input
           {
-            std::cout << CPRN(ary_cCounterBits[index]);  // show the elements
-            ++index;  // increment the coutner
-            if((index % 4) == 0)  // if 4 bit has been printed out
+            int iNumOfSearched = numInput - Correlator.get_PatternLen() - Index_PacketStart;  // samples searched without a header
+            int iNumOfSlots = (bSkipInvalid == false) ? CONSTRAIN(iNumOfSearched/N_in, 0, (noutput_items - iNumOfProduced)/N_out) : 0;  // packets without sync
+            for(int index_S = 0; index_S < iNumOfSlots; ++index_S)  // one output packet per input packet length
             {
-              std::cout << ", ";  // show the elements
+              this->MarkPacket(sync, counter, iNumOfProduced, -1);  // indicate loss of sync
+              iNumOfProduced += N_out;
+              ++index_B;
             }
+            Index_PacketStart = ((iNumOfProduced + N_out) <= noutput_items) ? (numInput - Correlator.get_PatternLen()) : (Index_PacketStart + iNumOfSlots*N_in);  // first index not searched or not reported
+            break;  // leave the loop
           }
-          std::cout << "]" << std::endl;
-          std::cout << "Remove_Header_impl: Counter = " << counterValue << std::endl;;
-          #endif
-
-          CopyArrays<char>((in + Index_PacketStart), (out + index_B*N_out), N_out);  // insert data into the output array
-
-          if(bSpBConnected == true)  // if SpB is to transferred
+          if (bSkipInvalid == false)  // missed packet has an output
           {
-            CopyArrays<char>((in_SpB + Index_PacketStart), (out_SpB + index_B*N_out), N_out);  // insert SpB into the output array
+            this->MarkPacket(sync, counter, iNumOfProduced, -1);  // header is missed; the output packet is not valid
+            iNumOfProduced += N_out;
+            ++index_B;  // next output packet
           }
+          Index_PacketStart += N_in;  // go to the next packet
+          continue;
+        }
+        if ((index_M + N_min) > numInput)  // packet is not complete
+        {
+          Index_PacketStart = index_M;  // look at it in the next call
+          break;  // leave the loop
+        }
 
-          Index_PacketStart += N_out;  // update packet index to point to end of packet
+        Index_PacketStart = index_M + (iPreambleLen + iLabelLen*iLabelBitsPerLet)*iSamplesPerBit;  // update packet index to point to counter section
 
-          #ifdef _DEBUG_MODE_
-          std::cout << "Remove_Header_impl: Packet index = " << Index_PacketStart << std::endl;
-          #endif
+        this->ReadField(in, Index_PacketStart, ary_cCounterBits, iCounterLen);  // decide the counter field
+        int64_t counterValue = Bits2Num<int64_t>(ary_cCounterBits, iCounterLen);  // convert the counter bits to equivalent number
+        Index_PacketStart += iCounterLen*iSamplesPerBit;  // update packet index to point to data section
 
-          #ifdef _ARRAY_MODE_
-          std::cout << "Remove_Header_impl: Output = ";
-          DisplayArray<char>(out, noutput_items, 0);  // display input array
-          std::cout << std::endl;
-          if(bSpBConnected == true)  // if SpB is to transferred
+        int iDataLen = N_out;  // packet data samples
+        if (iLengthLen != 0)  // the header gives the data length
+        {
+          char ary_cLengthBits[LENGTH_BITS];  // length field bits
+          this->ReadField(in, Index_PacketStart, ary_cLengthBits, iLengthLen);  // decide the length field
+          iDataLen = this->LengthItems(Bits2Num<int>(ary_cLengthBits, iLengthLen));  // data items of the length field; -1 if not whole bytes
+          Index_PacketStart += iLengthLen*iSamplesPerBit;  // update packet index to point to data section
+          if ((iDataLen < 0) || (iDataLen > iPacketSize))  // not a real header, or a corrupted one
           {
-            std::cout << "Remove_Header_impl: SpB = ";
-            DisplayArray<char>(out_SpB, noutput_items, 0);  // display input array
-            std::cout << std::endl;
+            TRACE(unique_id(), TRC_REJECT, 3, index_M, iDataLen, iPacketSize);  // length field is not valid; header is ignored
+            this->count(iPerfMisses);  // header is missed
+            this->LoseSync(index_M);  // search again after this header
+            Index_PacketStart = index_M + 1;
+            continue;
           }
-          #endif
-          
-          index_M = MatchBitSeq<char>((in + Index_PacketStart), ptr_cHeaderPattern, ptr_cAuxPattern, numInput - Index_PacketStart, N_headerPattern); // find first matching index
-          if(index_M == -1)  // no more match is found
+          if ((index_M + N_header + iDataLen*iDataScale + iCrcLen*iSamplesPerBit) > numInput)  // packet is not complete
           {
+            Index_PacketStart = index_M;  // look at it in the next call
             break;  // leave the loop
           }
-          Index_PacketStart += index_M;  // adjust the input index
-          if((totNumInput - Index_PacketStart) < N_in)  // if no more packet is available
+        }
+        index_First = (index_First == -1) ? index_M : index_First;  // first header of this call
+
+        int iFlow = 0;  // flow of the packet
+        if (iNumOfFlows > 1)  // label is not in the pattern; the label field selects the flow
+        {
+          iFlow = this->FindFlow(in, index_M + iPreambleLen*iSamplesPerBit);  // flow of the label
+          if (iFlow == -1)  // packet of no flow; the header still keeps the lock
           {
-            break;  // leave the loop
+            Index_PacketStart += iDataLen*iDataScale + iCrcLen*iSamplesPerBit;  // go to the next packet
+            continue;
+          }
+        }
+        int iOffset = vFlowOffsets[iFlow];  // output index of the packet in its flow
+
+        TRACE(unique_id(), TRC_PACKET, index_B, Index_PacketStart, int(counterValue));  // header parsed; lowest counter bits
+        this->count(iPerfPackets);  // one more packet
+
+        bool bCrcOk = (iCrcLen == 0) || this->CheckCrc(in, Index_PacketStart, iDataLen, counterValue);  // packet integrity
+        if ((bCrcOk == false) && (bTagMode == false) && (bPduMode == false))  // the streams have no room for the result; bad packet is dropped
+        {
+          if (bSkipInvalid == false)  // dropped packet has an output
+          {
+            this->MarkPacket(sync, counter, iOffset, -1);  // output packet is not valid
+            this->add_item_tag(iFlow, this->nitems_written(iFlow) + iOffset, pmtCrcOk, pmt::from_bool(false));  // tells a CRC error from a missed header
+            vFlowOffsets[iFlow] += N_out;
+            iNumOfProduced += N_out;
+            ++index_B;  // next output packet
           }
+          Index_PacketStart += iDataLen*iDataScale + iCrcLen*iSamplesPerBit;  // update packet index to point to end of packet
+          continue;
+        }
+        this->MarkPacket(sync, counter, iOffset, counterValue, iFlow);  // set sync pulse and counter output
+        if ((bPduMode == false) && (iCrcLen != 0))  // CRC result goes with the packet start
+        {
+          this->add_item_tag(iFlow, this->nitems_written(iFlow) + iOffset, pmtCrcOk, pmt::from_bool(bCrcOk));  // CRC check result
+        }
+        if ((bTagMode == true) && (bPduMode == false) && (iLengthLen != 0))  // packet length goes with the packet start
+        {
+          this->add_item_tag(iFlow, this->nitems_written(iFlow) + iOffset, pmtLength, pmt::from_long(iDataLen));  // packet length
+        }
 
+        if(bPduMode == true)  // data goes out as a message
+        {
+          this->PublishPacket(in, Index_PacketStart, iDataLen, counterValue, index_M - iExpected, bCrcOk, iFlow);  // send the packet
+        }
+        else
+        {
+          this->CopyData(in, Index_PacketStart, ((char *) output_items[iFlow] + iOffset), iDataLen);  // insert data into the output array of the flow
         }
 
-        #ifdef _DEBUG_MODE_
-        std::cout << "------------------------------------------" << std::endl;
-        std::cout << std::endl << "Remove_Header_impl: DSP main loop: End" << std::endl;
+        if(bSpBConnected == true)  // if SpB is to transferred
+        {
+          CopyArrays<char>((in_SpB + Index_PacketStart/iDataScale), (out_SpB + iOffset), iDataLen);  // insert SpB into the output array; one value per input byte in packed mode
+        }
+
+        Index_PacketStart += iDataLen*iDataScale + iCrcLen*iSamplesPerBit;  // update packet index to point to end of packet; the next header is expected here
+        vFlowOffsets[iFlow] += iDataLen;  // next output packet of the flow
+        iNumOfProduced += iDataLen;
+        ++index_B;  // next output packet
+
+        #ifdef _ARRAY_MODE_
+        std::cout << "Remove_Header_impl: Output = ";
+        DisplayArray<char>(out, ((out != nullptr) ? noutput_items : 0), 0);  // display output array; none in PDU mode
+        std::cout << std::endl;
+        if(bSpBConnected == true)  // if SpB is to transferred
+        {
+          std::cout << "Remove_Header_impl: SpB = ";
+          DisplayArray<char>(out_SpB, noutput_items, 0);  // display input array
+          std::cout << std::endl;
+        }
         #endif
+      }
 
+      if (index_First != -1)  // a header is found
+      {
+        TRACE(unique_id(), TRC_MATCH, index_First, index_B);  // headers found
       }
       else  // if a match is not found
       {
-
-        #ifdef _DEBUG_MODE_
-        std::cout << "Remove_Header_impl: No match found!" << std::endl;
-        #endif
-        FillArray<int>(counter, -1, noutput_items);  // indicate loss of sync
-
-        Index_PacketStart = numInput;  // total number of items being analysed
+        TRACE(unique_id(), TRC_MATCH, -1, 0);  // no header found
       }
 
-      #ifdef _DEBUG_MODE_
-      std::cout << "Remove_Header_impl: Total processed item = " << Index_PacketStart << ", " << numInput << std::endl;
-      #endif
+      // consume up to the first packet not processed; it stays in the input buffer for the next call
+      int iNumOfCarried = (iSyncState == SYNC_HUNT) ? 0 : CONSTRAIN(SYNC_TOL_BITS*iSamplesPerBit, 0, Index_PacketStart);  // room for a header that comes early
+      int iNumOfConsumed = CONSTRAIN(Index_PacketStart - iNumOfCarried, 0, numInput)/iDataScale;  // number of consumed inputs; whole bytes in packed mode
+      int iNumOfProdOutput = (bPduMode == true) ? 0 : iNumOfProduced;  // number of produced outputs; none in PDU mode
+      iNextHeader = Index_PacketStart - iNumOfConsumed*iDataScale;  // expected header position in the next call; with the bits left of a byte in packed mode
+
+      TRACE(unique_id(), TRC_WORK_EXIT, iNumOfProdOutput, iNumOfConsumed);  // work returns
 
       #ifdef _ARRAY_MODE_
       std::cout << "Remove_Header_impl: Final output = ";
-      DisplayArray<char>(out, noutput_items, 0);  // display input array
+      DisplayArray<char>(out, iNumOfProdOutput, 0);  // display input array
       std::cout << std::endl;
       if(bSpBConnected == true)  // if SpB is to transferred
       {
         std::cout << "Remove_Header_impl: Final SpB = ";
-        DisplayArray<char>(out_SpB, noutput_items, 0);  // display input array
+        DisplayArray<char>(out_SpB, iNumOfProdOutput, 0);  // display input array
         std::cout << std::endl;
       }
       #endif
@@ -472,14 +875,25 @@ namespace gr {
       // Tell runtime system how many input items we consumed on
       // each input stream.
 
-      consume_each (totNumInput);
+      consume_each (iNumOfConsumed);
 
       #ifdef _FLOW_MODE_
       std::cout << "Remove_Header_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
       #endif
 
+      PerfTimer.set_Items(iNumOfConsumed, iNumOfProdOutput);  // items of this call
+
+      if ((iNumOfFlows > 1) && (bPduMode == false))  // each flow output has its own number of packets
+      {
+        for(int index_f = 0; index_f < iNumOfFlows; ++index_f)  // go through the flows
+        {
+          produce(index_f, vFlowOffsets[index_f]);
+        }
+        return WORK_CALLED_PRODUCE;
+      }
+
       // Tell runtime system how many output items we produced.
-      return noutput_items;
+      return iNumOfProdOutput;
     }
 
   } /* namespace Hybrid_Comm */
@@ -22,11 +22,15 @@
 #define INCLUDED_HYBRID_COMM_REMOVE_HEADER_IMPL_H
 
 #include <Hybrid_Comm/Remove_Header.h>
+#include <Comm_Kernels/perf_block.h>
+#include <algorithm>
+#include <Comm_Kernels/bit_correlator.h>
+#include <unordered_map>
 
 namespace gr {
   namespace Hybrid_Comm {
 
-    class Remove_Header_impl : public Remove_Header
+    class Remove_Header_impl : public Remove_Header, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -35,7 +39,10 @@ namespace gr {
       char *ptr_cLabel;  // packet label array
       char *ptr_cLabelBits;  // packet label bit sequence
       int iLabelLen;  // packet label array length
-      int iSamplesPerBit;  // samples per bit of the header
+      int iSamplesPerBit;  // samples per bit of the header; 1 in packed mode
+      int iChannelSpB;  // samples per bit on the channel
+      bool bPacked;  // input and output bytes of 8 bits
+      int iDataScale;  // input samples per output item; 8 bits per byte in packed mode
       int iPacketSize;  // packet data samples length
       int iCounter;  // packet counter
       char *ptr_cPreambleSeq;  // preamble resampled bit sequence
@@ -44,27 +51,106 @@ namespace gr {
 
       char *ary_cCounterBits;  // counter bit sequence
 
-      char *ptr_cAuxStorage;  // auxillary storage array
-      int iStoredSampLen;  // stored samples array length
-      bool bStorageLoaded;  // flag to show that storage is loaded with data from previous section
       char *ptr_cHeaderPattern;  // header pattern sequence
       char *ptr_cAuxPattern;  // auxillary pattern sequence
+      Comm_Kernels::Bit_Correlator Correlator;  // bit-parallel header pattern search
+      int iSyncState;  // header sync state; SYNC_HUNT, SYNC_VERIFY or SYNC_LOCK
+      int iSyncHits;  // headers found at the expected position while verifying
+      int iSyncMisses;  // consecutive headers missed at the expected position
+      int iMaxMisses;  // consecutive missed headers before lock is lost
+      int iNextHeader;  // expected position of the next header in the input of the next call
+      uint64_t iLastHeader;  // absolute input position of the last header counted by the sync state machine
+      pmt::pmt_t pmtPreambleStart;  // upstream preamble tag key
+      std::vector<gr::tag_t> vTags;  // upstream preamble tags of the input
+      std::vector<int> vPreambleStarts;  // input positions of the upstream preamble tags of this call
+      int iTagMaxErr;  // mismatching header pattern samples accepted at an upstream preamble tag
+      bool bTagMode;  // packet starts and counters are stream tags instead of streams
+      pmt::pmt_t pmtPacketStart;  // packet start tag key
+      pmt::pmt_t pmtSeq;  // packet counter tag key
+      bool bPduMode;  // packets go out as messages instead of streams
+      std::vector<pmt::pmt_t> vpmtPduPorts;  // PDU message port id of each flow
+      std::vector<pmt::pmt_t> vpmtLabels;  // packet label of each flow; PDU metadata
+      std::vector<unsigned char> vPduBytes;  // packed data of a PDU
+      std::vector<unsigned char> vCrcBytes;  // packed data bits of a packet for the CRC
+      int iCounterLen;  // counter field length
+      int iCrcLen;  // CRC field length; 0 without the field
+      pmt::pmt_t pmtCrcOk;  // CRC check result tag key
+      int iLengthLen;  // length field length; 0 without the field
+      pmt::pmt_t pmtLength;  // packet length tag key
+      int iNumOfFlows;  // number of labelled flows (outputs or PDU ports); 1 with a single label
+      std::unordered_map<std::string, int> mapFlows;  // flow index of each label
+      std::vector<char> vLabelFieldBits;  // label field bits of a received header
+      std::string sLabelField;  // label field of a received header
+      std::vector<int> vFlowOffsets;  // output samples of each flow in a work call
+      int iPerfPackets;  // performance counter: deframed packets
+      int iPerfSyncLosses;  // performance counter: locks lost
+      int iPerfMisses;  // performance counter: headers missed at the expected position
+      int iPerfSearches;  // performance counter: full header searches
+      int iPerfCrcErrors;  // performance counter: packets with a CRC error
+      int iPerfUnknown;  // performance counter: packets with a label of no flow
       #ifdef _FLOW_MODE_
       int iFlowCounter;  // flow debugging counter
       #endif
 
       static const std::vector<int> iov;  // io signature
+      static const std::vector<int> iovTag;  // io signature in tag mode
       
       static const std::vector<char> defPreamb;  // default preamble
       static const std::string defLabel;  // default packet label
-      static const int iCounterLen;  // counter field length
       static const int iLabelBitsPerLet;  // label bits per letters
       static const int iNumOfOutputMultiple;  // number of input items multiple
 
      public:
-      Remove_Header_impl(int packetSize = PACKET_SAMP_SIZE, const std::vector<char>& preamble = defPreamb, const std::string& label = defLabel, int samplesPerBit = 1);
+      Remove_Header_impl(int packetSize = PACKET_SAMP_SIZE, const std::vector<char>& preamble = defPreamb, const std::string& label = defLabel, int samplesPerBit = 1, bool tagMode = false, bool pduMode = false, bool crc = false, bool lengthField = false, int seqBits = COUNTER_BITS, bool packed = false);
       ~Remove_Header_impl();
       void ConfigureHeaderSize(void);  // configure header size based on the new pattern
+      int FindHeader(int iExpected);  // next header from the expected position; runs the sync state machine. -1 if none, SYNC_WAIT if it may be past the input
+      int FindTagged(int iStart, int iStop);  // header at an upstream preamble tag in [iStart, iStop); -1 if none
+      void SetSyncState(int iState, int iIndex);  // move the sync state machine to a new state
+      void LoseSync(int iIndex);  // back to the full search; a lost lock is counted
+      void MarkPacket(char *sync, int *counter, int iOffset, int64_t counterValue, int iFlow = 0);  // sync pulse and counter, or tags, of an output packet
+      void PublishPacket(const char *in, int iIndex, int iDataLen, int64_t counterValue, int iOffset, bool bCrcOk, int iFlow = 0);  // send the data of a packet from the PDU port of its flow
+      int FindFlow(const char *in, int iIndex);  // flow index of a received label field; -1 if no flow has the label
+      static int CountLabels(const std::string& label);  // number of labels in a label list
+      bool CheckCrc(const char *in, int iIndex, int iDataLen, int64_t counterValue);  // check the CRC field after the data
+      void ReadField(const char *in, int iIndex, char *ptr_cBits, int iNumOfBits);  // decided bits of a header field
+      void CopyData(const char *in, int iIndex, char *ptr_cOut, int iDataLen);  // data items of a packet
+
+      // Length field value of a packet of 'iDataLen' data items; payload bits in PDU mode, its samples on the channel otherwise
+      int LengthValue(int iDataLen) const
+      {
+        if (bPduMode == true)  // whole bytes; the bits do not depend on the samples per bit
+        {
+          return (bPacked == true) ? 8*iDataLen : iDataLen/iSamplesPerBit;
+        }
+        return (bPacked == true) ? iDataLen*8*iChannelSpB : iDataLen;
+      }
+
+      // Longest packet the length field holds, in data items; whole bytes in PDU mode
+      int LengthMaxItems(void) const
+      {
+        const int iMaxValue = (1 << iLengthLen) - 1;  // largest field value
+        if (bPduMode == true)  // payload bits
+        {
+          return (bPacked == true) ? iMaxValue/8 : (iMaxValue/8)*8*iSamplesPerBit;
+        }
+        return (bPacked == true) ? iMaxValue/(8*iChannelSpB) : iMaxValue;
+      }
+
+      // Data items of a length field value; -1 if it is not whole bytes in PDU and packed modes
+      int LengthItems(int iLengthValue) const
+      {
+        const int iLengthUnit = (bPduMode == true) ? 8 : this->LengthValue(1);  // field value of the smallest packet step
+        if ((bPduMode == false) && (bPacked == false))  // data samples
+        {
+          return iLengthValue;
+        }
+        if ((iLengthValue % iLengthUnit) != 0)  // not whole bytes
+        {
+          return -1;
+        }
+        return ((bPduMode == true) && (bPacked == false)) ? iLengthValue*iSamplesPerBit : iLengthValue/iLengthUnit;
+      }
 
 
       // Where all the action really happens
@@ -75,6 +161,12 @@ namespace gr {
            gr_vector_const_void_star &input_items,
            gr_vector_void_star &output_items);
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set preamble
       void set_Preamble(const std::vector<char>& preamble)
       {
@@ -84,13 +176,15 @@ namespace gr {
           ptr_cPreamble = nullptr;  // label the array as empty
         }
 
-        iPreambleLen = preamble.size();  // update new number of preamble samples
+        int iPadLen = (bPacked == true) ? (8 - int(preamble.size())%8)%8 : 0;  // packed headers are whole bytes; '0's before the preamble
+        iPreambleLen = preamble.size() + iPadLen;  // update new number of preamble samples
 
         ptr_cPreamble = new char [iPreambleLen];  // get the array memory
 
-        for(int index = 0; index < iPreambleLen; ++index)  // go through the array
+        FillArray<char>(ptr_cPreamble, VAL_0, iPadLen);  // leading '0's
+        for(int index = iPadLen; index < iPreambleLen; ++index)  // go through the array
         {
-          ptr_cPreamble[index] = preamble[index];  // update the element
+          ptr_cPreamble[index] = preamble[index - iPadLen];  // update the element
         }
         
         #ifdef _DEBUG_MODE_
@@ -127,9 +221,19 @@ namespace gr {
         #endif
       }
 
-      // Set packet label
-      void set_Label(const std::string& label)
+      // Set packet label; a list of labels separated by LABEL_SEP gives the label of each flow
+      void set_Label(const std::string& labels)
       {
+        std::vector<std::string> vLabels;  // label of each flow
+        for(std::string::size_type iStart = 0; iStart <= labels.length(); )  // go through the list
+        {
+          std::string::size_type iEnd = labels.find(LABEL_SEP, iStart);  // end of this label
+          iEnd = (iEnd == std::string::npos) ? labels.length() : iEnd;
+          vLabels.push_back(labels.substr(iStart, iEnd - iStart));
+          iStart = iEnd + 1;  // next label
+        }
+        const std::string& label = vLabels[0];  // the first label sets the label field length
+
         if (ptr_cLabel != nullptr)  // if the array is free
         {
           delete[] ptr_cLabel;  // release the array
@@ -147,6 +251,23 @@ namespace gr {
 
         std::strcpy(ptr_cLabel, label.c_str());  // copy the string to char array
 
+        mapFlows.clear();  // labels of the flows
+        vpmtLabels.assign(iNumOfFlows, pmt::string_to_symbol(label));
+        for(int index_f = 0; index_f < std::min<int>(iNumOfFlows, vLabels.size()); ++index_f)  // go through the flows; there is no output for the extra labels
+        {
+          if (vLabels[index_f].length() != (unsigned) iLabelLen)  // label field has the length of the first label
+          {
+            #ifdef _DEBUG_MODE_
+            std::cout << "Remove_Header_impl: Label \"" << vLabels[index_f] << "\" is ignored; its length is not " << iLabelLen << std::endl;
+            #endif
+            continue;
+          }
+          mapFlows.emplace(vLabels[index_f], index_f);  // the first flow with the label gets its packets
+          vpmtLabels[index_f] = pmt::string_to_symbol(vLabels[index_f]);  // label of the PDUs of the flow
+        }
+        vLabelFieldBits.resize(iLabelLen*iLabelBitsPerLet);
+        sLabelField.resize(iLabelLen);
+
         for(int index_l = 0; index_l < iLabelLen; ++index_l)  // go through the array
         {
           Num2Bits<char>(ptr_cLabel[index_l], ( ptr_cLabelBits + index_l*iLabelBitsPerLet ), iLabelBitsPerLet);  // convert the letter to bit sequence
@@ -221,9 +342,10 @@ namespace gr {
         #ifdef _THREAD_MUTEX_
         gr::thread::scoped_lock dummy(d_mutex_delay);  //  create a mutex lock for the current scope#
         #endif
-        iSamplesPerBit = CONSTRAIN(samplesPerBit, 1, INT_MAX);
+        iChannelSpB = CONSTRAIN(samplesPerBit, 1, INT_MAX);
+        iSamplesPerBit = (bPacked == true) ? 1 : iChannelSpB;  // packed headers have one sample per bit
         #ifdef _DEBUG_MODE_
-        std::cout << "Remove_Header_impl: Samples per bit = " << iSamplesPerBit << std::endl;
+        std::cout << "Remove_Header_impl: Samples per bit = " << iChannelSpB << std::endl;
         #endif
 
         this->ConfigureHeaderSize();  // configure header size based on the new pattern
@@ -233,9 +355,9 @@ namespace gr {
       int get_SamplesPerBit(void)
       {
         #ifdef _DEBUG_MODE_
-        std::cout << "Remove_Header_impl: Samples per bit = " << iSamplesPerBit << std::endl;
+        std::cout << "Remove_Header_impl: Samples per bit = " << iChannelSpB << std::endl;
         #endif
-        return iSamplesPerBit;
+        return iChannelSpB;
       }
 
       // Set packet data samples length
@@ -244,7 +366,11 @@ namespace gr {
         #ifdef _THREAD_MUTEX_
         gr::thread::scoped_lock dummy(d_mutex_delay);  //  create a mutex lock for the current scope#
         #endif
-        iPacketSize = CONSTRAIN(packetSize, 1, INT_MAX);
+        iPacketSize = CONSTRAIN(packetSize, 1, (iLengthLen != 0) ? this->LengthMaxItems() : INT_MAX);  // the length field holds the longest packet; a larger size is rejected by the constructor
+        if ((bPduMode == true) && (bPacked == false))  // PDUs are whole bytes; so is the longest packet
+        {
+          iPacketSize = std::max(iPacketSize - iPacketSize % (8*iSamplesPerBit), 8*iSamplesPerBit);
+        }
         this->set_output_multiple(iPacketSize);
         #ifdef _DEBUG_MODE_
         std::cout << "Remove_Header_impl: Packet data samples length = " << iPacketSize << std::endl;
@@ -262,6 +388,84 @@ namespace gr {
         return iPacketSize;
       }
 
+      // Set number of consecutive missed headers before lock is lost
+      void set_MaxMisses(int maxMisses)
+      {
+        iMaxMisses = CONSTRAIN(maxMisses, 1, INT_MAX);
+        #ifdef _DEBUG_MODE_
+        std::cout << "Remove_Header_impl: Maximum missed headers = " << iMaxMisses << std::endl;
+        #endif
+      }
+
+      // Get number of consecutive missed headers before lock is lost
+      int get_MaxMisses(void)
+      {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Remove_Header_impl: Maximum missed headers = " << iMaxMisses << std::endl;
+        #endif
+        return iMaxMisses;
+      }
+
+      // Get tag mode
+      bool get_TagMode(void)
+      {
+        return bTagMode;
+      }
+
+      // Get PDU mode
+      bool get_PduMode(void)
+      {
+        return bPduMode;
+      }
+
+      // Get number of labelled flows
+      int get_NumOfFlows(void)
+      {
+        return iNumOfFlows;
+      }
+
+      // Get counter field length
+      int get_SeqBits(void)
+      {
+        return iCounterLen;
+      }
+
+      // Set CRC field
+      void set_Crc(bool crc)
+      {
+        #ifdef _THREAD_MUTEX_
+        gr::thread::scoped_lock dummy(d_mutex_delay);  //  create a mutex lock for the current scope#
+        #endif
+        iCrcLen = crc ? CRC_BITS : 0;
+        #ifdef _DEBUG_MODE_
+        std::cout << "Remove_Header_impl: CRC field is " << ((iCrcLen != 0) ? "on" : "off") << std::endl;
+        #endif
+      }
+
+      // Get CRC field
+      bool get_Crc(void)
+      {
+        return (iCrcLen != 0);
+      }
+
+      // Get length field
+      bool get_LengthField(void)
+      {
+        return (iLengthLen != 0);
+      }
+
+      // Get header sync state
+      int get_SyncState(void)
+      {
+        return iSyncState;
+      }
+
+      // Get packed mode
+      bool get_Packed(void)
+      {
+        return bPacked;
+      }
+
     };
 
   } // namespace Hybrid_Comm
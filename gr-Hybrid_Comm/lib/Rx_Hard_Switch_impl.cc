@@ -44,6 +44,8 @@ namespace gr {
               gr::io_signature::make3(3, 3, sizeof(char), sizeof(char), sizeof(float)),
               gr::io_signature::make(1, 2, sizeof(char)))
     {
+      this->setup_Stats(this);  // register the stats message port
+
       #ifdef _FLOW_MODE_
       iFlowCounter = 0;
       #endif
@@ -72,6 +74,8 @@ namespace gr {
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       #ifdef _FLOW_MODE_
       std::cout << "Rx_Hard_Switch_impl: Entry: Counter = " << iFlowCounter << std::endl;
       #endif
@@ -134,6 +138,8 @@ namespace gr {
       std::cout << "Rx_Hard_Switch_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
       #endif
 
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
@@ -22,11 +22,12 @@
 #define INCLUDED_HYBRID_COMM_RX_PARALLEL_SWITCH_IMPL_H
 
 #include <Hybrid_Comm/Rx_Parallel_Switch.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace Hybrid_Comm {
 
-    class Rx_Parallel_Switch_impl : public Rx_Parallel_Switch
+    class Rx_Parallel_Switch_impl : public Rx_Parallel_Switch, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -48,6 +49,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set packet size
       void set_PacketSize(int packetsize)
       {
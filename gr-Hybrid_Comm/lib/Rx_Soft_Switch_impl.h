@@ -22,11 +22,12 @@
 #define INCLUDED_HYBRID_COMM_RX_SOFT_SWITCH_IMPL_H
 
 #include <Hybrid_Comm/Rx_Soft_Switch.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace Hybrid_Comm {
 
-    class Rx_Soft_Switch_impl : public Rx_Soft_Switch
+    class Rx_Soft_Switch_impl : public Rx_Soft_Switch, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -55,6 +56,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set packet size
       void set_PacketSize(int packetsize)
       {
@@ -22,13 +22,14 @@
 #define INCLUDED_HYBRID_COMM_SIGNAL_QUALITY_METRE_IMPL_H
 
 #include <Hybrid_Comm/Signal_Quality_Metre.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace Hybrid_Comm {
 
     enum MeasType {Ps = 0, Pn = 1, SNR = 2, QF = 3};    
 
-    class Signal_Quality_Metre_impl : public Signal_Quality_Metre
+    class Signal_Quality_Metre_impl : public Signal_Quality_Metre, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -61,6 +62,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
 
       // Set samples per symbol
       void set_SampsPerSymb(int sampPerSymb)
@@ -65,6 +65,8 @@ namespace gr {
      */
     Slicer_impl::~Slicer_impl()
     {
+      this->setup_Stats(this);  // register the stats message port
+
     }
 
     int
@@ -72,6 +74,8 @@ namespace gr {
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       #ifdef _FLOW_MODE_
       std::cout << "Slicer_impl: Entry: Counter = " << iFlowCounter << std::endl;
       #endif
@@ -127,6 +131,8 @@ namespace gr {
       std::cout << "Slicer_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
       #endif
       
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
@@ -22,11 +22,12 @@
 #define INCLUDED_HYBRID_COMM_SLICER_IMPL_H
 
 #include <Hybrid_Comm/Slicer.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace Hybrid_Comm {
 
-    class Slicer_impl : public Slicer
+    class Slicer_impl : public Slicer, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -50,6 +51,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set averaging window size
       void set_AvgWinSize(int avgWinSize)
       {
@@ -29,10 +29,10 @@ namespace gr {
   namespace Hybrid_Comm {
 
     Source_BV::sptr
-    Source_BV::make(int winSize, std::string signalType)
+    Source_BV::make(int winSize, std::string signalType, int seed, int streamId, bool packed)
     {
       return gnuradio::get_initial_sptr
-        (new Source_BV_impl(winSize, signalType));
+        (new Source_BV_impl(winSize, signalType, seed, streamId, packed));
     }
 
     const std::string Source_BV_impl::strConstant = CNT_STR;
@@ -41,11 +41,13 @@ namespace gr {
     /*
      * The private constructor
      */
-    Source_BV_impl::Source_BV_impl(int packetSize, std::string signalType)
+    Source_BV_impl::Source_BV_impl(int packetSize, std::string signalType, int seed, int streamId, bool packed)
       : gr::sync_block("Source_BV",
               gr::io_signature::make(1, 1, sizeof(char)),
-              gr::io_signature::make(1, 2, sizeof(char))), iBitsPerPack(1), RandGen()
+              gr::io_signature::make(1, 2, sizeof(char))), iBitsPerPack(1), bPacked(packed), RandGen()
     {
+      this->setup_Stats(this);  // register the stats message port
+
       #ifdef _FLOW_MODE_
       iFlowCounter = 0;
       #endif
@@ -56,6 +58,11 @@ namespace gr {
       this->set_PacketSize(packetSize);  // set packet size
       this->set_SignalType(signalType);  // set signal type
 
+      if(seed >= 0)  // reproducible mode
+      {
+        RandGen.set_Seed(seed, streamId);  // start from the given substream
+      }
+
       #ifdef _FLOW_MODE_
       std::cout << "Source_BV_impl: Packet size = " << iPacketSize << std::endl;
       #endif
@@ -73,6 +80,8 @@ namespace gr {
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       #ifdef _FLOW_MODE_
       std::cout << "Source_BV_impl: Entry: Counter = " << iFlowCounter << std::endl;
       #endif
@@ -106,7 +115,7 @@ namespace gr {
       // Do <+signal processing+>
       if(cSignalType == Constant)  // if the signal type is constant
       {
-        FillArray<char>(out, VAL_1, noutput_items);  // fill the output array with constant
+        FillArray<char>(out, (bPacked ? char(0xFF) : VAL_1), noutput_items);  // fill the output array with constant; all the bits of a byte
 
         for(int index = 0; index < NoP; ++index)  // go through the packets
         {
@@ -121,10 +130,22 @@ namespace gr {
         int InterpRatio = 1;  // window size to number of required bits ratio
         int Index_Out = 0;  // starting index of output chunck
 
-        ptr_cRandSig = new char [iPacketSize];  // create dummy array assuming 'InterpRatio = 1'
+        ptr_cRandSig = new char [bPacked ? 8*iPacketSize : iPacketSize];  // create dummy array assuming 'InterpRatio = 1'
 
         for(int index = 0; index < NoP; ++index)  // go through the packets
         {
+          if(bPacked == true)  // every bit once; 8 per output byte
+          {
+            iBitsPerPack = 8*iPacketSize;
+            RandGen.UniformBinary(ptr_cRandSig, iBitsPerPack);  // the bits of an unpacked packet of the same bits
+            PackBits(ptr_cRandSig, (unsigned char *)(out + index*iPacketSize), iPacketSize);  // first bit in the most significant bit
+            if(bSpBConnected == true)  // if SpB is to transferred
+            {
+              FillArray<char>((out_SpB + index*iPacketSize), SpB[index*iPacketSize], iPacketSize);  // fill SpB with input value
+            }
+            continue;
+          }
+
           iBitsPerPack = iPacketSize/SpB[index*iPacketSize];  // update bits per window based on the 1st element in the input 'samples per bit' array
 
           InterpRatio = iPacketSize/iBitsPerPack;  // number of required bits (source sample)
@@ -193,6 +214,8 @@ namespace gr {
       std::cout << "Source_BV_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
       #endif
 
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
@@ -22,13 +22,14 @@
 #define INCLUDED_HYBRID_COMM_SOURCE_BV_IMPL_H
 
 #include <Hybrid_Comm/Source_BV.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace Hybrid_Comm {
 
     enum SigType {Constant = 0, Random = 1};
     
-    class Source_BV_impl : public Source_BV
+    class Source_BV_impl : public Source_BV, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -36,6 +37,7 @@ namespace gr {
       char cSignalType;  // signal type
       int iBitsPerPack;  // current bits per package
       char *ptr_cRandSig;  // random signal array
+      bool bPacked;  // output bytes of 8 bits
       #ifdef _THREAD_MUTEX_
       gr::thread::mutex d_mutex_delay;  // thread safety mutex
       #endif
@@ -48,7 +50,7 @@ namespace gr {
       static const std::string strRandom;
 
      public:
-      Source_BV_impl(int packetSize = PACKET_SAMP_SIZE, std::string signalType = strConstant);
+      Source_BV_impl(int packetSize = PACKET_SAMP_SIZE, std::string signalType = strConstant, int seed = DEF_SEED, int streamId = DEF_STREAM_ID, bool packed = false);
       ~Source_BV_impl();
 
       // Where all the action really happens
@@ -58,6 +60,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
 
       // Set packet size
       void set_PacketSize(int packetSize)
@@ -99,6 +107,12 @@ namespace gr {
         return (cSignalType == Constant) ? strConstant : strRandom;
       }
 
+      // Get packed mode
+      bool get_Packed(void)
+      {
+        return bPacked;
+      }
+
     };
 
   } // namespace Hybrid_Comm
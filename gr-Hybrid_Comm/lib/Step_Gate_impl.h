@@ -22,11 +22,12 @@
 #define INCLUDED_HYBRID_COMM_STEP_GATE_IMPL_H
 
 #include <Hybrid_Comm/Step_Gate.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace Hybrid_Comm {
 
-    class Step_Gate_impl : public Step_Gate
+    class Step_Gate_impl : public Step_Gate, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -52,6 +53,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set packet size
       void set_PacketSize(int packetsize)
       {
@@ -23,30 +23,69 @@
 #endif
 
 #include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <stdexcept>
 #include "Stream_Aligner_impl.h"
 
 namespace gr {
   namespace Hybrid_Comm {
 
     Stream_Aligner::sptr
-    Stream_Aligner::make(int packetSize)
+    Stream_Aligner::make(int packetSize, bool tagMode, int seqBits, int bufferDepth, bool zeroCopy, int numOfLinks, bool jitterMode)
     {
       return gnuradio::get_initial_sptr
-        (new Stream_Aligner_impl(packetSize));
+        (new Stream_Aligner_impl(packetSize, tagMode, seqBits, bufferDepth, zeroCopy, numOfLinks, jitterMode));
     }
 
-    const std::vector<int> Stream_Aligner_impl::iov = {sizeof(char), sizeof(char), sizeof(int), sizeof(char), sizeof(char), sizeof(int)};  // io signature
+    const std::vector<int> Stream_Aligner_impl::iov = {sizeof(char), sizeof(char), sizeof(int)};  // io signature of a link; data, sync and counter
+    const std::vector<int> Stream_Aligner_impl::iovTag = {sizeof(char)};  // io signature of a link in tag mode; no sync and counter streams
     const int Stream_Aligner_impl::iMaxInBufCoeff = 2;  // maximum input items buffer coefficient; this code is only writen for upto 2 packets
 
 
     /*
      * The private constructor
      */
-    Stream_Aligner_impl::Stream_Aligner_impl(int packetSize)
-      : gr::sync_block("Stream Aligner",
-              gr::io_signature::makev(6, 6, iov),
-              gr::io_signature::make(2, 3, sizeof(char))), Buffer(packetSize), bBufStored(false)
+    Stream_Aligner_impl::Stream_Aligner_impl(int packetSize, bool tagMode, int seqBits, int bufferDepth, bool zeroCopy, int numOfLinks, bool jitterMode)
+      : gr::block("Stream Aligner",
+              gr::io_signature::makev(int(InputSignature(tagMode, numOfLinks).size()), int(InputSignature(tagMode, numOfLinks).size()), InputSignature(tagMode, numOfLinks)),
+              gr::io_signature::make(CONSTRAIN(numOfLinks, 2, ALIGNER_MAX_LINKS), CONSTRAIN(numOfLinks, 2, ALIGNER_MAX_LINKS) + 1, sizeof(char))), Buffer(packetSize, bufferDepth), bBufStored(false),
+              bTagMode(tagMode), iSeqBits(tagMode ? COUNTER_WIDTH(seqBits) : MIN(COUNTER_WIDTH(seqBits), COUNTER_STREAM_BITS)),
+              bZeroCopy(zeroCopy || (numOfLinks > 2)), iNumOfLinks(CONSTRAIN(numOfLinks, 2, ALIGNER_MAX_LINKS)),
+              bJitterMode(jitterMode), vDelayWindow(JITTER_WINDOW, 0), vDelaySorted(JITTER_WINDOW, 0), iWindowNext(-1), iJitterDelay(0),
+              pmtPacketStart(pmt::mp(PACKET_START_TAG)), pmtSeq(pmt::mp(SEQ_TAG))
     {
+      if((jitterMode == true) && ((zeroCopy == true) || (numOfLinks > 2)))  // the jitter buffer is part of the buffered alignment of two links
+      {
+        throw std::invalid_argument("Stream_Aligner: jitter mode needs the buffered alignment of 2 links (zeroCopy " + std::string(zeroCopy ? "on" : "off") + ", " + std::to_string(numOfLinks) + " links)");
+      }
+      if((zeroCopy == false) && (numOfLinks > 2))  // more links are aligned in zero-copy mode only
+      {
+        GR_LOG_INFO(d_logger, "Stream_Aligner: " + std::to_string(iNumOfLinks) + " links are aligned in zero-copy mode");
+      }
+
+      if((bTagMode == true) || (bZeroCopy == true))  // the packet tags are read here; the aligned outputs do not match the input offsets
+      {
+        this->set_tag_propagation_policy(TPP_DONT);
+      }
+
+      vLinkPos.assign(iNumOfLinks, 0);  // zero-copy mode link state
+      vLinkDelay.assign(iNumOfLinks, 0);
+      vAvailable.assign(iNumOfLinks, 0);
+      vCounter.assign(iNumOfLinks, 0);
+      vPmtCounter.assign(iNumOfLinks, pmt::PMT_NIL);
+      vHeadReady.assign(iNumOfLinks, 0);
+      vStartTags.resize(iNumOfLinks);
+      vSeqTags.resize(iNumOfLinks);
+      vStartNext.assign(iNumOfLinks, 0);
+      vSeqNext.assign(iNumOfLinks, 0);
+
+      this->setup_Stats(this);  // register the stats message port
+      iPerfOverflows = this->add_Counter("buffer_overflows");
+      iPerfDropped = this->add_Counter("packets_dropped");
+      iPerfLate = this->add_Counter("packets_late");
+      iPerfEarly = this->add_Counter("packets_early");
+      iPerfRealigns = this->add_Counter("realigns");
+
       #ifdef _FLOW_MODE_
       iFlowCounter = 0;
       #endif
@@ -68,85 +107,630 @@ namespace gr {
     {
     }
 
+    /*
+     * io signature of all links; the data, sync and counter inputs of each link in turn, or its data input in tag mode
+     */
+    std::vector<int> Stream_Aligner_impl::InputSignature(bool tagMode, int numOfLinks)
+    {
+      const std::vector<int> &vLink = tagMode ? iovTag : iov;  // inputs of a link
+      std::vector<int> vInputs;
+      for(int index_l = 0; index_l < CONSTRAIN(numOfLinks, 2, ALIGNER_MAX_LINKS); ++index_l)  // go through the links
+      {
+        vInputs.insert(vInputs.end(), vLink.begin(), vLink.end());
+      }
+      return vInputs;
+    }
+
+    /*
+     * Delay as given at the 'ctl' output; longer delays are saturated to its range
+     */
+    char Stream_Aligner_impl::CtlDelay(int iDelay)
+    {
+      return char(CONSTRAIN(iDelay, SCHAR_MIN, SCHAR_MAX));
+    }
+
+    /*
+     * First packet start within the first packet length of an input and its counter, from the stream tags
+     */
+    void Stream_Aligner_impl::FindPacketTag(int iInput, int &index_s, int64_t &counterValue)
+    {
+      uint64_t uStart = this->nitems_read(iInput);  // absolute index of the first input item
+      std::vector<tag_t> vTags;
+
+      index_s = iPacketSize;  // first packet start
+      this->get_tags_in_range(vTags, iInput, uStart, uStart + iPacketSize, pmtPacketStart);
+      for(const tag_t &tag : vTags)  // go through the packet starts
+      {
+        index_s = (int(tag.offset - uStart) < index_s) ? int(tag.offset - uStart) : index_s;
+      }
+      index_s = (index_s == iPacketSize) ? 0 : index_s;  // as with no sync pulse
+
+      counterValue = NO_SEQ_VAL;  // no counter; the packet is dropped
+      this->get_tags_in_range(vTags, iInput, uStart + index_s, uStart + index_s + 1, pmtSeq);
+      if(vTags.empty() == false)  // counter of the packet
+      {
+        counterValue = int64_t(pmt::to_long(vTags[0].value));
+      }
+    }
+
+    /*
+     * First packet start within the first packet length of a link and its counter
+     */
+    void Stream_Aligner_impl::FindPacketSync(int iLink, const gr_vector_const_void_star &input_items, int &index_s, int64_t &counterValue)
+    {
+      if(bTagMode == true)  // packet starts and counters are tags
+      {
+        this->FindPacketTag(iLink, index_s, counterValue);
+        return;
+      }
+
+      const char *sync = (const char *) input_items[LinkInput(iLink) + 1];
+      const int *counter = (const int *) input_items[LinkInput(iLink) + 2];
+
+      index_s = 0;  // as with no sync pulse
+      for(int index = 0; index < iPacketSize; ++index)  // go through first iPacketSize item
+      {
+        if(sync[index] == 1)  // if a sync pulse is found
+        {
+          index_s = index;  // update first sync pulse index
+          break;
+        }
+      }
+      counterValue = counter[index_s];  // first counter
+    }
+
+    /*
+     * Counter of the packet starting at an input index of a link; the counter tags of this call are walked in order
+     */
+    int64_t Stream_Aligner_impl::PacketCounter(int iLink, int iIndex, const gr_vector_const_void_star &input_items)
+    {
+      if(bTagMode == false)  // counter input
+      {
+        return ((const int *) input_items[LinkInput(iLink) + 2])[iIndex];
+      }
+
+      const uint64_t uOffset = this->nitems_read(iLink) + iIndex;  // absolute index of the packet start
+      const std::vector<tag_t> &vSeqs = vSeqTags[iLink];
+      while((vSeqNext[iLink] < vSeqs.size()) && (vSeqs[vSeqNext[iLink]].offset < uOffset))  // counters already passed
+      {
+        ++vSeqNext[iLink];
+      }
+      if((vSeqNext[iLink] < vSeqs.size()) && (vSeqs[vSeqNext[iLink]].offset == uOffset))  // counter of the packet
+      {
+        return int64_t(pmt::to_long(vSeqs[vSeqNext[iLink]].value));
+      }
+      return NO_SEQ_VAL;  // no counter; the packet is dropped
+    }
+
+    /*
+     * Add a delay observation to the window and return the median of the window; the first observation fills it
+     */
+    int Stream_Aligner_impl::UpdateDelay(int iObserved)
+    {
+      if(iWindowNext < 0)  // no observation yet
+      {
+        FillArray<int>(vDelayWindow.data(), iObserved, JITTER_WINDOW);
+        iWindowNext = 0;
+      }
+      vDelayWindow[iWindowNext] = iObserved;  // replace the oldest observation
+      iWindowNext = (iWindowNext + 1) % JITTER_WINDOW;
+
+      CopyArrays<int>(vDelayWindow.data(), vDelaySorted.data(), JITTER_WINDOW);
+      std::nth_element(vDelaySorted.begin(), vDelaySorted.begin() + JITTER_WINDOW/2, vDelaySorted.end());  // fixed window; the cost does not grow with the stream
+      return vDelaySorted[JITTER_WINDOW/2];
+    }
+
+    /*
+     * Empty the buffer bank and the counters of its packets; one counter per keyed slot
+     */
+    void Stream_Aligner_impl::ClearHeld(void)
+    {
+      Buffer.clear();
+      vHeldSeq.assign(size_t(Buffer.get_RingSize()), NO_SEQ_VAL);  // the capacity is kept
+    }
+
+    /*
+     * Hold a lead packet in the slot of its counter; a packet still in the slot was never paired and is dropped
+     */
+    int64_t Stream_Aligner_impl::PushHeld(const char *inArray, int64_t iSeq)
+    {
+      int64_t &iSlotSeq = vHeldSeq[size_t(uint64_t(iSeq) & uint64_t(vHeldSeq.size() - 1))];  // counter in the slot; the ring length is a power of two
+      int64_t iDropped = iSlotSeq;  // counter of the packet not paired
+      Buffer.store(uint64_t(iSeq), inArray);
+      iSlotSeq = iSeq;
+      return iDropped;
+    }
+
+    /*
+     * Take the held packet of a counter out of the buffer bank; false if it is not held
+     */
+    bool Stream_Aligner_impl::PopHeld(char *outArray, int64_t iSeq)
+    {
+      int64_t &iSlotSeq = vHeldSeq[size_t(uint64_t(iSeq) & uint64_t(vHeldSeq.size() - 1))];  // counter in the slot
+      if(iSlotSeq != iSeq)  // the packet of the counter has not come, or was overwritten
+      {
+        return false;
+      }
+      Buffer.fetch(uint64_t(iSeq), outArray);
+      iSlotSeq = NO_SEQ_VAL;  // the slot is free
+      return true;
+    }
+
+    /*
+     * Data input of a link; in stream mode its sync and counter inputs follow it
+     */
+    int Stream_Aligner_impl::LinkInput(int iLink)
+    {
+      return bTagMode ? iLink : 3*iLink;
+    }
+
+    /*
+     * Packet at the head of a link in zero-copy mode. The items before the packet start are skipped; returns false
+     * if there is no complete packet in the available items.
+     */
+    bool Stream_Aligner_impl::NextPacket(int iLink, int iAvailable, const gr_vector_const_void_star &input_items, int64_t &counterValue, pmt::pmt_t &pmtCounter)
+    {
+      int index_s = iAvailable;  // packet start; none found
+
+      if(bTagMode == true)  // packet starts and counters are tags
+      {
+        const uint64_t uStart = this->nitems_read(iLink);  // absolute index of the first input item
+        const std::vector<tag_t> &vStarts = vStartTags[iLink];
+        const std::vector<tag_t> &vSeqs = vSeqTags[iLink];
+
+        while((vStartNext[iLink] < vStarts.size()) && (vStarts[vStartNext[iLink]].offset < uStart + vLinkPos[iLink]))  // starts already passed
+        {
+          ++vStartNext[iLink];
+        }
+        if(vStartNext[iLink] < vStarts.size())  // next packet start
+        {
+          index_s = int(vStarts[vStartNext[iLink]].offset - uStart);
+
+          while((vSeqNext[iLink] < vSeqs.size()) && (vSeqs[vSeqNext[iLink]].offset < uStart + index_s))  // counters already passed
+          {
+            ++vSeqNext[iLink];
+          }
+          counterValue = NO_SEQ_VAL;  // no counter; the packet is dropped
+          pmtCounter = pmt::PMT_NIL;
+          if((vSeqNext[iLink] < vSeqs.size()) && (vSeqs[vSeqNext[iLink]].offset == uStart + index_s))  // counter of the packet
+          {
+            pmtCounter = vSeqs[vSeqNext[iLink]].value;
+            counterValue = int64_t(pmt::to_long(pmtCounter));
+          }
+        }
+      }
+      else
+      {
+        const char *sync = (const char *) input_items[LinkInput(iLink) + 1];
+        const int *counter = (const int *) input_items[LinkInput(iLink) + 2];
+
+        for(int index = vLinkPos[iLink]; index < iAvailable; ++index)  // go through the unread items
+        {
+          if(sync[index] == 1)  // if a sync pulse is found
+          {
+            index_s = index;  // update packet start index
+            counterValue = counter[index_s];  // packet counter
+            break;
+          }
+        }
+      }
+
+      vLinkPos[iLink] = MIN(index_s, iAvailable);  // the items before the packet start are skipped
+      return (iAvailable - vLinkPos[iLink] >= iPacketSize);  // the whole packet is available
+    }
+
+    void
+    Stream_Aligner_impl::forecast (int noutput_items, gr_vector_int &ninput_items_required)
+    {
+      for (size_t index = 0; index < ninput_items_required.size(); index++)  // go through all inputs
+      {
+        ninput_items_required[index] = bZeroCopy ? iPacketSize : noutput_items;  // one packet at each link head, or as many items as the outputs
+      }
+    }
+
     int
-    Stream_Aligner_impl::work(int noutput_items,
-        gr_vector_const_void_star &input_items,
-        gr_vector_void_star &output_items)
+    Stream_Aligner_impl::general_work (int noutput_items,
+                      gr_vector_int &ninput_items,
+                      gr_vector_const_void_star &input_items,
+                      gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       #ifdef _FLOW_MODE_
       std::cout << "Stream_Aligner_impl: Entry: Counter = " << iFlowCounter << std::endl;
       #endif
 
-      const char *data_1 = (const char *) input_items[0];
-      const char *sync_1 = (const char *) input_items[1];
-      const int *counter_1 = (const int *) input_items[2];
-      const char *data_2 = (const char *) input_items[3];
-      const char *sync_2 = (const char *) input_items[4];
-      const int *counter_2 = (const int *) input_items[5];
+      int iNumOfProdOutput = 0;  // number of produced outputs
+      int iNumOfConsumed = 0;  // number of consumed inputs at the links; equal in buffered mode
 
-      char *stream_1 = (char *) output_items[0];
-      char *stream_2 = (char *) output_items[1];
-      char *ctl = (char *) output_items[2];
+      if(bZeroCopy == true)  // the links are consumed at their own rates
+      {
+        iNumOfProdOutput = this->AlignInPlace(noutput_items, ninput_items, input_items, output_items);
+        iNumOfConsumed = *std::max_element(vLinkPos.begin(), vLinkPos.end());
+      }
+      else  // all inputs are consumed equally
+      {
+        int iNumOfItems = noutput_items;  // items aligned in this call; complete packets
+        for(size_t index = 0; index < ninput_items.size(); index++)  // go through all inputs
+        {
+          iNumOfItems = MIN(iNumOfItems, ninput_items[index]);
+        }
+        iNumOfItems = iNumOfItems/iPacketSize*iPacketSize;
 
-      #ifdef _DEBUG_MODE_
-      std::cout << "Stream_Aligner_impl: Work called." << std::endl;
-      std::cout << "Stream_Aligner_impl: Available total number of output samples = " << noutput_items << std::endl;
-      std::cout << "Stream_Aligner_impl: Packet size = " << iPacketSize << std::endl;
+        gr_vector_void_star vOutputs(output_items);  // outputs; the delay goes to a scratch array if it is not connected
+        if((int) vOutputs.size() == iNumOfLinks)  // delay output is not connected
+        {
+          vCtlScratch.resize(noutput_items);
+          vOutputs.push_back(vCtlScratch.data());
+        }
+
+        if((iNumOfItems > 0) && (bJitterMode == true))  // at least one packet; follow the running delay
+        {
+          iNumOfProdOutput = this->AlignJitter(iNumOfItems, input_items, vOutputs);
+        }
+        else if(iNumOfItems > 0)  // at least one packet
+        {
+          iNumOfProdOutput = this->AlignBuffered(iNumOfItems, input_items, vOutputs);
+        }
+        iNumOfConsumed = iNumOfProdOutput;
+        consume_each(iNumOfConsumed);  // the outputs follow the inputs item by item
+      }
+
+      #ifdef _FLOW_MODE_
+      std::cout << "Stream_Aligner_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
       #endif
 
-      FillArray<char>(ctl, INV_SIG_VAL, noutput_items);  // fill output with misalignment
+      PerfTimer.set_Items(iNumOfConsumed, iNumOfProdOutput);  // items of this call
+      return iNumOfProdOutput;
+    }
 
+    /*
+     * Zero-copy alignment: the packets at the link heads are compared and the older ones are dropped, till their
+     * counters match; the matched packets are copied out once. The lead links are read slower, so their delay is
+     * held by the input buffers.
+     */
+    int Stream_Aligner_impl::AlignInPlace(int noutput_items,
+        gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+    {
+      TRACE(unique_id(), TRC_WORK_ENTRY, noutput_items, ninput_items[0], iPacketSize);  // work called
 
-      // Do <+signal processing+>
-      #ifdef _DEBUG_MODE_
-      std::cout << "----------------------------------------------------" << std::endl;
-      #endif
-      int index_s_1 = 0;  // first sync pulse index for data stream 1
-      for(int index = 0; index < iPacketSize; ++index)  // go through first iPacketSize item from data_1
+      for(int index_l = 0; index_l < iNumOfLinks; ++index_l)  // go through the links
       {
-        if(sync_1[index] == 1)  // if a sync pulse is found
+        vAvailable[index_l] = ninput_items[LinkInput(index_l)];
+        if(bTagMode == true)  // get the packet tags of this call, in order
+        {
+          const uint64_t uStart = this->nitems_read(index_l);  // absolute index of the first input item
+          this->get_tags_in_range(vStartTags[index_l], index_l, uStart, uStart + vAvailable[index_l], pmtPacketStart);
+          this->get_tags_in_range(vSeqTags[index_l], index_l, uStart, uStart + vAvailable[index_l], pmtSeq);
+          std::sort(vStartTags[index_l].begin(), vStartTags[index_l].end(), tag_t::offset_compare);
+          std::sort(vSeqTags[index_l].begin(), vSeqTags[index_l].end(), tag_t::offset_compare);
+          vStartNext[index_l] = 0;
+          vSeqNext[index_l] = 0;
+        }
+        else  // the sync and counter inputs of a link go with its data
+        {
+          vAvailable[index_l] = MIN(vAvailable[index_l], MIN(ninput_items[LinkInput(index_l) + 1], ninput_items[LinkInput(index_l) + 2]));
+        }
+        vLinkPos[index_l] = 0;  // nothing read yet
+      }
+
+      int iSlowest = vAvailable[0]/iPacketSize;  // packets waiting at the slowest link
+      for(int index_l = 1; index_l < iNumOfLinks; ++index_l)  // go through the links
+      {
+        iSlowest = MIN(iSlowest, vAvailable[index_l]/iPacketSize);
+      }
+      int iOthers = INT_MAX;  // fewest packets waiting at a link other than link 1
+      for(int index_l = 0; index_l < iNumOfLinks; ++index_l)  // go through the links
+      {
+        vLinkDelay[index_l] = vAvailable[index_l]/iPacketSize - iSlowest;  // delay held by the link input buffer
+        iOthers = (index_l > 0) ? MIN(iOthers, vAvailable[index_l]/iPacketSize) : iOthers;
+      }
+      int streams_delay = vAvailable[0]/iPacketSize - iOthers;  // packets waiting at link 1 less the fewest waiting at another link
+
+      vHeadReady.assign(iNumOfLinks, 0);  // no head packet is found yet
+      int iNumOfProdOutput = 0;  // number of produced outputs
+      while(iNumOfProdOutput + iPacketSize <= noutput_items)  // room for one more packet at the outputs
+      {
+        bool bHeads = true;  // all link heads are complete packets
+        for(int index_l = 0; index_l < iNumOfLinks; ++index_l)  // go through the links; only the moved heads are looked for
+        {
+          if(vHeadReady[index_l] == 0)  // the link head moved
+          {
+            vHeadReady[index_l] = this->NextPacket(index_l, vAvailable[index_l], input_items, vCounter[index_l], vPmtCounter[index_l]) ? 1 : 0;
+            while((vHeadReady[index_l] != 0) && (vCounter[index_l] == NO_SEQ_VAL))  // packet without a counter; it can not be paired
+            {
+              TRACE(unique_id(), TRC_BUFFER, 2, index_l + 1, vLinkPos[index_l], NO_SEQ_VAL);  // packet dropped
+              this->count(iPerfDropped);
+              vLinkPos[index_l] += iPacketSize;  // drop it
+              vHeadReady[index_l] = this->NextPacket(index_l, vAvailable[index_l], input_items, vCounter[index_l], vPmtCounter[index_l]) ? 1 : 0;
+            }
+          }
+          bHeads = (vHeadReady[index_l] != 0) && bHeads;
+        }
+        if(bHeads == false)  // wait for more items
         {
-          index_s_1 = index;  // update first sync pulse index
           break;
         }
+
+        int index_n = 0;  // link with the newest head packet
+        for(int index_l = 1; index_l < iNumOfLinks; ++index_l)  // go through the links
+        {
+          index_n = (SeqDiff(uint64_t(vCounter[index_l]), uint64_t(vCounter[index_n]), iSeqBits) > 0) ? index_l : index_n;
+        }
+
+        bool bAligned = true;  // all heads are from the same packet
+        for(int index_l = 0; index_l < iNumOfLinks; ++index_l)  // go through the links
+        {
+          while((vHeadReady[index_l] != 0) && (SeqDiff(uint64_t(vCounter[index_n]), uint64_t(vCounter[index_l]), iSeqBits) > 0))  // older packet; its match is gone
+          {
+            TRACE(unique_id(), TRC_BUFFER, 2, index_l + 1, vLinkPos[index_l], int(vCounter[index_l]));  // packet dropped
+            this->count(iPerfDropped);
+            vLinkPos[index_l] += iPacketSize;  // drop it
+            vHeadReady[index_l] = this->NextPacket(index_l, vAvailable[index_l], input_items, vCounter[index_l], vPmtCounter[index_l]) ? 1 : 0;
+            bAligned = false;
+          }
+        }
+        if(bAligned == false)  // compare the new heads
+        {
+          continue;
+        }
+
+        for(int index_l = 0; index_l < iNumOfLinks; ++index_l)  // go through the links
+        {
+          const char *data = (const char *) input_items[LinkInput(index_l)];
+          char *stream = (char *) output_items[index_l];
+
+          CopyArrays<char>((data + vLinkPos[index_l]), (stream + iNumOfProdOutput), iPacketSize);  // aligned packet to output
+          if(bTagMode == true)  // the packet keeps its tags
+          {
+            this->add_item_tag(index_l, this->nitems_written(index_l) + iNumOfProdOutput, pmtPacketStart, pmt::PMT_T);  // packet starts here
+            if(pmt::eq(vPmtCounter[index_l], pmt::PMT_NIL) == false)  // packet counter
+            {
+              this->add_item_tag(index_l, this->nitems_written(index_l) + iNumOfProdOutput, pmtSeq, vPmtCounter[index_l]);
+            }
+          }
+          vLinkPos[index_l] += iPacketSize;  // packet read
+          vHeadReady[index_l] = 0;
+        }
+        iNumOfProdOutput += iPacketSize;  // update number of produced outputs
       }
-      int c_1 = counter_1[index_s_1];  // first counter for data stream 1
-      int n_v_p_1 = (index_s_1 == 0) ? int(noutput_items/iPacketSize) : int(noutput_items/iPacketSize) - 1;  // number of valid packets
-      #ifdef _DEBUG_MODE_
-      std::cout << "Stream_Aligner_impl: First sync pulse index for data stream 1  = " << index_s_1 << std::endl;
-      std::cout << "Stream_Aligner_impl: First counter value for data stream 1  = " << c_1 << std::endl;
-      std::cout << "Stream_Aligner_impl: Number of valid packets for data stream 1  = " << n_v_p_1 << std::endl;
-      #endif
 
+      if((int) output_items.size() > iNumOfLinks)  // delay output is connected
+      {
+        FillArray<char>((char *) output_items[iNumOfLinks], CtlDelay(streams_delay), iNumOfProdOutput);  // fill output with delay
+      }
+
+      for(int index_l = 0; index_l < iNumOfLinks; ++index_l)  // go through the links
+      {
+        for(int index_i = LinkInput(index_l); index_i < (bTagMode ? index_l + 1 : LinkInput(index_l) + 3); ++index_i)  // the data, sync and counter inputs of the link
+        {
+          consume(index_i, vLinkPos[index_l]);  // items read at the link
+        }
+      }
+
+      TRACE(unique_id(), TRC_DELAY, streams_delay, 0, 0, 0);  // delay held by the input buffers
+      TRACE(unique_id(), TRC_WORK_EXIT, iNumOfProdOutput, noutput_items);  // work returns
+
+      return iNumOfProdOutput;
+    }
+
+    /*
+     * Jitter buffer alignment: the inputs are read item by item with the outputs, as in the buffered alignment, but
+     * the delay held by the buffer bank follows the running median of the packet counter differences. A change up to
+     * JITTER_JUMP packets is followed one packet at a time; only a larger one resets the buffer bank. Each held packet
+     * sits in the bank slot of its counter and is sent out only with the lag packet of the same counter, so reordered
+     * lead packets are still paired, and the packets left in the bank when items are discarded on a sync error are
+     * dropped when their slot is taken again, never paired with later ones.
+     */
+    int Stream_Aligner_impl::AlignJitter(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+    {
+      const char *data[2] = {(const char *) input_items[LinkInput(0)], (const char *) input_items[LinkInput(1)]};
+      char *stream[2] = {(char *) output_items[0], (char *) output_items[1]};
+      char *ctl = (char *) output_items[2];
+
+      TRACE(unique_id(), TRC_WORK_ENTRY, noutput_items, noutput_items, iPacketSize);  // work called
+
+      int index_s_1 = 0;  // first sync pulse index for data stream 1
+      int64_t c_1 = DEF_SIG_VAL;  // first counter for data stream 1
       int index_s_2 = 0;  // first sync pulse index for data stream 2
-      for(int index = 0; index < iPacketSize; ++index)  // go through first iPacketSize item from data_2
+      int64_t c_2 = DEF_SIG_VAL;  // first counter for data stream 2
+      this->FindPacketSync(0, input_items, index_s_1, c_1);
+      this->FindPacketSync(1, input_items, index_s_2, c_2);
+
+      if(index_s_1 != index_s_2)  // if the sync pulses are not aligned; the buffer and the delay estimate are kept, the counters tell the stale packets
       {
-        if(sync_2[index] == 1)  // if a sync pulse is found
+        TRACE(unique_id(), TRC_STATE, PULSE_MISAL_ERR, index_s_1 - index_s_2, noutput_items);  // sync pulses are misaligned
+
+        FillArray<char>(stream[0], PULSE_MISAL_ERR, noutput_items);  // fill output with -1 as error
+        FillArray<char>(stream[1], PULSE_MISAL_ERR, noutput_items);  // fill output with -1 as error
+        FillArray<char>(ctl, index_s_1 - index_s_2, noutput_items);  // fill output with misalignment
+        TRACE(unique_id(), TRC_WORK_EXIT, noutput_items, noutput_items);  // work returns
+        return noutput_items;
+      }
+
+      if(index_s_1 != 0)  // if sync pulses are not at zero index; the buffer and the delay estimate are kept, the counters tell the stale packets
+      {
+        TRACE(unique_id(), TRC_STATE, NONZERO_IND_ERR, index_s_1, index_s_1);  // sync pulses are not at index zero
+
+        FillArray<char>(stream[0], NONZERO_IND_ERR, index_s_1);  // fill output with -2 as error
+        FillArray<char>(stream[1], NONZERO_IND_ERR, index_s_1);  // fill output with -2 as error
+        FillArray<char>(ctl, index_s_1, index_s_1);  // fill output with offset
+        TRACE(unique_id(), TRC_WORK_EXIT, index_s_1, noutput_items);  // work returns
+        return index_s_1;
+      }
+
+      if(bTagMode == true)  // get the counter tags of this call, in order
+      {
+        for(int index_l = 0; index_l < 2; ++index_l)  // go through the links
         {
-          index_s_2 = index;  // update first sync pulse index
-          break;
+          const uint64_t uStart = this->nitems_read(index_l);  // absolute index of the first input item
+          this->get_tags_in_range(vSeqTags[index_l], index_l, uStart, uStart + noutput_items, pmtSeq);
+          std::sort(vSeqTags[index_l].begin(), vSeqTags[index_l].end(), tag_t::offset_compare);
+          vSeqNext[index_l] = 0;
         }
       }
-      int c_2 = counter_2[index_s_2];  // first counter for data stream 2
-      int n_v_p_2 = (index_s_2 == 0) ? int(noutput_items/iPacketSize) : int(noutput_items/iPacketSize) - 1;  // number of valid packets
-      #ifdef _DEBUG_MODE_
-      std::cout << "Stream_Aligner_impl: First sync pulse index for data stream 2  = " << index_s_2 << std::endl;
-      std::cout << "Stream_Aligner_impl: First counter value for data stream 2  = " << c_2 << std::endl;
-      std::cout << "Stream_Aligner_impl: Number of valid packets for data stream 2  = " << n_v_p_2 << std::endl;
-      #endif
 
-      char streams_delay = c_1 - c_2;  // calculate delay
-      #ifdef _DEBUG_MODE_
-      std::cout << "Stream_Aligner_impl: Streams delay  = " << streams_delay << std::endl;
-      #endif
+      for(int index_i = 0; index_i < noutput_items; index_i += iPacketSize)  // go through the packets
+      {
+        const int64_t iSeq[2] = {PacketCounter(0, index_i, input_items), PacketCounter(1, index_i, input_items)};  // counters of this packet
+        const bool bSeqs = (iSeq[0] != NO_SEQ_VAL) && (iSeq[1] != NO_SEQ_VAL);  // both packets have counters; a packet without one is dropped and does not move the delay
+        if((bSeqs == false) && (iWindowNext < 0))  // no delay yet to place the other packet
+        {
+          TRACE(unique_id(), TRC_STATE, INV_SIG_VAL, iJitterDelay, iPacketSize);  // packet without a counter
+          this->count(iPerfDropped);
+          FillArray<char>((stream[0] + index_i), INV_SIG_VAL, iPacketSize);  // fill output with INV_SIG_VAL as error
+          FillArray<char>((stream[1] + index_i), INV_SIG_VAL, iPacketSize);  // fill output with INV_SIG_VAL as error
+          FillArray<char>((ctl + index_i), INV_SIG_VAL, iPacketSize);  // fill output with INV_SIG_VAL as error
+          continue;
+        }
+
+        if(bSeqs == true)  // one more delay observation
+        {
+          int64_t iSeqDelay = SeqDiff(uint64_t(iSeq[0]), uint64_t(iSeq[1]), iSeqBits);  // counter difference of this packet
+          int iObserved = int(CONSTRAIN(iSeqDelay, int64_t(-INT_MAX), int64_t(INT_MAX)));  // delay of this packet
+          bool bFirst = (iWindowNext < 0);  // first observation; the delay is taken as it is
+          int iEstimate = this->UpdateDelay(iObserved);  // running delay
+
+          if(bFirst == true)  // start from the observed delay
+          {
+            ClearHeld();
+            iJitterDelay = iEstimate;
+          }
+          else if((abs(iEstimate - iJitterDelay) > JITTER_JUMP) || ((iEstimate > 0) && (iJitterDelay < 0)) || ((iEstimate < 0) && (iJitterDelay > 0)))  // the delay jumped or the lead stream changed
+          {
+            TRACE(unique_id(), TRC_DELAY, iEstimate, (iEstimate < 0) ? 2 : 1, 0, 0);  // new delay
+            this->count(iPerfRealigns);
+            ClearHeld();  // the stored packets are of the old delay
+            iJitterDelay = iEstimate;
+          }
+          else if(iEstimate != iJitterDelay)  // small change; one packet at a time
+          {
+            iJitterDelay += (iEstimate > iJitterDelay) ? 1 : -1;
+          }
+
+          if(iObserved < iJitterDelay)  // packet delay below the compensated one
+          {
+            this->count(iPerfLate);
+          }
+          else if(iObserved > iJitterDelay)  // packet delay above the compensated one
+          {
+            this->count(iPerfEarly);
+          }
+        }
+
+        const int id_lead = (iJitterDelay < 0) ? 1 : 0;  // lead stream
+        const int id_lag = 1 - id_lead;  // lag stream
+        const int iHeld = abs(iJitterDelay);  // packets held in the buffer bank
+
+        FillArray<char>((ctl + index_i), CtlDelay(iJitterDelay), iPacketSize);  // fill output with delay
+
+        if(iHeld > Buffer.get_BankSize())  // if delay is longer than available buffer
+        {
+          TRACE(unique_id(), TRC_STATE, LONG_DELAY_ERR, iJitterDelay, iPacketSize);  // delay is longer than the buffer bank
+          FillArray<char>((stream[0] + index_i), LONG_DELAY_ERR, iPacketSize);  // fill output with -3 as error
+          FillArray<char>((stream[1] + index_i), LONG_DELAY_ERR, iPacketSize);  // fill output with -3 as error
+          ClearHeld();  // nothing to hold
+          continue;
+        }
+
+        CopyArrays<char>((data[id_lag] + index_i), (stream[id_lag] + index_i), iPacketSize);  // lag packet to output
+
+        if(iHeld == 0)  // no delay
+        {
+          ClearHeld();
+          if(bSeqs == false)  // the pair is not known to be of the same packet
+          {
+            TRACE(unique_id(), TRC_STATE, INV_SIG_VAL, iJitterDelay, iPacketSize);  // packet without a counter
+            this->count(iPerfDropped);
+            FillArray<char>((stream[0] + index_i), INV_SIG_VAL, iPacketSize);  // fill output with INV_SIG_VAL as error
+            FillArray<char>((stream[1] + index_i), INV_SIG_VAL, iPacketSize);  // fill output with INV_SIG_VAL as error
+            continue;
+          }
+          CopyArrays<char>((data[id_lead] + index_i), (stream[id_lead] + index_i), iPacketSize);  // lead packet to output
+          continue;
+        }
+
+        if(iSeq[id_lag] == NO_SEQ_VAL)  // lag packet without a counter; dropped
+        {
+          TRACE(unique_id(), TRC_STATE, INV_SIG_VAL, iJitterDelay, iPacketSize);  // packet without a counter
+          this->count(iPerfDropped);
+          FillArray<char>((stream[id_lead] + index_i), INV_SIG_VAL, iPacketSize);  // fill output with INV_SIG_VAL as error
+          FillArray<char>((stream[id_lag] + index_i), INV_SIG_VAL, iPacketSize);  // fill output with INV_SIG_VAL as error
+        }
+        else if(PopHeld((stream[id_lead] + index_i), iSeq[id_lag]) == true)  // the lead packet of the lag packet counter
+        {
+          TRACE(unique_id(), TRC_BUFFER, 0, id_lead + 1, index_i, int(iSeq[id_lag]));  // packet recovered from buffer
+        }
+        else  // the buffer is being filled
+        {
+          TRACE(unique_id(), TRC_STATE, FILLING_BUF_ERR, iJitterDelay, iPacketSize);  // buffer is being filled
+          FillArray<char>((stream[id_lead] + index_i), FILLING_BUF_ERR, iPacketSize);  // fill output with FILLING_BUF_ERR as error
+          FillArray<char>((stream[id_lag] + index_i), FILLING_BUF_ERR, iPacketSize);  // fill output with FILLING_BUF_ERR as error
+        }
+
+        if(iSeq[id_lead] == NO_SEQ_VAL)  // lead packet without a counter; not held
+        {
+          TRACE(unique_id(), TRC_BUFFER, 2, id_lead + 1, index_i, NO_SEQ_VAL);  // packet dropped
+          this->count(iPerfDropped);
+          continue;
+        }
+        TRACE(unique_id(), TRC_BUFFER, 1, id_lead + 1, index_i, int(iSeq[id_lead]));  // packet stored into buffer
+        int64_t iDropped = PushHeld((data[id_lead] + index_i), iSeq[id_lead]);  // hold the lead packet in the slot of its counter
+        if(iDropped != NO_SEQ_VAL)  // the packet left in the slot was never paired
+        {
+          TRACE(unique_id(), TRC_BUFFER, 2, id_lead + 1, index_i, int(iDropped));  // packet dropped
+          this->count(iPerfDropped);
+        }
+      }
+
+      TRACE(unique_id(), TRC_WORK_EXIT, noutput_items, noutput_items);  // work returns
+
+      return noutput_items;
+    }
+
+    /*
+     * Buffered alignment: the inputs are read item by item with the outputs, and the lead packets wait in the
+     * buffer bank.
+     */
+    int Stream_Aligner_impl::AlignBuffered(int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+    {
+      const char *data_1 = (const char *) input_items[0];
+      const char *data_2 = (const char *) input_items[bTagMode ? 1 : 3];
+
+      char *stream_1 = (char *) output_items[0];
+      char *stream_2 = (char *) output_items[1];
+      char *ctl = (char *) output_items[2];
+
+      TRACE(unique_id(), TRC_WORK_ENTRY, noutput_items, noutput_items, iPacketSize);  // work called
+
+      FillArray<char>(ctl, INV_SIG_VAL, noutput_items);  // fill output with misalignment
+
+      // Do <+signal processing+>
+      int index_s_1 = 0;  // first sync pulse index for data stream 1
+      int64_t c_1 = DEF_SIG_VAL;  // first counter for data stream 1
+      int index_s_2 = 0;  // first sync pulse index for data stream 2
+      int64_t c_2 = DEF_SIG_VAL;  // first counter for data stream 2
+      this->FindPacketSync(0, input_items, index_s_1, c_1);
+      this->FindPacketSync(1, input_items, index_s_2, c_2);
+
+      int n_v_p_1 = (index_s_1 == 0) ? int(noutput_items/iPacketSize) : int(noutput_items/iPacketSize) - 1;  // number of valid packets
+      TRACE(unique_id(), TRC_SYNC, 1, index_s_1, int(c_1), n_v_p_1);  // first sync pulse of stream 1
+      TRACE(unique_id(), TRC_SYNC, 2, index_s_2, int(c_2), (index_s_2 == 0) ? int(noutput_items/iPacketSize) : int(noutput_items/iPacketSize) - 1);  // first sync pulse of stream 2 and its valid packets
+
+      int64_t iSeqDelay = SeqDiff(uint64_t(c_1), uint64_t(c_2), iSeqBits);  // counter difference; right across the counter wrap
+      int streams_delay = int(CONSTRAIN(iSeqDelay, int64_t(-INT_MAX), int64_t(INT_MAX)));  // calculate delay
 
       int iNumOfProdOutput = noutput_items;  // number of produced outputs
 
       if(index_s_1 != index_s_2)  // if the sync pulses are not aligned
       {
-        #ifdef _DEBUG_MODE_
-        std::cout << "Stream_Aligner_impl: Sync pulses are misaligned." << std::endl;
-        #endif
+        TRACE(unique_id(), TRC_STATE, PULSE_MISAL_ERR, index_s_1 - index_s_2, noutput_items);  // sync pulses are misaligned
 
         FillArray<char>(stream_1, PULSE_MISAL_ERR, noutput_items);  // fill output with -1 as error
         FillArray<char>(stream_2, PULSE_MISAL_ERR, noutput_items);  // fill output with -1 as error
@@ -161,15 +745,9 @@ namespace gr {
       }    
       else  // otherwise; the sync pulses are aligned
       {
-        #ifdef _DEBUG_MODE_
-        std::cout << "Stream_Aligner_impl: Sync pulses are aligned." << std::endl;
-        #endif
-
         if(index_s_1 != 0)  // if sync pulses are not at zero index
         {
-          #ifdef _DEBUG_MODE_
-          std::cout << "Stream_Aligner_impl: Sync pulses are not at index zero." << std::endl;
-          #endif
+          TRACE(unique_id(), TRC_STATE, NONZERO_IND_ERR, index_s_1, index_s_1);  // sync pulses are not at index zero
 
           FillArray<char>(stream_1, NONZERO_IND_ERR, index_s_1);  // fill output with -2 as error
           FillArray<char>(stream_2, NONZERO_IND_ERR, index_s_1);  // fill output with -2 as error
@@ -182,20 +760,29 @@ namespace gr {
             bBufStored = false;  // set the buffer state
           }
         }
-        else  // otherwise; sync pulses are at zero index
+        else if((c_1 == NO_SEQ_VAL) || (c_2 == NO_SEQ_VAL))  // the first packet has no counter; its delay is not known
         {
-          #ifdef _DEBUG_MODE_
-          std::cout << "Stream_Aligner_impl: Sync pulses are at index zero." << std::endl;
-          #endif
+          TRACE(unique_id(), TRC_STATE, INV_SIG_VAL, 0, iPacketSize);  // packet without a counter
+          this->count(iPerfDropped);
 
-          if(abs(streams_delay) > Buffer.BankSize)  // if delay is longer than available buffer
+          FillArray<char>(stream_1, INV_SIG_VAL, iPacketSize);  // fill output with INV_SIG_VAL as error
+          FillArray<char>(stream_2, INV_SIG_VAL, iPacketSize);  // fill output with INV_SIG_VAL as error
+          iNumOfProdOutput = iPacketSize;  // the packet is dropped at both streams
+
+          if(bBufStored == true)  // if there is stored buffer
+          {
+            Buffer.clear();  // clear the buffer
+            bBufStored = false;  // set the buffer state
+          }
+        }
+        else  // otherwise; sync pulses are at zero index
+        {
+          if(abs(streams_delay) > Buffer.get_BankSize())  // if delay is longer than available buffer
           {
-            #ifdef _DEBUG_MODE_
-            std::cout << "Stream_Aligner_impl: Delay period is longer than available buffer bank." << std::endl;
-            #endif
+            TRACE(unique_id(), TRC_STATE, LONG_DELAY_ERR, streams_delay, noutput_items);  // delay is longer than the buffer bank
             FillArray<char>(stream_1, LONG_DELAY_ERR, noutput_items);  // fill output with -3 as error
             FillArray<char>(stream_2, LONG_DELAY_ERR, noutput_items);  // fill output with -3 as error
-            FillArray<char>(ctl, streams_delay, noutput_items);  // fill output with delay
+            FillArray<char>(ctl, CtlDelay(streams_delay), noutput_items);  // fill output with delay
             iNumOfProdOutput = noutput_items;  // update number of produced outputs
 
             if(bBufStored == true)  // if there is stored buffer
@@ -206,13 +793,11 @@ namespace gr {
           }
           else if(streams_delay == 0)  // if there is no delay
           {
-            #ifdef _DEBUG_MODE_
-            std::cout << "Stream_Aligner_impl: Signals are synced." << std::endl;
-            #endif
+            TRACE(unique_id(), TRC_STATE, 0, 0, noutput_items);  // streams are synced
 
             CopyArrays<char>(data_1, stream_1, noutput_items);  // fill output with input
             CopyArrays<char>(data_2, stream_2, noutput_items);  // fill output with input
-            FillArray<char>(ctl, streams_delay, noutput_items);  // fill output with delay
+            FillArray<char>(ctl, CtlDelay(streams_delay), noutput_items);  // fill output with delay
             iNumOfProdOutput = noutput_items;  // update number of produced outputs
 
             if(bBufStored == true)  // if there is stored buffer
@@ -223,16 +808,12 @@ namespace gr {
           }          
           else  // otherwise; if (1: stream_1 is ahead of stream_2) or (2: stream_2 is ahead of stream_3)
           {
-
             const char* input_lead;  // lead input signal
             const char* input_lag;  // lag signal
 
             char* output_lead;  // lead output signal
             char* output_lag;  // lag output signal
 
-            char id_lead;  // lead signal id
-            char id_lag;  // lag signal ids
-
             int index_i_lead = 0;  // index of input lead stream
             int index_i_lag = 0;  // index of input lag stream
 
@@ -243,61 +824,39 @@ namespace gr {
             {
               input_lead = data_1;  // set input lead array pointer
               output_lead = stream_1;  // set output lead array pointer
-              id_lead = '1';  // set lead signal id
 
               input_lag = data_2;  // set input lag array pointer
               output_lag = stream_2;  // set output lag array pointer
-              id_lag = '2';  // set lag signal id
             }
             else  // otherwise; 2: stream_2 is ahead of stream_1 stream_2 is lead; stream_1 is lag
             {
               input_lead = data_2;  // set input lead array pointer
               output_lead = stream_2;  // set output lead array pointer
-              id_lead = '2';  // set lead signal id
 
               input_lag = data_1;  // set input lag array pointer
               output_lag = stream_1;  // set output lag array pointer
-              id_lag = '1';  // set lag signal id
 
               streams_delay *= -1;  // make it positive
             }
 
             bBufStored = (streams_delay == Buffer.get_TakenSlots()) ? true : false;  // set the flag to stored status
 
-            #ifdef _DEBUG_MODE_
-            std::cout << "Stream_Aligner_impl: Stream " << id_lead << " is ahead of stream " << id_lag << std::endl;
-            #endif
+            TRACE(unique_id(), TRC_DELAY, streams_delay, ((streams_delay > 0) ? 1 : 2), (streams_delay < n_v_p_1) ? 1 : 0, bBufStored ? 1 : 0);  // lead stream and delay
 
             if(streams_delay < n_v_p_1)  // if the delayed signal is within the input stream; note that n_v_p_1 == n_v_p_2
             {
-              #ifdef _DEBUG_MODE_
-              std::cout << "Stream_Aligner_impl: Delayed stream is within the input data." << std::endl;
-              #endif
-
               if(bBufStored == true)  // if there is stored buffer
               {
-                #ifdef _DEBUG_MODE_
-                std::cout << "Stream_Aligner_impl: Stored buffer is available." << std::endl;
-                #endif
-
                 // stream lead
                 for(int index_p = 0; index_p < streams_delay; ++index_p)  // go through stored input packets
                 {
-                  #ifdef _DEBUG_MODE_
-                  std::cout << "Stream_Aligner_impl: Data is recovered from buffer." << std::endl;
-                  std::cout << "Stream_Aligner_impl: Stream " << id_lead << " output index = " << index_o_lead << std::endl;
-                  #endif
+                  TRACE(unique_id(), TRC_BUFFER, 0, ((streams_delay > 0) ? 1 : 2), index_o_lead, Buffer.get_TakenSlots());  // packet recovered from buffer
                   Buffer.pop((output_lead + index_o_lead));  // put the previously saved packet to output
                   index_o_lead += iPacketSize;  // update output index
                 }
 
                 for(int index_p = 0; index_p < n_v_p_1 - streams_delay; ++index_p)  // go through available input packets
                 {
-                  #ifdef _DEBUG_MODE_
-                  std::cout << "Stream_Aligner_impl: Data is streamed from input." << std::endl;
-                  std::cout << "Stream_Aligner_impl: Stream " << id_lead << " input index = " << index_i_lead << std::endl;
-                  std::cout << "Stream_Aligner_impl: Stream " << id_lead << " output index = " << index_o_lead << std::endl;
-                  #endif
                   CopyArrays<char>((input_lead + index_i_lead), (output_lead + index_o_lead), iPacketSize);  // fill output with input
                   index_i_lead += iPacketSize;  // update input index
                   index_o_lead += iPacketSize;  // update output index
@@ -305,24 +864,23 @@ namespace gr {
 
                 for(int index_p = 0; index_p < streams_delay; ++index_p)  // go through extra input packets
                 {
-                  #ifdef _DEBUG_MODE_
-                  std::cout << "Stream_Aligner_impl: Data is stored into buffer." << std::endl;
-                  std::cout << "Stream_Aligner_impl: Stream " << id_lead << " input index = " << index_i_lead << std::endl;
-                  #endif
+                  TRACE(unique_id(), TRC_BUFFER, 1, ((streams_delay > 0) ? 1 : 2), index_i_lead, Buffer.get_TakenSlots());  // packet stored into buffer
+                  if(Buffer.get_TakenSlots() == Buffer.get_BankSize())  // the oldest stored packet is overwritten
+                  {
+                    this->count(iPerfOverflows);
+                  }
                   Buffer.push((input_lead + index_i_lead));  // put the extra input packet into buffer
                   index_i_lead += iPacketSize;  // update output index
                 }
 
                 // stream lag
                 CopyArrays<char>(input_lag, output_lag, noutput_items);  // fill output with input
-                FillArray<char>(ctl, streams_delay, noutput_items);  // fill output with delay
+                FillArray<char>(ctl, CtlDelay(streams_delay), noutput_items);  // fill output with delay
                 iNumOfProdOutput = noutput_items;  // update number of produced outputs
               }
               else  // if there is no stored buffer
               {
-                #ifdef _DEBUG_MODE_
-                std::cout << "Stream_Aligner_impl: Stored buffer is not available." << std::endl;
-                #endif
+                TRACE(unique_id(), TRC_STATE, FILLING_BUF_ERR, streams_delay, iPacketSize*streams_delay);  // buffer is being filled
 
                 Buffer.clear();  // clear the buffer
                 
@@ -337,11 +895,6 @@ namespace gr {
                 // stream lead
                 for(int index_p = 0; index_p < n_v_p_1 - streams_delay; ++index_p)  // go through available input packets
                 {
-                  #ifdef _DEBUG_MODE_
-                  std::cout << "Stream_Aligner_impl: Data is streamed from input." << std::endl;
-                  std::cout << "Stream_Aligner_impl: Stream " << id_lead << " input index = " << index_i_lead << std::endl;
-                  std::cout << "Stream_Aligner_impl: Stream " << id_lead << " output index = " << index_o_lead << std::endl;
-                  #endif
                   CopyArrays<char>((input_lead + index_i_lead), (output_lead + index_o_lead), iPacketSize);  // fill output with input
                   index_i_lead += iPacketSize;  // update input index
                   index_o_lead += iPacketSize;  // update output index
@@ -349,50 +902,41 @@ namespace gr {
 
                 for(int index_p = 0; index_p < streams_delay; ++index_p)  // go through extra input packets
                 {
-                  #ifdef _DEBUG_MODE_
-                  std::cout << "Stream_Aligner_impl: Data is stored into buffer." << std::endl;
-                  std::cout << "Stream_Aligner_impl: Stream " << id_lead << " input index = " << index_i_lead << std::endl;
-                  #endif
+                  TRACE(unique_id(), TRC_BUFFER, 1, ((streams_delay > 0) ? 1 : 2), index_i_lead, Buffer.get_TakenSlots());  // packet stored into buffer
+                  if(Buffer.get_TakenSlots() == Buffer.get_BankSize())  // the oldest stored packet is overwritten
+                  {
+                    this->count(iPerfOverflows);
+                  }
                   Buffer.push((input_lead + index_i_lead));  // put the extra input packet into buffer
                   index_i_lead += iPacketSize;  // update input index
                 }
 
                 // stream lag
                 CopyArrays<char>((input_lag + index_i_lag), (output_lag + index_o_lag), (n_v_p_1 - streams_delay)*iPacketSize);  // fill output with input
-                FillArray<char>(ctl, streams_delay, noutput_items);  // fill output with delay
+                FillArray<char>(ctl, CtlDelay(streams_delay), noutput_items);  // fill output with delay
                 iNumOfProdOutput = noutput_items;  // update number of produced outputs
               }
 
             }
             else  // otherwise; if the delayed signal is not within the input stream
             {
-              #ifdef _DEBUG_MODE_
-              std::cout << "Stream_Aligner_impl: Delayed stream is not within the input data." << std::endl;
-              #endif
-
               if(bBufStored == true)  // if there is stored buffer
               {
-                #ifdef _DEBUG_MODE_
-                std::cout << "Stream_Aligner_impl: Stored buffer is available." << std::endl;
-                #endif
-
                 // stream lead
                 for(int index_p = 0; index_p < n_v_p_1; ++index_p)  // go through stored input packets
                 {
-                  #ifdef _DEBUG_MODE_
-                  std::cout << "Stream_Aligner_impl: Data is recovered from buffer." << std::endl;
-                  std::cout << "Stream_Aligner_impl: Stream " << id_lead << " output index = " << index_o_lead << std::endl;
-                  #endif
+                  TRACE(unique_id(), TRC_BUFFER, 0, ((streams_delay > 0) ? 1 : 2), index_o_lead, Buffer.get_TakenSlots());  // packet recovered from buffer
                   Buffer.pop((output_lead + index_o_lead));  // put the previously saved packet to output
                   index_o_lead += iPacketSize;  // update output index
                 }
 
                 for(int index_p = 0; index_p < n_v_p_1; ++index_p)  // go through all input packets
                 {
-                  #ifdef _DEBUG_MODE_
-                  std::cout << "Stream_Aligner_impl: Data is stored into buffer." << std::endl;
-                  std::cout << "Stream_Aligner_impl: Stream " << id_lead << " input index = " << index_i_lead << std::endl;
-                  #endif
+                  TRACE(unique_id(), TRC_BUFFER, 1, ((streams_delay > 0) ? 1 : 2), index_i_lead, Buffer.get_TakenSlots());  // packet stored into buffer
+                  if(Buffer.get_TakenSlots() == Buffer.get_BankSize())  // the oldest stored packet is overwritten
+                  {
+                    this->count(iPerfOverflows);
+                  }
                   Buffer.push((input_lead + index_i_lead));  // put the extra input packet into buffer
                   index_i_lead += iPacketSize;  // update output index
                 }
@@ -403,18 +947,15 @@ namespace gr {
               }
               else  // if there is no stored buffer
               {
-                #ifdef _DEBUG_MODE_
-                std::cout << "Stream_Aligner_impl: Stored buffer is not available." << std::endl;
-                #endif
-
                 int iNumOfConsumed = 0;  // number of consumed input packets
 
                 for(iNumOfConsumed = 0; iNumOfConsumed < n_v_p_1;)  // go through all input packets and store them in the buffer till the delay can be compensated
                 {
-                  #ifdef _DEBUG_MODE_
-                  std::cout << "Stream_Aligner_impl: Data is stored into buffer." << std::endl;
-                  std::cout << "Stream_Aligner_impl: Stream " << id_lead << " input index = " << index_i_lead << std::endl;
-                  #endif
+                  TRACE(unique_id(), TRC_BUFFER, 1, ((streams_delay > 0) ? 1 : 2), index_i_lead, Buffer.get_TakenSlots());  // packet stored into buffer
+                  if(Buffer.get_TakenSlots() == Buffer.get_BankSize())  // the oldest stored packet is overwritten
+                  {
+                    this->count(iPerfOverflows);
+                  }
                   Buffer.push((input_lead + index_i_lead));  // put the extra input packet into buffer
                   index_i_lead += iPacketSize;  // update output index
 
@@ -422,15 +963,10 @@ namespace gr {
 
                   if(Buffer.get_TakenSlots() == streams_delay)  // if enough packets are stored
                   {
-                    #ifdef _DEBUG_MODE_
-                    std::cout << "Stream_Aligner_impl: Enough data is stored." << std::endl;
-                    #endif
                     break;  // leave the loop
                   }
                 }
-                #ifdef _DEBUG_MODE_
-                std::cout << "Stream_Aligner_impl: Number of consumed input packets = " << iNumOfConsumed << std::endl;
-                #endif
+                TRACE(unique_id(), TRC_STATE, FILLING_BUF_ERR, streams_delay, iNumOfConsumed*iPacketSize);  // buffer is being filled
 
                 // fill the unavailable section with 'filling buffer' status
                 FillArray<char>((output_lead + index_o_lead), FILLING_BUF_ERR, iNumOfConsumed*iPacketSize);  // fill output with -4 as error
@@ -443,13 +979,7 @@ namespace gr {
       }
       // Tell runtime system how many output items we produced.
 
-      #ifdef _DEBUG_MODE_
-      std::cout << "Stream_Aligner_impl: Consumed output = " << iNumOfProdOutput << std::endl;
-      #endif
-
-      #ifdef _FLOW_MODE_
-      std::cout << "Stream_Aligner_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
-      #endif
+      TRACE(unique_id(), TRC_WORK_EXIT, iNumOfProdOutput, noutput_items);  // work returns
 
       return iNumOfProdOutput;
     }
@@ -22,46 +22,99 @@
 #define INCLUDED_HYBRID_COMM_STREAM_ALIGNER_IMPL_H
 
 #include <Hybrid_Comm/Stream_Aligner.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace Hybrid_Comm {
 
-    class Stream_Aligner_impl : public Stream_Aligner
+    class Stream_Aligner_impl : public Stream_Aligner, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
       int iPacketSize;  // packet size
       Bank_Buff<char> Buffer;  // buffer
+      int iPerfOverflows;  // performance counter: packets lost to a full buffer
+      int iPerfDropped;  // performance counter: zero-copy mode packets with no match at the other input; jitter mode packets dropped from the buffer; packets without a counter
+      int iPerfLate;  // performance counter: jitter mode packets with a delay below the compensated one
+      int iPerfEarly;  // performance counter: jitter mode packets with a delay above the compensated one
+      int iPerfRealigns;  // performance counter: jitter mode delay jumps; the buffer is reset
       bool bBufStored;  // flag to show buffer has been stored
+      bool bTagMode;  // packet starts and counters are stream tags instead of streams
+      int iSeqBits;  // counter bits compared; serial number arithmetic
+      bool bZeroCopy;  // the delay is held by the input buffers; the inputs are consumed at different rates
+      int iNumOfLinks;  // number of aligned links
+      std::vector<int> vLinkPos;  // zero-copy mode: items of each link read in this call
+      std::vector<int> vLinkDelay;  // zero-copy mode: packets waiting at each link beyond those at the slowest link
+      std::vector<int> vAvailable;  // zero-copy mode: available items of each link in this call
+      std::vector<int64_t> vCounter;  // zero-copy mode: counter of each link head
+      std::vector<pmt::pmt_t> vPmtCounter;  // zero-copy mode: counter tag value of each link head
+      std::vector<char> vHeadReady;  // zero-copy mode: the head packet of each link is found
+      std::vector<std::vector<tag_t>> vStartTags;  // zero-copy tag mode: packet start tags of each link in this call
+      std::vector<std::vector<tag_t>> vSeqTags;  // zero-copy tag mode: counter tags of each link in this call
+      std::vector<size_t> vStartNext;  // zero-copy tag mode: next packet start tag of each link
+      std::vector<size_t> vSeqNext;  // zero-copy tag mode: next counter tag of each link
+      std::vector<char> vCtlScratch;  // buffered mode: delay values when the delay output is not connected
+      bool bJitterMode;  // the buffered alignment follows a running median of the delay
+      std::vector<int> vDelayWindow;  // jitter mode: last delay observations
+      std::vector<int> vDelaySorted;  // jitter mode: scratch for the median
+      int iWindowNext;  // jitter mode: next observation slot; -1 when there is no observation yet
+      int iJitterDelay;  // jitter mode: delay compensated by the buffer bank
+      std::vector<int64_t> vHeldSeq;  // jitter mode: counter of the packet in each keyed slot of the buffer bank; NO_SEQ_VAL when empty
+      pmt::pmt_t pmtPacketStart;  // packet start tag key
+      pmt::pmt_t pmtSeq;  // packet counter tag key
       #ifdef _FLOW_MODE_
       int iFlowCounter;  // flow debugging counter
       #endif
 
-      static const std::vector<int> iov;  // io signature
+      static const std::vector<int> iov;  // io signature of a link
+      static const std::vector<int> iovTag;  // io signature of a link in tag mode
       static const int iMaxInBufCoeff;  // maximum input items buffer coefficient 
 
      public:
-      Stream_Aligner_impl(int packetSize = PACKET_SAMP_SIZE);
+      Stream_Aligner_impl(int packetSize = PACKET_SAMP_SIZE, bool tagMode = false, int seqBits = COUNTER_BITS, int bufferDepth = BUFF_SIZE, bool zeroCopy = false, int numOfLinks = ALIGNER_LINKS, bool jitterMode = false);
+      static std::vector<int> InputSignature(bool tagMode, int numOfLinks);  // io signature of all links
+      void FindPacketTag(int iInput, int &index_s, int64_t &counterValue);  // first packet start and counter from the stream tags
+      void FindPacketSync(int iLink, const gr_vector_const_void_star &input_items, int &index_s, int64_t &counterValue);  // first packet start and counter of a link
+      int64_t PacketCounter(int iLink, int iIndex, const gr_vector_const_void_star &input_items);  // counter of the packet starting at an input index
+      int UpdateDelay(int iObserved);  // add a delay observation; return the running median
+      void ClearHeld(void);  // jitter mode: empty the buffer bank and its counters
+      int64_t PushHeld(const char *inArray, int64_t iSeq);  // jitter mode: hold a lead packet in the slot of its counter; the counter of a dropped packet, or NO_SEQ_VAL
+      bool PopHeld(char *outArray, int64_t iSeq);  // jitter mode: the held packet of a counter; false if it is not held
+      static char CtlDelay(int iDelay);  // delay as given at the 'ctl' output; saturated to its range
+      int LinkInput(int iLink);  // data input of a link; its sync and counter inputs follow in stream mode
+      bool NextPacket(int iLink, int iAvailable, const gr_vector_const_void_star &input_items, int64_t &counterValue, pmt::pmt_t &pmtCounter);  // packet at the head of a link
+      int AlignBuffered(int noutput_items, gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);  // equal consumption; the delay is held by the buffer bank
+      int AlignJitter(int noutput_items, gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);  // equal consumption; the buffer bank follows the running delay
+      int AlignInPlace(int noutput_items, gr_vector_int &ninput_items, gr_vector_const_void_star &input_items, gr_vector_void_star &output_items);  // the delay is held by the input buffers
       ~Stream_Aligner_impl();
 
       // Where all the action really happens
-      int work(
-              int noutput_items,
-              gr_vector_const_void_star &input_items,
-              gr_vector_void_star &output_items
-      );
+      void forecast (int noutput_items, gr_vector_int &ninput_items_required);
+
+      int general_work(int noutput_items,
+           gr_vector_int &ninput_items,
+           gr_vector_const_void_star &input_items,
+           gr_vector_void_star &output_items);
+
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
 
       // Set packet size
       void set_PacketSize(int packetSize)
       {
-        #ifdef _THREAD_MUTEX_
-        gr::thread::scoped_lock dummy(d_mutex_delay);  //  create a mutex lock for the current scope#
-        #endif
+        gr::thread::scoped_lock guard(d_setlock);  // the scheduler holds it around work; the buffer bank is not changed under a work call
 
         iPacketSize = CONSTRAIN(packetSize, 1, INT_MAX);
         Buffer.set_SlotSize(iPacketSize);  // set new slot size
+        iWindowNext = -1;  // the delay is estimated again
         this->set_output_multiple(iPacketSize);  // make sure there are complete number of packets in the incoming data
-        this->set_max_noutput_items(iPacketSize*Buffer.BankSize*iMaxInBufCoeff - 1);  // set the maximum number of items
+        if(bZeroCopy == false)  // the buffered alignment handles a limited number of packets per call
+        {
+          this->set_max_noutput_items(int(MIN(int64_t(iPacketSize)*Buffer.get_BankSize()*iMaxInBufCoeff - 1, int64_t(INT_MAX))));  // set the maximum number of items
+        }
 
         #ifdef _DEBUG_MODE_
         std::cout << "Stream_Aligner_impl: Packet size = " << iPacketSize << std::endl;
@@ -70,6 +123,31 @@ namespace gr {
         bBufStored = false;  // set the buffer storage flag
       }
 
+      // Set buffer bank depth
+      void set_BufferDepth(int bufferDepth)
+      {
+        gr::thread::scoped_lock guard(d_setlock);  // the scheduler holds it around work; the buffer bank is not changed under a work call
+
+        Buffer.set_BankSize(bufferDepth);  // new depth; the bank is emptied
+        iWindowNext = -1;  // the delay is estimated again
+        if(bZeroCopy == false)  // the buffered alignment handles a limited number of packets per call
+        {
+          this->set_max_noutput_items(int(MIN(int64_t(iPacketSize)*Buffer.get_BankSize()*iMaxInBufCoeff - 1, int64_t(INT_MAX))));  // set the maximum number of items
+        }
+
+        #ifdef _DEBUG_MODE_
+        std::cout << "Stream_Aligner_impl: Buffer depth = " << Buffer.get_BankSize() << std::endl;
+        #endif
+
+        bBufStored = false;  // set the buffer storage flag
+      }
+
+      // Get buffer bank depth
+      int get_BufferDepth(void)
+      {
+        return Buffer.get_BankSize();
+      }
+
       // Get packet size
       int get_PacketSize(void)
       {
@@ -79,6 +157,48 @@ namespace gr {
         return iPacketSize;
       }
 
+      // Get tag mode
+      bool get_TagMode(void)
+      {
+        return bTagMode;
+      }
+
+      // Get zero-copy mode
+      bool get_ZeroCopy(void)
+      {
+        return bZeroCopy;
+      }
+
+      // Get jitter mode
+      bool get_JitterMode(void)
+      {
+        return bJitterMode;
+      }
+
+      // Get delay compensated by the jitter buffer
+      int get_JitterDelay(void)
+      {
+        return iJitterDelay;
+      }
+
+      // Get number of aligned links
+      int get_NumOfLinks(void)
+      {
+        return iNumOfLinks;
+      }
+
+      // Get packets waiting at a link beyond those at the slowest link
+      int get_LinkDelay(int link)
+      {
+        return vLinkDelay[CONSTRAIN(link, 0, iNumOfLinks - 1)];
+      }
+
+      // Get counter bits compared
+      int get_SeqBits(void)
+      {
+        return iSeqBits;
+      }
+
     };
 
   } // namespace Hybrid_Comm
@@ -45,6 +45,10 @@ namespace gr {
               gr::io_signature::make2(2, 2, sizeof(char), sizeof(float)),
               gr::io_signature::make(2, 3, sizeof(char)))
     {
+      this->setup_Stats(this);  // register the stats message port
+      iPerfSwitches = this->add_Counter("link_switches");
+      iActiveLink = 0;  // no packet yet
+
       #ifdef _FLOW_MODE_
       iFlowCounter = 0;
       #endif
@@ -73,6 +77,8 @@ namespace gr {
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       #ifdef _FLOW_MODE_
       std::cout << "Tx_Hard_Switch_impl: Entry: Counter = " << iFlowCounter << std::endl;
       #endif
@@ -109,7 +115,14 @@ namespace gr {
           FillArray<char>((out_SpB + index_p*iPacketSize), sel[index_p*iPacketSize], iPacketSize);  // fill SpB with input value
         }
 
-        if(sel[index_p*iPacketSize] < fThresh)  // if selection signal is less than threshold value; link 1 is active
+        int iLink = (sel[index_p*iPacketSize] < fThresh) ? 1 : 2;  // link of this packet
+        if((iLink != iActiveLink) && (iActiveLink != 0))  // the link is switched
+        {
+          this->count(iPerfSwitches);
+        }
+        iActiveLink = iLink;
+
+        if(iLink == 1)  // if selection signal is less than threshold value; link 1 is active
         {
           CopyArrays<char>((in + index_p*iPacketSize), (link_1 + index_p*iPacketSize), iPacketSize);  // copy the input array to link 1
           FillArray<char>((link_2 + index_p*iPacketSize), DEF_SIG_VAL, iPacketSize);  // fill array with input value
@@ -140,6 +153,8 @@ namespace gr {
       std::cout << "Tx_Hard_Switch_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
       #endif
 
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
@@ -22,16 +22,19 @@
 #define INCLUDED_HYBRID_COMM_TX_HARD_SWITCH_IMPL_H
 
 #include <Hybrid_Comm/Tx_Hard_Switch.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace Hybrid_Comm {
 
-    class Tx_Hard_Switch_impl : public Tx_Hard_Switch
+    class Tx_Hard_Switch_impl : public Tx_Hard_Switch, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
       int iPacketSize;  // packet size
       float fThresh;  // threshold
+      int iActiveLink;  // link of the last packet; 0 before the first packet
+      int iPerfSwitches;  // performance counter: link switches
       #ifdef _FLOW_MODE_
       int iFlowCounter;  // flow debugging counter
       #endif
@@ -51,6 +54,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set packet size
       void set_PacketSize(int packetsize)
       {
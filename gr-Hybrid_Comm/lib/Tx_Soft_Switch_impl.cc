@@ -47,6 +47,8 @@ namespace gr {
               gr::io_signature::make2(2, 2, sizeof(char), sizeof(float)),
               gr::io_signature::make(2, 3, sizeof(char))), ptr_fThresh(nullptr), ptr_cSpP_1(nullptr), ptr_cSpP_2(nullptr)
     {
+      this->setup_Stats(this);  // register the stats message port
+
       #ifdef _FLOW_MODE_
       iFlowCounter = 0;
       #endif
@@ -76,6 +78,8 @@ namespace gr {
         gr_vector_const_void_star &input_items,
         gr_vector_void_star &output_items)
     {
+      Work_Timer PerfTimer(*this);  // time this call for the performance counters
+
       #ifdef _FLOW_MODE_
       std::cout << "Tx_Soft_Switch_impl: Entry: Counter = " << iFlowCounter << std::endl;
       #endif
@@ -229,6 +233,8 @@ namespace gr {
       std::cout << "Tx_Soft_Switch_impl: Exit: Counter = " << iFlowCounter++ << std::endl;
       #endif
 
+      PerfTimer.set_Items(noutput_items, noutput_items);  // items of this call
+
       // Tell runtime system how many output items we produced.
       return noutput_items;
     }
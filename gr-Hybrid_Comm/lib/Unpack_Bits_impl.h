@@ -0,0 +1,80 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2020 gr-Hybrid_Comm author.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_HYBRID_COMM_UNPACK_BITS_IMPL_H
+#define INCLUDED_HYBRID_COMM_UNPACK_BITS_IMPL_H
+
+#include <Hybrid_Comm/Unpack_Bits.h>
+#include <Comm_Kernels/perf_block.h>
+
+namespace gr {
+  namespace Hybrid_Comm {
+
+    class Unpack_Bits_impl : public Unpack_Bits, public Comm_Kernels::Perf_Block
+    {
+     private:
+      int iSamplesPerBit;  // samples per bit of the unpacked signal
+      #ifdef _FLOW_MODE_
+      int iFlowCounter;  // flow debugging counter
+      #endif
+
+     public:
+      Unpack_Bits_impl(int samplesPerBit = DEF_SPB);
+      ~Unpack_Bits_impl();
+
+      // Where all the action really happens
+      int work(
+              int noutput_items,
+              gr_vector_const_void_star &input_items,
+              gr_vector_void_star &output_items
+      );
+
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
+      // Set samples per bit
+      void set_SamplesPerBit(int samplesPerBit)
+      {
+        iSamplesPerBit = CONSTRAIN(samplesPerBit, 1, INT_MAX/8);
+        this->set_interpolation(8*iSamplesPerBit);  // one byte holds 8 bits
+        #ifdef _DEBUG_MODE_
+        std::cout << "Unpack_Bits_impl: Samples per bit = " << iSamplesPerBit << std::endl;
+        #endif
+      }
+
+      // Get samples per bit
+      int get_SamplesPerBit(void)
+      {
+        #ifdef _DEBUG_MODE_
+        std::cout << "Unpack_Bits_impl: Samples per bit = " << iSamplesPerBit << std::endl;
+        #endif
+        return iSamplesPerBit;
+      }
+
+    };
+
+  } // namespace Hybrid_Comm
+} // namespace gr
+
+#endif /* INCLUDED_HYBRID_COMM_UNPACK_BITS_IMPL_H */
+
@@ -21,6 +21,7 @@
 
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
+import pmt
 import Hybrid_Comm_swig as Hybrid_Comm
 import random
 import numpy
@@ -164,6 +165,300 @@ class qa_Add_Header(gr_unittest.TestCase):
         self.assertAlmostEqual(Res, 0)
 
 
+    def test_003_t(self):  # test 3: counter values past one byte
+        NumOfPackets = 300
+        PacketSize = 20
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Label = 'L1'
+        CounterLen = 16
+        HeaderSpB = 3
+
+        Data = [(x % 100) + 2 for x in range(0, NumOfPackets*PacketSize)]
+
+        src = blocks.vector_source_b(Data)
+        testBlock = Hybrid_Comm.Add_Header(PacketSize, Preamble, Label, HeaderSpB)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, testBlock)
+        self.tb.connect(testBlock, dst)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock = list(dst.data())
+
+        Preamble_b = self.Char2Str(Preamble)
+        Label_b = [((bin(ord(x)).replace('b', '0'))[-1::-1])[0:8] for x in Label]
+        Output_arr = []
+        for i in range(0, NumOfPackets):
+            Header_str = Preamble_b + self.Char2Str(Label_b) + self.Num2Bin(i, CounterLen)[-1::-1]
+            Output_arr += [ord(x) - ord('0') for x in self.rectpulse(Header_str, HeaderSpB)] + Data[i*PacketSize:(i + 1)*PacketSize]
+            pass
+
+        print()
+        print("***************************")
+        print("Test 3:")
+        print("Number of output samples = ", len(resBlock))
+
+        self.assertEqual(resBlock, Output_arr)
+
+
+    def test_004_t(self):  # test 4: PDU mode; PDUs framed and deframed again, without padding
+        NumOfPDUs = 20
+        PacketSize = 135  # rounded down to whole bytes
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Label = 'L1'
+        HeaderSpB = 2
+        NumOfBytes = int(PacketSize/(8*HeaderSpB))
+
+        Payloads = [[random.randint(0, 255) for x in range(0, random.randint(1, NumOfBytes))] for i in range(0, NumOfPDUs)]
+
+        txBlock = Hybrid_Comm.Add_Header(PacketSize, Preamble, Label, HeaderSpB, True)
+        rxBlock = Hybrid_Comm.Remove_Header(PacketSize, Preamble, Label, HeaderSpB, False, True)
+        dst = blocks.message_debug()
+        self.tb.connect(txBlock, rxBlock)
+        self.tb.msg_connect((rxBlock, 'pdu'), (dst, 'store'))
+
+        # set up fg
+        self.tb.start()
+        for Payload in Payloads:
+            txBlock.to_basic_block()._post(pmt.intern('pdu'), pmt.cons(pmt.make_dict(), pmt.init_u8vector(len(Payload), Payload)))
+            pass
+        bDone = self.WaitForMessages(dst, NumOfPDUs)  # every PDU has the length field; none waits for the next header
+        self.tb.stop()
+        self.tb.wait()
+        # check data
+        Res_meta = [pmt.car(dst.get_message(i)) for i in range(0, dst.num_messages())]
+        Res_data = [list(pmt.u8vector_elements(pmt.cdr(dst.get_message(i)))) for i in range(0, dst.num_messages())]
+        Res_counter = [pmt.to_long(pmt.dict_ref(m, pmt.intern('seq'), pmt.PMT_NIL)) for m in Res_meta]
+        Res_label = [pmt.symbol_to_string(pmt.dict_ref(m, pmt.intern('label'), pmt.PMT_NIL)) for m in Res_meta]
+        Res_state = [pmt.to_long(pmt.dict_ref(m, pmt.intern('sync_state'), pmt.PMT_NIL)) for m in Res_meta]
+        Exp_data = Payloads  # PDU headers have the length field; not padded
+        Exp_state = [1, 1] + [2]*(NumOfPDUs - 2)  # first header and one more to verify, then locked
+
+        print()
+        print("***************************")
+        print("Test 4:")
+        print("Number of sent PDUs = ", NumOfPDUs)
+        print("Number of received PDUs = ", len(Res_data))
+        print("Sync states = ", Res_state)
+
+        self.assertTrue(bDone)
+        self.assertTrue(txBlock.get_PduMode())
+        self.assertTrue(txBlock.get_LengthField())
+        self.assertTrue(rxBlock.get_LengthField())
+        self.assertEqual(txBlock.get_PacketSize(), NumOfBytes*8*HeaderSpB)
+        self.assertEqual(rxBlock.get_PacketSize(), NumOfBytes*8*HeaderSpB)
+        self.assertEqual(Res_data, Exp_data)
+        self.assertEqual(Res_counter, list(range(0, NumOfPDUs)))
+        self.assertEqual(Res_label, [Label]*NumOfPDUs)
+        self.assertEqual(Res_state, Exp_state)
+
+
+    def test_005_t(self):  # test 5: length field; PDUs of any length go through without padding
+        NumOfPDUs = 20
+        PacketSize = 128
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Label = 'L1'
+        HeaderSpB = 2
+        NumOfBytes = int(PacketSize/(8*HeaderSpB))
+
+        Payloads = [[random.randint(0, 255) for x in range(0, random.randint(1, NumOfBytes))] for i in range(0, NumOfPDUs)]
+
+        txBlock = Hybrid_Comm.Add_Header(PacketSize, Preamble, Label, HeaderSpB, True, True, True)
+        rxBlock = Hybrid_Comm.Remove_Header(PacketSize, Preamble, Label, HeaderSpB, False, True, True, True)
+        dst = blocks.message_debug()
+        self.tb.connect(txBlock, rxBlock)
+        self.tb.msg_connect((rxBlock, 'pdu'), (dst, 'store'))
+
+        # set up fg
+        self.tb.start()
+        for Payload in Payloads:
+            txBlock.to_basic_block()._post(pmt.intern('pdu'), pmt.cons(pmt.make_dict(), pmt.init_u8vector(len(Payload), Payload)))
+            pass
+        bDone = self.WaitForMessages(dst, NumOfPDUs)
+        self.tb.stop()
+        self.tb.wait()
+        # check data
+        Res_meta = [pmt.car(dst.get_message(i)) for i in range(0, dst.num_messages())]
+        Res_data = [list(pmt.u8vector_elements(pmt.cdr(dst.get_message(i)))) for i in range(0, dst.num_messages())]
+        Res_counter = [pmt.to_long(pmt.dict_ref(m, pmt.intern('seq'), pmt.PMT_NIL)) for m in Res_meta]
+        Res_label = [pmt.symbol_to_string(pmt.dict_ref(m, pmt.intern('label'), pmt.PMT_NIL)) for m in Res_meta]
+        Res_state = [pmt.to_long(pmt.dict_ref(m, pmt.intern('sync_state'), pmt.PMT_NIL)) for m in Res_meta]
+        Res_crc = [pmt.to_bool(pmt.dict_ref(m, pmt.intern('crc_ok'), pmt.PMT_F)) for m in Res_meta]
+        Exp_state = [1, 1] + [2]*(NumOfPDUs - 2)  # first header and one more to verify, then locked
+
+        print()
+        print("***************************")
+        print("Test 5:")
+        print("Number of sent PDUs = ", NumOfPDUs)
+        print("Number of received PDUs = ", len(Res_data))
+        print("Sync states = ", Res_state)
+
+        self.assertTrue(bDone)
+        self.assertTrue(txBlock.get_LengthField())
+        self.assertTrue(rxBlock.get_LengthField())
+        self.assertEqual(Res_data, Payloads)  # not padded
+        self.assertEqual(Res_counter, list(range(0, NumOfPDUs)))
+        self.assertEqual(Res_label, [Label]*NumOfPDUs)
+        self.assertEqual(Res_state, Exp_state)
+        self.assertEqual(Res_crc, [True]*NumOfPDUs)
+
+
+    def test_006_t(self):  # test 6: 48 bit counter field
+        NumOfPackets = 40
+        PacketSize = 20
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Label = 'L1'
+        CounterLen = 48
+        HeaderSpB = 2
+
+        Data = [(x % 100) + 2 for x in range(0, NumOfPackets*PacketSize)]
+
+        src = blocks.vector_source_b(Data)
+        testBlock = Hybrid_Comm.Add_Header(PacketSize, Preamble, Label, HeaderSpB, False, False, False, CounterLen)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, testBlock)
+        self.tb.connect(testBlock, dst)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock = list(dst.data())
+
+        Preamble_b = self.Char2Str(Preamble)
+        Label_b = [((bin(ord(x)).replace('b', '0'))[-1::-1])[0:8] for x in Label]
+        Output_arr = []
+        for i in range(0, NumOfPackets):
+            Header_str = Preamble_b + self.Char2Str(Label_b) + self.Num2Bin(i, CounterLen)[-1::-1]
+            Output_arr += [ord(x) - ord('0') for x in self.rectpulse(Header_str, HeaderSpB)] + Data[i*PacketSize:(i + 1)*PacketSize]
+            pass
+
+        print()
+        print("***************************")
+        print("Test 6:")
+        print("Number of output samples = ", len(resBlock))
+
+        self.assertEqual(testBlock.get_SeqBits(), CounterLen)
+        self.assertEqual(resBlock, Output_arr)
+
+
+    def test_007_t(self):  # test 7: packed mode; the packets of the unpacked block, 8 bits per byte
+        NumOfPackets = 12
+        PacketSize = 20  # bytes
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0)
+        Label = 'PK'
+        HeaderSpB = 2
+
+        Data = numpy.random.randint(0, 256, NumOfPackets*PacketSize, dtype=numpy.uint8).tolist()
+
+        src_p = blocks.vector_source_b(Data)
+        src_u = blocks.vector_source_b(Data)
+        testBlock = Hybrid_Comm.Add_Header(PacketSize, Preamble, Label, HeaderSpB, False, True, False, 16, True)
+        refBlock = Hybrid_Comm.Add_Header(8*PacketSize*HeaderSpB, Preamble, Label, HeaderSpB, False, True)
+        unpack_p = Hybrid_Comm.Unpack_Bits(HeaderSpB)
+        unpack_u = Hybrid_Comm.Unpack_Bits(HeaderSpB)
+        dst_p = blocks.vector_sink_b()
+        dst_u = blocks.vector_sink_b()
+        self.tb.connect(src_p, testBlock, unpack_p, dst_p)
+        self.tb.connect(src_u, unpack_u, refBlock, dst_u)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock = dst_p.data()
+        refOutput = dst_u.data()
+        OutPacketSize = (len(Preamble) + 8*len(Label) + 16 + 32)*HeaderSpB + 8*PacketSize*HeaderSpB
+
+        print()
+        print("***************************")
+        print("Test 7:")
+        print("Packed output length = ", len(resBlock))
+        print("Unpacked output length = ", len(refOutput))
+
+        self.assertTrue(testBlock.get_Packed())
+        self.assertEqual(testBlock.get_SamplesPerBit(), HeaderSpB)
+        self.assertEqual(len(resBlock), NumOfPackets*OutPacketSize)
+        self.assertEqual(resBlock, refOutput)
+
+
+    def test_008_t(self):  # test 8: PDUs of an Ethernet MTU at 8 samples per bit; the length field holds the payload bits
+        NumOfPDUs = 4
+        NumOfBytes = 1500
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Label = 'L1'
+        HeaderSpB = 8
+        PacketSize = NumOfBytes*8*HeaderSpB  # beyond the 65535 samples of the length field
+
+        Payloads = [[random.randint(0, 255) for x in range(0, NumOfBytes - i)] for i in range(0, NumOfPDUs)]
+
+        txBlock = Hybrid_Comm.Add_Header(PacketSize, Preamble, Label, HeaderSpB, True, True, True)
+        rxBlock = Hybrid_Comm.Remove_Header(PacketSize, Preamble, Label, HeaderSpB, False, True, True, True)
+        dst = blocks.message_debug()
+        self.tb.connect(txBlock, rxBlock)
+        self.tb.msg_connect((rxBlock, 'pdu'), (dst, 'store'))
+
+        # set up fg
+        self.tb.start()
+        for Payload in Payloads:
+            txBlock.to_basic_block()._post(pmt.intern('pdu'), pmt.cons(pmt.make_dict(), pmt.init_u8vector(len(Payload), Payload)))
+            pass
+        bDone = self.WaitForMessages(dst, NumOfPDUs)
+        self.tb.stop()
+        self.tb.wait()
+        # check data
+        Res_data = [list(pmt.u8vector_elements(pmt.cdr(dst.get_message(i)))) for i in range(0, dst.num_messages())]
+
+        print()
+        print("***************************")
+        print("Test 8:")
+        print("Number of sent PDUs = ", NumOfPDUs)
+        print("Number of received PDUs = ", len(Res_data))
+
+        self.assertTrue(bDone)
+        self.assertEqual(txBlock.get_PacketSize(), PacketSize)
+        self.assertEqual(rxBlock.get_PacketSize(), PacketSize)
+        self.assertEqual(Res_data, Payloads)
+        with self.assertRaises((ValueError, RuntimeError)):  # a stream packet longer than the length field holds is rejected, not cut
+            Hybrid_Comm.Add_Header(70000, Preamble, Label, HeaderSpB, False, False, True)
+        with self.assertRaises((ValueError, RuntimeError)):
+            Hybrid_Comm.Remove_Header(70000, Preamble, Label, HeaderSpB, False, False, False, True)
+
+
+    def test_009_t(self):  # test 9: tagged packets longer than the packet size are dropped, not cut into two packets
+        PacketSize = 20
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Label = 'L1'
+        HeaderSpB = 2
+        Lengths = [5, 30, 12, 20, 45, 8]  # 30 and 45 are over-long
+
+        Packets = [numpy.random.randint(0, 2, n).tolist() for n in Lengths]
+        Kept = [p for p in Packets if len(p) <= PacketSize]
+
+        src = blocks.vector_source_b(sum(Packets, []), False, 1, self.LengthTags(Packets))
+        ref = blocks.vector_source_b(sum(Kept, []), False, 1, self.LengthTags(Kept))
+        testBlock = Hybrid_Comm.Add_Header(PacketSize, Preamble, Label, HeaderSpB, False, True, True)
+        refBlock = Hybrid_Comm.Add_Header(PacketSize, Preamble, Label, HeaderSpB, False, True, True)
+        dst = blocks.vector_sink_b()
+        dst_ref = blocks.vector_sink_b()
+        self.tb.connect(src, testBlock, dst)
+        self.tb.connect(ref, refBlock, dst_ref)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock = dst.data()
+        refOutput = dst_ref.data()
+
+        print()
+        print("***************************")
+        print("Test 9:")
+        print("Output length = ", len(resBlock))
+        print("Expected output length = ", len(refOutput))
+
+        self.assertTrue(len(refOutput) > 0)
+        self.assertEqual(resBlock, refOutput)  # same packets and counters as without the over-long ones
+
+
     def rectpulse(self, inArray, SpS):
         flatten = lambda l: [item for sublist in l for item in sublist]
         outArray = [[bit,]*SpS for bit in inArray]
@@ -171,6 +466,28 @@ class qa_Add_Header(gr_unittest.TestCase):
         return numpy.array(outArray)
         
 
+    def LengthTags(self, Packets):  # a 'packet_len' tag at the start of each packet
+        Tags = []
+        iOffset = 0
+        for Packet in Packets:
+            Tag = gr.tag_t()
+            Tag.offset = iOffset
+            Tag.key = pmt.intern('packet_len')
+            Tag.value = pmt.from_long(len(Packet))
+            Tags.append(Tag)
+            iOffset += len(Packet)
+            pass
+        return Tags
+
+
+    def WaitForMessages(self, dst, NumOfMessages, Timeout = 10.0):  # poll the message sink until the messages arrive or the time is out
+        fEnd = time.time() + Timeout
+        while (dst.num_messages() < NumOfMessages) and (time.time() < fEnd):
+            time.sleep(0.01)
+            pass
+        return dst.num_messages() == NumOfMessages
+
+
     def Num2Bin(self, Number, Length = 8):
         Res = '{0:{width}{base}}'.format(Number, width = Length, base = 'b')
         return Res.replace(" ", "0")
@@ -274,6 +274,55 @@ class qa_Link_Tester(gr_unittest.TestCase):
         self.assertAlmostEqual(LT, samp_rate/SampPerBit)        
 
 
+    def test_005_t(self):  # test: packed BER; 8 bits per byte
+        NumOfBytes = 1000
+        PacketSize = 100
+        samp_rate = 1e3
+
+        Bytes_1 = numpy.random.randint(0, 256, NumOfBytes, dtype=numpy.uint8)
+        Bytes_2 = numpy.random.randint(0, 256, NumOfBytes, dtype=numpy.uint8)
+        Bytes_2[0:NumOfBytes//2] = Bytes_1[0:NumOfBytes//2]  # first half without errors
+
+        ctl_sig = [1]*NumOfBytes
+        spb_sig = [2]*NumOfBytes
+
+        l1 = blocks.vector_source_b(Bytes_1.tolist())
+        l2 = blocks.vector_source_b(Bytes_2.tolist())
+        ctl = blocks.vector_source_b(ctl_sig)
+        sbp = blocks.vector_source_b(spb_sig)
+        testBlock = Hybrid_Comm.Link_Tester(PacketSize, samp_rate, True)
+        dst_BER = blocks.vector_sink_f()
+        dst_LA = blocks.vector_sink_f()
+        dst_LT = blocks.vector_sink_f()
+        self.tb.connect(l1, (testBlock, 0))
+        self.tb.connect(l2, (testBlock, 1))
+        self.tb.connect(ctl, (testBlock, 2))
+        self.tb.connect(sbp, (testBlock, 3))
+        self.tb.connect((testBlock, 0), dst_BER)
+        self.tb.connect((testBlock, 1), dst_LA)
+        self.tb.connect((testBlock, 2), dst_LT)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        BER = dst_BER.data()[-1]
+        LA = dst_LA.data()[-1]
+        LT = dst_LT.data()[-1]
+
+        Exp_BER = numpy.sum(numpy.unpackbits(Bytes_1 ^ Bytes_2)) / (8.0*NumOfBytes)
+
+        print("***************************")
+        print("Test packed BER:")
+        print("Expected BER = ", Exp_BER)
+        print("Calculated BER = ", BER)
+
+        self.assertTrue(testBlock.get_Packed())
+        self.assertAlmostEqual(BER, Exp_BER, 4)
+        self.assertAlmostEqual(LA, 100.0, 3)
+        self.assertAlmostEqual(LT, samp_rate/2, 1)  # bit rate of 2 samples per bit
+
+
+
     def rectpulse(self, inArray, SpS):
         flatten = lambda l: [item for sublist in l for item in sublist]
         outArray = [[bit,]*SpS for bit in inArray]
@@ -0,0 +1,101 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2020 gr-Hybrid_Comm author.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import Hybrid_Comm_swig as Hybrid_Comm
+import random
+import numpy
+import math
+import time
+
+class qa_Pack_Bits(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def test_001_t(self):  # one sample per bit
+        NoB = 8*100  # number of bits
+        SpB = 1
+
+        Bits = numpy.random.randint(0, 2, NoB)
+        Sig = Bits.tolist()
+
+        src = blocks.vector_source_b(Sig)
+        testBlock = Hybrid_Comm.Pack_Bits(SpB)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, testBlock)
+        self.tb.connect(testBlock, dst)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock = dst.data()
+
+        Exp_Res = numpy.packbits(Bits.astype(numpy.uint8)).tolist()  # first bit is the most significant bit
+
+        print()
+        print("***************************")
+        print("Test 1:")
+        print("Number of bits = ", NoB)
+        print("Results length = ", len(resBlock))
+        print()
+
+        self.assertFloatTuplesAlmostEqual(Exp_Res, resBlock, 0)
+
+
+    def test_002_t(self):  # several samples per bit
+        NoB = 8*100  # number of bits
+        SpB = 3
+
+        Bits = numpy.random.randint(0, 2, NoB)
+        Sig = numpy.repeat(Bits, SpB).tolist()
+
+        src = blocks.vector_source_b(Sig)
+        testBlock = Hybrid_Comm.Pack_Bits(SpB)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, testBlock)
+        self.tb.connect(testBlock, dst)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock = dst.data()
+
+        Exp_Res = numpy.packbits(Bits.astype(numpy.uint8)).tolist()
+
+        print()
+        print("***************************")
+        print("Test 2:")
+        print("Number of bits = ", NoB)
+        print("Samples per bit = ", SpB)
+        print("Results length = ", len(resBlock))
+        print()
+
+        self.assertFloatTuplesAlmostEqual(Exp_Res, resBlock, 0)
+
+
+if __name__ == '__main__':
+    numpy.random.seed(int(time.time()))
+    gr_unittest.run(qa_Pack_Bits)
@@ -0,0 +1,133 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2020 gr-Hybrid_Comm author.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import pmt
+import Hybrid_Comm_swig as Hybrid_Comm
+import random
+import numpy
+import math
+import time
+
+class qa_Preamble_Sync(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def Signal(self, Preamble, SpB, NumOfPackets, PacketSize, NoiseStd):  # noisy on-off keyed packets, each starting with the preamble
+        Rand = numpy.random.RandomState(7)  # same signal every run
+        Bits = []
+        Starts = []
+        for i in range(0, NumOfPackets):
+            Starts.append(len(Bits)*SpB)
+            Bits += list(Preamble) + Rand.randint(0, 2, PacketSize).tolist()
+            pass
+        Sig = numpy.repeat(numpy.array(Bits, dtype=float), SpB) + 0.5  # levels 0.5 and 1.5
+        Sig += Rand.normal(0, NoiseStd, len(Sig))
+        return Sig.tolist(), Starts
+
+
+    def test_001_t(self):  # short preamble; direct correlation
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0, 0, 1, 0, 0, 1, 1, 0, 1, 0)
+        SpB = 2
+        NumOfPackets = 20
+        PacketSize = 100
+        NoiseStd = 0.1
+
+        Sig, Starts = self.Signal(Preamble, SpB, NumOfPackets, PacketSize, NoiseStd)
+
+        src = blocks.vector_source_f(Sig)
+        testBlock = Hybrid_Comm.Preamble_Sync(Preamble, SpB, 0.9)
+        dst = blocks.vector_sink_f()
+        dst_corr = blocks.vector_sink_f()
+        self.tb.connect(src, testBlock)
+        self.tb.connect((testBlock, 0), dst)
+        self.tb.connect((testBlock, 1), dst_corr)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock = dst.data()
+        Tags = [t for t in dst.tags() if pmt.symbol_to_string(t.key) == 'preamble_start']
+        Res_start = [t.offset for t in Tags]
+        Res_peak = [pmt.to_double(pmt.dict_ref(t.value, pmt.intern('corr_peak'), pmt.PMT_NIL)) for t in Tags]
+        Res_snr = [pmt.to_double(pmt.dict_ref(t.value, pmt.intern('snr'), pmt.PMT_NIL)) for t in Tags]
+        Delay = testBlock.get_Delay()
+        Exp_start = [s + Delay for s in Starts if s + Delay < len(Sig)]
+        Exp_snr = 10*math.log10(0.25/NoiseStd**2)  # signal and noise power over the preamble
+
+        print()
+        print("***************************")
+        print("Test 1:")
+        print("Preamble starts = ", Res_start)
+        print("Correlation peaks = ", Res_peak)
+        print("SNR estimates = ", Res_snr)
+
+        self.assertFalse(testBlock.get_Fft())
+        self.assertEqual(Delay, 2*len(Preamble)*SpB - 1)
+        self.assertEqual(Res_start, Exp_start)
+        self.assertFloatTuplesAlmostEqual(resBlock[Delay:], Sig[:len(Sig) - Delay], 6)
+        self.assertTrue(min(Res_peak) >= 0.9)
+        self.assertTrue(abs(numpy.mean(Res_snr) - Exp_snr) < 2.0)
+
+
+    def test_002_t(self):  # long preamble; FFT correlation at an SNR the sliced bits would not survive
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0, 0, 1, 0, 0, 1, 1, 0, 1, 0)
+        SpB = 32  # 1024 samples; correlated by FFT on any CPU
+        NumOfPackets = 10
+        PacketSize = 50
+        NoiseStd = 0.6
+
+        Sig, Starts = self.Signal(Preamble, SpB, NumOfPackets, PacketSize, NoiseStd)
+
+        src = blocks.vector_source_f(Sig)
+        testBlock = Hybrid_Comm.Preamble_Sync(Preamble, SpB, 0.45)
+        dst = blocks.vector_sink_f()
+        self.tb.connect(src, testBlock)
+        self.tb.connect(testBlock, dst)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        Tags = [t for t in dst.tags() if pmt.symbol_to_string(t.key) == 'preamble_start']
+        Res_start = [t.offset for t in Tags]
+        Delay = testBlock.get_Delay()
+        Exp_start = [s + Delay for s in Starts if s + Delay < len(Sig)]
+
+        print()
+        print("***************************")
+        print("Test 2:")
+        print("Preamble starts = ", Res_start)
+        print("Expected starts = ", Exp_start)
+
+        self.assertTrue(testBlock.get_Fft())
+        self.assertEqual(len(Res_start), len(Exp_start))
+        for r, e in zip(Res_start, Exp_start):
+            self.assertTrue(abs(r - e) <= SpB//2)  # within half a bit
+
+
+if __name__ == '__main__':
+    numpy.random.seed(int(time.time()))
+    gr_unittest.run(qa_Preamble_Sync)
@@ -21,11 +21,13 @@
 
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
+import pmt
 import Hybrid_Comm_swig as Hybrid_Comm
 import random
 import numpy
 import math
 import time
+import zlib
 
 class qa_Remove_Header(gr_unittest.TestCase):
 
@@ -274,6 +276,361 @@ class qa_Remove_Header(gr_unittest.TestCase):
         self.assertAlmostEqual(Res_data, 0)
 
 
+    def test_004_t(self):  # test 4: a corrupted header is skipped while the lock is kept
+        NumOfPackets = 40
+        PacketSize = 50
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Label = 'R'
+        CounterLen = 16
+        HeaderSpB = 2
+        BadPacket = 5
+
+        Preamble_b = self.Char2Str(Preamble)
+        Label_b = [((bin(ord(x)).replace('b', '0'))[-1::-1])[0:8] for x in Label]
+        Data = [(x % 100) + 2 for x in range(0, PacketSize)]  # never matches the header bits
+        Stream = []
+        for i in range(0, NumOfPackets):
+            Header_str = Preamble_b + self.Char2Str(Label_b) + self.Num2Bin(i, CounterLen)[-1::-1]
+            H_arr = [ord(x) - ord('0') for x in self.rectpulse(Header_str, HeaderSpB)]
+            if i == BadPacket:
+                H_arr[0] = 1 - H_arr[0]  # one corrupted preamble bit
+            Stream += H_arr + Data
+            pass
+
+        src = blocks.vector_source_b(Stream)
+        testBlock = Hybrid_Comm.Remove_Header(PacketSize, Preamble, Label, HeaderSpB)
+        dst_out = blocks.vector_sink_b()
+        dst_sync = blocks.vector_sink_b()
+        dst_counter = blocks.vector_sink_i()
+        self.tb.connect(src, testBlock)
+        self.tb.connect((testBlock, 0), dst_out)
+        self.tb.connect((testBlock, 1), dst_sync)
+        self.tb.connect((testBlock, 2), dst_counter)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_sync = dst_sync.data()
+        resBlock_counter = dst_counter.data()
+
+        Res_counter = [c for s, c in zip(resBlock_sync, resBlock_counter) if s == 1]
+        Exp_counter = [x for x in range(0, NumOfPackets) if x != BadPacket]
+
+        print()
+        print("***************************")
+        print("Test 4:")
+        print("Counter values = ", Res_counter)
+        print("Sync state = ", testBlock.get_SyncState())
+
+        self.assertEqual(Res_counter[0:30], Exp_counter[0:30])
+        self.assertEqual(testBlock.get_SyncState(), 2)  # locked
+        self.assertEqual(testBlock.get_MaxMisses(), 3)
+
+
+    def test_005_t(self):  # test 5: tag mode; packet starts and counters are stream tags
+        NumOfPackets = 20
+        PacketSize = 50
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Label = 'R'
+        CounterLen = 16
+        HeaderSpB = 1
+
+        Preamble_b = self.Char2Str(Preamble)
+        Label_b = [((bin(ord(x)).replace('b', '0'))[-1::-1])[0:8] for x in Label]
+        Data = [(x % 100) + 2 for x in range(0, PacketSize)]  # never matches the header bits
+        Stream = []
+        for i in range(0, NumOfPackets):
+            Header_str = Preamble_b + self.Char2Str(Label_b) + self.Num2Bin(i, CounterLen)[-1::-1]
+            Stream += [ord(x) - ord('0') for x in self.rectpulse(Header_str, HeaderSpB)] + Data
+            pass
+
+        src = blocks.vector_source_b(Stream)
+        testBlock = Hybrid_Comm.Remove_Header(PacketSize, Preamble, Label, HeaderSpB, True)
+        dst_out = blocks.vector_sink_b()
+        self.tb.connect(src, testBlock)
+        self.tb.connect((testBlock, 0), dst_out)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_out = dst_out.data()
+        Tags = dst_out.tags()
+        Res_start = [t.offset for t in Tags if pmt.symbol_to_string(t.key) == 'packet_start']
+        Res_counter = [pmt.to_long(t.value) for t in Tags if pmt.symbol_to_string(t.key) == 'seq']
+
+        print()
+        print("***************************")
+        print("Test 5:")
+        print("Packet starts = ", Res_start)
+        print("Counter values = ", Res_counter)
+
+        self.assertTrue(testBlock.get_TagMode())
+        self.assertEqual(list(resBlock_out[0:PacketSize]), Data)
+        self.assertEqual(list(resBlock_out), Data*NumOfPackets)  # the last packet is complete; it does not wait for another header
+        self.assertEqual(Res_start, [x*PacketSize for x in range(0, NumOfPackets)])
+        self.assertEqual(Res_counter, list(range(0, NumOfPackets)))
+
+
+    def test_006_t(self):  # test 6: CRC field; a packet with a corrupted data bit is dropped
+        NumOfPackets = 30
+        PacketSize = 40
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Label = 'R'
+        CounterLen = 16
+        CrcLen = 32
+        HeaderSpB = 2
+        BadPacket = 7
+
+        Preamble_b = self.Char2Str(Preamble)
+        Label_b = [((bin(ord(x)).replace('b', '0'))[-1::-1])[0:8] for x in Label]
+        DataBits = [(x + 1) % 2 for x in range(0, PacketSize//HeaderSpB)]  # 1, 0, 1, ...; never matches the header bits
+        Data = [b for b in DataBits for s in range(0, HeaderSpB)]
+        DataBytes = [int(self.Char2Str((DataBits[k:k + 8] + [0]*8)[0:8]), 2) for k in range(0, len(DataBits), 8)]  # first bit in the most significant bit; last byte filled up with 0s
+        Stream = []
+        for i in range(0, NumOfPackets):
+            Header_str = Preamble_b + self.Char2Str(Label_b) + self.Num2Bin(i, CounterLen)[-1::-1]
+            Crc = zlib.crc32(bytes([i & 0xFF, (i >> 8) & 0xFF] + DataBytes)) & 0xFFFFFFFF  # CRC of the counter bytes and the packed data bits
+            Crc_str = self.Num2Bin(Crc, CrcLen)[-1::-1]
+            Packet = list(Data)
+            if i == BadPacket:
+                Packet[3*HeaderSpB:4*HeaderSpB] = [1 - DataBits[3]]*HeaderSpB  # one corrupted data bit
+            Stream += [ord(x) - ord('0') for x in self.rectpulse(Header_str, HeaderSpB)] + Packet + [ord(x) - ord('0') for x in self.rectpulse(Crc_str, HeaderSpB)]
+            pass
+
+        src = blocks.vector_source_b(Stream)
+        testBlock = Hybrid_Comm.Remove_Header(PacketSize, Preamble, Label, HeaderSpB, False, False, True)
+        dst_out = blocks.vector_sink_b()
+        dst_sync = blocks.vector_sink_b()
+        dst_counter = blocks.vector_sink_i()
+        self.tb.connect(src, testBlock)
+        self.tb.connect((testBlock, 0), dst_out)
+        self.tb.connect((testBlock, 1), dst_sync)
+        self.tb.connect((testBlock, 2), dst_counter)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_out = dst_out.data()
+        resBlock_sync = dst_sync.data()
+        resBlock_counter = dst_counter.data()
+
+        Res_counter = [c for s, c in zip(resBlock_sync, resBlock_counter) if s == 1]
+        Exp_counter = [x for x in range(0, NumOfPackets) if x != BadPacket]
+        Res_crc = [(t.offset//PacketSize, pmt.to_bool(t.value)) for t in dst_out.tags() if pmt.symbol_to_string(t.key) == 'crc_ok']  # (output packet, CRC result)
+
+        print()
+        print("***************************")
+        print("Test 6:")
+        print("Counter values = ", Res_counter)
+        print("CRC results = ", Res_crc)
+
+        self.assertTrue(testBlock.get_Crc())
+        self.assertEqual(list(resBlock_out[0:PacketSize]), Data)
+        self.assertTrue(BadPacket not in Res_counter)
+        self.assertEqual(Res_counter[0:20], Exp_counter[0:20])
+        self.assertEqual([r for p, r in Res_crc].count(False), 1)
+        self.assertEqual(resBlock_counter[[p for p, r in Res_crc if r == False][0]*PacketSize], -1)  # the dropped packet has the counter -1
+
+
+    def test_007_t(self):  # test 7: several labels; the packets of each label go to the output of its flow
+        NumOfPackets = 60
+        PacketSize = 40
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Labels = ['RA', 'RB', 'RC']  # 'RC' has no flow
+        CounterLen = 16
+        HeaderSpB = 2
+
+        Preamble_b = self.Char2Str(Preamble)
+        Data = [[(x % 90) + 2 + 3*f for x in range(0, PacketSize)] for f in range(0, len(Labels))]  # never matches the header bits
+        Counters = [0]*len(Labels)
+        Stream = []
+        for i in range(0, NumOfPackets):
+            f = (i*7 + i//3) % len(Labels)  # label of the packet
+            Label_b = [((bin(ord(x)).replace('b', '0'))[-1::-1])[0:8] for x in Labels[f]]
+            Header_str = Preamble_b + self.Char2Str(Label_b) + self.Num2Bin(Counters[f], CounterLen)[-1::-1]
+            Stream += [ord(x) - ord('0') for x in self.rectpulse(Header_str, HeaderSpB)] + Data[f]
+            Counters[f] += 1
+            pass
+
+        src = blocks.vector_source_b(Stream)
+        testBlock = Hybrid_Comm.Remove_Header(PacketSize, Preamble, 'RA,RB', HeaderSpB)
+        dst_out = [blocks.vector_sink_b(), blocks.vector_sink_b()]
+        self.tb.connect(src, testBlock)
+        self.tb.connect((testBlock, 0), dst_out[0])
+        self.tb.connect((testBlock, 1), dst_out[1])
+
+        # set up fg
+        self.tb.run()
+        # check data
+        print()
+        print("***************************")
+        print("Test 7:")
+
+        self.assertEqual(testBlock.get_NumOfFlows(), 2)
+        self.assertTrue(testBlock.get_TagMode())
+        for f in range(0, 2):  # go through the flows
+            resBlock_out = dst_out[f].data()
+            Tags = dst_out[f].tags()
+            Res_start = [t.offset for t in Tags if pmt.symbol_to_string(t.key) == 'packet_start']
+            Res_counter = [pmt.to_long(t.value) for t in Tags if pmt.symbol_to_string(t.key) == 'seq']
+            print("Flow", f, "counter values = ", Res_counter)
+
+            self.assertEqual(list(resBlock_out), Data[f]*Counters[f])
+            self.assertEqual(Res_start, [x*PacketSize for x in range(0, Counters[f])])
+            self.assertEqual(Res_counter, list(range(0, Counters[f])))
+
+
+    def test_008_t(self):  # test 8: length field; every packet gives exactly its data
+        NumOfPackets = 30
+        PacketSize = 60
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Label = 'R'
+        CounterLen = 16
+        LengthLen = 16
+        HeaderSpB = 2
+
+        Preamble_b = self.Char2Str(Preamble)
+        Label_b = [((bin(ord(x)).replace('b', '0'))[-1::-1])[0:8] for x in Label]
+        Lengths = [random.randint(1, PacketSize) for i in range(0, NumOfPackets)]
+        Data = [[(x % 100) + 2 for x in range(i, i + Lengths[i])] for i in range(0, NumOfPackets)]  # never matches the header bits
+        Stream = []
+        for i in range(0, NumOfPackets):
+            Header_str = Preamble_b + self.Char2Str(Label_b) + self.Num2Bin(i, CounterLen)[-1::-1] + self.Num2Bin(Lengths[i], LengthLen)[-1::-1]
+            Stream += [ord(x) - ord('0') for x in self.rectpulse(Header_str, HeaderSpB)] + Data[i]
+            pass
+
+        src = blocks.vector_source_b(Stream)
+        testBlock = Hybrid_Comm.Remove_Header(PacketSize, Preamble, Label, HeaderSpB, True, False, False, True)
+        dst_out = blocks.vector_sink_b()
+        self.tb.connect(src, testBlock)
+        self.tb.connect((testBlock, 0), dst_out)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_out = dst_out.data()
+        Tags = dst_out.tags()
+        Res_start = [t.offset for t in Tags if pmt.symbol_to_string(t.key) == 'packet_start']
+        Res_length = [pmt.to_long(t.value) for t in Tags if pmt.symbol_to_string(t.key) == 'packet_len']
+        Res_counter = [pmt.to_long(t.value) for t in Tags if pmt.symbol_to_string(t.key) == 'seq']
+
+        print()
+        print("***************************")
+        print("Test 8:")
+        print("Packet lengths = ", Res_length)
+        print("Counter values = ", Res_counter)
+
+        self.assertTrue(testBlock.get_LengthField())
+        self.assertEqual(Res_counter, list(range(0, NumOfPackets)))
+        self.assertEqual(Res_length, Lengths)
+        self.assertEqual(Res_start, [sum(Lengths[0:i]) for i in range(0, NumOfPackets)])
+        self.assertEqual(list(resBlock_out), [x for d in Data for x in d])
+
+
+    def test_009_t(self):  # test 9: packed mode; headers at a bit offset of the packed input
+        NumOfPackets = 20
+        PacketSize = 16  # bytes
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1)  # led by 3 '0's in packed mode
+        Label = 'PK'
+        HeaderSpB = 2
+        BitOffset = 3
+
+        Data = numpy.random.randint(0, 256, NumOfPackets*PacketSize, dtype=numpy.uint8)
+
+        # packed packets of Add_Header
+        src = blocks.vector_source_b(Data.tolist())
+        txBlock = Hybrid_Comm.Add_Header(PacketSize, Preamble, Label, HeaderSpB, False, True, False, 16, True)
+        dst_tx = blocks.vector_sink_b()
+        self.tb.connect(src, txBlock, dst_tx)
+        self.tb.run()
+
+        # the channel bits, packed again from 'BitOffset' bits later
+        Bits = numpy.unpackbits(numpy.array(dst_tx.data(), dtype=numpy.uint8))
+        Bits = numpy.concatenate((numpy.zeros(BitOffset, dtype=numpy.uint8), Bits, numpy.zeros(8 - BitOffset, dtype=numpy.uint8)))
+        Stream = numpy.packbits(Bits).tolist()
+
+        self.tb = gr.top_block()
+        src = blocks.vector_source_b(Stream)
+        testBlock = Hybrid_Comm.Remove_Header(PacketSize, Preamble, Label, HeaderSpB, True, False, True, False, 16, True)
+        dst_out = blocks.vector_sink_b()
+        self.tb.connect(src, testBlock)
+        self.tb.connect((testBlock, 0), dst_out)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_out = dst_out.data()
+        Tags = dst_out.tags()
+        Res_counter = [pmt.to_long(t.value) for t in Tags if pmt.symbol_to_string(t.key) == 'seq']
+        Res_crc = [pmt.to_bool(t.value) for t in Tags if pmt.symbol_to_string(t.key) == 'crc_ok']
+
+        print()
+        print("***************************")
+        print("Test 9:")
+        print("Counter values = ", Res_counter)
+        print("CRC results = ", Res_crc)
+
+        self.assertTrue(testBlock.get_Packed())
+        self.assertEqual(Res_counter, list(range(0, NumOfPackets)))
+        self.assertEqual(Res_crc, [True]*NumOfPackets)
+        self.assertEqual(list(resBlock_out), Data.tolist())
+
+
+    def test_010_t(self):  # test 10: weak signal; headers taken at the preamble tags of Preamble_Sync, through Slicer
+        NumOfPackets = 20
+        PacketSize = 400
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1, 0, 0, 1, 0, 0, 1, 1, 0, 1, 0)
+        Label = 'W'
+        CounterLen = 16
+        HeaderSpB = 8
+        NoiseStd = 0.25
+
+        Preamble_b = self.Char2Str(Preamble)
+        Label_b = [((bin(ord(x)).replace('b', '0'))[-1::-1])[0:8] for x in Label]
+        Rand = numpy.random.RandomState(7)  # same signal every run
+        Bits = []
+        for i in range(0, NumOfPackets):
+            Header_str = Preamble_b + self.Char2Str(Label_b) + self.Num2Bin(i, CounterLen)[-1::-1]
+            Bits += [ord(x) - ord('0') for x in Header_str] + Rand.randint(0, 2, PacketSize//HeaderSpB).tolist()
+            pass
+        Bits += [0]*(2*len(Preamble))  # room for the delay of Preamble_Sync
+        Sig = numpy.repeat(numpy.array(Bits, dtype=float), HeaderSpB) + 0.5  # levels 0.5 and 1.5
+        Sig += Rand.normal(0, NoiseStd, len(Sig))
+
+        Res_counter = []
+        Res_upstream = []  # tags of Preamble_Sync at the output; none pass the block
+        for bSync in [False, True]:  # sliced directly, then after Preamble_Sync
+            self.tb = gr.top_block()
+            src = blocks.vector_source_f(Sig.tolist())
+            syncBlock = Hybrid_Comm.Preamble_Sync(Preamble, HeaderSpB, 0.5)
+            sliceBlock = Hybrid_Comm.Slicer(HeaderSpB, 3, 1.0)
+            testBlock = Hybrid_Comm.Remove_Header(PacketSize, Preamble, Label, HeaderSpB, True)
+            dst_out = blocks.vector_sink_b()
+            if bSync == True:
+                self.tb.connect(src, syncBlock, sliceBlock, testBlock)
+            else:
+                self.tb.connect(src, sliceBlock, testBlock)
+            self.tb.connect((testBlock, 0), dst_out)
+
+            # set up fg
+            self.tb.run()
+            # check data
+            Tags = dst_out.tags()
+            Res_counter.append([pmt.to_long(t.value) for t in Tags if pmt.symbol_to_string(t.key) == 'seq'])
+            Res_upstream += [t.offset for t in Tags if pmt.symbol_to_string(t.key) == 'preamble_start']
+            pass
+
+        print()
+        print("***************************")
+        print("Test 10:")
+        print("Counter values without preamble tags = ", Res_counter[0])
+        print("Counter values with preamble tags = ", Res_counter[1])
+
+        self.assertTrue(len(Res_counter[0]) < NumOfPackets)  # some sliced headers have wrong samples
+        self.assertEqual(Res_counter[1], list(range(0, NumOfPackets)))
+        self.assertEqual(Res_upstream, [])
+
+
     def rectpulse(self, inArray, SpS):
         flatten = lambda l: [item for sublist in l for item in sublist]
         outArray = [[bit,]*SpS for bit in inArray]
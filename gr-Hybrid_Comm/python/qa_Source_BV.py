@@ -152,6 +152,78 @@ class qa_Source_BV(gr_unittest.TestCase):
         self.assertAlmostEqual(sig_e, sig_c, 0)
 
 
+    def test_004_t(self):  # reproducible seeded mode
+        NumOfChunk = 100
+        PacketSize = 1000
+        N = PacketSize * NumOfChunk
+        SigType = "Random"  # random signal
+        BpW_elem = (20, 50)  # bits per window
+        Seed = 1234
+
+        bpw_Ar = numpy.random.randint(0, 2, N, dtype=numpy.int8) * (BpW_elem[1] - BpW_elem[0]) + BpW_elem[0]
+        BPW = bpw_Ar.tolist()
+
+        # blocks 0 and 1 share the substream, block 2 uses the next one
+        src = blocks.vector_source_b(BPW)
+        testBlock = [Hybrid_Comm.Source_BV(PacketSize, SigType, Seed, streamId) for streamId in (0, 0, 1)]
+        dst = [blocks.vector_sink_b() for index in range(3)]
+        for index in range(3):
+            self.tb.connect(src, testBlock[index])
+            self.tb.connect((testBlock[index], 0), dst[index])
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock = [d.data() for d in dst]
+
+        print()        
+        print("***************************")
+        print("Seed = ", Seed)
+        print()        
+        print("Reproducible source test:")
+        print("Same substream outputs are equal: ", resBlock[0] == resBlock[1])
+        print("Different substream outputs are equal: ", resBlock[0] == resBlock[2])
+        print()
+
+        # same (seed, stream id) must repeat; different stream id must not
+        self.assertEqual(resBlock[0], resBlock[1])
+        self.assertNotEqual(resBlock[0], resBlock[2])
+
+
+    def test_005_t(self):  # packed mode; the bits of the unpacked source, 8 per byte
+        NumOfChunk = 20
+        PacketSize = 25  # bytes
+        SampPerBit = 3
+        SigType = "Random"  # random signal
+        Seed = 4321
+
+        src_p = blocks.vector_source_b([SampPerBit]*PacketSize*NumOfChunk)
+        src_u = blocks.vector_source_b([SampPerBit]*8*PacketSize*SampPerBit*NumOfChunk)
+        testBlock = Hybrid_Comm.Source_BV(PacketSize, SigType, Seed, 0, True)
+        refBlock = Hybrid_Comm.Source_BV(8*PacketSize*SampPerBit, SigType, Seed, 0)
+        unpack = Hybrid_Comm.Unpack_Bits(SampPerBit)
+        dst_p = blocks.vector_sink_b()
+        dst_u = blocks.vector_sink_b()
+        self.tb.connect(src_p, testBlock, unpack, dst_p)
+        self.tb.connect(src_u, refBlock, dst_u)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock = dst_p.data()
+        refOutput = dst_u.data()
+
+        print()
+        print("***************************")
+        print("Packed source test:")
+        print("Unpacked outputs are equal: ", resBlock == refOutput)
+        print()
+
+        self.assertTrue(testBlock.get_Packed())
+        self.assertEqual(len(resBlock), 8*PacketSize*SampPerBit*NumOfChunk)
+        self.assertEqual(resBlock, refOutput)
+
+
 if __name__ == '__main__':
     numpy.random.seed(int(time.time()))
     gr_unittest.run(qa_Source_BV)
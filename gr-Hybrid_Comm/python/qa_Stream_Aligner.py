@@ -21,6 +21,7 @@
 
 from gnuradio import gr, gr_unittest
 from gnuradio import blocks
+import pmt
 import Hybrid_Comm_swig as Hybrid_Comm
 import random
 import numpy
@@ -150,6 +151,508 @@ class qa_Stream_Aligner(gr_unittest.TestCase):
         self.assertAlmostEqual(Res_3, 0)
 
 
+    def test_002_t(self):  # test 2: the counters wrap; the delay is taken across the wrap
+        N = 50
+        PacketSize = 2
+        Delay = 3
+        CounterLen = 16
+        CounterStart = 2**CounterLen - 10
+
+        NumOfPack = int(N/PacketSize)
+        N = PacketSize*NumOfPack
+
+        data_1 = numpy.array(range(0, N))
+        data_2 = numpy.array(range(N, 2*N))
+        sync = numpy.zeros(N, dtype = numpy.byte)
+        sync[0::PacketSize] = 1
+
+        counter_1 = numpy.zeros(N, dtype = numpy.int)
+        counter_1[::PacketSize] = [(CounterStart + Delay + x) % 2**CounterLen for x in range(0, NumOfPack)]
+        counter_2 = numpy.zeros(N, dtype = numpy.int)
+        counter_2[::PacketSize] = [(CounterStart + x) % 2**CounterLen for x in range(0, NumOfPack)]
+
+        Out_Exp_1 = numpy.ones(N, dtype = numpy.byte)*255
+        Out_Exp_1[PacketSize*Delay:] = data_1[:-PacketSize*Delay]
+        Out_Exp_2 = numpy.ones(N, dtype = numpy.byte)*255
+        Out_Exp_2[PacketSize*Delay:] = data_2[PacketSize*Delay:]
+
+        testBlock = Hybrid_Comm.Stream_Aligner(PacketSize, False, CounterLen)
+        dst_stream_1 = blocks.vector_sink_b()
+        dst_stream_2 = blocks.vector_sink_b()
+        dst_delay = blocks.vector_sink_b()
+        self.tb.connect(blocks.vector_source_b(data_1), (testBlock, 0))
+        self.tb.connect(blocks.vector_source_b(sync), (testBlock, 1))
+        self.tb.connect(blocks.vector_source_i(counter_1), (testBlock, 2))
+        self.tb.connect(blocks.vector_source_b(data_2), (testBlock, 3))
+        self.tb.connect(blocks.vector_source_b(sync), (testBlock, 4))
+        self.tb.connect(blocks.vector_source_i(counter_2), (testBlock, 5))
+        self.tb.connect((testBlock, 0), dst_stream_1)
+        self.tb.connect((testBlock, 1), dst_stream_2)
+        self.tb.connect((testBlock, 2), dst_delay)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_stream_1 = dst_stream_1.data()
+        resBlock_stream_2 = dst_stream_2.data()
+        resBlock_delay = dst_delay.data()
+
+        print()
+        print("***************************")
+        print("Test 2:")
+        print("Counter 1 = ", counter_1)
+        print("Counter 2 = ", counter_2)
+        print("Calculated stream 1 = ", resBlock_stream_1)
+        print("Expected stream 1   = ", Out_Exp_1)
+        print("Delay               = ", resBlock_delay)
+
+        self.assertEqual(testBlock.get_SeqBits(), CounterLen)
+        self.assertEqual(list(resBlock_stream_1), list(Out_Exp_1.astype(numpy.uint8)))
+        self.assertEqual(list(resBlock_stream_2), list(Out_Exp_2.astype(numpy.uint8)))
+
+
+    def test_003_t(self):  # test 3: a delay longer than the buffer bank is not taken modulo 256
+        N = 50
+        PacketSize = 2
+        Delay = 256 + 3
+        CounterLen = 32
+
+        NumOfPack = int(N/PacketSize)
+        N = PacketSize*NumOfPack
+
+        data = numpy.array(range(0, N))
+        sync = numpy.zeros(N, dtype = numpy.byte)
+        sync[0::PacketSize] = 1
+
+        counter_1 = numpy.zeros(N, dtype = numpy.int)
+        counter_1[::PacketSize] = range(Delay, NumOfPack + Delay)
+        counter_2 = numpy.zeros(N, dtype = numpy.int)
+        counter_2[::PacketSize] = range(0, NumOfPack)
+
+        testBlock = Hybrid_Comm.Stream_Aligner(PacketSize, False, CounterLen)
+        dst_stream_1 = blocks.vector_sink_b()
+        dst_stream_2 = blocks.vector_sink_b()
+        self.tb.connect(blocks.vector_source_b(data), (testBlock, 0))
+        self.tb.connect(blocks.vector_source_b(sync), (testBlock, 1))
+        self.tb.connect(blocks.vector_source_i(counter_1), (testBlock, 2))
+        self.tb.connect(blocks.vector_source_b(data), (testBlock, 3))
+        self.tb.connect(blocks.vector_source_b(sync), (testBlock, 4))
+        self.tb.connect(blocks.vector_source_i(counter_2), (testBlock, 5))
+        self.tb.connect((testBlock, 0), dst_stream_1)
+        self.tb.connect((testBlock, 1), dst_stream_2)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_stream_1 = dst_stream_1.data()
+        resBlock_stream_2 = dst_stream_2.data()
+
+        print()
+        print("***************************")
+        print("Test 3:")
+        print("Calculated stream 1 = ", resBlock_stream_1)
+        print("Calculated stream 2 = ", resBlock_stream_2)
+
+        self.assertEqual(testBlock.get_SeqBits(), 31)  # counter inputs carry 31 bits
+        self.assertEqual(list(resBlock_stream_1), [253,]*N)  # LONG_DELAY_ERR
+        self.assertEqual(list(resBlock_stream_2), [253,]*N)
+
+
+    def test_004_t(self):  # test 4: a buffer deep enough for the delay of test 3
+        PacketSize = 2
+        Delay = 256 + 3
+        Depth = 300
+        NumOfPack = Delay + 50
+        N = PacketSize*NumOfPack
+
+        data_1 = numpy.array([x % 100 for x in range(0, N)])
+        data_2 = numpy.array([(x*7) % 100 for x in range(0, N)])
+        sync = numpy.zeros(N, dtype = numpy.byte)
+        sync[0::PacketSize] = 1
+
+        counter_1 = numpy.zeros(N, dtype = numpy.int)
+        counter_1[::PacketSize] = range(Delay, NumOfPack + Delay)
+        counter_2 = numpy.zeros(N, dtype = numpy.int)
+        counter_2[::PacketSize] = range(0, NumOfPack)
+
+        Out_Exp_1 = [255,]*(PacketSize*Delay) + list(data_1[:-PacketSize*Delay])
+        Out_Exp_2 = [255,]*(PacketSize*Delay) + list(data_2[PacketSize*Delay:])
+
+        testBlock = Hybrid_Comm.Stream_Aligner(PacketSize, False, 16, Depth)
+        dst_stream_1 = blocks.vector_sink_b()
+        dst_stream_2 = blocks.vector_sink_b()
+        self.tb.connect(blocks.vector_source_b(data_1), (testBlock, 0))
+        self.tb.connect(blocks.vector_source_b(sync), (testBlock, 1))
+        self.tb.connect(blocks.vector_source_i(counter_1), (testBlock, 2))
+        self.tb.connect(blocks.vector_source_b(data_2), (testBlock, 3))
+        self.tb.connect(blocks.vector_source_b(sync), (testBlock, 4))
+        self.tb.connect(blocks.vector_source_i(counter_2), (testBlock, 5))
+        self.tb.connect((testBlock, 0), dst_stream_1)
+        self.tb.connect((testBlock, 1), dst_stream_2)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_stream_1 = dst_stream_1.data()
+        resBlock_stream_2 = dst_stream_2.data()
+
+        print()
+        print("***************************")
+        print("Test 4:")
+        print("Buffer depth = ", testBlock.get_BufferDepth())
+        print("Number of output samples = ", len(resBlock_stream_1))
+
+        self.assertEqual(testBlock.get_BufferDepth(), Depth)
+        self.assertEqual(list(resBlock_stream_1), Out_Exp_1)
+        self.assertEqual(list(resBlock_stream_2), Out_Exp_2)
+
+
+    def test_005_t(self):  # test 5: zero-copy mode; the delay of test 3 is held by the input buffers and no error values are sent out
+        PacketSize = 2
+        Delay = 256 + 3
+        NumOfPack = Delay + 50
+        N = PacketSize*NumOfPack
+        Offset = 3
+
+        data_1 = numpy.array([x % 100 for x in range(0, N)])
+        data_2 = numpy.array([(x*7) % 100 for x in range(0, N)])
+        sync = numpy.zeros(N, dtype = numpy.byte)
+        sync[0::PacketSize] = 1
+
+        counter_1 = numpy.zeros(N, dtype = numpy.int)
+        counter_1[::PacketSize] = range(Delay, NumOfPack + Delay)
+        counter_2 = numpy.zeros(N, dtype = numpy.int)
+        counter_2[::PacketSize] = range(0, NumOfPack)
+
+        # items before the first packet start of input 2 are skipped
+        data_2 = numpy.insert(data_2, 0, [0,]*Offset)
+        sync_2 = numpy.insert(sync, 0, [0,]*Offset)
+        counter_2 = numpy.insert(counter_2, 0, [0,]*Offset)
+
+        Out_Exp_1 = list(data_1[:-PacketSize*Delay])
+        Out_Exp_2 = list(data_2[Offset + PacketSize*Delay:])
+
+        testBlock = Hybrid_Comm.Stream_Aligner(PacketSize, False, 16, 1, True)
+        dst_stream_1 = blocks.vector_sink_b()
+        dst_stream_2 = blocks.vector_sink_b()
+        dst_delay = blocks.vector_sink_b()
+        self.tb.connect(blocks.vector_source_b(data_1), (testBlock, 0))
+        self.tb.connect(blocks.vector_source_b(sync), (testBlock, 1))
+        self.tb.connect(blocks.vector_source_i(counter_1), (testBlock, 2))
+        self.tb.connect(blocks.vector_source_b(data_2), (testBlock, 3))
+        self.tb.connect(blocks.vector_source_b(sync_2), (testBlock, 4))
+        self.tb.connect(blocks.vector_source_i(counter_2), (testBlock, 5))
+        self.tb.connect((testBlock, 0), dst_stream_1)
+        self.tb.connect((testBlock, 1), dst_stream_2)
+        self.tb.connect((testBlock, 2), dst_delay)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_stream_1 = dst_stream_1.data()
+        resBlock_stream_2 = dst_stream_2.data()
+
+        print()
+        print("***************************")
+        print("Test 5:")
+        print("Zero copy = ", testBlock.get_ZeroCopy())
+        print("Number of output samples = ", len(resBlock_stream_1))
+
+        self.assertEqual(testBlock.get_ZeroCopy(), True)
+        self.assertEqual(list(resBlock_stream_1), Out_Exp_1)
+        self.assertEqual(list(resBlock_stream_2), Out_Exp_2)
+
+
+    def test_006_t(self):  # test 6: three links, each aligned to the slowest one
+        PacketSize = 2
+        Delays = [5, 2, 0]
+        NumOfPack = 40
+        N = PacketSize*NumOfPack
+        NumOfLinks = len(Delays)
+
+        sync = numpy.zeros(N, dtype = numpy.byte)
+        sync[0::PacketSize] = 1
+
+        testBlock = Hybrid_Comm.Stream_Aligner(PacketSize, False, 16, 1, False, NumOfLinks)
+        Out_Exp = []
+        dst_stream = []
+        for index_l in range(0, NumOfLinks):
+            data = numpy.array([(x*(2*index_l + 3)) % 100 for x in range(0, N)])
+            counter = numpy.zeros(N, dtype = numpy.int)
+            counter[::PacketSize] = range(Delays[index_l], NumOfPack + Delays[index_l])
+            Out_Exp.append(list(data[PacketSize*(max(Delays) - Delays[index_l]):N - PacketSize*Delays[index_l]]))
+
+            dst_stream.append(blocks.vector_sink_b())
+            self.tb.connect(blocks.vector_source_b(data), (testBlock, 3*index_l))
+            self.tb.connect(blocks.vector_source_b(sync), (testBlock, 3*index_l + 1))
+            self.tb.connect(blocks.vector_source_i(counter), (testBlock, 3*index_l + 2))
+            self.tb.connect((testBlock, index_l), dst_stream[index_l])
+
+        # set up fg
+        self.tb.run()
+
+        print()
+        print("***************************")
+        print("Test 6:")
+        print("Number of links = ", testBlock.get_NumOfLinks())
+        print("Zero copy = ", testBlock.get_ZeroCopy())
+
+        self.assertEqual(testBlock.get_NumOfLinks(), NumOfLinks)
+        self.assertEqual(testBlock.get_ZeroCopy(), True)
+        for index_l in range(0, NumOfLinks):
+            self.assertEqual(list(dst_stream[index_l].data()), Out_Exp[index_l])
+
+
+    def test_007_t(self):  # test 7: jitter mode; a pair of reordered packets does not move the delay, and each is paired with the packet of its counter
+        PacketSize = 2
+        Delay = 3
+        NumOfPack = 60
+        N = PacketSize*NumOfPack
+
+        data_1 = numpy.array([x % 100 for x in range(0, N)])
+        data_2 = numpy.array([(x*7) % 100 for x in range(0, N)])
+        sync = numpy.zeros(N, dtype = numpy.byte)
+        sync[0::PacketSize] = 1
+
+        count_1 = list(range(Delay, NumOfPack + Delay))
+        count_1[20], count_1[21] = count_1[21], count_1[20]  # packets 20 and 21 of stream 1 arrive swapped
+        counter_1 = numpy.zeros(N, dtype = numpy.int)
+        counter_1[::PacketSize] = count_1
+        counter_2 = numpy.zeros(N, dtype = numpy.int)
+        counter_2[::PacketSize] = range(0, NumOfPack)
+
+        Out_Exp_1 = [255,]*(PacketSize*Delay) + list(data_1[:-PacketSize*Delay])
+        Out_Exp_2 = [255,]*(PacketSize*Delay) + list(data_2[PacketSize*Delay:])
+        Out_Exp_1[PacketSize*23:PacketSize*24] = data_1[PacketSize*21:PacketSize*22]  # counter 23 came second
+        Out_Exp_1[PacketSize*24:PacketSize*25] = data_1[PacketSize*20:PacketSize*21]  # counter 24 came first; both pairs go out
+
+        testBlock = Hybrid_Comm.Stream_Aligner(PacketSize, False, 16, 5, False, 2, True)
+        dst_stream_1 = blocks.vector_sink_b()
+        dst_stream_2 = blocks.vector_sink_b()
+        dst_delay = blocks.vector_sink_b()
+        self.tb.connect(blocks.vector_source_b(data_1), (testBlock, 0))
+        self.tb.connect(blocks.vector_source_b(sync), (testBlock, 1))
+        self.tb.connect(blocks.vector_source_i(counter_1), (testBlock, 2))
+        self.tb.connect(blocks.vector_source_b(data_2), (testBlock, 3))
+        self.tb.connect(blocks.vector_source_b(sync), (testBlock, 4))
+        self.tb.connect(blocks.vector_source_i(counter_2), (testBlock, 5))
+        self.tb.connect((testBlock, 0), dst_stream_1)
+        self.tb.connect((testBlock, 1), dst_stream_2)
+        self.tb.connect((testBlock, 2), dst_delay)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_stream_1 = dst_stream_1.data()
+        resBlock_stream_2 = dst_stream_2.data()
+        resBlock_delay = dst_delay.data()
+
+        print()
+        print("***************************")
+        print("Test 7:")
+        print("Jitter mode = ", testBlock.get_JitterMode())
+        print("Jitter buffer delay = ", testBlock.get_JitterDelay())
+        print("Delay = ", resBlock_delay)
+
+        self.assertEqual(testBlock.get_JitterMode(), True)
+        self.assertEqual(testBlock.get_JitterDelay(), Delay)
+        self.assertEqual(list(resBlock_stream_1), Out_Exp_1)
+        self.assertEqual(list(resBlock_stream_2), Out_Exp_2)
+        self.assertEqual(list(resBlock_delay), [Delay,]*N)
+        with self.assertRaises((ValueError, RuntimeError)):  # the jitter buffer is not used in zero-copy mode
+            Hybrid_Comm.Stream_Aligner(PacketSize, False, 16, 5, True, 2, True)
+        with self.assertRaises((ValueError, RuntimeError)):  # nor with more than 2 links
+            Hybrid_Comm.Stream_Aligner(PacketSize, False, 16, 5, False, 3, True)
+
+
+    def test_008_t(self):  # test 8: jitter mode; misaligned sync pulses mid-stream discard items, and the packets left in the buffer are not paired with later ones
+        PacketSize = 2
+        Delay = 3
+        NumOfPack = 60
+        N = PacketSize*NumOfPack
+
+        data_1 = numpy.repeat(numpy.arange(0, NumOfPack), PacketSize)  # stream 1 packet p is all p
+        data_2 = numpy.repeat(numpy.arange(100, NumOfPack + 100), PacketSize)  # stream 2 packet p is all p + 100
+        sync_1 = numpy.zeros(N, dtype = numpy.byte)
+        sync_1[0::PacketSize] = 1
+        sync_2 = numpy.copy(sync_1)
+        sync_2[PacketSize*30:PacketSize*40] = [0, 1]*10  # the pulses of packets 30 to 39 of stream 2 are an item late; a call starts among them
+
+        counter_1 = numpy.zeros(N, dtype = numpy.int)
+        counter_1[::PacketSize] = range(Delay, NumOfPack + Delay)
+        counter_2 = numpy.zeros(N, dtype = numpy.int)
+        counter_2[::PacketSize] = range(0, NumOfPack)
+
+        testBlock = Hybrid_Comm.Stream_Aligner(PacketSize, False, 16, 5, False, 2, True)
+        dst_stream_1 = blocks.vector_sink_b()
+        dst_stream_2 = blocks.vector_sink_b()
+        dst_delay = blocks.vector_sink_b()
+        self.tb.connect(blocks.vector_source_b(data_1), (testBlock, 0))
+        self.tb.connect(blocks.vector_source_b(sync_1), (testBlock, 1))
+        self.tb.connect(blocks.vector_source_i(counter_1), (testBlock, 2))
+        self.tb.connect(blocks.vector_source_b(data_2), (testBlock, 3))
+        self.tb.connect(blocks.vector_source_b(sync_2), (testBlock, 4))
+        self.tb.connect(blocks.vector_source_i(counter_2), (testBlock, 5))
+        self.tb.connect((testBlock, 0), dst_stream_1)
+        self.tb.connect((testBlock, 1), dst_stream_2)
+        self.tb.connect((testBlock, 2), dst_delay)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_stream_1 = list(dst_stream_1.data())
+        resBlock_stream_2 = list(dst_stream_2.data())
+
+        Misaligned = 0  # packets discarded for the misaligned pulses
+        Paired = 0  # packets sent out in pairs
+        for index_p in range(0, NumOfPack):  # every output packet is an error, or packet p - Delay of stream 1 with packet p of stream 2
+            Packet_1 = resBlock_stream_1[PacketSize*index_p:PacketSize*(index_p + 1)]
+            Packet_2 = resBlock_stream_2[PacketSize*index_p:PacketSize*(index_p + 1)]
+            if Packet_1 == [251,]*PacketSize:
+                self.assertEqual(Packet_2, [251,]*PacketSize)
+                Misaligned += 1
+            elif Packet_1 == [255,]*PacketSize:
+                self.assertEqual(Packet_2, [255,]*PacketSize)
+            else:
+                self.assertEqual(Packet_1, [index_p - Delay,]*PacketSize)
+                self.assertEqual(Packet_2, [index_p + 100,]*PacketSize)
+                Paired += 1
+
+        print()
+        print("***************************")
+        print("Test 8:")
+        print("Misaligned packets = ", Misaligned)
+        print("Paired packets = ", Paired)
+
+        self.assertEqual(len(resBlock_stream_1), N)
+        self.assertGreater(Misaligned, 0)
+        self.assertEqual(resBlock_stream_1[-PacketSize*5:], list(data_1[-PacketSize*(5 + Delay):-PacketSize*Delay]))  # aligned again after the misaligned pulses
+        self.assertEqual(testBlock.get_JitterDelay(), Delay)
+
+
+    def test_009_t(self):  # test 9: tag mode; two links through Remove_Header in tag mode, aligned by the buffer bank
+        PacketSize = 20
+        Delay = 3
+        NumOfPack = 30
+        N = PacketSize*NumOfPack
+
+        data_1 = [(x % 100) + 2 for x in range(0, N)]  # never matches the header bits
+        data_2 = [((x*3) % 100) + 2 for x in range(0, N)]
+
+        Out_Exp_1 = [255,]*(PacketSize*Delay) + data_1[PacketSize*Delay:N - PacketSize*Delay]  # link 1 starts at counter Delay
+        Out_Exp_2 = [255,]*(PacketSize*Delay) + data_2[PacketSize*Delay:N - PacketSize*Delay]
+
+        testBlock = Hybrid_Comm.Stream_Aligner(PacketSize, True)
+        dst_stream_1 = blocks.vector_sink_b()
+        dst_stream_2 = blocks.vector_sink_b()
+        self.tb.connect(self.TaggedLink(data_1, PacketSize, Delay), (testBlock, 0))
+        self.tb.connect(self.TaggedLink(data_2, PacketSize, 0), (testBlock, 1))
+        self.tb.connect((testBlock, 0), dst_stream_1)
+        self.tb.connect((testBlock, 1), dst_stream_2)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_stream_1 = list(dst_stream_1.data())
+        resBlock_stream_2 = list(dst_stream_2.data())
+
+        print()
+        print("***************************")
+        print("Test 9:")
+        print("Tag mode = ", testBlock.get_TagMode())
+        print("Number of output samples = ", len(resBlock_stream_1))
+
+        self.assertTrue(testBlock.get_TagMode())
+        self.assertEqual(resBlock_stream_1, Out_Exp_1)
+        self.assertEqual(resBlock_stream_2, Out_Exp_2)
+
+
+    def test_010_t(self):  # test 10: tag mode; two links through Remove_Header in tag mode, aligned in zero-copy mode with the tags of the packets
+        PacketSize = 20
+        Delay = 4
+        NumOfPack = 30
+        N = PacketSize*NumOfPack
+
+        data_1 = [(x % 100) + 2 for x in range(0, N)]
+        data_2 = [((x*3) % 100) + 2 for x in range(0, N)]
+
+        testBlock = Hybrid_Comm.Stream_Aligner(PacketSize, True, 16, 1, True)
+        dst_stream_1 = blocks.vector_sink_b()
+        dst_stream_2 = blocks.vector_sink_b()
+        self.tb.connect(self.TaggedLink(data_1, PacketSize, 0), (testBlock, 0))
+        self.tb.connect(self.TaggedLink(data_2, PacketSize, Delay), (testBlock, 1))
+        self.tb.connect((testBlock, 0), dst_stream_1)
+        self.tb.connect((testBlock, 1), dst_stream_2)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock_stream_1 = list(dst_stream_1.data())
+        resBlock_stream_2 = list(dst_stream_2.data())
+        Tags = dst_stream_1.tags()
+        Res_start = [t.offset for t in Tags if pmt.symbol_to_string(t.key) == 'packet_start']
+        Res_counter = [pmt.to_long(t.value) for t in Tags if pmt.symbol_to_string(t.key) == 'seq']
+
+        print()
+        print("***************************")
+        print("Test 10:")
+        print("Zero copy = ", testBlock.get_ZeroCopy())
+        print("Counter values = ", Res_counter)
+
+        self.assertEqual(testBlock.get_ZeroCopy(), True)
+        self.assertEqual(resBlock_stream_1, data_1[PacketSize*Delay:])  # only the packets of both links
+        self.assertEqual(resBlock_stream_2, data_2[PacketSize*Delay:])
+        self.assertEqual(Res_start, [x*PacketSize for x in range(0, NumOfPack - Delay)])
+        self.assertEqual(Res_counter, list(range(Delay, NumOfPack)))
+
+
+    def test_011_t(self):  # test 11: the Stream Aligner (Multi Link) block of GRC; three links through Remove_Header in tag mode
+        PacketSize = 20
+        Delays = [5, 2, 0]
+        NumOfPack = 30
+        N = PacketSize*NumOfPack
+        NumOfLinks = len(Delays)
+
+        testBlock = Hybrid_Comm.Stream_Aligner(PacketSize, True, 16, 1, True, NumOfLinks)  # make line of the block
+        Out_Exp = []
+        dst_stream = []
+        for index_l in range(0, NumOfLinks):
+            data = [((x*(2*index_l + 1)) % 100) + 2 for x in range(0, N)]
+            Out_Exp.append(data[PacketSize*max(Delays):])  # the counters every link has
+
+            dst_stream.append(blocks.vector_sink_b())
+            self.tb.connect(self.TaggedLink(data, PacketSize, Delays[index_l]), (testBlock, index_l))
+            self.tb.connect((testBlock, index_l), dst_stream[index_l])
+
+        # set up fg
+        self.tb.run()
+
+        print()
+        print("***************************")
+        print("Test 11:")
+        print("Number of links = ", testBlock.get_NumOfLinks())
+        print("Link delays = ", [testBlock.get_LinkDelay(x) for x in range(0, NumOfLinks)])
+
+        self.assertEqual(testBlock.get_NumOfLinks(), NumOfLinks)
+        self.assertTrue(testBlock.get_TagMode())
+        for index_l in range(0, NumOfLinks):
+            self.assertEqual(list(dst_stream[index_l].data()), Out_Exp[index_l])
+
+
+    def TaggedLink(self, Data, PacketSize, Skip):  # packets framed by Add_Header and taken by Remove_Header in tag mode; the first Skip packets are lost
+        Preamble = (0, 0, 1, 1, 0, 1, 0, 1)
+        Label = 'L1'
+        HeaderSpB = 1
+        FrameLen = (len(Preamble) + 8*len(Label) + 16)*HeaderSpB + PacketSize
+
+        src = blocks.vector_source_b(Data)
+        txBlock = Hybrid_Comm.Add_Header(PacketSize, Preamble, Label, HeaderSpB)
+        skip = blocks.skiphead(gr.sizeof_char, Skip*FrameLen)
+        rxBlock = Hybrid_Comm.Remove_Header(PacketSize, Preamble, Label, HeaderSpB, True)
+        self.tb.connect(src, txBlock, skip, rxBlock)
+        return rxBlock
+
+
 if __name__ == '__main__':
     numpy.random.seed(int(time.time()))
     gr_unittest.run(qa_Stream_Aligner)
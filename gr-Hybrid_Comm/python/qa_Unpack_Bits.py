@@ -0,0 +1,107 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2020 gr-Hybrid_Comm author.
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this software; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+from gnuradio import blocks
+import Hybrid_Comm_swig as Hybrid_Comm
+import random
+import numpy
+import math
+import time
+
+class qa_Unpack_Bits(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def test_001_t(self):  # one sample per bit
+        NoBytes = 100  # number of bytes
+        SpB = 1
+
+        Bytes = numpy.random.randint(0, 256, NoBytes)
+        Sig = Bytes.tolist()
+
+        src = blocks.vector_source_b(Sig)
+        testBlock = Hybrid_Comm.Unpack_Bits(SpB)
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, testBlock)
+        self.tb.connect(testBlock, dst)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resBlock = dst.data()
+
+        Exp_Res = numpy.unpackbits(Bytes.astype(numpy.uint8)).tolist()  # most significant bit first
+
+        print()
+        print("***************************")
+        print("Test 1:")
+        print("Number of bytes = ", NoBytes)
+        print("Results length = ", len(resBlock))
+        print()
+
+        self.assertFloatTuplesAlmostEqual(Exp_Res, resBlock, 0)
+
+
+    def test_002_t(self):  # unpack with samples per bit, then pack back
+        NoBytes = 100  # number of bytes
+        SpB = 4
+
+        Bytes = numpy.random.randint(0, 256, NoBytes)
+        Sig = Bytes.tolist()
+
+        src = blocks.vector_source_b(Sig)
+        testBlock = Hybrid_Comm.Unpack_Bits(SpB)
+        packBlock = Hybrid_Comm.Pack_Bits(SpB)
+        dst_unpacked = blocks.vector_sink_b()
+        dst_packed = blocks.vector_sink_b()
+        self.tb.connect(src, testBlock)
+        self.tb.connect(testBlock, dst_unpacked)
+        self.tb.connect(testBlock, packBlock)
+        self.tb.connect(packBlock, dst_packed)
+
+        # set up fg
+        self.tb.run()
+        # check data
+        resUnpacked = dst_unpacked.data()
+        resPacked = dst_packed.data()
+
+        Exp_Res = numpy.repeat(numpy.unpackbits(Bytes.astype(numpy.uint8)), SpB).tolist()
+
+        print()
+        print("***************************")
+        print("Test 2:")
+        print("Number of bytes = ", NoBytes)
+        print("Samples per bit = ", SpB)
+        print("Results length = ", len(resUnpacked))
+        print()
+
+        self.assertFloatTuplesAlmostEqual(Exp_Res, resUnpacked, 0)
+        self.assertFloatTuplesAlmostEqual(Sig, resPacked, 0)
+
+
+if __name__ == '__main__':
+    numpy.random.seed(int(time.time()))
+    gr_unittest.run(qa_Unpack_Bits)
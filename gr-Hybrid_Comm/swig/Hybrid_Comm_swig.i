@@ -23,6 +23,9 @@
 #include "Hybrid_Comm/Slicer.h"
 #include "Hybrid_Comm/Tx_Hard_Switch.h"
 #include "Hybrid_Comm/Tx_Soft_Switch.h"
+#include "Hybrid_Comm/Pack_Bits.h"
+#include "Hybrid_Comm/Preamble_Sync.h"
+#include "Hybrid_Comm/Unpack_Bits.h"
 
 %}
 
@@ -57,4 +60,10 @@ GR_SWIG_BLOCK_MAGIC2(Hybrid_Comm, Slicer);
 GR_SWIG_BLOCK_MAGIC2(Hybrid_Comm, Tx_Hard_Switch);
 %include "Hybrid_Comm/Tx_Soft_Switch.h"
 GR_SWIG_BLOCK_MAGIC2(Hybrid_Comm, Tx_Soft_Switch);
+%include "Hybrid_Comm/Pack_Bits.h"
+GR_SWIG_BLOCK_MAGIC2(Hybrid_Comm, Pack_Bits);
+%include "Hybrid_Comm/Preamble_Sync.h"
+GR_SWIG_BLOCK_MAGIC2(Hybrid_Comm, Preamble_Sync);
+%include "Hybrid_Comm/Unpack_Bits.h"
+GR_SWIG_BLOCK_MAGIC2(Hybrid_Comm, Unpack_Bits);
 
@@ -0,0 +1,55 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2020 gr-RF_Comm author.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+// sustained throughput of the RF_Comm blocks; see Throughput_Harness for the options
+
+#include <RF_Comm/FSP_Loss.h>
+#include <RF_Comm/Rain_Loss.h>
+
+#include <throughput_harness.h>
+
+using namespace gr::Comm_Kernels;
+
+
+int main(int argc, char **argv)
+{
+  Throughput_Harness Harness("RF_Comm", argc, argv);
+
+  const std::vector<float> vUnit(1024, 1.0f);  // unit signal; the channel blocks only scale it
+  const std::vector<size_t> vFloatOut = {sizeof(float)};
+
+  Harness.add("FSP_Loss", 0, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::RF_Comm::FSP_Loss::sptr block = gr::RF_Comm::FSP_Loss::make(1000, 0.01);
+    H.connect_source<float>(tb, vUnit, block, 0);
+    H.connect_sinks(tb, block, vFloatOut);
+    return block;
+  });
+
+  Harness.add("Rain_Loss", 0, [&](Throughput_Harness &H, gr::top_block_sptr tb, const Throughput_Point &P) -> gr::block_sptr
+  {
+    gr::RF_Comm::Rain_Loss::sptr block = gr::RF_Comm::Rain_Loss::make(1000, 64.8);
+    H.connect_source<float>(tb, vUnit, block, 0);
+    H.connect_sinks(tb, block, vFloatOut);
+    return block;
+  });
+
+  return Harness.run();
+}
@@ -22,11 +22,12 @@
 #define INCLUDED_RF_COMM_RAIN_LOSS_IMPL_H
 
 #include <RF_Comm/Rain_Loss.h>
+#include <Comm_Kernels/perf_block.h>
 
 namespace gr {
   namespace RF_Comm {
 
-    class Rain_Loss_impl : public Rain_Loss
+    class Rain_Loss_impl : public Rain_Loss, public Comm_Kernels::Perf_Block
     {
      private:
       // Nothing to declare in this block.
@@ -47,6 +48,12 @@ namespace gr {
               gr_vector_void_star &output_items
       );
 
+      // Register the performance counters with ControlPort
+      void setup_rpc()
+      {
+        this->setup_Perf_Rpc(alias());
+      }
+
       // Set link length
       void set_LinkLen(float linkLen)
       {